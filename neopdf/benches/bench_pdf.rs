@@ -1,7 +1,43 @@
 use criterion::{criterion_group, criterion_main, Criterion};
+use std::alloc::{GlobalAlloc, Layout, System};
+use std::sync::atomic::{AtomicUsize, Ordering};
 
 use neopdf::pdf::PDF;
 
+/// Global allocator that counts the number of heap allocations.
+struct CountingAllocator;
+
+static ALLOCATIONS: AtomicUsize = AtomicUsize::new(0);
+
+unsafe impl GlobalAlloc for CountingAllocator {
+    unsafe fn alloc(&self, layout: Layout) -> *mut u8 {
+        ALLOCATIONS.fetch_add(1, Ordering::Relaxed);
+        unsafe { System.alloc(layout) }
+    }
+
+    unsafe fn dealloc(&self, ptr: *mut u8, layout: Layout) {
+        unsafe { System.dealloc(ptr, layout) }
+    }
+
+    unsafe fn realloc(&self, ptr: *mut u8, layout: Layout, new_size: usize) -> *mut u8 {
+        ALLOCATIONS.fetch_add(1, Ordering::Relaxed);
+        unsafe { System.realloc(ptr, layout, new_size) }
+    }
+}
+
+#[global_allocator]
+static GLOBAL: CountingAllocator = CountingAllocator;
+
+/// Returns the average number of heap allocations performed by one call of `f`.
+fn allocations_per_call<F: FnMut()>(ncalls: usize, mut f: F) -> f64 {
+    let before = ALLOCATIONS.load(Ordering::Relaxed);
+    for _ in 0..ncalls {
+        f();
+    }
+    let after = ALLOCATIONS.load(Ordering::Relaxed);
+    (after - before) as f64 / ncalls as f64
+}
+
 fn xfxq2(c: &mut Criterion) {
     let pdf = PDF::load("NNPDF40_nnlo_as_01180", 0);
 
@@ -10,6 +46,71 @@ fn xfxq2(c: &mut Criterion) {
     });
 }
 
+fn xfxq2_scan(c: &mut Criterion) {
+    let pdf = PDF::load("NNPDF40_nnlo_as_01180", 0);
+    let pids = [-5, -4, -3, -2, -1, 21, 1, 2, 3, 4, 5];
+    // A scan over points of all the subgrids, such that the scalar path is dominated by the
+    // dispatch to the interpolators of the different subgrids and flavors.
+    let points: Vec<[f64; 2]> = (0..100)
+        .flat_map(|ix| {
+            let x = 10f64.powf(-8.0 + 7.9 * ix as f64 / 99.0);
+            (0..10).map(move |iq2| [x, 10f64.powf(0.5 + 7.0 * iq2 as f64 / 9.0)])
+        })
+        .collect();
+
+    c.bench_function("xfxq2_scan", |b| {
+        b.iter(|| {
+            for point in &points {
+                for &pid in &pids {
+                    std::hint::black_box(pdf.xfxq2(pid, std::hint::black_box(point)));
+                }
+            }
+        })
+    });
+}
+
+fn xfxq2_allocations(c: &mut Criterion) {
+    let pdf = PDF::load("NNPDF40_nnlo_as_01180", 0);
+
+    // The scalar path must not allocate, neither inside nor outside the grid ranges.
+    for point in [[1e-3, 4.0], [1e-10, 1.0], [0.5, 1e12]] {
+        let allocations = allocations_per_call(1000, || {
+            std::hint::black_box(pdf.xfxq2(21, std::hint::black_box(&point)));
+        });
+        assert!(
+            allocations == 0.0,
+            "xfxq2 performs {allocations} allocations per call at {point:?}"
+        );
+    }
+
+    // The batch path must not allocate either, once the knots it caches on the first call
+    // are built, both for a single flavor and for flavors sharing the interpolation weights.
+    let pids = [-2, -1, 21, 1, 2];
+    let xs = [1e-3, 1e-10, 0.5];
+    let q2s = [4.0, 1.0, 1e12];
+    for flavors in [&pids[..1], &pids[..]] {
+        let mut out = vec![0.0; flavors.len() * xs.len()];
+        pdf.xfxq2_batch(flavors, &xs, &q2s, &mut out).unwrap();
+        let allocations = allocations_per_call(1000, || {
+            pdf.xfxq2_batch(flavors, std::hint::black_box(&xs), &q2s, &mut out)
+                .unwrap();
+        });
+        assert!(
+            allocations == 0.0,
+            "xfxq2_batch performs {allocations} allocations per call for {} flavors",
+            flavors.len()
+        );
+    }
+
+    c.bench_function("xfxq2_allocations", |b| {
+        b.iter(|| {
+            allocations_per_call(1, || {
+                std::hint::black_box(pdf.xfxq2(21, std::hint::black_box(&[1e-3, 4.0])));
+            })
+        })
+    });
+}
+
 fn xfxq2_cheby(c: &mut Criterion) {
     let pdf = PDF::load("MAP22_grids_FF_Km_N3LL.neopdf.lz4", 0);
 
@@ -36,6 +137,46 @@ fn xfxq2_cheby_batch(c: &mut Criterion) {
     });
 }
 
+/// Builds a TMD scan of `nkt` values of `kT` at each of the `nx * nq2` fixed `(x, Q2)`.
+fn tmd_scan(nkt: usize, nx: usize, nq2: usize) -> Vec<Vec<f64>> {
+    let linspace = |min: f64, max: f64, n: usize| -> Vec<f64> {
+        (0..n)
+            .map(|i| min + i as f64 * (max - min) / (n as f64 - 1.0))
+            .collect()
+    };
+    let kts = linspace(1e-4, 5.0, nkt);
+    let xs = linspace(1e-1, 0.9, nx);
+    let q2s = linspace(1.0, 1e4, nq2);
+
+    xs.iter()
+        .flat_map(|&x| q2s.iter().map(move |&q2| (x, q2)))
+        .flat_map(|(x, q2)| kts.iter().map(move |&kt| vec![kt, x, q2]))
+        .collect()
+}
+
+fn xfxq2_cheby_tmd_scan(c: &mut Criterion) {
+    let pdf = PDF::load("MAP22_grids_FF_Km_N3LL.neopdf.lz4", 0);
+
+    // 1e5 points: scans of 1000 values of `kT` at 100 fixed `(x, Q2)`.
+    let points = tmd_scan(1000, 10, 10);
+    let slice_points: Vec<&[f64]> = points.iter().map(Vec::as_slice).collect();
+
+    let mut group = c.benchmark_group("xfxq2_cheby_tmd_scan");
+    group.sample_size(10);
+    group.bench_function("batch", |b| {
+        b.iter(|| pdf.xfxq2_cheby_batch(2, std::hint::black_box(&slice_points)))
+    });
+    group.bench_function("scalar", |b| {
+        b.iter(|| {
+            std::hint::black_box(&slice_points)
+                .iter()
+                .map(|point| pdf.xfxq2(2, point))
+                .sum::<f64>()
+        })
+    });
+    group.finish();
+}
+
 fn xfxq2s(c: &mut Criterion) {
     let pdf = PDF::load("NNPDF40_nnlo_as_01180", 0);
 
@@ -60,6 +201,35 @@ fn xfxq2s(c: &mut Criterion) {
     });
 }
 
+fn xfxq2_grid(c: &mut Criterion) {
+    let pdf = PDF::load("NNPDF40_nnlo_as_01180", 0);
+
+    // A table of 100 x 100 points for 11 flavors, as used for convolutions and plots.
+    let pids: Vec<i32> = (-5..=5)
+        .map(|pid| if pid == 0 { 21 } else { pid })
+        .collect();
+    let xs: Vec<f64> = (0..100)
+        .map(|i| 10f64.powf(-6.0 + 6.0 * f64::from(i) / 99.0))
+        .collect();
+    let q2s: Vec<f64> = (0..100)
+        .map(|i| 10f64.powf(0.5 + 5.0 * f64::from(i) / 99.0))
+        .collect();
+    let (xs_batch, q2s_batch): (Vec<f64>, Vec<f64>) = xs
+        .iter()
+        .flat_map(|&x| q2s.iter().map(move |&q2| (x, q2)))
+        .unzip();
+    let mut out = vec![0.0; pids.len() * xs.len() * q2s.len()];
+
+    let mut group = c.benchmark_group("xfxq2_grid");
+    group.bench_function("grid", |b| {
+        b.iter(|| pdf.xfxq2_grid(&pids, std::hint::black_box(&xs), &q2s, &mut out))
+    });
+    group.bench_function("batch", |b| {
+        b.iter(|| pdf.xfxq2_batch(&pids, std::hint::black_box(&xs_batch), &q2s_batch, &mut out))
+    });
+    group.finish();
+}
+
 fn xfxq2_members(c: &mut Criterion) {
     let pdfs = PDF::load_pdfs("NNPDF40_nnlo_as_01180");
 
@@ -74,9 +244,13 @@ fn xfxq2_members(c: &mut Criterion) {
 criterion_group!(
     benches,
     xfxq2,
+    xfxq2_scan,
+    xfxq2_allocations,
     xfxq2s,
+    xfxq2_grid,
     xfxq2_members,
     xfxq2_cheby,
-    xfxq2_cheby_batch
+    xfxq2_cheby_batch,
+    xfxq2_cheby_tmd_scan
 );
 criterion_main!(benches);
@@ -6,10 +6,12 @@
 use ninterp::interpolator::Extrapolate;
 use ninterp::prelude::*;
 use std::collections::HashMap;
+use std::sync::atomic::{AtomicUsize, Ordering};
 use thiserror::Error;
 
 use super::metadata::MetaData;
 use super::strategy::AlphaSCubicInterpolation;
+use super::utils;
 
 /// Errors that can occur during the analytical computations of `alpha_s`.
 #[derive(Debug, Error)]
@@ -55,6 +57,35 @@ impl AlphaS {
             AlphaS::Interpol(interpol) => interpol.alphas_q2(q2),
         }
     }
+
+    /// Calculates the strong coupling `alpha_s` at several values of `Q^2`, such that
+    /// `out[i]` holds the value at `q2s[i]`. The method is only dispatched once.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `q2s` and `out` have different lengths.
+    pub fn alphas_q2s(&self, q2s: &[f64], out: &mut [f64]) {
+        assert_eq!(q2s.len(), out.len());
+        match self {
+            AlphaS::Analytic(analytic) => {
+                for (value, &q2) in out.iter_mut().zip(q2s) {
+                    *value = analytic.alphas_q2(q2);
+                }
+            }
+            AlphaS::Interpol(interpol) => {
+                for (value, &q2) in out.iter_mut().zip(q2s) {
+                    *value = interpol.alphas_q2(q2);
+                }
+            }
+        }
+    }
+}
+
+/// The constants of the analytic running for a given number of active flavors.
+#[derive(Clone, Copy)]
+struct RunningConstants {
+    lambda_qcd: f64,
+    betas: [f64; 4],
 }
 
 /// Strong coupling calculator using the analytic formulas.
@@ -66,6 +97,11 @@ pub struct AlphaSAnalytic {
     mb_sq: f64,
     mt_sq: f64,
     num_fl: u32,
+    /// Whether the flavor scheme is `FIXED`, resolved once instead of at every call.
+    fixed_scheme: bool,
+    /// `Lambda_QCD` and the beta function coefficients for each number of active flavors,
+    /// or `None` if no `Lambda_QCD` is defined for it.
+    constants: [Option<RunningConstants>; 7],
 }
 
 impl AlphaSAnalytic {
@@ -82,20 +118,35 @@ impl AlphaSAnalytic {
             meta.alphas_order_qcd
         };
 
-        Ok(Self {
+        let mut analytic = Self {
             qcd_order: alphas_order_qcd,
             lambda_maps,
             mc_sq: meta.m_charm * meta.m_charm,
             mb_sq: meta.m_bottom * meta.m_bottom,
             mt_sq: meta.m_top * meta.m_top,
             num_fl: meta.number_flavors,
+            fixed_scheme: meta.flavor_scheme.to_uppercase() == "FIXED",
             fl_scheme: meta.flavor_scheme.clone(),
-        })
+            constants: [None; 7],
+        };
+
+        analytic.constants = std::array::from_fn(|nf| {
+            let nf = nf as u32;
+            analytic
+                .lambda_qcd(nf)
+                .ok()
+                .map(|lambda_qcd| RunningConstants {
+                    lambda_qcd,
+                    betas: [0, 1, 2, 3].map(|bto| analytic.betas(bto, nf).unwrap()),
+                })
+        });
+
+        Ok(analytic)
     }
 
     fn number_flavors_q2(&self, q2: f64) -> u32 {
         match () {
-            _ if self.fl_scheme.to_uppercase() == "FIXED" => self.num_fl,
+            _ if self.fixed_scheme => self.num_fl,
             _ if q2 > self.mt_sq && self.mt_sq > 0.0 => 6,
             _ if q2 > self.mb_sq && self.mb_sq > 0.0 => 5,
             _ if q2 > self.mc_sq && self.mc_sq > 0.0 => 4,
@@ -142,7 +193,16 @@ impl AlphaSAnalytic {
     pub fn alphas_q2(&self, q2: f64) -> f64 {
         // Copied from https://gitlab.com/hepcedar/lhapdf/-/blob/main/src/AlphaS_Analytic.cc
         let nf = self.number_flavors_q2(q2);
-        let lambda_qcd = self.lambda_qcd(nf).unwrap();
+        let constants = self
+            .constants
+            .get(nf as usize)
+            .copied()
+            .flatten()
+            .unwrap_or_else(|| RunningConstants {
+                lambda_qcd: self.lambda_qcd(nf).unwrap(),
+                betas: [0, 1, 2, 3].map(|bto| self.betas(bto, nf).unwrap()),
+            });
+        let lambda_qcd = constants.lambda_qcd;
 
         if q2 <= lambda_qcd * lambda_qcd {
             return f64::INFINITY;
@@ -155,8 +215,7 @@ impl AlphaSAnalytic {
         };
         let y = 1.0 / lnx;
 
-        let beta0 = self.betas(0, nf).unwrap();
-        let beta1 = self.betas(1, nf).unwrap();
+        let [beta0, beta1, beta2, beta3] = constants.betas;
         let (beta02, beta12) = (beta0 * beta0, beta1 * beta1);
         let prefac = 1.0 / beta0;
         let mut tmp = 1.0;
@@ -171,8 +230,6 @@ impl AlphaSAnalytic {
         }
 
         if self.qcd_order > 2 {
-            let beta2 = self.betas(2, nf).unwrap();
-
             let prefac_b = beta12 / (beta02 * beta02);
             let a_20 = lnlnx2 - lnlnx;
             let a_21 = beta2 * beta0 / beta12;
@@ -181,9 +238,6 @@ impl AlphaSAnalytic {
         }
 
         if self.qcd_order > 3 {
-            let beta2 = self.betas(2, nf).unwrap();
-            let beta3 = self.betas(3, nf).unwrap();
-
             let prefac_c = 1. / (beta02 * beta02 * beta02);
             let a_30 = (beta12 * beta1) * (lnlnx3 - (5.0 / 2.0) * lnlnx2 - 2.0 * lnlnx + 0.5);
             let a_31 = 3.0 * beta0 * beta1 * beta2 * lnlnx;
@@ -198,11 +252,124 @@ impl AlphaSAnalytic {
 /// Strong coupling calculator using interpolation.
 pub struct AlphaSInterpol {
     interpolator: Interp1DOwned<f64, AlphaSCubicInterpolation>,
+    /// The precomputed cubic segments evaluating the values within the range of the knots.
+    table: Option<AlphaSTable>,
+}
+
+/// The cubic Hermite segment of `AlphaSCubicInterpolation` between two consecutive knots,
+/// with its derivatives already scaled by the width of the interval.
+#[derive(Clone, Copy)]
+struct HermiteSegment {
+    logq2: f64,
+    dlogq2: f64,
+    vl: f64,
+    vdl: f64,
+    vh: f64,
+    vdh: f64,
+}
+
+/// The segments of `AlphaSCubicInterpolation` for all the intervals of the knots, such that
+/// an evaluation within the range of the knots reduces to an interval search and a single
+/// cubic polynomial. The search first tries the interval of the previous evaluation, which
+/// is usually the right one when the scales are evaluated in order.
+///
+/// The segments are computed with the same operations as the strategy, such that the
+/// results are identical.
+struct AlphaSTable {
+    logq2s: Vec<f64>,
+    segments: Vec<HermiteSegment>,
+    /// Index of the knot preceding the previously evaluated point.
+    hint: AtomicUsize,
+}
+
+impl AlphaSTable {
+    /// Computes the segments of the knots `logq2s` with the values `alphas`, or returns
+    /// `None` if there are too few knots for the derivatives of the strategy.
+    fn new(logq2s: &[f64], alphas: &[f64]) -> Option<Self> {
+        let n = logq2s.len();
+        if n < 3 || alphas.len() != n {
+            return None;
+        }
+
+        let forward = |i: usize| (alphas[i + 1] - alphas[i]) / (logq2s[i + 1] - logq2s[i]);
+        let backward = |i: usize| (alphas[i] - alphas[i - 1]) / (logq2s[i] - logq2s[i - 1]);
+        let central = |i: usize| 0.5 * (forward(i) + backward(i));
+
+        let segments = (0..n - 1)
+            .map(|i| {
+                let (didlogq2, di1dlogq2) = if i == 0 {
+                    (forward(i), central(i + 1))
+                } else if i == n - 2 {
+                    (central(i), backward(i + 1))
+                } else {
+                    (central(i), central(i + 1))
+                };
+                let dlogq2 = logq2s[i + 1] - logq2s[i];
+
+                HermiteSegment {
+                    logq2: logq2s[i],
+                    dlogq2,
+                    vl: alphas[i],
+                    vdl: didlogq2 * dlogq2,
+                    vh: alphas[i + 1],
+                    vdh: di1dlogq2 * dlogq2,
+                }
+            })
+            .collect();
+
+        Some(Self {
+            logq2s: logq2s.to_vec(),
+            segments,
+            hint: AtomicUsize::new(0),
+        })
+    }
+
+    /// Evaluates the segment containing `logq2`, or returns `None` if `logq2` lies outside
+    /// of the range of the knots.
+    fn interpolate(&self, logq2: f64) -> Option<f64> {
+        let logq2s = &self.logq2s;
+        let n = logq2s.len();
+        if !(logq2s[0] <= logq2 && logq2 <= logq2s[n - 1]) {
+            return None;
+        }
+
+        // The index of the first knot not below `logq2`, as found by the strategy.
+        let hint = self.hint.load(Ordering::Relaxed);
+        let above = if hint + 1 < n && logq2s[hint] < logq2 && logq2 <= logq2s[hint + 1] {
+            hint + 1
+        } else {
+            let above = logq2s.partition_point(|&x| x < logq2);
+            self.hint.store(above.saturating_sub(1), Ordering::Relaxed);
+            above
+        };
+
+        // Select the interval as `AlphaSCubicInterpolation::ilogq2below`.
+        let i = if (logq2s[above] - logq2).abs() < 1e-9 {
+            if above == n - 1 {
+                above - 1
+            } else {
+                above
+            }
+        } else {
+            above - 1
+        };
+
+        let segment = &self.segments[i];
+        let tlogq2 = (logq2 - segment.logq2) / segment.dlogq2;
+        Some(utils::hermite_cubic_interpolate(
+            tlogq2,
+            segment.vl,
+            segment.vdl,
+            segment.vh,
+            segment.vdh,
+        ))
+    }
 }
 
 impl AlphaSInterpol {
     pub fn from_metadata(meta: &MetaData) -> Result<Self, String> {
         let q2_values: Vec<f64> = meta.alphas_q_values.iter().map(|&q| (q * q).ln()).collect();
+        let table = AlphaSTable::new(&q2_values, &meta.alphas_vals);
         let interpolator = Interp1D::new(
             q2_values.into(),
             meta.alphas_vals.to_owned().into(),
@@ -211,10 +378,17 @@ impl AlphaSInterpol {
         )
         .map_err(|e| e.to_string())?;
 
-        Ok(Self { interpolator })
+        Ok(Self {
+            interpolator,
+            table,
+        })
     }
 
     pub fn alphas_q2(&self, q2: f64) -> f64 {
-        self.interpolator.interpolate(&[q2.ln()]).unwrap_or(0.0)
+        let logq2 = q2.ln();
+        self.table
+            .as_ref()
+            .and_then(|table| table.interpolate(logq2))
+            .unwrap_or_else(|| self.interpolator.interpolate(&[logq2]).unwrap_or(0.0))
     }
 }
@@ -0,0 +1,242 @@
+//! This module provides the on-demand loading of the members of a PDF set under a memory
+//! budget.
+//!
+//! # Contents
+//!
+//! - [`MemberCache`]: Decodes the members of a set when they are first requested and keeps
+//!   the most recently used ones resident, up to a given number of bytes.
+//! - [`CacheStats`]: Counters describing the activity and the content of a cache.
+//!
+//! # Note
+//!
+//! Loading all the members of a large set, e.g. the replicas of a Monte Carlo set, can exceed
+//! the available memory, while the lazy iterator only visits the members in order. A
+//! [`MemberCache`] gives random access to the members instead: a requested member is decoded
+//! from the set, e.g. with `GridArrayReader::load_grid` for NeoPDF sets, and the least
+//! recently used members are evicted whenever the resident members exceed the budget.
+
+use std::collections::{BTreeMap, HashMap};
+use std::sync::{Arc, Mutex, PoisonError};
+
+use super::gridpdf::LoadOptions;
+use super::metadata::MetaData;
+use super::pdf::{open_pdfset, pdfset_loader, PdfSet, PDF};
+
+/// Counters describing the activity and the content of a [`MemberCache`].
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct CacheStats {
+    /// The number of requests served by a resident member.
+    pub hits: u64,
+    /// The number of requests which required the member to be decoded.
+    pub misses: u64,
+    /// The number of members evicted to stay within the budget.
+    pub evictions: u64,
+    /// The number of bytes held by the resident members, see `PDF::resident_bytes`.
+    pub resident_bytes: usize,
+    /// The number of resident members.
+    pub num_resident: usize,
+}
+
+/// A resident member together with its size and the time of its last use.
+struct CacheEntry {
+    pdf: Arc<PDF>,
+    bytes: usize,
+    last_used: u64,
+}
+
+/// The mutable state of a [`MemberCache`], guarded by a single lock.
+#[derive(Default)]
+struct CacheState {
+    entries: HashMap<usize, CacheEntry>,
+    /// The resident members ordered by the time of their last use, oldest first.
+    recency: BTreeMap<u64, usize>,
+    /// Logical clock ordering the uses of the members.
+    clock: u64,
+    stats: CacheStats,
+}
+
+impl CacheState {
+    fn tick(&mut self) -> u64 {
+        self.clock += 1;
+        self.clock
+    }
+
+    /// Marks a resident member as used now, returning it.
+    ///
+    /// The size of the member is updated to include the interpolators built since it was
+    /// last requested.
+    fn touch(&mut self, member: usize) -> Option<Arc<PDF>> {
+        let now = self.tick();
+        let entry = self.entries.get_mut(&member)?;
+        self.recency.remove(&entry.last_used);
+        self.recency.insert(now, member);
+        entry.last_used = now;
+
+        let bytes = entry.pdf.resident_bytes();
+        self.stats.resident_bytes = self.stats.resident_bytes - entry.bytes + bytes;
+        entry.bytes = bytes;
+
+        Some(Arc::clone(&entry.pdf))
+    }
+
+    /// Evicts the least recently used members, except `keep`, until the resident members
+    /// fit into `max_bytes`.
+    fn evict(&mut self, max_bytes: usize, keep: usize) {
+        while self.stats.resident_bytes > max_bytes {
+            let Some((&last_used, &lru)) = self.recency.iter().find(|(_, &member)| member != keep)
+            else {
+                break;
+            };
+
+            self.recency.remove(&last_used);
+            let entry = self.entries.remove(&lru).unwrap();
+            self.stats.resident_bytes -= entry.bytes;
+            self.stats.evictions += 1;
+        }
+        self.stats.num_resident = self.entries.len();
+    }
+}
+
+/// Gives access to the members of a PDF set, decoding them on demand and keeping the most
+/// recently used ones resident within a memory budget.
+///
+/// The cache can be shared across threads. The members are handed out as `Arc<PDF>`, such
+/// that a member evicted while it is still in use stays valid until its last handle is
+/// dropped. The decoding of a member happens outside of the lock, so that concurrent
+/// requests for different members are decoded in parallel; concurrent requests for the same
+/// missing member may both decode it, in which case the first one to finish is kept.
+///
+/// The size of a member counted against the budget is `PDF::resident_bytes`, which grows as
+/// its interpolators are built by the evaluations. It is measured when the member is decoded
+/// and updated whenever the member is requested again.
+pub struct MemberCache {
+    set: Box<dyn PdfSet>,
+    info: MetaData,
+    options: LoadOptions,
+    max_bytes: usize,
+    state: Mutex<CacheState>,
+}
+
+impl MemberCache {
+    /// Creates a cache over the members of a PDF set.
+    ///
+    /// # Arguments
+    ///
+    /// * `pdf_name` - The name of the PDF set, in the LHAPDF or NeoPDF format.
+    /// * `max_bytes` - The maximum number of bytes held by the resident members. The most
+    ///   recently requested member is always kept, even if it alone exceeds the budget.
+    pub fn new(pdf_name: &str, max_bytes: usize) -> Self {
+        Self::with_options(pdf_name, max_bytes, LoadOptions::default())
+    }
+
+    /// Creates a cache over the members of a PDF set, whose members are built according to
+    /// `options`.
+    ///
+    /// # Arguments
+    ///
+    /// * `pdf_name` - The name of the PDF set, in the LHAPDF or NeoPDF format.
+    /// * `max_bytes` - The maximum number of bytes held by the resident members.
+    /// * `options` - The `LoadOptions` used to build the members.
+    pub fn with_options(pdf_name: &str, max_bytes: usize, options: LoadOptions) -> Self {
+        let set = open_pdfset(pdf_name);
+        let info = set.info().clone();
+
+        Self {
+            set,
+            info,
+            options,
+            max_bytes,
+            state: Mutex::new(CacheState::default()),
+        }
+    }
+
+    /// Returns the metadata shared by the members of the set.
+    pub fn metadata(&self) -> &MetaData {
+        &self.info
+    }
+
+    /// Returns the number of members of the set.
+    pub fn num_members(&self) -> usize {
+        self.set.num_members()
+    }
+
+    /// Returns the maximum number of bytes held by the resident members.
+    pub fn max_bytes(&self) -> usize {
+        self.max_bytes
+    }
+
+    /// Returns a member of the set, decoding it if it is not resident.
+    ///
+    /// # Arguments
+    ///
+    /// * `member` - The index of the member.
+    ///
+    /// # Returns
+    ///
+    /// The member, or `None` if `member` is not smaller than `num_members()`.
+    pub fn get(&self, member: usize) -> Option<Arc<PDF>> {
+        if member >= self.num_members() {
+            return None;
+        }
+
+        {
+            let mut state = self.lock();
+            if let Some(pdf) = state.touch(member) {
+                state.stats.hits += 1;
+                return Some(pdf);
+            }
+            state.stats.misses += 1;
+        }
+
+        let pdf = Arc::new(pdfset_loader(self.set.as_ref(), member, self.options));
+        let bytes = pdf.resident_bytes();
+
+        let mut guard = self.lock();
+        let state = &mut *guard;
+        let pdf = match state.touch(member) {
+            Some(pdf) => pdf,
+            None => {
+                // The clock was already advanced by `touch`.
+                let now = state.clock;
+                state.recency.insert(now, member);
+                state.entries.insert(
+                    member,
+                    CacheEntry {
+                        pdf: Arc::clone(&pdf),
+                        bytes,
+                        last_used: now,
+                    },
+                );
+                state.stats.resident_bytes += bytes;
+                pdf
+            }
+        };
+        state.evict(self.max_bytes, member);
+
+        Some(pdf)
+    }
+
+    /// Returns whether a member is resident, without affecting its recency.
+    pub fn contains(&self, member: usize) -> bool {
+        self.lock().entries.contains_key(&member)
+    }
+
+    /// Returns the counters of the cache.
+    pub fn stats(&self) -> CacheStats {
+        self.lock().stats
+    }
+
+    /// Drops all the resident members. The counters of requests are kept.
+    pub fn clear(&self) {
+        let mut state = self.lock();
+        state.entries.clear();
+        state.recency.clear();
+        state.stats.resident_bytes = 0;
+        state.stats.num_resident = 0;
+    }
+
+    fn lock(&self) -> std::sync::MutexGuard<'_, CacheState> {
+        self.state.lock().unwrap_or_else(PoisonError::into_inner)
+    }
+}
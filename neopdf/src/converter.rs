@@ -41,7 +41,7 @@ pub fn convert_lhapdf<P: AsRef<std::path::Path>>(
         .map(|(_meta, knot_array)| knot_array)
         .collect();
 
-    GridArrayCollection::compress(&grids, metadata, output_path)?;
+    GridArrayCollection::write(&grids, metadata, output_path)?;
     Ok(())
 }
 
@@ -148,14 +148,16 @@ pub fn combine_lhapdf_npdfs<P: AsRef<std::path::Path>>(
             }
 
             // Concatenate along the nucleons axis to get [nucleons=pdf_names.len(), ...]
-            let grid_views: Vec<_> = subgrids.iter().map(|sg| sg.grid.view()).collect();
+            let grids: Vec<_> = subgrids.iter().map(|sg| sg.grid()).collect();
+            let grid_views: Vec<_> = grids.iter().map(|grid| grid.view()).collect();
             let concatenated = concatenate(Axis(0), &grid_views.to_vec())?;
             let nucleons = Array1::from(a_values.clone());
             let new_subgrid = SubGrid {
                 xs: xs.clone(),
                 q2s: q2s.clone(),
                 kts: kts.clone(),
-                grid: concatenated,
+                grid: concatenated.into_shared(),
+                grid_f32: None,
                 nucleons,
                 alphas: alphas.clone(),
                 nucleons_range,
@@ -166,15 +168,12 @@ pub fn combine_lhapdf_npdfs<P: AsRef<std::path::Path>>(
             };
             combined_subgrids.push(new_subgrid);
         }
-        let combined_grid = GridArray {
-            pids: pids.clone(),
-            subgrids: combined_subgrids,
-        };
+        let combined_grid = GridArray::from_subgrids(combined_subgrids, pids.clone());
         combined_grids.push(combined_grid);
     }
 
     let combined_grids: Vec<&GridArray> = combined_grids.iter().collect();
-    GridArrayCollection::compress(&combined_grids, &meta, output_path)?;
+    GridArrayCollection::write(&combined_grids, &meta, output_path)?;
     Ok(())
 }
 
@@ -277,14 +276,16 @@ pub fn combine_lhapdf_alphas<P: AsRef<std::path::Path>>(
             }
 
             // Concatenate along the alphas axis to get [..., alphas=pdf_names.len(), ...]
-            let grid_views: Vec<_> = subgrids.iter().map(|sg| sg.grid.view()).collect();
+            let grids: Vec<_> = subgrids.iter().map(|sg| sg.grid()).collect();
+            let grid_views: Vec<_> = grids.iter().map(|grid| grid.view()).collect();
             let concatenated = concatenate(Axis(1), &grid_views.to_vec())?;
             let alphas = Array1::from(alphas_values.clone());
             let new_subgrid = SubGrid {
                 xs: xs.clone(),
                 q2s: q2s.clone(),
                 kts: kts.clone(),
-                grid: concatenated,
+                grid: concatenated.into_shared(),
+                grid_f32: None,
                 nucleons: nucleons.clone(),
                 alphas,
                 nucleons_range: subgrids[0].nucleons_range,
@@ -295,14 +296,11 @@ pub fn combine_lhapdf_alphas<P: AsRef<std::path::Path>>(
             };
             combined_subgrids.push(new_subgrid);
         }
-        let combined_grid = GridArray {
-            pids: pids.clone(),
-            subgrids: combined_subgrids,
-        };
+        let combined_grid = GridArray::from_subgrids(combined_subgrids, pids.clone());
         combined_grids.push(combined_grid);
     }
 
     let combined_grids: Vec<&GridArray> = combined_grids.iter().collect();
-    GridArrayCollection::compress(&combined_grids, &meta, output_path)?;
+    GridArrayCollection::write(&combined_grids, &meta, output_path)?;
     Ok(())
 }
@@ -0,0 +1,199 @@
+//! This module defines how the batch entry points distribute their work over threads.
+//!
+//! # Contents
+//!
+//! - [`BatchExecutor`]: Runs the chunks of a batch evaluation, possibly concurrently.
+//! - [`RayonExecutor`], [`SequentialExecutor`]: The executors provided by the library.
+//! - [`PointStatus`]: Outcome of the evaluation of a single point of a batch.
+//!
+//! # Note
+//!
+//! The batch entry points, e.g. `GridPDF::xfxq2s_into`, split their output buffers into
+//! chunks of consecutive points and hand the chunks over to an executor. Applications which
+//! already manage their own workers, e.g. with TBB, can implement [`BatchExecutor`] such that
+//! the chunks run on these workers instead of on a second thread pool.
+
+use rayon::prelude::*;
+use rayon::{ThreadPool, ThreadPoolBuildError, ThreadPoolBuilder};
+use std::sync::{Arc, Mutex, PoisonError};
+
+use super::gridpdf::Error;
+
+/// Default number of points evaluated by a chunk of a batch.
+pub const DEFAULT_CHUNK_SIZE: usize = 256;
+
+/// Outcome of the evaluation of a single point of a batch.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub enum PointStatus {
+    /// The value of the point was computed.
+    #[default]
+    Success = 0,
+    /// No subgrid contains the point.
+    SubgridNotFound = 1,
+    /// The flavor is not part of the grid or the interpolation failed.
+    InterpolationError = 2,
+}
+
+impl From<&Error> for PointStatus {
+    fn from(error: &Error) -> Self {
+        match error {
+            Error::SubgridNotFound { .. } => Self::SubgridNotFound,
+            Error::InterpolationError(_) => Self::InterpolationError,
+        }
+    }
+}
+
+/// Runs the chunks of a batch evaluation.
+pub trait BatchExecutor: Sync {
+    /// Calls `task` once for every index in `0..num_tasks` and returns once all the calls
+    /// have completed. The calls may run concurrently and in any order.
+    fn execute(&self, num_tasks: usize, task: &(dyn Fn(usize) + Sync));
+
+    /// The number of points evaluated by a chunk.
+    fn chunk_size(&self) -> usize {
+        DEFAULT_CHUNK_SIZE
+    }
+}
+
+/// Runs the chunks on a rayon thread pool, whose workers steal the chunks from each other.
+#[derive(Debug, Clone)]
+pub struct RayonExecutor {
+    /// The dedicated thread pool, or `None` to use the pool of the caller.
+    pool: Option<Arc<ThreadPool>>,
+    /// The number of points evaluated by a chunk.
+    chunk_size: usize,
+}
+
+impl Default for RayonExecutor {
+    fn default() -> Self {
+        Self {
+            pool: None,
+            chunk_size: DEFAULT_CHUNK_SIZE,
+        }
+    }
+}
+
+impl RayonExecutor {
+    /// Creates an executor running on the current rayon thread pool, i.e. the global pool
+    /// unless it is called from within `ThreadPool::install`.
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Creates an executor running on a dedicated pool of `num_threads` threads.
+    ///
+    /// # Errors
+    ///
+    /// Returns a `ThreadPoolBuildError` if the threads cannot be spawned.
+    pub fn with_threads(num_threads: usize) -> Result<Self, ThreadPoolBuildError> {
+        let pool = ThreadPoolBuilder::new().num_threads(num_threads).build()?;
+
+        Ok(Self::with_pool(Arc::new(pool)))
+    }
+
+    /// Creates an executor running on an existing thread pool.
+    pub fn with_pool(pool: Arc<ThreadPool>) -> Self {
+        Self {
+            pool: Some(pool),
+            chunk_size: DEFAULT_CHUNK_SIZE,
+        }
+    }
+
+    /// Sets the number of points evaluated by a chunk. A value of zero is treated as one.
+    #[must_use]
+    pub fn with_chunk_size(mut self, chunk_size: usize) -> Self {
+        self.chunk_size = chunk_size.max(1);
+        self
+    }
+}
+
+impl BatchExecutor for RayonExecutor {
+    fn execute(&self, num_tasks: usize, task: &(dyn Fn(usize) + Sync)) {
+        let run = || (0..num_tasks).into_par_iter().for_each(task);
+
+        match &self.pool {
+            Some(pool) => pool.install(run),
+            None => run(),
+        }
+    }
+
+    fn chunk_size(&self) -> usize {
+        self.chunk_size
+    }
+}
+
+/// Runs the chunks one after the other on the calling thread.
+#[derive(Debug, Clone, Copy, Default)]
+pub struct SequentialExecutor;
+
+impl BatchExecutor for SequentialExecutor {
+    fn execute(&self, num_tasks: usize, task: &(dyn Fn(usize) + Sync)) {
+        (0..num_tasks).for_each(task);
+    }
+}
+
+/// Splits `out` and `status` into chunks and evaluates them with `executor`.
+///
+/// The closure `eval` receives the index of the first point of a chunk together with the
+/// parts of `out` and `status` belonging to the chunk. Each chunk is locked by a single task
+/// only, such that the locks are never contended.
+pub(crate) fn for_each_chunk<F>(
+    executor: &dyn BatchExecutor,
+    out: &mut [f64],
+    status: &mut [PointStatus],
+    eval: F,
+) where
+    F: Fn(usize, &mut [f64], &mut [PointStatus]) + Sync,
+{
+    let chunk_size = executor.chunk_size().max(1);
+    let chunks: Vec<Mutex<(&mut [f64], &mut [PointStatus])>> = out
+        .chunks_mut(chunk_size)
+        .zip(status.chunks_mut(chunk_size))
+        .map(Mutex::new)
+        .collect();
+
+    executor.execute(chunks.len(), &|ichunk| {
+        let mut chunk = chunks[ichunk]
+            .lock()
+            .unwrap_or_else(PoisonError::into_inner);
+        let (out, status) = &mut *chunk;
+        eval(ichunk * chunk_size, out, status);
+    });
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn fill(executor: &dyn BatchExecutor, len: usize) -> (Vec<f64>, Vec<PointStatus>) {
+        let mut out = vec![0.0; len];
+        let mut status = vec![PointStatus::InterpolationError; len];
+        for_each_chunk(executor, &mut out, &mut status, |start, out, status| {
+            for (offset, (value, code)) in out.iter_mut().zip(status.iter_mut()).enumerate() {
+                *value = (start + offset) as f64;
+                *code = PointStatus::Success;
+            }
+        });
+        (out, status)
+    }
+
+    #[test]
+    fn test_for_each_chunk() {
+        let expected: Vec<f64> = (0..1000).map(|i| i as f64).collect();
+        let executors: [&dyn BatchExecutor; 3] = [
+            &SequentialExecutor,
+            &RayonExecutor::new().with_chunk_size(7),
+            &RayonExecutor::with_threads(2).unwrap(),
+        ];
+
+        for executor in executors {
+            let (out, status) = fill(executor, expected.len());
+            assert_eq!(out, expected);
+            assert!(status.iter().all(|&s| s == PointStatus::Success));
+        }
+
+        let (out, status) = fill(&SequentialExecutor, 0);
+        assert!(out.is_empty() && status.is_empty());
+    }
+}
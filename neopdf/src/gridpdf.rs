@@ -4,19 +4,165 @@
 //!
 //! - [`GridPDF`]: High-level interface for PDF grid interpolation and metadata access.
 //! - [`GridArray`]: Stores the full set of subgrids and flavor IDs.
+//! - [`LoadOptions`]: Options refining the construction of the interpolators of a member.
 
 use core::panic;
-use ndarray::{Array1, Array2};
+use ndarray::{ArcArray1, Array1, Array2};
 use serde::{Deserialize, Serialize};
-use std::collections::HashMap;
+use std::cell::Cell;
+use std::sync::{Arc, OnceLock};
 use thiserror::Error;
 
 use super::alphas::AlphaS;
-use super::interpolator::{DynInterpolator, InterpolatorFactory};
+use super::executor::{for_each_chunk, BatchExecutor, PointStatus, RayonExecutor};
+use super::interpolator::{
+    interpolate_row, AxisWeights, BatchPoints, InterleavedKnots, InterpolationConfig,
+    InterpolatorTable, LeadingScan, StencilKernel, SubgridAxes,
+};
 use super::metadata::{InterpolatorType, MetaData};
 use super::parser::SubgridData;
+use super::placement::NumaPolicy;
+use super::stats::{EvalStatistics, EvalStats};
 use super::subgrid::{ParamRange, RangeParameters, SubGrid};
 
+/// Maximum number of coordinates of a point, i.e. `(A, alpha_s, kT, x, Q2)`.
+const MAX_DIMENSIONS: usize = 5;
+
+/// Maximum number of flavors whose indices are resolved at once by `GridPDF::xfxq2_batch`
+/// and `GridPDF::xfxq2_fixed`.
+const MAX_BATCH_FLAVORS: usize = 32;
+
+/// Minimum number of flavors evaluated at once by `GridPDF::xfxq2_batch` for which the knot
+/// values of a 2D subgrid are read for all the flavors at once, see `InterleavedKnots`.
+const MIN_INTERLEAVED_FLAVORS: usize = 4;
+
+/// Maximum number of consecutive points of `GridPDF::xfxq2_fixed_x` and
+/// `GridPDF::xfxq2_fixed_q2` evaluated at once.
+const FIXED_AXIS_POINTS: usize = 16;
+
+/// Number of knots whose partial sums are kept on the stack by `GridPDF::xfxq2_fixed_x` and
+/// `GridPDF::xfxq2_fixed_q2`, see `interpolate_row`.
+const FIXED_AXIS_KNOTS: usize = 64;
+
+/// The axis along which the points of `GridPDF::xfxq2_fixed_x` and
+/// `GridPDF::xfxq2_fixed_q2` share their coordinate.
+#[derive(Clone, Copy)]
+enum FixedAxis {
+    X,
+    Q2,
+}
+
+/// Buffers of `GridPDF::xfxq2_grid`, kept by each thread and reused by its calls.
+#[derive(Default)]
+struct GridScratch {
+    /// The indices of the flavors.
+    pid_indices: Vec<usize>,
+    /// The subgrids containing each `x`, see `SubgridSets`.
+    x_sets: Vec<u64>,
+    /// The subgrids containing each `Q2`, see `SubgridSets`.
+    q2_sets: Vec<u64>,
+    /// The subgrid of each point of the current row.
+    row_subgrids: Vec<usize>,
+    /// The weights of each `x` in each subgrid, with shape `[subgrids, xs]`.
+    wx_table: Vec<AxisWeights>,
+    /// The weights of each `Q2` in each subgrid, with shape `[subgrids, q2s]`.
+    wq2_table: Vec<AxisWeights>,
+    /// Whether the weights of each subgrid were computed.
+    ready: Vec<bool>,
+    /// The partial sums of a row, see `interpolate_row`.
+    partial: Vec<f64>,
+}
+
+thread_local! {
+    /// The buffers of `GridPDF::xfxq2_grid` of the current thread.
+    static GRID_SCRATCH: Cell<GridScratch> = Cell::new(GridScratch::default());
+}
+
+/// Buffers of `GridPDF::xfxq2_cheby_batch_into`, kept by each thread and reused by the chunks
+/// it evaluates.
+#[derive(Default)]
+struct ChebyScratch {
+    /// The offsets in the current chunk of the points of each subgrid.
+    groups: Vec<Vec<usize>>,
+    /// The log-transformed points of the current subgrid.
+    points: BatchPoints,
+}
+
+thread_local! {
+    /// The buffers of `GridPDF::xfxq2_cheby_batch_into` of the current thread.
+    static CHEBY_SCRATCH: Cell<ChebyScratch> = Cell::new(ChebyScratch::default());
+}
+
+/// Clears `buffer` and fills it with `len` copies of `value`, keeping its capacity.
+fn reset<T: Clone>(buffer: &mut Vec<T>, len: usize, value: T) {
+    buffer.clear();
+    buffer.resize(len, value);
+}
+
+/// Bit sets of the subgrids containing a list of values along an axis.
+///
+/// Each value has two sets of `words` words: the subgrids whose range contains the value,
+/// followed by the ones whose range contains the value clamped to the bounding box of the
+/// subgrids, any of which is at minimal distance from a point outside of the subgrids.
+#[derive(Clone, Copy)]
+struct SubgridSets {
+    words: usize,
+}
+
+impl SubgridSets {
+    fn new(num_subgrids: usize) -> Self {
+        Self {
+            words: num_subgrids.div_ceil(64),
+        }
+    }
+
+    /// Writes the sets of `values` into `sets`, where `range` is the range of a subgrid
+    /// along the axis and `bounds` the range of the bounding box.
+    fn fill(
+        self,
+        subgrids: &[SubGrid],
+        range: fn(&SubGrid) -> ParamRange,
+        values: &[f64],
+        bounds: ParamRange,
+        sets: &mut Vec<u64>,
+    ) {
+        reset(sets, 2 * self.words * values.len(), 0);
+        for (set, &value) in sets.chunks_exact_mut(2 * self.words).zip(values) {
+            let clamped = value.max(bounds.min).min(bounds.max);
+            let (contained, clamped_contained) = set.split_at_mut(self.words);
+            for (idx, subgrid) in subgrids.iter().enumerate() {
+                let range = range(subgrid);
+                if range.contains(value) {
+                    contained[idx / 64] |= 1u64 << (idx % 64);
+                }
+                if range.contains(clamped) {
+                    clamped_contained[idx / 64] |= 1u64 << (idx % 64);
+                }
+            }
+        }
+    }
+
+    /// Returns the sets of the value at `index`.
+    fn of(self, sets: &[u64], index: usize) -> &[u64] {
+        &sets[2 * self.words * index..][..2 * self.words]
+    }
+
+    /// Returns the first subgrid containing the point whose sets along `x` and `Q2` are
+    /// `x_sets` and `q2_sets`, or else the first one containing the clamped point.
+    fn first_common(self, x_sets: &[u64], q2_sets: &[u64]) -> Option<usize> {
+        let first = |a: &[u64], b: &[u64]| {
+            a.iter().zip(b).enumerate().find_map(|(word, (&a, &b))| {
+                let common = a & b;
+                (common != 0).then(|| 64 * word + common.trailing_zeros() as usize)
+            })
+        };
+        let (x_sets, x_clamped) = x_sets.split_at(self.words);
+        let (q2_sets, q2_clamped) = q2_sets.split_at(self.words);
+
+        first(x_sets, q2_sets).or_else(|| first(x_clamped, q2_clamped))
+    }
+}
+
 /// Errors that can occur during PDF grid operations.
 #[derive(Debug, Error)]
 pub enum Error {
@@ -34,12 +180,151 @@ pub enum Error {
 }
 
 /// Stores the complete PDF grid data, including all subgrids and flavor information.
-#[derive(Debug, Serialize, Deserialize)]
+#[derive(Debug, Clone, Serialize, Deserialize)]
 pub struct GridArray {
     /// An array of particle flavor IDs (PIDs).
     pub pids: Array1<i32>,
     /// A collection of `SubGrid` instances that make up the full grid.
+    ///
+    /// The lookup index used by `GridArray::find_subgrid` is built from the subgrids and is
+    /// not updated when they are modified, which `GridArray::reindex` does. Until then, the
+    /// subgrid returned by the index is checked against the current ranges and the lookups
+    /// fall back to a linear scan if it does not contain the point: they still return a
+    /// subgrid containing the point if there is one, though not necessarily the first one,
+    /// and are slower.
     pub subgrids: Vec<SubGrid>,
+    /// Lookup index used to locate the subgrid of a point. It is not serialized and
+    /// is rebuilt on first use after deserialization.
+    #[serde(skip)]
+    index: OnceLock<SubgridIndex>,
+}
+
+/// Lookup table mapping `(x, Q2)` cells to the subgrids that overlap them.
+///
+/// The `x` and `Q2` boundaries of all the subgrids are sorted into two tables which
+/// define a rectilinear partition of the plane. Each cell stores, in increasing order,
+/// the indices of the subgrids whose closed ranges intersect it. Locating the subgrid
+/// of a point therefore amounts to two binary searches followed by a check of the few
+/// candidates of the cell, which preserves the first-match semantics of a linear scan.
+///
+/// The index only resolves the points contained in a subgrid: the candidates are checked
+/// against the current ranges of the subgrids, and the points outside of all of them are
+/// left to the distance scan of `GridArray::find_subgrid`. The index keeps the number of
+/// subgrids it was built from, such that it is bypassed if subgrids are added or removed.
+#[derive(Debug, Clone)]
+struct SubgridIndex {
+    /// Sorted and deduplicated `x` boundaries of the subgrids.
+    x_bounds: Vec<f64>,
+    /// Sorted and deduplicated `Q2` boundaries of the subgrids.
+    q2_bounds: Vec<f64>,
+    /// Number of cells along the `Q2` direction.
+    nq2_cells: usize,
+    /// Offsets into `candidates` for each cell, in row-major `(x, Q2)` order.
+    offsets: Vec<usize>,
+    /// Flattened lists of candidate subgrid indices for each cell.
+    candidates: Vec<usize>,
+    /// Number of coordinates expected for a point.
+    ndims: usize,
+    /// Number of subgrids the index was built from.
+    num_subgrids: usize,
+}
+
+impl SubgridIndex {
+    /// Builds the lookup index for a collection of subgrids.
+    fn new(subgrids: &[SubGrid]) -> Self {
+        let sorted_bounds = |range: fn(&SubGrid) -> ParamRange| {
+            let mut bounds: Vec<f64> = subgrids
+                .iter()
+                .flat_map(|sg| [range(sg).min, range(sg).max])
+                .collect();
+            bounds.sort_by(f64::total_cmp);
+            bounds.dedup();
+            bounds
+        };
+        let x_bounds = sorted_bounds(|sg| sg.x_range);
+        let q2_bounds = sorted_bounds(|sg| sg.q2_range);
+
+        let cell_range = |bounds: &[f64], i: usize| {
+            ParamRange::new(bounds[i], bounds[(i + 1).min(bounds.len() - 1)])
+        };
+        let overlaps = |a: ParamRange, b: ParamRange| a.min <= b.max && b.min <= a.max;
+
+        let nx_cells = Self::num_cells(&x_bounds);
+        let nq2_cells = Self::num_cells(&q2_bounds);
+        let mut offsets = Vec::with_capacity(nx_cells * nq2_cells + 1);
+        let mut candidates = Vec::new();
+        offsets.push(0);
+
+        for ix in 0..nx_cells {
+            let x_cell = cell_range(&x_bounds, ix);
+            for iq2 in 0..nq2_cells {
+                let q2_cell = cell_range(&q2_bounds, iq2);
+                candidates.extend(
+                    subgrids
+                        .iter()
+                        .enumerate()
+                        .filter(|(_, sg)| {
+                            overlaps(sg.x_range, x_cell) && overlaps(sg.q2_range, q2_cell)
+                        })
+                        .map(|(idx, _)| idx),
+                );
+                offsets.push(candidates.len());
+            }
+        }
+
+        let ndims = subgrids.first().map_or(0, |sg| sg.parameter_ranges().1);
+
+        Self {
+            x_bounds,
+            q2_bounds,
+            nq2_cells,
+            offsets,
+            candidates,
+            ndims,
+            num_subgrids: subgrids.len(),
+        }
+    }
+
+    /// Number of cells defined by a table of boundaries.
+    fn num_cells(bounds: &[f64]) -> usize {
+        match bounds.len() {
+            0 => 0,
+            1 => 1,
+            n => n - 1,
+        }
+    }
+
+    /// Returns the index of the cell containing `value`, if within the boundaries.
+    fn cell(bounds: &[f64], value: f64) -> Option<usize> {
+        let (first, last) = (bounds.first()?, bounds.last()?);
+        if !(value >= *first && value <= *last) {
+            return None;
+        }
+        let upper = bounds.partition_point(|&b| b <= value);
+        Some((upper - 1).min(Self::num_cells(bounds) - 1))
+    }
+
+    /// Returns the first subgrid that contains the point, if any.
+    ///
+    /// The candidates of the cell of the point are checked against the current ranges of the
+    /// subgrids, such that the subgrid returned contains the point even if the subgrids were
+    /// modified since the index was built. Returns `None` if the point is outside of all the
+    /// subgrids, if the index cannot resolve it or if subgrids were added or removed since
+    /// the index was built, in which case the caller has to fall back to a full scan.
+    fn find(&self, subgrids: &[SubGrid], points: &[f64]) -> Option<usize> {
+        if points.len() != self.ndims || self.ndims < 2 || self.num_subgrids != subgrids.len() {
+            return None;
+        }
+
+        let (x, q2) = (points[self.ndims - 2], points[self.ndims - 1]);
+        let icell =
+            Self::cell(&self.x_bounds, x)? * self.nq2_cells + Self::cell(&self.q2_bounds, q2)?;
+
+        self.candidates[self.offsets[icell]..self.offsets[icell + 1]]
+            .iter()
+            .copied()
+            .find(|&idx| subgrids[idx].contains_point(points))
+    }
 }
 
 impl GridArray {
@@ -66,10 +351,24 @@ impl GridArray {
             })
             .collect();
 
-        Self {
-            pids: Array1::from_vec(pids),
+        Self::from_subgrids(subgrids, Array1::from_vec(pids))
+    }
+
+    /// Creates a new `GridArray` from already constructed subgrids.
+    ///
+    /// # Arguments
+    ///
+    /// * `subgrids` - A vector of `SubGrid` instances.
+    /// * `pids` - An array of particle flavor IDs.
+    pub fn from_subgrids(subgrids: Vec<SubGrid>, pids: Array1<i32>) -> Self {
+        let grid_array = Self {
+            pids,
             subgrids,
-        }
+            index: OnceLock::new(),
+        };
+        grid_array.subgrid_index();
+
+        grid_array
     }
 
     /// Gets the PDF value at a specific knot point in the grid.
@@ -103,11 +402,25 @@ impl GridArray {
         subgrid_idx: usize,
     ) -> f64 {
         let pid_idx = self.pid_index(flavor_id).expect("Invalid flavor ID");
-        self.subgrids[subgrid_idx].grid[[nucleon_idx, alpha_idx, pid_idx, kt_idx, x_idx, q2_idx]]
+        self.subgrids[subgrid_idx].knot_value([
+            nucleon_idx,
+            alpha_idx,
+            pid_idx,
+            kt_idx,
+            x_idx,
+            q2_idx,
+        ])
     }
 
     /// Finds the index of the subgrid that contains the given point.
     ///
+    /// The subgrid is located through a precomputed lookup index with sorted `x` and
+    /// `Q2` boundary tables. If no subgrid contains the point, the closest subgrid in
+    /// terms of Euclidean distance is returned instead, from a linear scan of the subgrids.
+    /// The subgrids are also scanned linearly if the index does not return a subgrid
+    /// containing the point because they were modified since it was built, see
+    /// `GridArray::reindex`.
+    ///
     /// # Arguments
     ///
     /// * `points` - A slice of coordinates for the point.
@@ -116,9 +429,8 @@ impl GridArray {
     ///
     /// An `Option<usize>` containing the index of the subgrid if found, otherwise `None`.
     pub fn find_subgrid(&self, points: &[f64]) -> Option<usize> {
-        self.subgrids
-            .iter()
-            .position(|sg| sg.contains_point(points))
+        self.subgrid_index()
+            .find(&self.subgrids, points)
             .or_else(|| {
                 self.subgrids
                     .iter()
@@ -132,8 +444,25 @@ impl GridArray {
             })
     }
 
+    /// Rebuilds the subgrid lookup index after a modification of `subgrids`.
+    ///
+    /// The lookups stay correct with an outdated index, but may then scan the subgrids
+    /// linearly, hence this should be called after any change of the number or of the
+    /// ranges of the subgrids.
+    pub fn reindex(&mut self) {
+        self.index = OnceLock::new();
+        self.subgrid_index();
+    }
+
+    /// Returns the subgrid lookup index, building it on first use.
+    ///
+    /// The index reflects the subgrids at the time it is built, see `GridArray::reindex`.
+    fn subgrid_index(&self) -> &SubgridIndex {
+        self.index.get_or_init(|| SubgridIndex::new(&self.subgrids))
+    }
+
     /// Gets the index corresponding to a given flavor ID.
-    fn pid_index(&self, flavor_id: i32) -> Option<usize> {
+    pub(crate) fn pid_index(&self, flavor_id: i32) -> Option<usize> {
         let normalize_pid = |pid| if pid == 0 { 21 } else { pid };
         let normalized_pids = normalize_pid(flavor_id);
         self.pids
@@ -188,18 +517,87 @@ pub enum ForcePositive {
     NoClipping,
 }
 
+impl ForcePositive {
+    /// Applies the clipping method to a given PDF value.
+    pub fn apply(&self, value: f64) -> f64 {
+        match self {
+            Self::ClipNegative => value.max(0.0),
+            Self::ClipSmall => value.max(1e-10),
+            Self::NoClipping => value,
+        }
+    }
+}
+
+/// Options refining how the members of a PDF set are prepared for interpolation.
+///
+/// The default options reproduce the behaviour of [`GridPDF::new`].
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq, Hash)]
+pub struct LoadOptions {
+    /// Precompute the 16 coefficients of the bicubic polynomial of every `(x, Q2)` cell of
+    /// the 2D subgrids interpolated with `LogBicubic`, such that an evaluation reduces to a
+    /// cell lookup and a single polynomial evaluation. This trades about four times the
+    /// memory of the knot values, and a longer loading, for a faster `GridPDF::xfxq2`.
+    pub precompute_coeffs: bool,
+    /// Store the knot values of the 2D subgrids interpolated with `LogBicubic`,
+    /// `LogBilinear` or `Bilinear` in single precision, see `SubGrid::to_single_precision`.
+    /// This halves their memory footprint and the bandwidth per evaluation, while the
+    /// interpolation weights and sums are still computed in double precision. The results
+    /// then deviate from the double-precision ones by the rounding of the knot values, i.e.
+    /// by a relative amount of the order of `1e-7`, see `PDF::precision_report`. The other
+    /// subgrids are kept in double precision, and this option takes precedence over
+    /// `precompute_coeffs` for the converted subgrids.
+    pub single_precision: bool,
+    /// Copy the knot values of the members loaded together into a single buffer aligned to
+    /// a huge page and advise the kernel to back it with transparent huge pages, which
+    /// spares most of the TLB misses of the evaluations scattered over large sets. The
+    /// resident memory grows by at most one huge page per buffer, and the knot values are
+    /// briefly held twice while they are copied. This has no effect on other platforms than
+    /// Linux or if transparent huge pages are disabled, see `placement`.
+    pub huge_pages: bool,
+    /// The placement of the knot values on the NUMA nodes, see [`NumaPolicy`] for its effect
+    /// on the resident memory.
+    pub numa: NumaPolicy,
+    /// Store the knot values of the 2D subgrids with the flavors innermost, see
+    /// `SubGrid::interleave`, such that `GridPDF::xfxq2_batch` gathers the stencil of a point
+    /// once for all the flavors when evaluating many of them. The knot values of a flavor
+    /// are then strided, which the evaluations of single flavors, e.g. `GridPDF::xfxq2`,
+    /// pay for, and they are copied once while loading.
+    pub interleave_flavors: bool,
+}
+
+impl LoadOptions {
+    /// Returns whether the knot values are placed in memory by `placement`, instead of being
+    /// left in the allocations of the decoded members.
+    pub(crate) fn places_knots(&self) -> bool {
+        self.huge_pages || self.numa != NumaPolicy::FirstTouch
+    }
+}
+
 /// The main PDF grid interface, providing high-level methods for interpolation.
+///
+/// A clone shares the knot values, the interpolators, the `alpha_s` calculator and the
+/// evaluation counters with the original, such that only the metadata and the knots of the
+/// axes are copied.
+#[derive(Clone)]
 pub struct GridPDF {
     /// The metadata associated with the PDF set.
     info: MetaData,
     /// The underlying grid data stored in a `GridArray`.
     pub knot_array: GridArray,
-    /// A nested vector of interpolators for each subgrid and flavor.
-    interpolators: Vec<Vec<Box<dyn DynInterpolator>>>,
+    /// The knots of the axes of each subgrid, shared by the interpolators of its flavors.
+    axes: Vec<SubgridAxes>,
+    /// The interpolators of each subgrid and flavor, built on first use.
+    interpolators: Arc<InterpolatorTable>,
+    /// Whether the interpolation is performed on the logarithm of the coordinates, resolved
+    /// once from the interpolator type of the set.
+    use_log: bool,
     /// Calculator for the running of alpha_s.
-    alphas: AlphaS,
+    alphas: Arc<AlphaS>,
     /// Clip the values to positive definite numbers if negatives.
     pub force_positive: Option<ForcePositive>,
+    /// The counters of the load and of the evaluations, see [`EvalStats`].
+    stats: Arc<EvalStats>,
 }
 
 impl GridPDF {
@@ -210,18 +608,76 @@ impl GridPDF {
     /// * `info` - The `MetaData` for the PDF set.
     /// * `knot_array` - The `GridArray` containing the grid data.
     pub fn new(info: MetaData, knot_array: GridArray) -> Self {
-        let interpolators = Self::build_interpolators(&info, &knot_array);
+        Self::with_options(info, knot_array, LoadOptions::default())
+    }
+
+    /// Creates a new `GridPDF` instance whose interpolators are built according to `options`.
+    ///
+    /// # Arguments
+    ///
+    /// * `info` - The `MetaData` for the PDF set.
+    /// * `knot_array` - The `GridArray` containing the grid data.
+    /// * `options` - The `LoadOptions` refining the construction of the interpolators.
+    pub fn with_options(info: MetaData, mut knot_array: GridArray, options: LoadOptions) -> Self {
+        Self::prepare_knots(&info, &mut knot_array, &options);
+
+        let axes: Vec<_> = knot_array.subgrids.iter().map(SubgridAxes::new).collect();
+        let interpolators = Arc::new(InterpolatorTable::new(
+            info.interpolator_type.clone(),
+            &knot_array.subgrids,
+            &axes,
+            knot_array.pids.len(),
+            options,
+        ));
+        knot_array.subgrid_index();
         let alphas = AlphaS::from_metadata(&info).expect("Failed to create AlphaS calculator");
+        let use_log = matches!(
+            info.interpolator_type,
+            InterpolatorType::LogBilinear
+                | InterpolatorType::LogBicubic
+                | InterpolatorType::LogTricubic
+                | InterpolatorType::LogChebyshev
+        );
 
         Self {
             info,
             knot_array,
+            axes,
             interpolators,
-            alphas,
+            use_log,
+            alphas: Arc::new(alphas),
             force_positive: None,
+            stats: Arc::new(EvalStats::default()),
+        }
+    }
+
+    /// Converts the knot values of `knot_array` to the storage selected by `options`, before
+    /// they are placed in memory. Calling this method again has no effect.
+    pub(crate) fn prepare_knots(
+        info: &MetaData,
+        knot_array: &mut GridArray,
+        options: &LoadOptions,
+    ) {
+        if options.single_precision && AxisWeights::is_supported(&info.interpolator_type) {
+            knot_array
+                .subgrids
+                .iter_mut()
+                .filter(|subgrid| {
+                    matches!(subgrid.interpolation_config(), InterpolationConfig::TwoD)
+                })
+                .for_each(SubGrid::to_single_precision);
+        }
+        if options.interleave_flavors {
+            knot_array.subgrids.iter_mut().for_each(SubGrid::interleave);
         }
     }
 
+    /// Makes this member share the evaluation counters of `other`, i.e. of another copy of
+    /// the same member.
+    pub(crate) fn share_stats(&mut self, other: &GridPDF) {
+        self.stats = Arc::clone(&other.stats);
+    }
+
     /// Sets the method for handling negative or small PDF values.
     ///
     /// # Arguments
@@ -241,34 +697,63 @@ impl GridPDF {
     ///
     /// The clipped PDF value, according to the policy set by `set_force_positive`.
     pub fn apply_force_positive(&self, value: f64) -> f64 {
-        match &self.force_positive {
-            Some(ForcePositive::ClipNegative) => value.max(0.0),
-            Some(ForcePositive::ClipSmall) => value.max(1e-10),
-            Some(ForcePositive::NoClipping) => value,
-            _ => value,
+        let Some(flag) = &self.force_positive else {
+            return value;
+        };
+        let clipped = flag.apply(value);
+        if clipped != value {
+            self.stats.record_force_positive();
         }
+        clipped
     }
 
-    /// Builds the interpolators for all subgrids and flavors.
-    fn build_interpolators(
-        info: &MetaData,
-        knot_array: &GridArray,
-    ) -> Vec<Vec<Box<dyn DynInterpolator>>> {
-        knot_array
-            .subgrids
+    /// Finds the subgrid of a point as `GridArray::find_subgrid`, recording the point in the
+    /// evaluation counters.
+    fn locate(&self, points: &[f64]) -> Option<usize> {
+        let subgrid_idx = self.knot_array.find_subgrid(points)?;
+        self.stats
+            .record_point(&self.knot_array.subgrids[subgrid_idx], points);
+        Some(subgrid_idx)
+    }
+
+    /// Returns the counters of the load and of the evaluations of the member.
+    pub fn eval_stats(&self) -> &EvalStats {
+        &self.stats
+    }
+
+    /// Returns a snapshot of the counters of the load and of the evaluations.
+    pub fn stats(&self) -> EvalStatistics {
+        self.stats.snapshot()
+    }
+
+    /// Builds the interpolators of the given flavors for all the subgrids, which are
+    /// otherwise built on their first use.
+    ///
+    /// # Arguments
+    ///
+    /// * `pids` - The flavor IDs whose interpolators are built.
+    ///
+    /// # Returns
+    ///
+    /// A `Result` which is `Ok(())` if all the flavors are part of the grid, or an `Error`
+    /// before any interpolator is built otherwise.
+    pub fn warmup(&self, pids: &[i32]) -> Result<(), Error> {
+        let pid_indices = pids
             .iter()
-            .map(|subgrid| {
-                (0..knot_array.pids.len())
-                    .map(|pid_idx| {
-                        InterpolatorFactory::create(
-                            info.interpolator_type.to_owned(),
-                            subgrid,
-                            pid_idx,
-                        )
-                    })
-                    .collect()
+            .map(|&pid| {
+                self.knot_array
+                    .pid_index(pid)
+                    .ok_or_else(|| Error::InterpolationError(format!("Invalid flavor ID: {pid}")))
             })
-            .collect()
+            .collect::<Result<Vec<_>, _>>()?;
+        self.interpolators.warmup(&pid_indices);
+
+        Ok(())
+    }
+
+    /// Returns the number of interpolators built so far, out of one per subgrid and flavor.
+    pub fn num_built_interpolators(&self) -> usize {
+        self.interpolators.num_built()
     }
 
     /// Interpolates the PDF value for `(nucleons, alphas, x, q2)` and a given flavor.
@@ -282,7 +767,7 @@ impl GridPDF {
     ///
     /// A `Result` containing the interpolated PDF value or an `Error`.
     pub fn xfxq2(&self, flavor_id: i32, points: &[f64]) -> Result<f64, Error> {
-        let subgrid_idx = self.knot_array.find_subgrid(points).ok_or_else(|| {
+        let subgrid_idx = self.locate(points).ok_or_else(|| {
             let (x, q2) = self.get_x_q2(points);
             Error::SubgridNotFound { x, q2 }
         })?;
@@ -292,27 +777,759 @@ impl GridPDF {
             .pid_index(flavor_id)
             .ok_or_else(|| Error::InterpolationError(format!("Invalid flavor ID: {flavor_id}")))?;
 
-        let use_log = matches!(
-            self.info.interpolator_type,
-            InterpolatorType::LogBilinear
-                | InterpolatorType::LogBicubic
-                | InterpolatorType::LogTricubic
-                | InterpolatorType::LogChebyshev
-        );
+        // The coordinates are transformed into a stack buffer to keep the hot path free
+        // of heap allocations.
+        let mut buffer = [0.0; MAX_DIMENSIONS];
+        let coords = buffer.get_mut(..points.len()).ok_or_else(|| {
+            Error::InterpolationError(format!("Too many coordinates: {}", points.len()))
+        })?;
+        let use_log = self.use_log();
+        for (coord, &p) in coords.iter_mut().zip(points) {
+            *coord = if use_log { p.ln() } else { p };
+        }
 
-        self.interpolators[subgrid_idx][pid_idx]
-            .interpolate_point(
-                &points
-                    .iter()
-                    .map(|&p| if use_log { p.ln() } else { p })
-                    .collect::<Vec<_>>(),
-            )
+        self.interpolators
+            .get(subgrid_idx, pid_idx)
+            .interpolate_point(coords)
             .map_err(|e| Error::InterpolationError(e.to_string()))
             .map(|result| self.apply_force_positive(result))
     }
 
+    /// Interpolates the PDF value of a flavor at several values of the leading coordinate of
+    /// a point, e.g. at several nucleon numbers `A` or values of `alpha_s` for a fixed
+    /// `(x, Q2)`.
+    ///
+    /// For the `LogTricubic` interpolation of 3D subgrids, e.g. the sets combined across
+    /// nuclei or values of `alpha_s`, the interpolation along `x` and `Q2` is performed once
+    /// per knot interval of the leading axis, such that scanning it costs little more than
+    /// a single evaluation. The results then agree with `GridPDF::xfxq2` up to rounding. The
+    /// other interpolation methods evaluate the values one by one.
+    ///
+    /// # Arguments
+    ///
+    /// * `flavor_id` - The particle flavor ID.
+    /// * `points` - The coordinates of the point, as passed to `GridPDF::xfxq2`, whose
+    ///   leading coordinate is ignored.
+    /// * `values` - The values of the leading coordinate.
+    /// * `out` - The output buffer, such that `out[i]` holds the value at `values[i]`.
+    ///
+    /// # Returns
+    ///
+    /// A `Result` which is `Ok(())` if all the values were computed or an `Error`, in which
+    /// case `out` is left partly written.
+    pub fn xfxq2_scan(
+        &self,
+        flavor_id: i32,
+        points: &[f64],
+        values: &[f64],
+        out: &mut [f64],
+    ) -> Result<(), Error> {
+        if values.len() != out.len() {
+            return Err(Error::InterpolationError(format!(
+                "Inconsistent scan sizes: {} values, {} outputs",
+                values.len(),
+                out.len()
+            )));
+        }
+        let pid_idx = self
+            .knot_array
+            .pid_index(flavor_id)
+            .ok_or_else(|| Error::InterpolationError(format!("Invalid flavor ID: {flavor_id}")))?;
+
+        if !(3..=MAX_DIMENSIONS).contains(&points.len()) {
+            return Err(Error::InterpolationError(format!(
+                "Expected between 3 and {MAX_DIMENSIONS} coordinates, got {}",
+                points.len()
+            )));
+        }
+
+        // The point and its transformed coordinates are kept in stack buffers, of which
+        // only the leading coordinate changes along the scan.
+        let mut point_buffer = [0.0; MAX_DIMENSIONS];
+        let mut coords_buffer = [0.0; MAX_DIMENSIONS];
+        let point = &mut point_buffer[..points.len()];
+        let coords = &mut coords_buffer[..points.len()];
+        point.copy_from_slice(points);
+        let use_log = self.use_log();
+        for (coord, &p) in coords.iter_mut().zip(points) {
+            *coord = if use_log { p.ln() } else { p };
+        }
+
+        let mut scan = LeadingScan::default();
+        for (result, &value) in out.iter_mut().zip(values) {
+            point[0] = value;
+            coords[0] = if use_log { value.ln() } else { value };
+            let subgrid_idx = self.locate(point).ok_or_else(|| {
+                let (x, q2) = self.get_x_q2(point);
+                Error::SubgridNotFound { x, q2 }
+            })?;
+
+            let interpolator = self.interpolators.get(subgrid_idx, pid_idx);
+            let value = scan
+                .interpolate(subgrid_idx, interpolator, coords)
+                .unwrap_or_else(|| interpolator.interpolate_point(coords))
+                .map_err(|e| Error::InterpolationError(e.to_string()))?;
+            *result = self.apply_force_positive(value);
+        }
+
+        Ok(())
+    }
+
+    /// Interpolates the PDF values for several flavors on a batch of `(x, Q2)` points.
+    ///
+    /// The subgrid and the coordinate transformation are resolved once per point and
+    /// are then shared by all the requested flavors. For an interpolation method which is
+    /// linear in the knot values, i.e. `LogBicubic`, `LogBilinear` and `Bilinear` on 2D
+    /// subgrids, the knot intervals and the interpolation weights of the point are computed
+    /// once as well, such that each flavor, including a single one, reduces to a weighted
+    /// sum of its knot values. The results then agree with `GridPDF::xfxq2` up to rounding,
+    /// whereas `GridPDF::xfxq2` itself keeps the scalar interpolators of the flavors. The
+    /// results are written into the caller-owned buffer `out` in row-major order with shape
+    /// `[pids, points]`, i.e. `out[ipid * xs.len() + ipoint]`.
+    ///
+    /// The weighted sums are computed by a [`StencilKernel`] using the vector instructions
+    /// available at runtime, whose results do not depend on the instructions used. The
+    /// weights along an axis are reused as long as consecutive points share their coordinate
+    /// along that axis and their subgrid, e.g. for a scan in `x` at fixed `Q2`.
+    ///
+    /// If the knot values of the 2D subgrids are stored with the flavors innermost, see
+    /// `LoadOptions::interleave_flavors`, and at least `MIN_INTERLEAVED_FLAVORS` flavors are
+    /// requested, the stencil of a point is gathered once for all the flavors instead of once
+    /// per flavor. The results are bit-identical to the ones of the flavors evaluated one by
+    /// one.
+    ///
+    /// The evaluation does not allocate. The flavors are resolved in groups of up to
+    /// `MAX_BATCH_FLAVORS`, and longer lists of flavors locate the points once per group.
+    ///
+    /// # Arguments
+    ///
+    /// * `pids` - A slice of flavor IDs.
+    /// * `xs` - A slice of momentum fractions `x`.
+    /// * `q2s` - A slice of energy scales `Q2`, with the same length as `xs`.
+    /// * `out` - The output buffer, of length `pids.len() * xs.len()`.
+    ///
+    /// # Returns
+    ///
+    /// A `Result` which is `Ok(())` if all the values were computed or an `Error`. On error,
+    /// `out` is left partly written: the values of the points preceding the failing one may
+    /// already have been stored, and the others are left untouched.
+    pub fn xfxq2_batch(
+        &self,
+        pids: &[i32],
+        xs: &[f64],
+        q2s: &[f64],
+        out: &mut [f64],
+    ) -> Result<(), Error> {
+        self.xfxq2_batch_with(pids, xs, q2s, out, |value| value)
+    }
+
+    /// Interpolates the PDF values for several flavors on a batch of `(x, Q2)` points into a
+    /// single-precision output buffer.
+    ///
+    /// The values are computed in double precision as by `GridPDF::xfxq2_batch`, and are
+    /// rounded to `f32` as they are stored, which halves the size of the output for
+    /// applications which only need single precision, e.g. Monte-Carlo integrations.
+    ///
+    /// # Arguments
+    ///
+    /// * `pids` - A slice of flavor IDs.
+    /// * `xs` - A slice of momentum fractions `x`.
+    /// * `q2s` - A slice of energy scales `Q2`, with the same length as `xs`.
+    /// * `out` - The output buffer, of length `pids.len() * xs.len()`.
+    ///
+    /// # Returns
+    ///
+    /// A `Result` which is `Ok(())` if all the values were computed or an `Error`, in which
+    /// case `out` is left partly written.
+    #[allow(clippy::cast_possible_truncation)]
+    pub fn xfxq2_batch_f32(
+        &self,
+        pids: &[i32],
+        xs: &[f64],
+        q2s: &[f64],
+        out: &mut [f32],
+    ) -> Result<(), Error> {
+        self.xfxq2_batch_with(pids, xs, q2s, out, |value| value as f32)
+    }
+
+    /// Implements `GridPDF::xfxq2_batch` for an output buffer whose values are converted
+    /// from `f64` with `store`.
+    fn xfxq2_batch_with<T: Copy>(
+        &self,
+        pids: &[i32],
+        xs: &[f64],
+        q2s: &[f64],
+        out: &mut [T],
+        store: fn(f64) -> T,
+    ) -> Result<(), Error> {
+        let npoints = xs.len();
+        if q2s.len() != npoints || out.len() != pids.len() * npoints {
+            return Err(Error::InterpolationError(format!(
+                "Inconsistent batch sizes: {} pids, {} xs, {} q2s, {} outputs",
+                pids.len(),
+                npoints,
+                q2s.len(),
+                out.len()
+            )));
+        }
+
+        if pids.len() > MAX_BATCH_FLAVORS {
+            let (head, tail) = pids.split_at(MAX_BATCH_FLAVORS);
+            let (out_head, out_tail) = out.split_at_mut(head.len() * npoints);
+            self.xfxq2_batch_with(head, xs, q2s, out_head, store)?;
+            return self.xfxq2_batch_with(tail, xs, q2s, out_tail, store);
+        }
+
+        // The flavor indices are resolved into a stack buffer to keep the batch free of
+        // heap allocations.
+        let mut indices = [0; MAX_BATCH_FLAVORS];
+        for (index, &pid) in indices.iter_mut().zip(pids) {
+            *index = self
+                .knot_array
+                .pid_index(pid)
+                .ok_or_else(|| Error::InterpolationError(format!("Invalid flavor ID: {pid}")))?;
+        }
+        let pid_indices = &indices[..pids.len()];
+
+        let use_log = self.use_log();
+        let interp_type = &self.info.interpolator_type;
+        let separable = AxisWeights::is_supported(interp_type);
+        let kernel = StencilKernel::detect();
+
+        // The weights of the previous point along each axis, with its subgrid and coordinate.
+        let mut cached_wx: Option<(usize, f64, AxisWeights)> = None;
+        let mut cached_wq2: Option<(usize, f64, AxisWeights)> = None;
+        let weights = |cache: &mut Option<(usize, f64, AxisWeights)>,
+                       subgrid_idx: usize,
+                       knots: &[f64],
+                       value: f64|
+         -> Result<AxisWeights, Error> {
+            match *cache {
+                Some((idx, cached, w)) if idx == subgrid_idx && cached == value => Ok(w),
+                _ => {
+                    let w = AxisWeights::new(interp_type, knots, value)
+                        .map_err(|e| Error::InterpolationError(e.to_string()))?;
+                    *cache = Some((subgrid_idx, value, w));
+                    Ok(w)
+                }
+            }
+        };
+
+        for (ipoint, (&x, &q2)) in xs.iter().zip(q2s).enumerate() {
+            let subgrid_idx = self
+                .locate(&[x, q2])
+                .ok_or(Error::SubgridNotFound { x, q2 })?;
+
+            let coords = if use_log { [x.ln(), q2.ln()] } else { [x, q2] };
+            let subgrid = &self.knot_array.subgrids[subgrid_idx];
+
+            if separable && matches!(subgrid.interpolation_config(), InterpolationConfig::TwoD) {
+                // The weights of the point are shared by all the flavors, which only differ
+                // by the knot values they are applied to.
+                let subgrid_axes = &self.axes[subgrid_idx];
+                let x_knots = subgrid_axes.xs(use_log).as_slice().unwrap();
+                let q2_knots = subgrid_axes.q2s(use_log).as_slice().unwrap();
+                let wx = weights(&mut cached_wx, subgrid_idx, x_knots, coords[0])?;
+                let wq2 = weights(&mut cached_wq2, subgrid_idx, q2_knots, coords[1])?;
+
+                if pid_indices.len() >= MIN_INTERLEAVED_FLAVORS {
+                    let mut values = [0.0; MAX_BATCH_FLAVORS];
+                    let values = &mut values[..pid_indices.len()];
+                    let interpolated = match &subgrid.grid_f32 {
+                        Some(grid) => InterleavedKnots::new(grid)
+                            .map(|knots| knots.interpolate(&wx, &wq2, pid_indices, values)),
+                        None => InterleavedKnots::new(&subgrid.grid)
+                            .map(|knots| knots.interpolate(&wx, &wq2, pid_indices, values)),
+                    };
+                    if interpolated.is_some() {
+                        for (ipid, &result) in values.iter().enumerate() {
+                            out[ipid * npoints + ipoint] = store(self.apply_force_positive(result));
+                        }
+                        continue;
+                    }
+                }
+
+                for (ipid, &pid_idx) in pid_indices.iter().enumerate() {
+                    let result = match subgrid.grid_slice_f32(pid_idx) {
+                        Some(values) => kernel.interpolate_f32(&wx, &wq2, values),
+                        None => kernel.interpolate(&wx, &wq2, subgrid.grid_slice(pid_idx).view()),
+                    };
+                    out[ipid * npoints + ipoint] = store(self.apply_force_positive(result));
+                }
+                continue;
+            }
+
+            for (ipid, &pid_idx) in pid_indices.iter().enumerate() {
+                let result = self
+                    .interpolators
+                    .get(subgrid_idx, pid_idx)
+                    .interpolate_point(&coords)
+                    .map_err(|e| Error::InterpolationError(e.to_string()))?;
+                out[ipid * npoints + ipoint] = store(self.apply_force_positive(result));
+            }
+        }
+
+        Ok(())
+    }
+
+    /// Interpolates the PDF values for several flavors on the tensor product of a list of
+    /// momentum fractions and a list of energy scales.
+    ///
+    /// The structure of the product is exploited for the interpolation methods which are
+    /// linear in the knot values, i.e. `LogBicubic`, `LogBilinear` and `Bilinear` on 2D
+    /// subgrids: the knot interval and the weights of each `x` and of each `Q2` are computed
+    /// once per subgrid they are used in, instead of once per point. The points are then
+    /// swept row by row, i.e. by increasing `Q2` at fixed `x`, where the knot values along
+    /// `x` are summed once per row and reused by all its points, see `interpolate_row`. The
+    /// results agree with `GridPDF::xfxq2` up to rounding. The other interpolation methods
+    /// evaluate the points one by one.
+    ///
+    /// Since the 2D subgrids are boxes in `(x, Q2)`, the subgrids containing each `x` and
+    /// each `Q2` are resolved once, in `O(subgrids * (xs + q2s))`, after which the subgrid
+    /// of a point is the first one containing both its coordinates. Points outside of all
+    /// the subgrids are resolved as by `GridArray::find_subgrid`. The buffers of the
+    /// evaluation are kept by the calling thread and reused by its next calls.
+    ///
+    /// # Arguments
+    ///
+    /// * `pids` - A slice of flavor IDs.
+    /// * `xs` - A slice of momentum fractions `x`.
+    /// * `q2s` - A slice of energy scales `Q2`.
+    /// * `out` - The output buffer with shape `[pids, xs, q2s]` flattened in row-major
+    ///   order, i.e. `out[(ipid * xs.len() + ix) * q2s.len() + iq2]`.
+    ///
+    /// # Returns
+    ///
+    /// A `Result` which is `Ok(())` if all the values were computed or an `Error`, in which
+    /// case `out` is left partly written.
+    pub fn xfxq2_grid(
+        &self,
+        pids: &[i32],
+        xs: &[f64],
+        q2s: &[f64],
+        out: &mut [f64],
+    ) -> Result<(), Error> {
+        let (nx, nq2) = (xs.len(), q2s.len());
+        if out.len() != pids.len() * nx * nq2 {
+            return Err(Error::InterpolationError(format!(
+                "Inconsistent grid sizes: {} pids, {} xs, {} q2s, {} outputs",
+                pids.len(),
+                nx,
+                nq2,
+                out.len()
+            )));
+        }
+
+        let mut scratch = GRID_SCRATCH.take();
+        let result = self.xfxq2_grid_with(&mut scratch, pids, xs, q2s, out);
+        GRID_SCRATCH.set(scratch);
+        result
+    }
+
+    /// Implements `GridPDF::xfxq2_grid` with the buffers of `scratch`.
+    fn xfxq2_grid_with(
+        &self,
+        scratch: &mut GridScratch,
+        pids: &[i32],
+        xs: &[f64],
+        q2s: &[f64],
+        out: &mut [f64],
+    ) -> Result<(), Error> {
+        let GridScratch {
+            pid_indices,
+            x_sets,
+            q2_sets,
+            row_subgrids,
+            wx_table,
+            wq2_table,
+            ready,
+            partial,
+        } = scratch;
+        let (nx, nq2) = (xs.len(), q2s.len());
+
+        pid_indices.clear();
+        for &pid in pids {
+            let pid_idx = self
+                .knot_array
+                .pid_index(pid)
+                .ok_or_else(|| Error::InterpolationError(format!("Invalid flavor ID: {pid}")))?;
+            pid_indices.push(pid_idx);
+        }
+
+        let use_log = self.use_log();
+        let transform = |value: f64| if use_log { value.ln() } else { value };
+        let interp_type = &self.info.interpolator_type;
+        let subgrids = &self.knot_array.subgrids;
+        let num_subgrids = subgrids.len();
+
+        // The 2D subgrids are boxes in `(x, Q2)`: the subgrids containing a point are the
+        // ones containing both its `x` and its `Q2`, which are resolved once per `x` and once
+        // per `Q2` instead of once per point, see `SubgridSets`.
+        let by_axis = subgrids
+            .iter()
+            .all(|sg| matches!(sg.interpolation_config(), InterpolationConfig::TwoD));
+        let sets = SubgridSets::new(num_subgrids);
+        if by_axis {
+            let bounds = |range: fn(&SubGrid) -> ParamRange| {
+                subgrids.iter().map(range).fold(
+                    ParamRange::new(f64::INFINITY, f64::NEG_INFINITY),
+                    |bounds, range| {
+                        ParamRange::new(bounds.min.min(range.min), bounds.max.max(range.max))
+                    },
+                )
+            };
+            let (x_bounds, q2_bounds) = (bounds(|sg| sg.x_range), bounds(|sg| sg.q2_range));
+            sets.fill(subgrids, |sg| sg.x_range, xs, x_bounds, x_sets);
+            sets.fill(subgrids, |sg| sg.q2_range, q2s, q2_bounds, q2_sets);
+        }
+
+        // The weights of the values along each axis in each subgrid, computed on the first
+        // use of the subgrid, see `ready`.
+        let separable = by_axis && AxisWeights::is_supported(interp_type);
+        if separable {
+            let max_nq2 = subgrids.iter().map(|sg| sg.q2s.len()).max().unwrap_or(0);
+            reset(wx_table, num_subgrids * nx, AxisWeights::default());
+            reset(wq2_table, num_subgrids * nq2, AxisWeights::default());
+            reset(ready, num_subgrids, false);
+            reset(partial, max_nq2, 0.0);
+        }
+
+        for (ix, &x) in xs.iter().enumerate() {
+            row_subgrids.clear();
+            for (iq2, &q2) in q2s.iter().enumerate() {
+                let found = if by_axis {
+                    sets.first_common(sets.of(x_sets, ix), sets.of(q2_sets, iq2))
+                } else {
+                    None
+                };
+                let subgrid_idx = match found {
+                    Some(subgrid_idx) => {
+                        self.stats.record_point(&subgrids[subgrid_idx], &[x, q2]);
+                        subgrid_idx
+                    }
+                    None => self
+                        .locate(&[x, q2])
+                        .ok_or(Error::SubgridNotFound { x, q2 })?,
+                };
+                row_subgrids.push(subgrid_idx);
+            }
+
+            if !separable {
+                for (iq2, (&q2, &subgrid_idx)) in q2s.iter().zip(row_subgrids.iter()).enumerate() {
+                    let coords = [transform(x), transform(q2)];
+                    for (ipid, &pid_idx) in pid_indices.iter().enumerate() {
+                        let result = self
+                            .interpolators
+                            .get(subgrid_idx, pid_idx)
+                            .interpolate_point(&coords)
+                            .map_err(|e| Error::InterpolationError(e.to_string()))?;
+                        out[(ipid * nx + ix) * nq2 + iq2] = self.apply_force_positive(result);
+                    }
+                }
+                continue;
+            }
+
+            // The points of the row are split into runs sharing their subgrid.
+            let mut start = 0;
+            while start < nq2 {
+                let subgrid_idx = row_subgrids[start];
+                let end = row_subgrids[start..]
+                    .iter()
+                    .position(|&idx| idx != subgrid_idx)
+                    .map_or(nq2, |len| start + len);
+
+                if !ready[subgrid_idx] {
+                    let axes = &self.axes[subgrid_idx];
+                    let tables = [
+                        (
+                            axes.xs(use_log),
+                            xs,
+                            &mut wx_table[subgrid_idx * nx..][..nx],
+                        ),
+                        (
+                            axes.q2s(use_log),
+                            q2s,
+                            &mut wq2_table[subgrid_idx * nq2..][..nq2],
+                        ),
+                    ];
+                    for (knots, values, table) in tables {
+                        let knots = knots.as_slice().unwrap();
+                        for (weights, &value) in table.iter_mut().zip(values) {
+                            *weights = AxisWeights::new(interp_type, knots, transform(value))
+                                .map_err(|e| Error::InterpolationError(e.to_string()))?;
+                        }
+                    }
+                    ready[subgrid_idx] = true;
+                }
+
+                let wx = &wx_table[subgrid_idx * nx + ix];
+                let wq2s = &wq2_table[subgrid_idx * nq2 + start..subgrid_idx * nq2 + end];
+                let subgrid = &subgrids[subgrid_idx];
+                for (ipid, &pid_idx) in pid_indices.iter().enumerate() {
+                    let row_out = &mut out[(ipid * nx + ix) * nq2..][start..end];
+                    match subgrid.grid_slice_f32(pid_idx) {
+                        Some(knot_values) => {
+                            interpolate_row(knot_values, wx, wq2s, partial, row_out);
+                        }
+                        None => {
+                            let knot_values = subgrid.grid_slice(pid_idx);
+                            interpolate_row(knot_values.view(), wx, wq2s, partial, row_out);
+                        }
+                    }
+                    for value in row_out {
+                        *value = self.apply_force_positive(*value);
+                    }
+                }
+                start = end;
+            }
+        }
+
+        Ok(())
+    }
+
+    /// Interpolates the PDF values for several flavors at a fixed momentum fraction and
+    /// several energy scales, together with `alpha_s` at these scales, e.g. for the
+    /// variations of the renormalization and factorization scales.
+    ///
+    /// For the interpolation methods which are linear in the knot values on 2D subgrids, the
+    /// weights along `x` are computed once per subgrid, and the knot values along `x` are
+    /// summed once per flavor and run of consecutive scales in the same subgrid, after which
+    /// every scale only contracts these sums with its own weights along `Q2`, see
+    /// `interpolate_row`. The results are bit-identical to the ones of `GridPDF::xfxq2_grid`
+    /// with a single `x`, and the evaluation does not allocate.
+    ///
+    /// # Arguments
+    ///
+    /// * `pids` - A slice of flavor IDs.
+    /// * `x` - The momentum fraction `x`.
+    /// * `q2s` - A slice of energy scales `Q2`.
+    /// * `out` - The output buffer with shape `[pids, q2s]` flattened in row-major order,
+    ///   i.e. `out[ipid * q2s.len() + iq2]`.
+    /// * `alphas` - The output buffer of `alpha_s`, with the same length as `q2s`.
+    ///
+    /// # Returns
+    ///
+    /// A `Result` which is `Ok(())` if all the values were computed or an `Error`, in which
+    /// case the buffers are left partly written.
+    pub fn xfxq2_fixed_x(
+        &self,
+        pids: &[i32],
+        x: f64,
+        q2s: &[f64],
+        out: &mut [f64],
+        alphas: &mut [f64],
+    ) -> Result<(), Error> {
+        self.alphas_q2_batch(q2s, alphas)?;
+        self.xfxq2_fixed(pids, FixedAxis::X, x, q2s, out)
+    }
+
+    /// Interpolates the PDF values for several flavors at several momentum fractions and a
+    /// fixed energy scale, and returns `alpha_s` at this scale.
+    ///
+    /// This is the transpose of `GridPDF::xfxq2_fixed_x`: the weights along `Q2` are computed
+    /// once per subgrid, and the knot values along `Q2` are summed once per flavor and run of
+    /// consecutive momentum fractions in the same subgrid, after which every `x` only
+    /// contracts these sums with its own weights along `x`. The results agree with
+    /// `GridPDF::xfxq2` up to rounding, and the evaluation does not allocate.
+    ///
+    /// # Arguments
+    ///
+    /// * `pids` - A slice of flavor IDs.
+    /// * `xs` - A slice of momentum fractions `x`.
+    /// * `q2` - The energy scale `Q2`.
+    /// * `out` - The output buffer with shape `[pids, xs]` flattened in row-major order,
+    ///   i.e. `out[ipid * xs.len() + ix]`.
+    ///
+    /// # Returns
+    ///
+    /// A `Result` with the value of `alpha_s` at `q2` if all the values were computed, or
+    /// an `Error`, in which case `out` is left partly written.
+    pub fn xfxq2_fixed_q2(
+        &self,
+        pids: &[i32],
+        xs: &[f64],
+        q2: f64,
+        out: &mut [f64],
+    ) -> Result<f64, Error> {
+        self.xfxq2_fixed(pids, FixedAxis::Q2, q2, xs, out)?;
+        Ok(self.alphas_q2(q2))
+    }
+
+    /// Implements `GridPDF::xfxq2_fixed_x` and `GridPDF::xfxq2_fixed_q2`, where `fixed` is
+    /// the coordinate shared by the points along `axis` and `values` are their coordinates
+    /// along the other axis.
+    fn xfxq2_fixed(
+        &self,
+        pids: &[i32],
+        axis: FixedAxis,
+        fixed: f64,
+        values: &[f64],
+        out: &mut [f64],
+    ) -> Result<(), Error> {
+        let npoints = values.len();
+        if out.len() != pids.len() * npoints {
+            return Err(Error::InterpolationError(format!(
+                "Inconsistent batch sizes: {} pids, {} points, {} outputs",
+                pids.len(),
+                npoints,
+                out.len()
+            )));
+        }
+
+        if pids.len() > MAX_BATCH_FLAVORS {
+            let (head, tail) = pids.split_at(MAX_BATCH_FLAVORS);
+            let (out_head, out_tail) = out.split_at_mut(head.len() * npoints);
+            self.xfxq2_fixed(head, axis, fixed, values, out_head)?;
+            return self.xfxq2_fixed(tail, axis, fixed, values, out_tail);
+        }
+
+        // The flavor indices are resolved once into a stack buffer, before the runs.
+        let mut indices = [0; MAX_BATCH_FLAVORS];
+        for (index, &pid) in indices.iter_mut().zip(pids) {
+            *index = self
+                .knot_array
+                .pid_index(pid)
+                .ok_or_else(|| Error::InterpolationError(format!("Invalid flavor ID: {pid}")))?;
+        }
+        let pid_indices = &indices[..pids.len()];
+
+        let point = |value: f64| match axis {
+            FixedAxis::X => [fixed, value],
+            FixedAxis::Q2 => [value, fixed],
+        };
+        let use_log = self.use_log();
+        let transform = |value: f64| if use_log { value.ln() } else { value };
+        let interp_type = &self.info.interpolator_type;
+        let separable = AxisWeights::is_supported(interp_type);
+        let locate = |value: f64| {
+            let [x, q2] = point(value);
+            self.locate(&[x, q2])
+                .ok_or(Error::SubgridNotFound { x, q2 })
+        };
+
+        // The weights along the fixed axis in the subgrid of the previous run.
+        let mut cached: Option<(usize, AxisWeights)> = None;
+        let mut partial = [0.0; FIXED_AXIS_KNOTS];
+        let mut next_subgrid = None;
+        let mut start = 0;
+
+        while start < npoints {
+            // The run of consecutive points in the same subgrid, of at most
+            // `FIXED_AXIS_POINTS` points.
+            let subgrid_idx = match next_subgrid.take() {
+                Some(subgrid_idx) => subgrid_idx,
+                None => locate(values[start])?,
+            };
+            let mut end = start + 1;
+            while end < npoints && end - start < FIXED_AXIS_POINTS {
+                let idx = locate(values[end])?;
+                if idx != subgrid_idx {
+                    next_subgrid = Some(idx);
+                    break;
+                }
+                end += 1;
+            }
+            let subgrid = &self.knot_array.subgrids[subgrid_idx];
+
+            if !separable || !matches!(subgrid.interpolation_config(), InterpolationConfig::TwoD) {
+                for (ipoint, &value) in values.iter().enumerate().take(end).skip(start) {
+                    let coords = point(value).map(transform);
+                    for (ipid, &pid_idx) in pid_indices.iter().enumerate() {
+                        let result = self
+                            .interpolators
+                            .get(subgrid_idx, pid_idx)
+                            .interpolate_point(&coords)
+                            .map_err(|e| Error::InterpolationError(e.to_string()))?;
+                        out[ipid * npoints + ipoint] = self.apply_force_positive(result);
+                    }
+                }
+                start = end;
+                continue;
+            }
+
+            let axes = &self.axes[subgrid_idx];
+            let (fixed_knots, knots) = match axis {
+                FixedAxis::X => (axes.xs(use_log), axes.q2s(use_log)),
+                FixedAxis::Q2 => (axes.q2s(use_log), axes.xs(use_log)),
+            };
+            let axis_weights = |knots: &ArcArray1<f64>, value: f64| {
+                AxisWeights::new(interp_type, knots.as_slice().unwrap(), transform(value))
+                    .map_err(|e| Error::InterpolationError(e.to_string()))
+            };
+            let wfixed = match cached {
+                Some((idx, weights)) if idx == subgrid_idx => weights,
+                _ => {
+                    let weights = axis_weights(fixed_knots, fixed)?;
+                    cached = Some((subgrid_idx, weights));
+                    weights
+                }
+            };
+            let mut weights = [AxisWeights::default(); FIXED_AXIS_POINTS];
+            let weights = &mut weights[..end - start];
+            for (w, &value) in weights.iter_mut().zip(&values[start..end]) {
+                *w = axis_weights(knots, value)?;
+            }
+
+            for (ipid, &pid_idx) in pid_indices.iter().enumerate() {
+                let out = &mut out[ipid * npoints..][start..end];
+                match (subgrid.grid_slice_f32(pid_idx), axis) {
+                    (Some(knot_values), FixedAxis::X) => {
+                        interpolate_row(knot_values, &wfixed, weights, &mut partial, out);
+                    }
+                    (Some(knot_values), FixedAxis::Q2) => {
+                        let knot_values = knot_values.reversed_axes();
+                        interpolate_row(knot_values, &wfixed, weights, &mut partial, out);
+                    }
+                    (None, FixedAxis::X) => {
+                        let knot_values = subgrid.grid_slice(pid_idx);
+                        interpolate_row(knot_values.view(), &wfixed, weights, &mut partial, out);
+                    }
+                    (None, FixedAxis::Q2) => {
+                        let knot_values = subgrid.grid_slice(pid_idx);
+                        let knot_values = knot_values.view().reversed_axes();
+                        interpolate_row(knot_values, &wfixed, weights, &mut partial, out);
+                    }
+                }
+                for value in out {
+                    *value = self.apply_force_positive(*value);
+                }
+            }
+            start = end;
+        }
+
+        Ok(())
+    }
+
+    /// Whether the interpolation is performed on the logarithm of the coordinates.
+    #[inline]
+    fn use_log(&self) -> bool {
+        self.use_log
+    }
+
+    /// Returns the number of bytes held by the knot values, the knots and the interpolators
+    /// of the member.
+    ///
+    /// The interpolators share the knot values and the knots instead of owning copies of
+    /// them, but the coefficient tables precomputed by some strategies, e.g. `LogBicubic`,
+    /// are their own. As the interpolators are built on first use, only the tables of those
+    /// built so far are included, such that the number grows with the evaluated flavors.
+    pub fn resident_bytes(&self) -> usize {
+        let knot_values: usize = self
+            .knot_array
+            .subgrids
+            .iter()
+            .map(SubGrid::knot_values_bytes)
+            .sum();
+        let knots: usize = self.axes.iter().map(SubgridAxes::resident_bytes).sum();
+
+        knot_values + knots + self.interpolators.resident_bytes()
+    }
+
     /// Interpolates PDF values for multiple points in parallel.
     ///
+    /// The points are evaluated on the current rayon thread pool, see
+    /// `GridPDF::xfxq2s_into` for evaluating them on another executor.
+    ///
     /// # Arguments
     ///
     /// * `flavors` - A vector of flavor IDs.
@@ -322,23 +1539,90 @@ impl GridPDF {
     /// # Returns
     ///
     /// A 2D array of interpolated PDF values with shape `[flavors, N_knots]`.
+    ///
+    /// # Panics
+    ///
+    /// Panics if the value of any of the points cannot be computed.
     pub fn xfxq2s(&self, flavors: Vec<i32>, slice_points: &[&[f64]]) -> Array2<f64> {
         let grid_shape = [flavors.len(), slice_points.len()];
         let flatten_len = grid_shape.iter().product();
+        let mut data = vec![0.0; flatten_len];
+        let mut status = vec![PointStatus::Success; flatten_len];
 
-        let data: Vec<f64> = (0..flatten_len)
-            .map(|idx| {
-                let num_cols = slice_points.len();
-                let (fl_idx, s_idx) = (idx / num_cols, idx % num_cols);
-                self.xfxq2(flavors[fl_idx], slice_points[s_idx]).unwrap()
-            })
-            .collect();
+        self.xfxq2s_into(
+            &flavors,
+            slice_points,
+            &mut data,
+            &mut status,
+            &RayonExecutor::new(),
+        )
+        .and_then(|()| self.batch_status(slice_points, &status))
+        .unwrap();
 
         Array2::from_shape_vec(grid_shape, data).unwrap()
     }
 
+    /// Interpolates PDF values for multiple flavors and points into a caller-owned buffer.
+    ///
+    /// The values are written in row-major order with shape `[flavors, points]`, i.e.
+    /// `out[iflavor * points.len() + ipoint]`. The buffer is split into chunks of consecutive
+    /// values which are evaluated by `executor`, e.g. a [`RayonExecutor`] or an executor
+    /// forwarding the chunks to the thread pool of the application.
+    ///
+    /// A value which cannot be computed does not interrupt the batch: it is set to `NaN`
+    /// and the reason is recorded in the corresponding entry of `status`.
+    ///
+    /// # Arguments
+    ///
+    /// * `flavors` - A slice of flavor IDs.
+    /// * `points` - A slice containing the collection of knots to interpolate on.
+    ///   A knot is a collection of points containing `(nucleon, alphas, x, Q2)`.
+    /// * `out` - The output buffer, of length `flavors.len() * points.len()`.
+    /// * `status` - The status of each value, with the same length as `out`.
+    /// * `executor` - The executor running the chunks.
+    ///
+    /// # Errors
+    ///
+    /// Returns an `Error` if the buffer sizes are inconsistent, in which case nothing is
+    /// written.
+    pub fn xfxq2s_into(
+        &self,
+        flavors: &[i32],
+        points: &[&[f64]],
+        out: &mut [f64],
+        status: &mut [PointStatus],
+        executor: &dyn BatchExecutor,
+    ) -> Result<(), Error> {
+        let npoints = points.len();
+        if out.len() != flavors.len() * npoints || status.len() != out.len() {
+            return Err(Error::InterpolationError(format!(
+                "Inconsistent batch sizes: {} pids, {} points, {} outputs, {} statuses",
+                flavors.len(),
+                npoints,
+                out.len(),
+                status.len()
+            )));
+        }
+
+        for_each_chunk(executor, out, status, |start, out, status| {
+            for (offset, (value, code)) in out.iter_mut().zip(status.iter_mut()).enumerate() {
+                let idx = start + offset;
+                let (fl_idx, s_idx) = (idx / npoints, idx % npoints);
+                (*value, *code) = match self.xfxq2(flavors[fl_idx], points[s_idx]) {
+                    Ok(result) => (result, PointStatus::Success),
+                    Err(err) => (f64::NAN, PointStatus::from(&err)),
+                };
+            }
+        });
+
+        Ok(())
+    }
+
     /// Interpolates PDF values for multiple points in parallel using Chebyshev batch interpolation.
     ///
+    /// The points are evaluated on the current rayon thread pool, see
+    /// `GridPDF::xfxq2_cheby_batch_into` for evaluating them on another executor.
+    ///
     /// # Arguments
     ///
     /// * `flavor_id` - The flavor ID.
@@ -349,8 +1633,61 @@ impl GridPDF {
     ///
     /// A `Vec<f64>` of interpolated PDF values.
     pub fn xfxq2_cheby_batch(&self, flavor_id: i32, points: &[&[f64]]) -> Result<Vec<f64>, Error> {
-        if points.is_empty() {
-            return Ok(Vec::new());
+        let mut results = vec![0.0; points.len()];
+        let mut status = vec![PointStatus::Success; points.len()];
+
+        self.xfxq2_cheby_batch_into(
+            flavor_id,
+            points,
+            &mut results,
+            &mut status,
+            &RayonExecutor::new(),
+        )?;
+        self.batch_status(points, &status)?;
+
+        Ok(results)
+    }
+
+    /// Interpolates PDF values for multiple points into a caller-owned buffer using Chebyshev
+    /// batch interpolation.
+    ///
+    /// The buffer is split into chunks of consecutive points which are evaluated by
+    /// `executor`. The points of a chunk are grouped by subgrid and each group is interpolated
+    /// at once. The batch interpolator of a subgrid is built by the first chunk requiring it
+    /// and is then shared by all the chunks.
+    ///
+    /// A value which cannot be computed does not interrupt the batch: it is set to `NaN`
+    /// and the reason is recorded in the corresponding entry of `status`.
+    ///
+    /// # Arguments
+    ///
+    /// * `flavor_id` - The flavor ID.
+    /// * `points` - A slice containing the collection of knots to interpolate on.
+    ///   A knot is a collection of points containing `(nucleon, alphas, x, Q2)`.
+    /// * `out` - The output buffer, with the same length as `points`.
+    /// * `status` - The status of each value, with the same length as `points`.
+    /// * `executor` - The executor running the chunks.
+    ///
+    /// # Errors
+    ///
+    /// Returns an `Error` if the buffer sizes are inconsistent, if the flavor ID is not part
+    /// of the grid, or if the interpolator is not `LogChebyshev`, in which case nothing is
+    /// written.
+    pub fn xfxq2_cheby_batch_into(
+        &self,
+        flavor_id: i32,
+        points: &[&[f64]],
+        out: &mut [f64],
+        status: &mut [PointStatus],
+        executor: &dyn BatchExecutor,
+    ) -> Result<(), Error> {
+        if out.len() != points.len() || status.len() != points.len() {
+            return Err(Error::InterpolationError(format!(
+                "Inconsistent batch sizes: {} points, {} outputs, {} statuses",
+                points.len(),
+                out.len(),
+                status.len()
+            )));
         }
 
         let pid_idx = self
@@ -364,52 +1701,84 @@ impl GridPDF {
             ));
         }
 
-        let mut subgrid_groups: HashMap<usize, Vec<(usize, &[f64])>> = HashMap::new();
-        for (i, point) in points.iter().enumerate() {
-            let subgrid_idx = self.knot_array.find_subgrid(point).ok_or_else(|| {
-                let (x, q2) = self.get_x_q2(point);
-                Error::SubgridNotFound { x, q2 }
-            })?;
+        let num_subgrids = self.knot_array.subgrids.len();
+        for_each_chunk(executor, out, status, |start, out, status| {
+            let chunk = &points[start..start + out.len()];
+            let mut scratch = CHEBY_SCRATCH.take();
+            let ChebyScratch {
+                groups,
+                points: log_points,
+            } = &mut scratch;
 
-            subgrid_groups
-                .entry(subgrid_idx)
-                .or_default()
-                .push((i, *point));
-        }
+            groups.resize_with(num_subgrids, Vec::new);
+            groups.iter_mut().for_each(Vec::clear);
+            for (offset, point) in chunk.iter().enumerate() {
+                match self.locate(point) {
+                    Some(subgrid_idx) => groups[subgrid_idx].push(offset),
+                    None => {
+                        out[offset] = f64::NAN;
+                        status[offset] = PointStatus::SubgridNotFound;
+                    }
+                }
+            }
 
-        let mut all_results: Vec<(usize, f64)> = Vec::new();
+            for (subgrid_idx, offsets) in groups.iter().enumerate() {
+                if offsets.is_empty() {
+                    continue;
+                }
 
-        for (subgrid_idx, group) in subgrid_groups {
-            let subgrid = &self.knot_array.subgrids[subgrid_idx];
+                let group = offsets.iter().map(|&offset| chunk[offset]);
+                let results = self
+                    .interpolators
+                    .get_batch(subgrid_idx, pid_idx)
+                    .ok()
+                    .and_then(|interpolator| interpolator.interpolate_log(group, log_points).ok());
 
-            let (indices, group_points): (Vec<_>, Vec<_>) = group.into_iter().unzip();
+                match results {
+                    Some(results) => {
+                        for (&offset, result) in offsets.iter().zip(results) {
+                            out[offset] = self.apply_force_positive(result);
+                            status[offset] = PointStatus::Success;
+                        }
+                    }
+                    None => {
+                        for &offset in offsets {
+                            out[offset] = f64::NAN;
+                            status[offset] = PointStatus::InterpolationError;
+                        }
+                    }
+                }
+            }
 
-            let log_points: Vec<Vec<f64>> = group_points
-                .iter()
-                .map(|p| p.iter().map(|&v| v.ln()).collect::<Vec<f64>>())
-                .collect();
+            CHEBY_SCRATCH.set(scratch);
+        });
 
-            let batch_interpolator =
-                InterpolatorFactory::create_batch_interpolator(subgrid, pid_idx)
-                    .map_err(Error::InterpolationError)?;
+        Ok(())
+    }
 
-            let results = batch_interpolator
-                .interpolate(log_points)
-                .map_err(|e| Error::InterpolationError(e.to_string()))?;
+    /// Converts the first failure recorded in the `status` of a batch into an `Error`.
+    ///
+    /// The entries of `status` are laid out as `[flavors, points]`, such that the point of
+    /// the entry `i` is `points[i % points.len()]`.
+    fn batch_status(&self, points: &[&[f64]], status: &[PointStatus]) -> Result<(), Error> {
+        let Some((idx, &code)) = status
+            .iter()
+            .enumerate()
+            .find(|&(_, &code)| code != PointStatus::Success)
+        else {
+            return Ok(());
+        };
 
-            for (original_index, result) in indices.into_iter().zip(results) {
-                all_results.push((original_index, result));
+        let point = points[idx % points.len()];
+        match code {
+            PointStatus::SubgridNotFound => {
+                let (x, q2) = self.get_x_q2(point);
+                Err(Error::SubgridNotFound { x, q2 })
             }
+            _ => Err(Error::InterpolationError(format!(
+                "Failed to interpolate the point {point:?}"
+            ))),
         }
-
-        // sort the results according to the original index
-        all_results.sort_by_key(|&(i, _)| i);
-        let final_results = all_results
-            .into_iter()
-            .map(|(_, r)| self.apply_force_positive(r))
-            .collect();
-
-        Ok(final_results)
     }
 
     /// Get the values of the momentum fraction `x` and momentum scale `Q2`.
@@ -441,6 +1810,30 @@ impl GridPDF {
         self.alphas.alphas_q2(q2)
     }
 
+    /// Gets the alpha_s values at several values of `Q²`.
+    ///
+    /// # Arguments
+    ///
+    /// * `q2s` - A slice of energy scales squared.
+    /// * `out` - The output buffer, such that `out[i]` holds the value at `q2s[i]`.
+    ///
+    /// # Returns
+    ///
+    /// A `Result` which is `Ok(())` if the values were computed or an `Error` if the lengths
+    /// of `q2s` and `out` differ.
+    pub fn alphas_q2_batch(&self, q2s: &[f64], out: &mut [f64]) -> Result<(), Error> {
+        if q2s.len() != out.len() {
+            return Err(Error::InterpolationError(format!(
+                "Inconsistent batch sizes: {} q2s, {} outputs",
+                q2s.len(),
+                out.len()
+            )));
+        }
+        self.alphas.alphas_q2s(q2s, out);
+
+        Ok(())
+    }
+
     /// Returns a reference to the PDF metadata.
     pub fn metadata(&self) -> &MetaData {
         &self.info
@@ -474,4 +1867,60 @@ mod tests {
         assert_eq!(grid_array.subgrids[0].grid.shape(), &[1, 1, 2, 1, 3, 2]);
         assert!(grid_array.find_subgrid(&[1.5, 4.5]).is_some());
     }
+
+    #[test]
+    fn test_find_subgrid_index() {
+        let subgrid = |q2s: Vec<f64>| SubgridData {
+            nucleons: vec![1.0],
+            alphas: vec![0.118],
+            kts: vec![0.0],
+            xs: vec![1.0, 2.0, 3.0],
+            q2s,
+            grid_data: vec![0.0; 6],
+        };
+        let subgrid_data = vec![
+            subgrid(vec![4.0, 5.0]),
+            subgrid(vec![5.0, 6.0]),
+            subgrid(vec![6.0, 8.0]),
+        ];
+        let mut grid_array = GridArray::new(subgrid_data, vec![21]);
+
+        let cases = [
+            ([1.5, 4.5], 0), // inside the first subgrid
+            ([1.5, 5.0], 0), // at a shared boundary, first match wins
+            ([3.0, 5.5], 1), // inside the second subgrid
+            ([2.0, 6.0], 1), // at a shared boundary, first match wins
+            ([2.0, 7.0], 2), // inside the last subgrid
+            ([0.5, 4.5], 0), // extrapolation in x
+            ([2.0, 1.0], 0), // extrapolation below the lowest Q2
+            ([9.0, 1e3], 2), // extrapolation in both x and Q2
+        ];
+
+        for (point, expected) in cases {
+            assert_eq!(grid_array.find_subgrid(&point), Some(expected), "{point:?}");
+        }
+
+        // Points with inconsistent dimensions fall back to the distance scan.
+        assert_eq!(grid_array.find_subgrid(&[1.0, 2.0, 7.0]), Some(0));
+
+        // Removed subgrids bypass the stale index, until it is rebuilt.
+        grid_array.subgrids.remove(0);
+        assert_eq!(grid_array.find_subgrid(&[1.5, 4.5]), Some(0));
+        assert_eq!(grid_array.find_subgrid(&[2.0, 7.0]), Some(1));
+        grid_array.reindex();
+
+        // Modified ranges are not in the stale index, whose candidates are checked against
+        // the current ranges, and the points outside of the subgrids are scanned linearly.
+        grid_array.subgrids[0].q2_range = ParamRange::new(5.0, 8.0);
+        grid_array.subgrids[1].q2_range = ParamRange::new(9.0, 10.0);
+        assert_eq!(grid_array.find_subgrid(&[2.0, 7.0]), Some(0));
+        assert_eq!(grid_array.find_subgrid(&[2.0, 9.5]), Some(1));
+        assert_eq!(grid_array.find_subgrid(&[2.0, 11.0]), Some(1));
+        grid_array.subgrids[0].q2_range = ParamRange::new(5.0, 7.5);
+        grid_array.subgrids[1].q2_range = ParamRange::new(6.0, 8.0);
+        assert_eq!(grid_array.find_subgrid(&[2.0, 7.0]), Some(0));
+        grid_array.reindex();
+        assert_eq!(grid_array.find_subgrid(&[2.0, 7.0]), Some(0));
+        assert_eq!(grid_array.find_subgrid(&[2.0, 9.0]), Some(1));
+    }
 }
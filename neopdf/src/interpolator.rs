@@ -4,6 +4,11 @@
 //! # Contents
 //!
 //! - [`DynInterpolator`]: Trait for dynamic, multi-dimensional interpolation.
+//! - [`FlavorInterpolator`]: Statically dispatched interpolator of a flavor of a subgrid.
+//! - [`InterpolatorTable`]: Contiguous storage of the interpolators of a member, built on
+//!   first use.
+//! - [`SubgridAxes`]: Knots of the axes of a subgrid, shared by its interpolators.
+//! - [`SinglePrecisionInterpolator`]: Interpolator of knot values stored in single precision.
 //! - [`InterpolatorFactory`]: Factory for constructing interpolators for SubGrid.
 //!
 //! # Note
@@ -11,22 +16,27 @@
 //! Interpolation strategies are defined in `strategy.rs`.
 //! The [`SubGrid`] struct is defined in `subgrid.rs`.
 
-use ndarray::{s, OwnedRepr};
+use ndarray::{
+    s, ArcArray, ArcArray1, ArrayView2, Data, Ix2, Ix3, Ix6, IxDyn, OwnedArcRepr, RawDataClone,
+    SliceArg,
+};
 use ninterp::data::{InterpData2D, InterpData3D};
 use ninterp::error::InterpolateError;
-use ninterp::interpolator::{
-    Extrapolate, Interp2D, Interp2DOwned, Interp3D, Interp3DOwned, InterpND, InterpNDOwned,
-};
+use ninterp::interpolator::{Extrapolate, Interp2D, Interp3D, InterpND};
 use ninterp::prelude::*;
 use ninterp::strategy::traits::{Strategy2D, Strategy3D, StrategyND};
 use ninterp::strategy::Linear;
+use std::sync::OnceLock;
 
+use super::gridpdf::LoadOptions;
 use super::metadata::InterpolatorType;
 use super::strategy::{
-    BilinearInterpolation, LogBicubicInterpolation, LogBilinearInterpolation,
-    LogChebyshevBatchInterpolation, LogChebyshevInterpolation, LogTricubicInterpolation,
+    BilinearInterpolation, LogBicubicInterpolation, LogBicubicTableInterpolation,
+    LogBilinearInterpolation, LogChebyshevBatchInterpolation, LogChebyshevInterpolation,
+    LogTricubicInterpolation,
 };
 use super::subgrid::SubGrid;
+use super::utils;
 
 /// Represents the dimensionality and structure of interpolation needed.
 ///
@@ -81,9 +91,10 @@ pub trait DynInterpolator: Send + Sync {
 }
 
 // Implement `DynInterpolator` for 2D interpolators.
-impl<S> DynInterpolator for Interp2DOwned<f64, S>
+impl<D, S> DynInterpolator for Interp2D<D, S>
 where
-    S: Strategy2D<OwnedRepr<f64>> + 'static + Clone + Send + Sync,
+    D: Data<Elem = f64> + RawDataClone + Clone + 'static + Send + Sync,
+    S: Strategy2D<D> + 'static + Clone + Send + Sync,
 {
     fn interpolate_point(&self, point: &[f64]) -> Result<f64, InterpolateError> {
         let [x, y] = point
@@ -94,9 +105,10 @@ where
 }
 
 // Implement `DynInterpolator` for 3D interpolators.
-impl<S> DynInterpolator for Interp3DOwned<f64, S>
+impl<D, S> DynInterpolator for Interp3D<D, S>
 where
-    S: Strategy3D<OwnedRepr<f64>> + 'static + Clone + Send + Sync,
+    D: Data<Elem = f64> + RawDataClone + Clone + 'static + Send + Sync,
+    S: Strategy3D<D> + 'static + Clone + Send + Sync,
 {
     fn interpolate_point(&self, point: &[f64]) -> Result<f64, InterpolateError> {
         let [x, y, z] = point
@@ -107,25 +119,912 @@ where
 }
 
 // Implement `DynInterpolator` for N-dimensional interpolators.
-impl<S> DynInterpolator for InterpNDOwned<f64, S>
+impl<D, S> DynInterpolator for InterpND<D, S>
 where
-    S: StrategyND<OwnedRepr<f64>> + 'static + Clone + Send + Sync,
+    D: Data<Elem = f64> + RawDataClone + Clone + 'static + Send + Sync,
+    S: StrategyND<D> + 'static + Clone + Send + Sync,
 {
     fn interpolate_point(&self, point: &[f64]) -> Result<f64, InterpolateError> {
         self.interpolate(point)
     }
 }
 
+/// Storage of the knots and of the knot values of the interpolators, shared with the subgrid.
+type Shared = OwnedArcRepr<f64>;
+
+/// The interpolator of a flavor of a subgrid, dispatched statically over the combinations of
+/// strategy and dimension built by [`InterpolatorFactory`].
+///
+/// All the interpolators of a set share the same variant, such that dispatching an
+/// evaluation is a branch which is always predicted instead of a virtual call, and the
+/// strategies are inlined into the evaluation. The interpolators are stored by value in an
+/// [`InterpolatorTable`] rather than each in its own heap allocation.
+pub enum FlavorInterpolator {
+    /// `Bilinear` interpolation in `(x, Q2)`.
+    Bilinear(Interp2D<Shared, BilinearInterpolation>),
+    /// `LogBilinear` interpolation in `(x, Q2)`.
+    LogBilinear(Interp2D<Shared, LogBilinearInterpolation>),
+    /// `LogBicubic` interpolation in `(x, Q2)`.
+    LogBicubic(Interp2D<Shared, LogBicubicInterpolation>),
+    /// `LogBicubic` interpolation in `(x, Q2)` with precomputed coefficients.
+    LogBicubicTable(Interp2D<Shared, LogBicubicTableInterpolation>),
+    /// `LogChebyshev` interpolation in `(x, Q2)`.
+    LogChebyshev2D(Interp2D<Shared, LogChebyshevInterpolation<2>>),
+    /// Interpolation in `(x, Q2)` of knot values stored in single precision.
+    SinglePrecision(SinglePrecisionInterpolator),
+    /// `LogTricubic` interpolation in `(z, x, Q2)`.
+    LogTricubic(Interp3D<Shared, LogTricubicInterpolation>),
+    /// `LogChebyshev` interpolation in `(z, x, Q2)`.
+    LogChebyshev3D(Interp3D<Shared, LogChebyshevInterpolation<3>>),
+    /// Linear interpolation in 4 or 5 dimensions.
+    LinearND(InterpND<Shared, Linear>),
+}
+
+impl FlavorInterpolator {
+    /// Interpolates a point whose coordinates are already transformed, e.g. log-transformed
+    /// for the logarithmic strategies.
+    #[inline]
+    pub fn interpolate_point(&self, point: &[f64]) -> Result<f64, InterpolateError> {
+        match self {
+            Self::Bilinear(interp) => interp.interpolate(&point_2d(point)?),
+            Self::LogBilinear(interp) => interp.interpolate(&point_2d(point)?),
+            Self::LogBicubic(interp) => interp.interpolate(&point_2d(point)?),
+            Self::LogBicubicTable(interp) => interp.interpolate(&point_2d(point)?),
+            Self::LogChebyshev2D(interp) => interp.interpolate(&point_2d(point)?),
+            Self::SinglePrecision(interp) => interp.interpolate(point_2d(point)?),
+            Self::LogTricubic(interp) => interp.interpolate(&point_3d(point)?),
+            Self::LogChebyshev3D(interp) => interp.interpolate(&point_3d(point)?),
+            Self::LinearND(interp) => interp.interpolate(point),
+        }
+    }
+
+    /// Returns the number of bytes held by the tables precomputed by the strategy, e.g. the
+    /// coefficients of `LogBicubic`. The knots and the knot values are shared with the
+    /// subgrid and not included.
+    pub fn resident_bytes(&self) -> usize {
+        match self {
+            Self::LogBicubic(interp) => interp.strategy.resident_bytes(),
+            Self::LogBicubicTable(interp) => interp.strategy.resident_bytes(),
+            _ => 0,
+        }
+    }
+}
+
+impl DynInterpolator for FlavorInterpolator {
+    fn interpolate_point(&self, point: &[f64]) -> Result<f64, InterpolateError> {
+        FlavorInterpolator::interpolate_point(self, point)
+    }
+}
+
+#[inline(always)]
+fn point_2d(point: &[f64]) -> Result<[f64; 2], InterpolateError> {
+    point
+        .try_into()
+        .map_err(|_| InterpolateError::Other("Expected 2D point".to_string()))
+}
+
+#[inline(always)]
+fn point_3d(point: &[f64]) -> Result<[f64; 3], InterpolateError> {
+    point
+        .try_into()
+        .map_err(|_| InterpolateError::Other("Expected 3D point".to_string()))
+}
+
+/// Interpolation of a flavor at several values of the leading coordinate of a 3D subgrid,
+/// e.g. the nucleon number `A` or `alpha_s`, at a fixed `(x, Q2)`.
+///
+/// For the `LogTricubic` interpolators, the interpolation along `x` and `Q2` is contracted
+/// once per knot interval of the leading axis, see
+/// [`LogTricubicInterpolation::leading_coefficients`], after which every value of the
+/// leading coordinate only evaluates six functions of it. A scan is tied to a flavor and
+/// to a fixed `(x, Q2)`, whereas the subgrid may change from one value to the next.
+#[derive(Default)]
+pub(crate) struct LeadingScan {
+    /// The subgrid and the knot interval of the leading axis of the cached coefficients.
+    cached: Option<(usize, usize, [f64; 6])>,
+}
+
+impl LeadingScan {
+    /// Interpolates `interpolator`, the one of the scanned flavor in the subgrid
+    /// `subgrid_idx`, at the transformed coordinates `[z, x, Q2]`.
+    ///
+    /// Returns `None` if the interpolator is not a `LogTricubic` one, in which case the
+    /// point is to be interpolated by `FlavorInterpolator::interpolate_point`.
+    pub(crate) fn interpolate(
+        &mut self,
+        subgrid_idx: usize,
+        interpolator: &FlavorInterpolator,
+        point: &[f64],
+    ) -> Option<Result<f64, InterpolateError>> {
+        let FlavorInterpolator::LogTricubic(interp) = interpolator else {
+            return None;
+        };
+
+        Some(point_3d(point).and_then(|[z, x, q2]| {
+            let data = &interp.data;
+            let zs = data.grid[0].as_slice().unwrap();
+            let z = z.clamp(zs[0], zs[zs.len() - 1]);
+            let interval = utils::find_interval_index(zs, z)?;
+
+            let coeffs = match self.cached {
+                Some((idx, cached, coeffs)) if idx == subgrid_idx && cached == interval => coeffs,
+                _ => {
+                    let coeffs =
+                        LogTricubicInterpolation::leading_coefficients(data, interval, x, q2)?;
+                    self.cached = Some((subgrid_idx, interval, coeffs));
+                    coeffs
+                }
+            };
+            let u = (z - zs[interval]) / (zs[interval + 1] - zs[interval]);
+
+            Ok(LogTricubicInterpolation::interpolate_leading(&coeffs, u))
+        }))
+    }
+}
+
+/// The interpolators of all the flavors of all the subgrids of a member, stored
+/// contiguously in `[subgrids, flavors]` order.
+///
+/// The interpolators are built on first use, such that a member whose evaluations only
+/// involve a few flavors does not pay for building the others, e.g. when loading all the
+/// members of a large set. The first use of an interpolator from several threads builds it
+/// once, while the others wait for it. `InterpolatorTable::warmup` builds them ahead of the
+/// evaluations, for latency-sensitive applications.
+pub struct InterpolatorTable {
+    interpolators: Vec<OnceLock<FlavorInterpolator>>,
+    /// The batch interpolators of each subgrid and flavor, only allocated for the
+    /// `LogChebyshev` sets, see `GridPDF::xfxq2_cheby_batch`.
+    batch_interpolators: Vec<OnceLock<Result<BatchInterpolator, String>>>,
+    num_flavors: usize,
+    interp_type: InterpolatorType,
+    /// The subgrids the interpolators are built from, sharing their knot values with the
+    /// subgrids of the member.
+    subgrids: Vec<SubGrid>,
+    axes: Vec<SubgridAxes>,
+    options: LoadOptions,
+}
+
+impl InterpolatorTable {
+    /// Creates the table of the interpolators of `subgrids`, without building any of them.
+    ///
+    /// # Arguments
+    ///
+    /// * `interp_type` - The interpolation strategy of the set.
+    /// * `subgrids` - The subgrids of the member.
+    /// * `axes` - The knots of the axes of each subgrid.
+    /// * `num_flavors` - The number of flavors of each subgrid.
+    /// * `options` - The `LoadOptions` the interpolators are built with.
+    pub fn new(
+        interp_type: InterpolatorType,
+        subgrids: &[SubGrid],
+        axes: &[SubgridAxes],
+        num_flavors: usize,
+        options: LoadOptions,
+    ) -> Self {
+        assert_eq!(
+            subgrids.len(),
+            axes.len(),
+            "Expected the axes of every subgrid"
+        );
+
+        let num_batch = if matches!(interp_type, InterpolatorType::LogChebyshev) {
+            subgrids.len() * num_flavors
+        } else {
+            0
+        };
+
+        Self {
+            interpolators: (0..subgrids.len() * num_flavors)
+                .map(|_| OnceLock::new())
+                .collect(),
+            batch_interpolators: (0..num_batch).map(|_| OnceLock::new()).collect(),
+            num_flavors,
+            interp_type,
+            subgrids: subgrids.to_vec(),
+            axes: axes.to_vec(),
+            options,
+        }
+    }
+
+    /// Returns the interpolator of a flavor of a subgrid, building it on first use.
+    #[inline]
+    pub fn get(&self, subgrid_idx: usize, pid_idx: usize) -> &FlavorInterpolator {
+        self.interpolators[subgrid_idx * self.num_flavors + pid_idx]
+            .get_or_init(|| self.build(subgrid_idx, pid_idx))
+    }
+
+    #[cold]
+    fn build(&self, subgrid_idx: usize, pid_idx: usize) -> FlavorInterpolator {
+        InterpolatorFactory::create_with_options(
+            self.interp_type.clone(),
+            &self.subgrids[subgrid_idx],
+            &self.axes[subgrid_idx],
+            pid_idx,
+            self.options,
+        )
+    }
+
+    /// Returns the batch interpolator of a flavor of a subgrid, building it on first use.
+    ///
+    /// # Panics
+    ///
+    /// Panics if the interpolation strategy of the set is not `LogChebyshev`.
+    pub fn get_batch(
+        &self,
+        subgrid_idx: usize,
+        pid_idx: usize,
+    ) -> Result<&BatchInterpolator, &str> {
+        self.batch_interpolators[subgrid_idx * self.num_flavors + pid_idx]
+            .get_or_init(|| {
+                InterpolatorFactory::create_batch_with_axes(
+                    &self.subgrids[subgrid_idx],
+                    &self.axes[subgrid_idx],
+                    pid_idx,
+                )
+            })
+            .as_ref()
+            .map_err(String::as_str)
+    }
+
+    /// Builds the interpolators of the given flavors for all the subgrids.
+    ///
+    /// # Arguments
+    ///
+    /// * `pid_indices` - The indices of the flavors.
+    pub fn warmup(&self, pid_indices: &[usize]) {
+        for subgrid_idx in 0..self.subgrids.len() {
+            for &pid_idx in pid_indices {
+                self.get(subgrid_idx, pid_idx);
+            }
+        }
+    }
+
+    /// Returns the number of bytes held by the tables of the interpolators built so far,
+    /// see `FlavorInterpolator::resident_bytes`.
+    pub fn resident_bytes(&self) -> usize {
+        self.interpolators
+            .iter()
+            .filter_map(OnceLock::get)
+            .map(FlavorInterpolator::resident_bytes)
+            .sum()
+    }
+
+    /// Returns the number of interpolators built so far.
+    pub fn num_built(&self) -> usize {
+        self.interpolators
+            .iter()
+            .filter(|interpolator| interpolator.get().is_some())
+            .count()
+    }
+}
+
+/// The knots of the axes of a subgrid, shared by the interpolators of all its flavors.
+///
+/// Every axis is kept both as is and log-transformed in reference-counted arrays, such that
+/// the interpolators of a subgrid only hold handles to the same knots instead of each owning
+/// its own transformed copy.
+#[derive(Debug, Clone)]
+pub struct SubgridAxes {
+    /// The knots of the axes `(A, alpha_s, kT, x, Q2)`.
+    knots: [ArcArray1<f64>; 5],
+    /// The logarithms of the knots of the axes `(A, alpha_s, kT, x, Q2)`.
+    log_knots: [ArcArray1<f64>; 5],
+}
+
+impl SubgridAxes {
+    /// Collects and transforms the knots of the axes of a subgrid.
+    pub fn new(subgrid: &SubGrid) -> Self {
+        let axes = [
+            &subgrid.nucleons,
+            &subgrid.alphas,
+            &subgrid.kts,
+            &subgrid.xs,
+            &subgrid.q2s,
+        ];
+
+        Self {
+            knots: axes.map(|axis| axis.to_owned().into_shared()),
+            log_knots: axes.map(|axis| axis.mapv(f64::ln).into_shared()),
+        }
+    }
+
+    /// Returns the knots of the nucleon numbers `A`, log-transformed if `log` is set.
+    pub fn nucleons(&self, log: bool) -> &ArcArray1<f64> {
+        self.axis(0, log)
+    }
+
+    /// Returns the knots of the `alpha_s` values, log-transformed if `log` is set.
+    pub fn alphas(&self, log: bool) -> &ArcArray1<f64> {
+        self.axis(1, log)
+    }
+
+    /// Returns the knots of the `kT` values, log-transformed if `log` is set.
+    pub fn kts(&self, log: bool) -> &ArcArray1<f64> {
+        self.axis(2, log)
+    }
+
+    /// Returns the knots of the momentum fraction `x`, log-transformed if `log` is set.
+    pub fn xs(&self, log: bool) -> &ArcArray1<f64> {
+        self.axis(3, log)
+    }
+
+    /// Returns the knots of the energy scale `Q2`, log-transformed if `log` is set.
+    pub fn q2s(&self, log: bool) -> &ArcArray1<f64> {
+        self.axis(4, log)
+    }
+
+    /// Returns the number of bytes held by the knots.
+    pub fn resident_bytes(&self) -> usize {
+        self.knots
+            .iter()
+            .chain(&self.log_knots)
+            .map(|axis| axis.len() * std::mem::size_of::<f64>())
+            .sum()
+    }
+
+    fn axis(&self, index: usize, log: bool) -> &ArcArray1<f64> {
+        if log {
+            &self.log_knots[index]
+        } else {
+            &self.knots[index]
+        }
+    }
+}
+
+/// The knots of an axis contributing to the interpolation of a coordinate and their weights.
+///
+/// This describes the interpolation methods of the 2D subgrids which are linear in the knot
+/// values, see [`AxisWeights::is_supported`]. The interpolated value of a point is then
+/// `sum_ab wx[a] * wq2[b] * f[ix - 1 + a][iq2 - 1 + b]`, where the weights along each axis
+/// only depend on the coordinate along that axis, and can thus be shared by all the points
+/// and grids with the same coordinate.
+#[derive(Debug, Clone, Copy, Default)]
+pub(crate) struct AxisWeights {
+    /// The index of the interval containing the coordinate.
+    pub index: usize,
+    /// The weights of the knots `index - 1` to `index + 2`.
+    pub weights: [f64; 4],
+}
+
+impl AxisWeights {
+    /// Returns whether the interpolation method is linear in the knot values.
+    pub(crate) fn is_supported(interp_type: &InterpolatorType) -> bool {
+        matches!(
+            interp_type,
+            InterpolatorType::LogBicubic
+                | InterpolatorType::LogBilinear
+                | InterpolatorType::Bilinear
+        )
+    }
+
+    /// Computes the interval of a coordinate along an axis and the weights of its knots.
+    ///
+    /// The coordinate is clamped into the range of the knots, as done by the interpolators.
+    ///
+    /// # Arguments
+    ///
+    /// * `interp_type` - The interpolation method, see [`AxisWeights::is_supported`].
+    /// * `knots` - The (transformed) knots of the axis.
+    /// * `value` - The (transformed) coordinate.
+    pub(crate) fn new(
+        interp_type: &InterpolatorType,
+        knots: &[f64],
+        value: f64,
+    ) -> Result<Self, InterpolateError> {
+        let value = value.clamp(knots[0], knots[knots.len() - 1]);
+        let index = utils::find_interval_index(knots, value)?;
+        let t = (value - knots[index]) / (knots[index + 1] - knots[index]);
+
+        let weights = match interp_type {
+            InterpolatorType::LogBicubic => LogBicubicInterpolation::knot_weights(knots, index, t),
+            _ => [0.0, 1.0 - t, t, 0.0],
+        };
+
+        Ok(Self { index, weights })
+    }
+
+    /// Returns the positions, among the knots `index - 1` to `index + 2`, of the knots that
+    /// exist on an axis with `nknots` knots.
+    pub(crate) fn knots(&self, nknots: usize) -> std::ops::Range<usize> {
+        usize::from(self.index == 0)..if self.index + 2 < nknots { 4 } else { 3 }
+    }
+}
+
+/// Kernel contracting the 4x4 stencil of knot values around a point with the weights of its
+/// axes, i.e. `sum_b wq2[b] * sum_a wx[a] * f[ix - 1 + a][iq2 - 1 + b]`.
+///
+/// The four knot values along `Q2` of each row of the stencil are contiguous in the grid, and
+/// are processed as one vector with the widest instructions available at runtime, see
+/// [`StencilKernel::detect`]. All the variants perform the same operations in the same order,
+/// without fused multiply-adds, such that their results are bit-identical.
+///
+/// The kernel contracts one point at a time, with the AVX (x86-64) or NEON (aarch64)
+/// instructions processing one row of four values, or two halves of it, per instruction.
+/// There are no AVX2 or AVX-512 variants contracting several points per vector: AVX2 does
+/// not widen the `f64` vectors of AVX, and the stencils of several points would have to be
+/// gathered from scattered rows to fill the eight lanes of AVX-512.
+///
+/// The knot values stored in single precision are widened to `f64` as they are loaded, which
+/// is exact, such that the contraction is accumulated in double precision as well.
+#[derive(Clone, Copy)]
+pub(crate) struct StencilKernel {
+    contract: fn(&[f64], usize, &[f64; 4], &[f64; 4]) -> f64,
+    contract_f32: fn(&[f32], usize, &[f64; 4], &[f64; 4]) -> f64,
+}
+
+impl StencilKernel {
+    /// Selects the widest variant of the kernel supported by the CPU.
+    pub(crate) fn detect() -> Self {
+        #[cfg(target_arch = "x86_64")]
+        {
+            if is_x86_feature_detected!("avx") {
+                return Self {
+                    contract: contract_avx,
+                    contract_f32: contract_avx_f32,
+                };
+            }
+            Self {
+                contract: contract_scalar,
+                contract_f32: contract_scalar,
+            }
+        }
+
+        #[cfg(target_arch = "aarch64")]
+        {
+            Self {
+                contract: contract_neon,
+                contract_f32: contract_neon_f32,
+            }
+        }
+
+        #[cfg(not(any(target_arch = "x86_64", target_arch = "aarch64")))]
+        {
+            Self {
+                contract: contract_scalar,
+                contract_f32: contract_scalar,
+            }
+        }
+    }
+
+    /// Interpolates the knot values of a 2D grid at the point described by its weights
+    /// along `x` and `Q2`.
+    ///
+    /// The stencils truncated by the boundaries of the grid are contracted with scalar code.
+    pub(crate) fn interpolate(
+        &self,
+        wx: &AxisWeights,
+        wq2: &AxisWeights,
+        knot_values: ArrayView2<f64>,
+    ) -> f64 {
+        contract_stencil(self.contract, wx, wq2, knot_values)
+    }
+
+    /// Interpolates the knot values of a 2D grid stored in single precision, see
+    /// [`StencilKernel::interpolate`].
+    pub(crate) fn interpolate_f32(
+        &self,
+        wx: &AxisWeights,
+        wq2: &AxisWeights,
+        knot_values: ArrayView2<f32>,
+    ) -> f64 {
+        contract_stencil(self.contract_f32, wx, wq2, knot_values)
+    }
+}
+
+/// Contracts the stencil of a point with `contract` if it lies in the interior of the grid,
+/// and with scalar code otherwise.
+///
+/// The stencil is read in place if the knot values are contiguous, and is gathered first if
+/// they are strided, i.e. for the interleaved 2D subgrids, see [`SubGrid::interleave`].
+#[inline(always)]
+fn contract_stencil<T: Copy + Into<f64>>(
+    contract: fn(&[T], usize, &[f64; 4], &[f64; 4]) -> f64,
+    wx: &AxisWeights,
+    wq2: &AxisWeights,
+    knot_values: ArrayView2<T>,
+) -> f64 {
+    let (nx, nq2) = knot_values.dim();
+    let interior = wx.knots(nx) == (0..4) && wq2.knots(nq2) == (0..4);
+
+    if interior {
+        if let Some(values) = knot_values.as_slice() {
+            let start = (wx.index - 1) * nq2 + wq2.index - 1;
+            return contract(&values[start..], nq2, &wx.weights, &wq2.weights);
+        }
+
+        let stencil =
+            knot_values.slice_move(s![wx.index - 1..wx.index + 3, wq2.index - 1..wq2.index + 3]);
+        let gathered: [T; 16] = std::array::from_fn(|k| stencil[[k / 4, k % 4]]);
+        return contract(&gathered, 4, &wx.weights, &wq2.weights);
+    }
+
+    let mut result = 0.0;
+    for a in wx.knots(nx) {
+        for b in wq2.knots(nq2) {
+            let value: f64 = knot_values[[wx.index + a - 1, wq2.index + b - 1]].into();
+            result += wx.weights[a] * wq2.weights[b] * value;
+        }
+    }
+    result
+}
+
+/// Interpolates the knot values of a 2D grid on a row of points sharing their coordinate
+/// along `x`, described by the weights `wx`, and whose weights along `Q2` are `wq2s`.
+///
+/// The four rows of knot values contributing along `x` are first summed once over the range
+/// of `Q2` knots used by the points, after which each point only contracts four of these
+/// partial sums. The rows are traversed sequentially, and the partial sums of a row are
+/// reused by all its points. In the interior of the grid the operations are the ones of the
+/// [`StencilKernel`], and the results agree with it up to rounding along the boundaries.
+///
+/// The roles of the axes are swapped by passing the transposed knot values, i.e. with shape
+/// `[Q2, x]`, together with the weights of a column along `Q2` and of the points along `x`.
+///
+/// # Arguments
+///
+/// * `knot_values` - The knot values of the grid, with shape `[x, Q2]`.
+/// * `wx` - The weights of the row along `x`.
+/// * `wq2s` - The weights of the points along `Q2`.
+/// * `partial` - A scratch buffer of at least four values. The points are evaluated in
+///   groups whose `Q2` knots fit in it, e.g. all at once if it holds as many values as
+///   `Q2` knots.
+/// * `out` - The values of the points, with the same length as `wq2s`.
+pub(crate) fn interpolate_row<T: Copy + Into<f64>>(
+    knot_values: ArrayView2<T>,
+    wx: &AxisWeights,
+    wq2s: &[AxisWeights],
+    partial: &mut [f64],
+    out: &mut [f64],
+) {
+    let (nx, nq2) = knot_values.dim();
+    let first = |w: &AxisWeights| w.index + w.knots(nq2).start - 1;
+    let last = |w: &AxisWeights| w.index + w.knots(nq2).end - 1;
+    let (Some(lo), Some(hi)) = (wq2s.iter().map(first).min(), wq2s.iter().map(last).max()) else {
+        return;
+    };
+
+    if hi - lo > partial.len() && wq2s.len() > 1 {
+        let mid = wq2s.len() / 2;
+        let (head, tail) = out.split_at_mut(mid);
+        interpolate_row(knot_values, wx, &wq2s[..mid], partial, head);
+        return interpolate_row(knot_values, wx, &wq2s[mid..], partial, tail);
+    }
+
+    let partial = &mut partial[..hi - lo];
+    partial.fill(0.0);
+    for a in wx.knots(nx) {
+        let w = wx.weights[a];
+        let row = knot_values.slice_move(s![wx.index + a - 1, lo..hi]);
+        for (p, &f) in partial.iter_mut().zip(row) {
+            *p += w * f.into();
+        }
+    }
+
+    for (value, wq2) in out.iter_mut().zip(wq2s) {
+        let mut result = 0.0;
+        for b in wq2.knots(nq2) {
+            result += partial[wq2.index + b - 1 - lo] * wq2.weights[b];
+        }
+        *value = result;
+    }
+}
+
+/// The knot values of all the flavors of a 2D subgrid stored with the flavors innermost,
+/// viewed with shape `[x, Q2, flavors]`.
+///
+/// In the standard layout `[A, alpha_s, flavors, kT, x, Q2]` of `SubGrid::grid` the knot
+/// values of each flavor are contiguous, such that evaluating all the flavors at a point
+/// gathers the 16 knots of the stencil once per flavor, from as many distant regions of the
+/// grid. The 2D subgrids are instead stored with the knots of all the flavors adjacent, see
+/// [`SubGrid::interleave`], and the stencil is gathered once for all of them. This type only
+/// borrows the knot values of the subgrid.
+pub(crate) struct InterleavedKnots<'a, T> {
+    values: &'a [T],
+    nx: usize,
+    nq2: usize,
+    num_flavors: usize,
+}
+
+impl<'a, T: Copy + Into<f64>> InterleavedKnots<'a, T> {
+    /// The maximal number of flavors of a subgrid evaluated at once.
+    pub(crate) const MAX_FLAVORS: usize = 32;
+
+    /// Views the knot values `grid` of a 2D subgrid, or returns `None` if they are not
+    /// stored with the flavors innermost or if the subgrid has too many flavors.
+    pub(crate) fn new(grid: &'a ArcArray<T, Ix6>) -> Option<Self> {
+        let &[1, 1, num_flavors, 1, nx, nq2] = grid.shape() else {
+            return None;
+        };
+        if num_flavors > Self::MAX_FLAVORS {
+            return None;
+        }
+        let knot_values = grid.slice(s![0, 0, .., 0, .., ..]).permuted_axes([1, 2, 0]);
+
+        Some(Self {
+            values: knot_values.to_slice()?,
+            nx,
+            nq2,
+            num_flavors,
+        })
+    }
+
+    /// Interpolates the flavors `pid_indices` at the point described by its weights along
+    /// `x` and `Q2`, see [`StencilKernel::interpolate`].
+    ///
+    /// The operations on each flavor are the ones of the scalar [`StencilKernel`], such that
+    /// the results are bit-identical to the ones of the flavors interpolated one by one.
+    ///
+    /// # Arguments
+    ///
+    /// * `wx` - The weights of the point along `x`.
+    /// * `wq2` - The weights of the point along `Q2`.
+    /// * `pid_indices` - The indices of the flavors.
+    /// * `out` - The values of the flavors, with the same length as `pid_indices`.
+    pub(crate) fn interpolate(
+        &self,
+        wx: &AxisWeights,
+        wq2: &AxisWeights,
+        pid_indices: &[usize],
+        out: &mut [f64],
+    ) {
+        let n = self.num_flavors;
+        let knots = |a: usize, b: usize| {
+            let start = ((wx.index + a - 1) * self.nq2 + wq2.index + b - 1) * n;
+            &self.values[start..start + n]
+        };
+
+        let mut results = [0.0; Self::MAX_FLAVORS];
+        let results = &mut results[..n];
+        let (x_knots, q2_knots) = (wx.knots(self.nx), wq2.knots(self.nq2));
+
+        if x_knots == (0..4) && q2_knots == (0..4) {
+            let mut partial = [[0.0; Self::MAX_FLAVORS]; 4];
+            for (a, &w) in wx.weights.iter().enumerate() {
+                for (b, row) in partial.iter_mut().enumerate() {
+                    for (p, &f) in row.iter_mut().zip(knots(a, b)) {
+                        *p += w * f.into();
+                    }
+                }
+            }
+            for (ipid, result) in results.iter_mut().enumerate() {
+                let rows = [
+                    partial[0][ipid],
+                    partial[1][ipid],
+                    partial[2][ipid],
+                    partial[3][ipid],
+                ];
+                *result = contract_rows(rows, &wq2.weights);
+            }
+        } else {
+            for a in x_knots {
+                for b in q2_knots.clone() {
+                    let w = wx.weights[a] * wq2.weights[b];
+                    for (result, &f) in results.iter_mut().zip(knots(a, b)) {
+                        *result += w * f.into();
+                    }
+                }
+            }
+        }
+
+        for (value, &pid_idx) in out.iter_mut().zip(pid_indices) {
+            *value = results[pid_idx];
+        }
+    }
+}
+
+/// Contracts the partial sums of the rows of a stencil with the weights along `Q2`.
+#[inline(always)]
+fn contract_rows(partial: [f64; 4], wq2: &[f64; 4]) -> f64 {
+    partial[0] * wq2[0] + partial[1] * wq2[1] + partial[2] * wq2[2] + partial[3] * wq2[3]
+}
+
+/// Scalar variant of the [`StencilKernel`], where the rows of the stencil start every
+/// `stride` values of `rows`.
+#[cfg_attr(target_arch = "aarch64", allow(dead_code))]
+fn contract_scalar<T: Copy + Into<f64>>(
+    rows: &[T],
+    stride: usize,
+    wx: &[f64; 4],
+    wq2: &[f64; 4],
+) -> f64 {
+    let mut partial = [0.0; 4];
+    for (a, &w) in wx.iter().enumerate() {
+        let row = &rows[a * stride..a * stride + 4];
+        for (p, &f) in partial.iter_mut().zip(row) {
+            *p += w * f.into();
+        }
+    }
+    contract_rows(partial, wq2)
+}
+
+/// AVX variant of the [`StencilKernel`], processing a row of the stencil per instruction.
+#[cfg(target_arch = "x86_64")]
+fn contract_avx(rows: &[f64], stride: usize, wx: &[f64; 4], wq2: &[f64; 4]) -> f64 {
+    // SAFETY: this variant is only selected by `StencilKernel::detect` if AVX is available.
+    unsafe { contract_avx_impl(rows, stride, wx, wq2) }
+}
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "avx")]
+unsafe fn contract_avx_impl(rows: &[f64], stride: usize, wx: &[f64; 4], wq2: &[f64; 4]) -> f64 {
+    use std::arch::x86_64::{
+        _mm256_add_pd, _mm256_loadu_pd, _mm256_mul_pd, _mm256_set1_pd, _mm256_setzero_pd,
+        _mm256_storeu_pd,
+    };
+
+    let mut partial = [0.0; 4];
+    unsafe {
+        let mut acc = _mm256_setzero_pd();
+        for (a, &w) in wx.iter().enumerate() {
+            let row = &rows[a * stride..a * stride + 4];
+            let product = _mm256_mul_pd(_mm256_set1_pd(w), _mm256_loadu_pd(row.as_ptr()));
+            acc = _mm256_add_pd(acc, product);
+        }
+        _mm256_storeu_pd(partial.as_mut_ptr(), acc);
+    }
+    contract_rows(partial, wq2)
+}
+
+/// AVX variant of the [`StencilKernel`] for knot values stored in single precision.
+#[cfg(target_arch = "x86_64")]
+fn contract_avx_f32(rows: &[f32], stride: usize, wx: &[f64; 4], wq2: &[f64; 4]) -> f64 {
+    // SAFETY: this variant is only selected by `StencilKernel::detect` if AVX is available.
+    unsafe { contract_avx_f32_impl(rows, stride, wx, wq2) }
+}
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "avx")]
+unsafe fn contract_avx_f32_impl(rows: &[f32], stride: usize, wx: &[f64; 4], wq2: &[f64; 4]) -> f64 {
+    use std::arch::x86_64::{
+        _mm256_add_pd, _mm256_cvtps_pd, _mm256_mul_pd, _mm256_set1_pd, _mm256_setzero_pd,
+        _mm256_storeu_pd, _mm_loadu_ps,
+    };
+
+    let mut partial = [0.0; 4];
+    unsafe {
+        let mut acc = _mm256_setzero_pd();
+        for (a, &w) in wx.iter().enumerate() {
+            let row = &rows[a * stride..a * stride + 4];
+            let values = _mm256_cvtps_pd(_mm_loadu_ps(row.as_ptr()));
+            acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_set1_pd(w), values));
+        }
+        _mm256_storeu_pd(partial.as_mut_ptr(), acc);
+    }
+    contract_rows(partial, wq2)
+}
+
+/// NEON variant of the [`StencilKernel`], processing a row of the stencil per two
+/// instructions.
+#[cfg(target_arch = "aarch64")]
+fn contract_neon(rows: &[f64], stride: usize, wx: &[f64; 4], wq2: &[f64; 4]) -> f64 {
+    use std::arch::aarch64::{vaddq_f64, vdupq_n_f64, vld1q_f64, vmulq_f64, vst1q_f64};
+
+    let mut partial = [0.0; 4];
+    // SAFETY: NEON is part of the baseline of the `aarch64` targets, and the slices of the
+    // rows and of the partial sums hold four values each.
+    unsafe {
+        let (mut low, mut high) = (vdupq_n_f64(0.0), vdupq_n_f64(0.0));
+        for (a, &w) in wx.iter().enumerate() {
+            let row = &rows[a * stride..a * stride + 4];
+            let w = vdupq_n_f64(w);
+            low = vaddq_f64(low, vmulq_f64(w, vld1q_f64(row.as_ptr())));
+            high = vaddq_f64(high, vmulq_f64(w, vld1q_f64(row[2..].as_ptr())));
+        }
+        vst1q_f64(partial.as_mut_ptr(), low);
+        vst1q_f64(partial[2..].as_mut_ptr(), high);
+    }
+    contract_rows(partial, wq2)
+}
+
+/// NEON variant of the [`StencilKernel`] for knot values stored in single precision.
+#[cfg(target_arch = "aarch64")]
+fn contract_neon_f32(rows: &[f32], stride: usize, wx: &[f64; 4], wq2: &[f64; 4]) -> f64 {
+    use std::arch::aarch64::{
+        vaddq_f64, vcvt_f64_f32, vdupq_n_f64, vld1_f32, vmulq_f64, vst1q_f64,
+    };
+
+    let mut partial = [0.0; 4];
+    // SAFETY: NEON is part of the baseline of the `aarch64` targets, and the slices of the
+    // rows and of the partial sums hold four values each.
+    unsafe {
+        let (mut low, mut high) = (vdupq_n_f64(0.0), vdupq_n_f64(0.0));
+        for (a, &w) in wx.iter().enumerate() {
+            let row = &rows[a * stride..a * stride + 4];
+            let w = vdupq_n_f64(w);
+            low = vaddq_f64(low, vmulq_f64(w, vcvt_f64_f32(vld1_f32(row.as_ptr()))));
+            high = vaddq_f64(
+                high,
+                vmulq_f64(w, vcvt_f64_f32(vld1_f32(row[2..].as_ptr()))),
+            );
+        }
+        vst1q_f64(partial.as_mut_ptr(), low);
+        vst1q_f64(partial[2..].as_mut_ptr(), high);
+    }
+    contract_rows(partial, wq2)
+}
+
+/// Interpolator of a flavor of a 2D subgrid whose knot values are stored in single precision.
+///
+/// The interpolation methods which are linear in the knot values, see
+/// [`AxisWeights::is_supported`], are expressed as the contraction of the stencil of the
+/// point with the weights of its axes. The weights are computed and the contraction is
+/// accumulated in double precision, such that the results only differ from the ones of the
+/// double-precision interpolators by the rounding of the knot values.
+pub struct SinglePrecisionInterpolator {
+    interp_type: InterpolatorType,
+    xs: ArcArray1<f64>,
+    q2s: ArcArray1<f64>,
+    values: ArcArray<f32, Ix2>,
+    kernel: StencilKernel,
+}
+
+impl SinglePrecisionInterpolator {
+    /// Creates the interpolator from the (transformed) knots of the axes and the knot values.
+    ///
+    /// # Panics
+    ///
+    /// Panics if the interpolation method is not supported or if the shapes are inconsistent.
+    pub fn new(
+        interp_type: InterpolatorType,
+        xs: ArcArray1<f64>,
+        q2s: ArcArray1<f64>,
+        values: ArcArray<f32, Ix2>,
+    ) -> Self {
+        assert!(
+            AxisWeights::is_supported(&interp_type),
+            "Unsupported single-precision interpolator: {interp_type:?}"
+        );
+        assert_eq!(
+            values.dim(),
+            (xs.len(), q2s.len()),
+            "Inconsistent grid shape"
+        );
+
+        Self {
+            interp_type,
+            xs,
+            q2s,
+            values,
+            kernel: StencilKernel::detect(),
+        }
+    }
+}
+
+impl SinglePrecisionInterpolator {
+    /// Interpolates a point `(x, Q2)` whose coordinates are already transformed.
+    #[inline]
+    pub fn interpolate(&self, [x, q2]: [f64; 2]) -> Result<f64, InterpolateError> {
+        let weights = |knots: &ArcArray1<f64>, value| {
+            let knots = knots.as_slice().expect("Non-contiguous knots");
+            AxisWeights::new(&self.interp_type, knots, value)
+        };
+        let (wx, wq2) = (weights(&self.xs, x)?, weights(&self.q2s, q2)?);
+
+        Ok(self.kernel.interpolate_f32(&wx, &wq2, self.values.view()))
+    }
+}
+
+impl DynInterpolator for SinglePrecisionInterpolator {
+    fn interpolate_point(&self, point: &[f64]) -> Result<f64, InterpolateError> {
+        self.interpolate(point_2d(point)?)
+    }
+}
+
 /// An enum to dispatch batch interpolation to the correct Chebyshev interpolator.
+///
+/// Like the [`FlavorInterpolator`]s, the batch interpolators share the knot values with the
+/// subgrid and the knots with its [`SubgridAxes`].
 pub enum BatchInterpolator {
-    Chebyshev2D(
-        LogChebyshevBatchInterpolation<2>,
-        InterpData2D<OwnedRepr<f64>>,
-    ),
-    Chebyshev3D(
-        LogChebyshevBatchInterpolation<3>,
-        InterpData3D<OwnedRepr<f64>>,
-    ),
+    Chebyshev2D(LogChebyshevBatchInterpolation<2>, InterpData2D<Shared>),
+    Chebyshev3D(LogChebyshevBatchInterpolation<3>, InterpData3D<Shared>),
+}
+
+/// The log-transformed points of the batches of [`BatchInterpolator::interpolate_log`],
+/// whose buffers are reused from one batch to the next.
+#[derive(Default)]
+pub struct BatchPoints {
+    points_2d: Vec<[f64; 2]>,
+    points_3d: Vec<[f64; 3]>,
 }
 
 impl BatchInterpolator {
@@ -148,85 +1047,215 @@ impl BatchInterpolator {
             }
         }
     }
+
+    /// Interpolates a batch of points whose coordinates are not log-transformed yet, the
+    /// transformed points being stored into `buffers`.
+    ///
+    /// # Panics
+    ///
+    /// Panics if a point does not have the dimension of the interpolator.
+    pub fn interpolate_log<'a>(
+        &self,
+        points: impl Iterator<Item = &'a [f64]>,
+        buffers: &mut BatchPoints,
+    ) -> Result<Vec<f64>, InterpolateError> {
+        match self {
+            BatchInterpolator::Chebyshev2D(strategy, data) => {
+                buffers.points_2d.clear();
+                buffers.points_2d.extend(points.map(|p| {
+                    let p: [f64; 2] = p.try_into().expect("Invalid point dimension for 2D");
+                    p.map(f64::ln)
+                }));
+                strategy.interpolate(data, &buffers.points_2d)
+            }
+            BatchInterpolator::Chebyshev3D(strategy, data) => {
+                buffers.points_3d.clear();
+                buffers.points_3d.extend(points.map(|p| {
+                    let p: [f64; 3] = p.try_into().expect("Invalid point dimension for 3D");
+                    p.map(f64::ln)
+                }));
+                strategy.interpolate(data, &buffers.points_3d)
+            }
+        }
+    }
 }
 
-/// Factory for creating dynamic interpolators based on interpolation type and grid dimensions.
+/// Factory for creating interpolators based on interpolation type and grid dimensions.
+///
+/// The interpolators do not own their data: the knot values are slices of the
+/// reference-counted `SubGrid::grid`, and the knots are taken from the [`SubgridAxes`] of the
+/// subgrid, such that all the flavors of a subgrid share the same buffers.
 pub struct InterpolatorFactory;
 
 impl InterpolatorFactory {
+    /// Creates the interpolator of a flavor of a subgrid.
+    ///
+    /// The knots of the subgrid are transformed for this interpolator only, see
+    /// [`InterpolatorFactory::create_with_axes`] to share them between several flavors.
     pub fn create(
         interp_type: InterpolatorType,
         subgrid: &SubGrid,
         pid_index: usize,
-    ) -> Box<dyn DynInterpolator> {
+    ) -> FlavorInterpolator {
+        Self::create_with_axes(interp_type, subgrid, &SubgridAxes::new(subgrid), pid_index)
+    }
+
+    /// Creates the interpolator of a flavor of a subgrid from the shared knots of its axes.
+    pub fn create_with_axes(
+        interp_type: InterpolatorType,
+        subgrid: &SubGrid,
+        axes: &SubgridAxes,
+        pid_index: usize,
+    ) -> FlavorInterpolator {
+        Self::create_with_options(
+            interp_type,
+            subgrid,
+            axes,
+            pid_index,
+            LoadOptions::default(),
+        )
+    }
+
+    /// Creates the interpolator of a flavor of a subgrid from the shared knots of its axes,
+    /// with the strategy refined by the [`LoadOptions`].
+    pub fn create_with_options(
+        interp_type: InterpolatorType,
+        subgrid: &SubGrid,
+        axes: &SubgridAxes,
+        pid_index: usize,
+        options: LoadOptions,
+    ) -> FlavorInterpolator {
+        // Slicing the shared grid only creates a new handle to its data.
+        let grid = subgrid.grid.clone();
+
         match subgrid.interpolation_config() {
-            InterpolationConfig::TwoD => Self::interpolator_xfxq2(interp_type, subgrid, pid_index),
+            InterpolationConfig::TwoD => {
+                if let Some(grid) = subgrid.grid_f32.clone() {
+                    let values = grid.slice_move(s![0, 0, pid_index, 0, .., ..]);
+                    let log = !matches!(interp_type, InterpolatorType::Bilinear);
+                    let (xs, q2s) = (axes.xs(log).clone(), axes.q2s(log).clone());
+                    return FlavorInterpolator::SinglePrecision(SinglePrecisionInterpolator::new(
+                        interp_type,
+                        xs,
+                        q2s,
+                        values,
+                    ));
+                }
+                let values = grid.slice_move(s![0, 0, pid_index, 0, .., ..]);
+                Self::interpolator_xfxq2(interp_type, axes, values, options)
+            }
             InterpolationConfig::ThreeDNucleons => {
-                Self::interpolator_xfxq2_nucleons(interp_type, subgrid, pid_index)
+                let values = grid.slice_move(s![.., 0, pid_index, 0, .., ..]);
+                Self::interpolator_3d(interp_type, axes.nucleons(true), axes, values)
             }
             InterpolationConfig::ThreeDAlphas => {
-                Self::interpolator_xfxq2_alphas(interp_type, subgrid, pid_index)
+                let values = grid.slice_move(s![0, .., pid_index, 0, .., ..]);
+                Self::interpolator_3d(interp_type, axes.alphas(true), axes, values)
             }
             InterpolationConfig::ThreeDKt => {
-                Self::interpolator_xfxq2_kts(interp_type, subgrid, pid_index)
+                let values = grid.slice_move(s![0, 0, pid_index, .., .., ..]);
+                Self::interpolator_3d(interp_type, axes.kts(true), axes, values)
             }
             InterpolationConfig::FourDNucleonsAlphas => {
-                Self::interpolator_xfxq2_nucleons_alphas(interp_type, subgrid, pid_index)
+                let values = grid.slice_move(s![.., .., pid_index, 0, .., ..]);
+                let coords = vec![
+                    axes.nucleons(false).clone(),
+                    axes.alphas(false).clone(),
+                    axes.xs(false).clone(),
+                    axes.q2s(false).clone(),
+                ];
+                Self::interpolator_nd(interp_type, coords, values.into_dyn())
             }
             InterpolationConfig::FourDNucleonsKt => {
-                Self::interpolator_xfxq2_nucleons_kts(interp_type, subgrid, pid_index)
+                let values = grid.slice_move(s![.., 0, pid_index, .., .., ..]);
+                let coords = vec![
+                    axes.nucleons(true).clone(),
+                    axes.kts(true).clone(),
+                    axes.xs(true).clone(),
+                    axes.q2s(true).clone(),
+                ];
+                Self::interpolator_nd(interp_type, coords, values.into_dyn())
             }
             InterpolationConfig::FourDAlphasKt => {
-                Self::interpolator_xfxq2_alphas_kts(interp_type, subgrid, pid_index)
+                let values = grid.slice_move(s![0, .., pid_index, .., .., ..]);
+                let coords = vec![
+                    axes.alphas(true).clone(),
+                    axes.kts(true).clone(),
+                    axes.xs(true).clone(),
+                    axes.q2s(true).clone(),
+                ];
+                Self::interpolator_nd(interp_type, coords, values.into_dyn())
             }
             InterpolationConfig::FiveD => {
-                Self::interpolator_xfxq2_5dim(interp_type, subgrid, pid_index)
+                let values = grid.slice_move(s![.., .., pid_index, .., .., ..]);
+                let coords = vec![
+                    axes.nucleons(true).clone(),
+                    axes.alphas(true).clone(),
+                    axes.kts(true).clone(),
+                    axes.xs(true).clone(),
+                    axes.q2s(true).clone(),
+                ];
+                Self::interpolator_nd(interp_type, coords, values.into_dyn())
             }
         }
     }
 
     fn interpolator_xfxq2(
         interp_type: InterpolatorType,
-        subgrid: &SubGrid,
-        pid_index: usize,
-    ) -> Box<dyn DynInterpolator> {
-        let grid_slice = subgrid.grid_slice(pid_index).to_owned();
+        axes: &SubgridAxes,
+        grid_slice: ArcArray<f64, Ix2>,
+        options: LoadOptions,
+    ) -> FlavorInterpolator {
+        let log = !matches!(interp_type, InterpolatorType::Bilinear);
+        let (xs, q2s) = (axes.xs(log).clone(), axes.q2s(log).clone());
 
         match interp_type {
-            InterpolatorType::Bilinear => Box::new(
+            InterpolatorType::LogBicubic if options.precompute_coeffs => {
+                FlavorInterpolator::LogBicubicTable(
+                    Interp2D::new(
+                        xs,
+                        q2s,
+                        grid_slice,
+                        LogBicubicTableInterpolation::default(),
+                        Extrapolate::Clamp,
+                    )
+                    .expect("Failed to create 2D interpolator"),
+                )
+            }
+            InterpolatorType::Bilinear => FlavorInterpolator::Bilinear(
                 Interp2D::new(
-                    subgrid.xs.to_owned(),
-                    subgrid.q2s.to_owned(),
+                    xs,
+                    q2s,
                     grid_slice,
                     BilinearInterpolation,
                     Extrapolate::Clamp,
                 )
                 .expect("Failed to create 2D interpolator"),
             ),
-            InterpolatorType::LogBilinear => Box::new(
+            InterpolatorType::LogBilinear => FlavorInterpolator::LogBilinear(
                 Interp2D::new(
-                    subgrid.xs.mapv(f64::ln),
-                    subgrid.q2s.mapv(f64::ln),
+                    xs,
+                    q2s,
                     grid_slice,
                     LogBilinearInterpolation,
                     Extrapolate::Clamp,
                 )
                 .expect("Failed to create 2D interpolator"),
             ),
-            InterpolatorType::LogBicubic => Box::new(
+            InterpolatorType::LogBicubic => FlavorInterpolator::LogBicubic(
                 Interp2D::new(
-                    subgrid.xs.mapv(f64::ln),
-                    subgrid.q2s.mapv(f64::ln),
+                    xs,
+                    q2s,
                     grid_slice,
                     LogBicubicInterpolation::default(),
                     Extrapolate::Clamp,
                 )
                 .expect("Failed to create 2D interpolator"),
             ),
-            InterpolatorType::LogChebyshev => Box::new(
+            InterpolatorType::LogChebyshev => FlavorInterpolator::LogChebyshev2D(
                 Interp2D::new(
-                    subgrid.xs.mapv(f64::ln),
-                    subgrid.q2s.mapv(f64::ln),
+                    xs,
+                    q2s,
                     grid_slice,
                     LogChebyshevInterpolation::<2>::default(),
                     Extrapolate::Clamp,
@@ -237,117 +1266,38 @@ impl InterpolatorFactory {
         }
     }
 
-    fn interpolator_xfxq2_nucleons(
-        interp_type: InterpolatorType,
-        subgrid: &SubGrid,
-        pid_index: usize,
-    ) -> Box<dyn DynInterpolator> {
-        let grid_data = subgrid
-            .grid
-            .slice(s![.., 0, pid_index, 0, .., ..])
-            .to_owned();
-        let reshaped_data = grid_data
-            .into_shape_with_order((subgrid.nucleons.len(), subgrid.xs.len(), subgrid.q2s.len()))
-            .expect("Failed to reshape 3D data");
-
-        match interp_type {
-            InterpolatorType::LogTricubic => Box::new(
-                Interp3D::new(
-                    subgrid.nucleons.mapv(f64::ln),
-                    subgrid.xs.mapv(f64::ln),
-                    subgrid.q2s.mapv(f64::ln),
-                    reshaped_data,
-                    LogTricubicInterpolation,
-                    Extrapolate::Clamp,
-                )
-                .expect("Failed to create 3D interpolator"),
-            ),
-            InterpolatorType::LogChebyshev => Box::new(
-                Interp3D::new(
-                    subgrid.nucleons.mapv(f64::ln),
-                    subgrid.xs.mapv(f64::ln),
-                    subgrid.q2s.mapv(f64::ln),
-                    reshaped_data,
-                    LogChebyshevInterpolation::<3>::default(),
-                    Extrapolate::Clamp,
-                )
-                .expect("Failed to create 3D interpolator"),
-            ),
-            _ => panic!("Unsupported 3D interpolator: {:?}", interp_type),
-        }
-    }
-
-    fn interpolator_xfxq2_alphas(
-        interp_type: InterpolatorType,
-        subgrid: &SubGrid,
-        pid_index: usize,
-    ) -> Box<dyn DynInterpolator> {
-        let grid_data = subgrid
-            .grid
-            .slice(s![0, .., pid_index, 0, .., ..])
-            .to_owned();
-        let reshaped_data = grid_data
-            .into_shape_with_order((subgrid.alphas.len(), subgrid.xs.len(), subgrid.q2s.len()))
-            .expect("Failed to reshape 3D data");
-
-        match interp_type {
-            InterpolatorType::LogTricubic => Box::new(
-                Interp3D::new(
-                    subgrid.alphas.mapv(f64::ln),
-                    subgrid.xs.mapv(f64::ln),
-                    subgrid.q2s.mapv(f64::ln),
-                    reshaped_data,
-                    LogTricubicInterpolation,
-                    Extrapolate::Clamp,
-                )
-                .expect("Failed to create 3D interpolator"),
-            ),
-            InterpolatorType::LogChebyshev => Box::new(
-                Interp3D::new(
-                    subgrid.alphas.mapv(f64::ln),
-                    subgrid.xs.mapv(f64::ln),
-                    subgrid.q2s.mapv(f64::ln),
-                    reshaped_data,
-                    LogChebyshevInterpolation::<3>::default(),
-                    Extrapolate::Clamp,
-                )
-                .expect("Failed to create 3D interpolator"),
-            ),
-            _ => panic!("Unsupported 3D interpolator: {:?}", interp_type),
-        }
-    }
-
-    fn interpolator_xfxq2_kts(
+    /// Creates a 3D interpolator over `(z, x, Q2)`, where `z` is the extra dimension of the
+    /// subgrid and the axes are log-transformed.
+    fn interpolator_3d(
         interp_type: InterpolatorType,
-        subgrid: &SubGrid,
-        pid_index: usize,
-    ) -> Box<dyn DynInterpolator> {
-        let grid_data = subgrid
-            .grid
-            .slice(s![0, 0, pid_index, .., .., ..])
-            .to_owned();
-        let reshaped_data = grid_data
-            .into_shape_with_order((subgrid.kts.len(), subgrid.xs.len(), subgrid.q2s.len()))
-            .expect("Failed to reshape 3D data");
+        z_knots: &ArcArray1<f64>,
+        axes: &SubgridAxes,
+        values: ArcArray<f64, Ix3>,
+    ) -> FlavorInterpolator {
+        let (zs, xs, q2s) = (
+            z_knots.clone(),
+            axes.xs(true).clone(),
+            axes.q2s(true).clone(),
+        );
 
         match interp_type {
-            InterpolatorType::LogTricubic => Box::new(
+            InterpolatorType::LogTricubic => FlavorInterpolator::LogTricubic(
                 Interp3D::new(
-                    subgrid.kts.mapv(f64::ln),
-                    subgrid.xs.mapv(f64::ln),
-                    subgrid.q2s.mapv(f64::ln),
-                    reshaped_data,
+                    zs,
+                    xs,
+                    q2s,
+                    values,
                     LogTricubicInterpolation,
                     Extrapolate::Clamp,
                 )
                 .expect("Failed to create 3D interpolator"),
             ),
-            InterpolatorType::LogChebyshev => Box::new(
+            InterpolatorType::LogChebyshev => FlavorInterpolator::LogChebyshev3D(
                 Interp3D::new(
-                    subgrid.kts.mapv(f64::ln),
-                    subgrid.xs.mapv(f64::ln),
-                    subgrid.q2s.mapv(f64::ln),
-                    reshaped_data,
+                    zs,
+                    xs,
+                    q2s,
+                    values,
                     LogChebyshevInterpolation::<3>::default(),
                     Extrapolate::Clamp,
                 )
@@ -357,226 +1307,81 @@ impl InterpolatorFactory {
         }
     }
 
-    fn interpolator_xfxq2_nucleons_alphas(
+    /// Creates a 4D or 5D interpolator from the knots of its axes.
+    fn interpolator_nd(
         interp_type: InterpolatorType,
-        subgrid: &SubGrid,
-        pid_index: usize,
-    ) -> Box<dyn DynInterpolator> {
-        let grid_data = subgrid
-            .grid
-            .slice(s![.., .., pid_index, 0, .., ..])
-            .to_owned();
-        let coords = vec![
-            subgrid.nucleons.to_owned(),
-            subgrid.alphas.to_owned(),
-            subgrid.xs.to_owned(),
-            subgrid.q2s.to_owned(),
-        ];
-        let reshaped_data = grid_data
-            .into_shape_with_order((
-                subgrid.nucleons.len(),
-                subgrid.alphas.len(),
-                subgrid.xs.len(),
-                subgrid.q2s.len(),
-            ))
-            .expect("Failed to reshape 4D data");
+        coords: Vec<ArcArray1<f64>>,
+        values: ArcArray<f64, IxDyn>,
+    ) -> FlavorInterpolator {
+        let ndims = coords.len();
 
         match interp_type {
-            InterpolatorType::InterpNDLinear => Box::new(
-                InterpND::new(coords, reshaped_data.into_dyn(), Linear, Extrapolate::Clamp)
-                    .expect("Failed to create 4D interpolator"),
+            InterpolatorType::InterpNDLinear => FlavorInterpolator::LinearND(
+                InterpND::new(coords, values, Linear, Extrapolate::Clamp)
+                    .unwrap_or_else(|_| panic!("Failed to create {ndims}D interpolator")),
             ),
-            _ => panic!("Unsupported 4D interpolator: {:?}", interp_type),
+            _ => panic!("Unsupported {ndims}D interpolator: {:?}", interp_type),
         }
     }
 
-    fn interpolator_xfxq2_nucleons_kts(
-        interp_type: InterpolatorType,
-        subgrid: &SubGrid,
-        pid_index: usize,
-    ) -> Box<dyn DynInterpolator> {
-        let grid_data = subgrid
-            .grid
-            .slice(s![.., 0, pid_index, .., .., ..])
-            .to_owned();
-        let coords = vec![
-            subgrid.nucleons.mapv(f64::ln),
-            subgrid.kts.mapv(f64::ln),
-            subgrid.xs.mapv(f64::ln),
-            subgrid.q2s.mapv(f64::ln),
-        ];
-        let reshaped_data = grid_data
-            .into_shape_with_order((
-                subgrid.nucleons.len(),
-                subgrid.kts.len(),
-                subgrid.xs.len(),
-                subgrid.q2s.len(),
-            ))
-            .expect("Failed to reshape 4D data");
-
-        match interp_type {
-            InterpolatorType::InterpNDLinear => Box::new(
-                InterpND::new(coords, reshaped_data.into_dyn(), Linear, Extrapolate::Clamp)
-                    .expect("Failed to create 4D interpolator"),
-            ),
-            _ => panic!("Unsupported 4D interpolator: {:?}", interp_type),
-        }
-    }
-
-    fn interpolator_xfxq2_alphas_kts(
-        interp_type: InterpolatorType,
-        subgrid: &SubGrid,
-        pid_index: usize,
-    ) -> Box<dyn DynInterpolator> {
-        let grid_data = subgrid
-            .grid
-            .slice(s![0, .., pid_index, .., .., ..])
-            .to_owned();
-        let coords = vec![
-            subgrid.alphas.mapv(f64::ln),
-            subgrid.kts.mapv(f64::ln),
-            subgrid.xs.mapv(f64::ln),
-            subgrid.q2s.mapv(f64::ln),
-        ];
-        let reshaped_data = grid_data
-            .into_shape_with_order((
-                subgrid.alphas.len(),
-                subgrid.kts.len(),
-                subgrid.xs.len(),
-                subgrid.q2s.len(),
-            ))
-            .expect("Failed to reshape 4D data");
-
-        match interp_type {
-            InterpolatorType::InterpNDLinear => Box::new(
-                InterpND::new(coords, reshaped_data.into_dyn(), Linear, Extrapolate::Clamp)
-                    .expect("Failed to create 4D interpolator"),
-            ),
-            _ => panic!("Unsupported 4D interpolator: {:?}", interp_type),
-        }
-    }
-
-    fn interpolator_xfxq2_5dim(
-        interp_type: InterpolatorType,
+    /// Creates the batch interpolator of a flavor of a `LogChebyshev` subgrid.
+    ///
+    /// The knots of the subgrid are transformed for this interpolator only, see
+    /// [`InterpolatorFactory::create_batch_with_axes`] to share them between several flavors.
+    pub fn create_batch_interpolator(
         subgrid: &SubGrid,
-        pid_index: usize,
-    ) -> Box<dyn DynInterpolator> {
-        let grid_data = subgrid
-            .grid
-            .slice(s![.., .., pid_index, .., .., ..])
-            .to_owned();
-        let coords = vec![
-            subgrid.nucleons.mapv(f64::ln),
-            subgrid.alphas.mapv(f64::ln),
-            subgrid.kts.mapv(f64::ln),
-            subgrid.xs.mapv(f64::ln),
-            subgrid.q2s.mapv(f64::ln),
-        ];
-        let reshaped_data = grid_data
-            .into_shape_with_order((
-                subgrid.nucleons.len(),
-                subgrid.alphas.len(),
-                subgrid.kts.len(),
-                subgrid.xs.len(),
-                subgrid.q2s.len(),
-            ))
-            .expect("Failed to reshape 5D data");
-
-        match interp_type {
-            InterpolatorType::InterpNDLinear => Box::new(
-                InterpND::new(coords, reshaped_data.into_dyn(), Linear, Extrapolate::Clamp)
-                    .expect("Failed to create 5D interpolator"),
-            ),
-            _ => panic!("Unsupported 5D interpolator: {:?}", interp_type),
-        }
+        pid_idx: usize,
+    ) -> Result<BatchInterpolator, String> {
+        Self::create_batch_with_axes(subgrid, &SubgridAxes::new(subgrid), pid_idx)
     }
 
-    pub fn create_batch_interpolator(
+    /// Creates the batch interpolator of a flavor of a `LogChebyshev` subgrid from the shared
+    /// knots of its axes, sharing the knot values with the subgrid.
+    pub fn create_batch_with_axes(
         subgrid: &SubGrid,
+        axes: &SubgridAxes,
         pid_idx: usize,
     ) -> Result<BatchInterpolator, String> {
-        match subgrid.interpolation_config() {
+        let (xs, q2s) = (axes.xs(true).clone(), axes.q2s(true).clone());
+
+        let (zs, values) = match subgrid.interpolation_config() {
             InterpolationConfig::TwoD => {
+                let values = shared_slice(subgrid, s![0, 0, pid_idx, 0, .., ..]);
                 let mut strategy = LogChebyshevBatchInterpolation::<2>::default();
-                let grid_slice = subgrid.grid_slice(pid_idx).to_owned();
-
-                let data = InterpData2D::new(
-                    subgrid.xs.mapv(f64::ln),
-                    subgrid.q2s.mapv(f64::ln),
-                    grid_slice,
-                )
-                .map_err(|e| e.to_string())?;
+                let data = InterpData2D::new(xs, q2s, values).map_err(|e| e.to_string())?;
                 strategy.init(&data).map_err(|e| e.to_string())?;
 
-                Ok(BatchInterpolator::Chebyshev2D(strategy, data))
+                return Ok(BatchInterpolator::Chebyshev2D(strategy, data));
             }
-            InterpolationConfig::ThreeDNucleons => {
-                let mut strategy = LogChebyshevBatchInterpolation::<3>::default();
-                let grid_data = subgrid.grid.slice(s![.., 0, pid_idx, 0, .., ..]).to_owned();
-
-                let reshaped_data = grid_data
-                    .into_shape_with_order((
-                        subgrid.nucleons.len(),
-                        subgrid.xs.len(),
-                        subgrid.q2s.len(),
-                    ))
-                    .expect("Failed to reshape 3D data");
-
-                let data = InterpData3D::new(
-                    subgrid.nucleons.mapv(f64::ln),
-                    subgrid.xs.mapv(f64::ln),
-                    subgrid.q2s.mapv(f64::ln),
-                    reshaped_data,
-                )
-                .map_err(|e| e.to_string())?;
-                strategy.init(&data).map_err(|e| e.to_string())?;
+            InterpolationConfig::ThreeDNucleons => (
+                axes.nucleons(true),
+                shared_slice(subgrid, s![.., 0, pid_idx, 0, .., ..]),
+            ),
+            InterpolationConfig::ThreeDAlphas => (
+                axes.alphas(true),
+                shared_slice(subgrid, s![0, .., pid_idx, 0, .., ..]),
+            ),
+            InterpolationConfig::ThreeDKt => (
+                axes.kts(true),
+                shared_slice(subgrid, s![0, 0, pid_idx, .., .., ..]),
+            ),
+            _ => return Err("Unsupported dimension for batch interpolation".to_string()),
+        };
 
-                Ok(BatchInterpolator::Chebyshev3D(strategy, data))
-            }
-            InterpolationConfig::ThreeDAlphas => {
-                let mut strategy = LogChebyshevBatchInterpolation::<3>::default();
-                let grid_data = subgrid.grid.slice(s![0, .., pid_idx, 0, .., ..]).to_owned();
-
-                let reshaped_data = grid_data
-                    .into_shape_with_order((
-                        subgrid.alphas.len(),
-                        subgrid.xs.len(),
-                        subgrid.q2s.len(),
-                    ))
-                    .expect("Failed to reshape 3D data");
-
-                let data = InterpData3D::new(
-                    subgrid.alphas.mapv(f64::ln),
-                    subgrid.xs.mapv(f64::ln),
-                    subgrid.q2s.mapv(f64::ln),
-                    reshaped_data,
-                )
-                .map_err(|e| e.to_string())?;
-                strategy.init(&data).map_err(|e| e.to_string())?;
+        let mut strategy = LogChebyshevBatchInterpolation::<3>::default();
+        let data = InterpData3D::new(zs.clone(), xs, q2s, values).map_err(|e| e.to_string())?;
+        strategy.init(&data).map_err(|e| e.to_string())?;
 
-                Ok(BatchInterpolator::Chebyshev3D(strategy, data))
-            }
-            InterpolationConfig::ThreeDKt => {
-                let mut strategy = LogChebyshevBatchInterpolation::<3>::default();
-                let grid_data = subgrid.grid.slice(s![0, 0, pid_idx, .., .., ..]).to_owned();
-
-                let reshaped_data = grid_data
-                    .into_shape_with_order((subgrid.kts.len(), subgrid.xs.len(), subgrid.q2s.len()))
-                    .expect("Failed to reshape 3D data");
-
-                let data = InterpData3D::new(
-                    subgrid.kts.mapv(f64::ln),
-                    subgrid.xs.mapv(f64::ln),
-                    subgrid.q2s.mapv(f64::ln),
-                    reshaped_data,
-                )
-                .map_err(|e| e.to_string())?;
-                strategy.init(&data).map_err(|e| e.to_string())?;
+        Ok(BatchInterpolator::Chebyshev3D(strategy, data))
+    }
+}
 
-                Ok(BatchInterpolator::Chebyshev3D(strategy, data))
-            }
-            _ => Err("Unsupported dimension for batch interpolation".to_string()),
-        }
+/// Slices the knot values of a subgrid in double precision, sharing them with the subgrid
+/// unless they are stored in single precision, in which case the slice is converted.
+fn shared_slice<I: SliceArg<Ix6>>(subgrid: &SubGrid, info: I) -> ArcArray<f64, I::OutDim> {
+    match &subgrid.grid_f32 {
+        Some(grid) => grid.slice(info).mapv(f64::from).into_shared(),
+        None => subgrid.grid.clone().slice_move(info),
     }
 }
 
@@ -714,6 +1519,100 @@ mod tests {
         assert!((result - 8.5).abs() < MAXDIFF);
     }
 
+    #[test]
+    fn test_stencil_kernel() {
+        let xs: Vec<f64> = (0..6).map(|i| (f64::from(i) * 0.7 - 5.0).exp()).collect();
+        let q2s: Vec<f64> = (0..5).map(|i| (f64::from(i) * 1.3).exp()).collect();
+        let values: Vec<f64> = (0..30).map(|i| (f64::from(i) * 0.37).sin() + 1.5).collect();
+        let subgrid = SubGrid::new(vec![1.0], vec![0.118], vec![0.0], xs, q2s, 1, values);
+        let axes = SubgridAxes::new(&subgrid);
+        let (x_knots, q2_knots) = (axes.xs(true), axes.q2s(true));
+        let kernel = StencilKernel::detect();
+
+        // Points in the interior cells as well as in the cells along the boundaries
+        for &(x, q2) in &[(0.02, 4.0), (0.007, 2.0), (0.1, 40.0), (0.2, 150.0)] {
+            let wx = AxisWeights::new(
+                &InterpolatorType::LogBicubic,
+                x_knots.as_slice().unwrap(),
+                f64::ln(x),
+            )
+            .unwrap();
+            let wq2 = AxisWeights::new(
+                &InterpolatorType::LogBicubic,
+                q2_knots.as_slice().unwrap(),
+                f64::ln(q2),
+            )
+            .unwrap();
+
+            let result = kernel.interpolate(&wx, &wq2, subgrid.grid_slice(0).view());
+            let expected = InterpolatorFactory::create(InterpolatorType::LogBicubic, &subgrid, 0)
+                .interpolate_point(&[x.ln(), q2.ln()])
+                .unwrap();
+            assert!((result - expected).abs() < 1e-13);
+
+            // The vector variants reproduce the scalar one bit by bit
+            if wx.knots(6) == (0..4) && wq2.knots(5) == (0..4) {
+                let values = subgrid.grid_slice(0);
+                let start = (wx.index - 1) * 5 + wq2.index - 1;
+                let scalar = contract_scalar(
+                    &values.as_slice().unwrap()[start..],
+                    5,
+                    &wx.weights,
+                    &wq2.weights,
+                );
+                assert_eq!(result.to_bits(), scalar.to_bits());
+            }
+        }
+    }
+
+    #[test]
+    fn test_single_precision_interpolator() {
+        let xs: Vec<f64> = (0..6).map(|i| (f64::from(i) * 0.7 - 5.0).exp()).collect();
+        let q2s: Vec<f64> = (0..5).map(|i| (f64::from(i) * 1.3).exp()).collect();
+        let values: Vec<f64> = (0..30).map(|i| (f64::from(i) * 0.37).sin() + 1.5).collect();
+        let double = SubGrid::new(vec![1.0], vec![0.118], vec![0.0], xs, q2s, 1, values);
+        let mut single = double.clone();
+        single.to_single_precision();
+        let kernel = StencilKernel::detect();
+
+        for interp_type in [
+            InterpolatorType::LogBicubic,
+            InterpolatorType::LogBilinear,
+            InterpolatorType::Bilinear,
+        ] {
+            let log = !matches!(interp_type, InterpolatorType::Bilinear);
+            let expected = InterpolatorFactory::create(interp_type.clone(), &double, 0);
+            let result = InterpolatorFactory::create(interp_type.clone(), &single, 0);
+            let axes = SubgridAxes::new(&single);
+
+            for &(x, q2) in &[(0.02, 4.0), (0.007, 2.0), (0.1, 40.0), (0.2, 150.0)] {
+                let point = if log { [x.ln(), q2.ln()] } else { [x, q2] };
+                let expected = expected.interpolate_point(&point).unwrap();
+                let result = result.interpolate_point(&point).unwrap();
+                assert!((result - expected).abs() < 1e-6 * expected.abs());
+
+                // The vector variants reproduce the scalar one bit by bit
+                let wx = AxisWeights::new(&interp_type, axes.xs(log).as_slice().unwrap(), point[0])
+                    .unwrap();
+                let wq2 =
+                    AxisWeights::new(&interp_type, axes.q2s(log).as_slice().unwrap(), point[1])
+                        .unwrap();
+                if wx.knots(6) == (0..4) && wq2.knots(5) == (0..4) {
+                    let values = single.grid_slice_f32(0).unwrap();
+                    let start = (wx.index - 1) * 5 + wq2.index - 1;
+                    let scalar = contract_scalar(
+                        &values.as_slice().unwrap()[start..],
+                        5,
+                        &wx.weights,
+                        &wq2.weights,
+                    );
+                    let vector = kernel.interpolate_f32(&wx, &wq2, values);
+                    assert_eq!(vector.to_bits(), scalar.to_bits());
+                }
+            }
+        }
+    }
+
     #[test]
     #[should_panic]
     fn test_unsupported_interpolator() {
@@ -20,13 +20,19 @@
 //!
 //! ## Module Overview
 //!
+//! - [`cache`]: On-demand loading of the members of a set under a memory budget.
 //! - [`converter`]: Utilities for converting and combining PDF sets.
+//! - [`executor`]: Distribution of the batch evaluations over threads.
 //! - [`gridpdf`]: Core grid data structures and high-level PDF grid interface.
 //! - [`interpolator`]: Dynamic interpolation traits and factories for PDF grids.
 //! - [`manage`]: Management utilities for PDF set installation, download, and path resolution.
+//! - [`members`]: Evaluation of all the members of a PDF set at once.
 //! - [`metadata`]: Metadata structures and types for describing PDF sets.
 //! - [`parser`]: Parsing utilities for reading and interpreting PDF set data files.
 //! - [`pdf`]: High-level interface for working with PDF sets and interpolation.
+//! - [`placement`]: Placement of the knot values on the NUMA nodes and on huge pages.
+//! - [`registry`]: Process-wide registry sharing the members loaded more than once.
+//! - [`stats`]: Optional counters describing the evaluations of a member.
 //! - [`strategy`]: Interpolation strategy implementations (bilinear, log-bicubic, etc.).
 //! - [`subgrid`]: Subgrid data structures and parameter range logic.
 //! - [`utils`]: Utility functions for interpolation and grid operations.
@@ -46,13 +52,19 @@
 //! See module-level documentation for more details and advanced usage.
 
 pub mod alphas;
+pub mod cache;
 pub mod converter;
+pub mod executor;
 pub mod gridpdf;
 pub mod interpolator;
 pub mod manage;
+pub mod members;
 pub mod metadata;
 pub mod parser;
 pub mod pdf;
+pub mod placement;
+pub mod registry;
+pub mod stats;
 pub mod strategy;
 pub mod subgrid;
 pub mod utils;
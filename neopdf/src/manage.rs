@@ -19,6 +19,20 @@ pub enum PdfSetFormat {
     Neopdf,
 }
 
+impl PdfSetFormat {
+    /// Determines the format of a PDF set from its name.
+    ///
+    /// Names ending with `.neopdf.lz4` or `.neopdf` refer to NeoPDF files, and all the
+    /// others to LHAPDF set directories.
+    pub fn from_set_name(set_name: &str) -> Self {
+        if set_name.ends_with(".neopdf.lz4") || set_name.ends_with(".neopdf") {
+            Self::Neopdf
+        } else {
+            Self::Lhapdf
+        }
+    }
+}
+
 #[derive(Debug, Deserialize, Serialize)]
 pub struct ManageData {
     neopdf_path: PathBuf,
@@ -0,0 +1,625 @@
+//! This module provides the evaluation of all the members of a PDF set at once.
+//!
+//! # Contents
+//!
+//! - [`MemberStack`]: Knot values of a set of members sharing the same knots, stored
+//!   member-contiguously such that all the members are interpolated in a single sweep.
+//! - [`ErrorType`], [`PDFUncertainty`]: Combination of the members of a set into a central
+//!   value and uncertainties.
+//!
+//! # Note
+//!
+//! The uncertainties of a PDF set require the same `(pid, x, Q2)` to be evaluated on every
+//! member. The members of a set are defined on the same knots, such that the subgrid, the
+//! knot intervals and the interpolation weights of a point are the same for all of them and
+//! only need to be computed once.
+
+use rayon::prelude::*;
+
+use super::gridpdf::{Error, ForcePositive, GridArray};
+use super::interpolator::{AxisWeights, InterpolationConfig, SubgridAxes};
+use super::metadata::InterpolatorType;
+use super::pdf::PDF;
+use super::subgrid::SubGrid;
+
+/// Number of members whose values are accumulated at once in a stack buffer.
+const MEMBER_CHUNK: usize = 64;
+
+/// The method combining the members of a set into uncertainties, following LHAPDF.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum ErrorType {
+    /// Monte Carlo replicas: the central value and the uncertainty are the mean and the
+    /// standard deviation of the replicas.
+    Replicas,
+    /// Asymmetric Hessian eigenvectors, given in pairs of positive and negative variations.
+    Hessian,
+    /// Symmetric Hessian eigenvectors, given as one variation per eigenvector.
+    SymmHessian,
+}
+
+impl ErrorType {
+    /// Parses the `ErrorType` of the metadata of a set, e.g. `hessian+as`.
+    ///
+    /// Each `+`-separated suffix denotes the variation of a parameter, such as `alpha_s`,
+    /// given by the last two members of the set as a pair of down and up variations.
+    ///
+    /// # Returns
+    ///
+    /// The `ErrorType` of the set and its number of parameter variations, or `None` if the
+    /// error type is not recognized.
+    pub fn parse(error_type: &str) -> Option<(Self, usize)> {
+        let mut parts = error_type.split('+');
+        let kind = match parts.next()?.trim().to_lowercase().as_str() {
+            "replicas" => Self::Replicas,
+            "hessian" => Self::Hessian,
+            "symmhessian" => Self::SymmHessian,
+            _ => return None,
+        };
+
+        Some((kind, parts.count()))
+    }
+}
+
+/// The central value and the uncertainties of a PDF value over the members of a set.
+///
+/// The uncertainties from the parameter variations are included in quadrature in
+/// `errplus`, `errminus` and `errsymm`, and are also reported separately in `errparam`.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default, PartialEq)]
+pub struct PDFUncertainty {
+    /// The central value: the first member for Hessian sets, the mean of the replicas
+    /// otherwise.
+    pub central: f64,
+    /// The positive uncertainty.
+    pub errplus: f64,
+    /// The negative uncertainty, as a positive number.
+    pub errminus: f64,
+    /// The symmetric uncertainty.
+    pub errsymm: f64,
+    /// The uncertainty from the parameter variations.
+    pub errparam: f64,
+}
+
+/// Accumulates the values of the members of a set, in order, into a [`PDFUncertainty`].
+///
+/// The members are consumed one at a time, such that their values never need to be
+/// stored all together.
+struct UncertaintyAccumulator {
+    error_type: ErrorType,
+    /// The number of members varying the PDF, excluding the central member and the
+    /// parameter variations.
+    ncore: usize,
+    /// The value of the central member.
+    central: f64,
+    /// The sum of the values of the core members.
+    sum: f64,
+    /// The sum of the squares of the positive deviations.
+    plus: f64,
+    /// The sum of the squares of the negative deviations.
+    minus: f64,
+    /// The sum of the squares of the symmetric deviations, or of the values of the replicas.
+    symm: f64,
+    /// The sum of the squares of the symmetric parameter deviations.
+    param: f64,
+    /// The first value of the current pair of members.
+    pending: f64,
+}
+
+impl UncertaintyAccumulator {
+    fn new(error_type: ErrorType, ncore: usize) -> Self {
+        Self {
+            error_type,
+            ncore,
+            central: 0.0,
+            sum: 0.0,
+            plus: 0.0,
+            minus: 0.0,
+            symm: 0.0,
+            param: 0.0,
+            pending: 0.0,
+        }
+    }
+
+    /// Adds the value of the member `imember`, the members being added in order.
+    fn push(&mut self, imember: usize, value: f64) {
+        let c0 = self.central;
+
+        if imember == 0 {
+            self.central = value;
+        } else if imember > self.ncore {
+            // The parameter variations come in pairs of down and up variations.
+            if (imember - self.ncore) % 2 == 1 {
+                self.pending = value;
+            } else {
+                let delta = 0.5 * (value - self.pending);
+                self.param += delta * delta;
+            }
+        } else {
+            match self.error_type {
+                ErrorType::Replicas => {
+                    self.sum += value;
+                    self.symm += value * value;
+                }
+                ErrorType::SymmHessian => self.symm += (value - c0) * (value - c0),
+                ErrorType::Hessian if imember % 2 == 1 => self.pending = value,
+                ErrorType::Hessian => {
+                    let (a, b) = (self.pending, value);
+                    let plus = (a - c0).max(b - c0).max(0.0);
+                    let minus = (c0 - a).max(c0 - b).max(0.0);
+                    self.plus += plus * plus;
+                    self.minus += minus * minus;
+                    self.symm += (a - b) * (a - b);
+                }
+            }
+        }
+    }
+
+    /// Combines the accumulated values into the central value and the uncertainties.
+    fn finish(self) -> PDFUncertainty {
+        let (central, errplus, errminus, errsymm) = match self.error_type {
+            ErrorType::Replicas => {
+                let n = self.ncore as f64;
+                let mean = self.sum / n;
+                let variance = n / (n - 1.0) * (self.symm / n - mean * mean);
+                // Rounding may yield slightly negative variances for identical replicas.
+                let sd = variance.max(0.0).sqrt();
+                (mean, sd, sd, sd)
+            }
+            ErrorType::SymmHessian => {
+                let err = self.symm.sqrt();
+                (self.central, err, err, err)
+            }
+            ErrorType::Hessian => (
+                self.central,
+                self.plus.sqrt(),
+                self.minus.sqrt(),
+                0.5 * self.symm.sqrt(),
+            ),
+        };
+
+        let errparam = self.param.sqrt();
+        let total = |err: f64| err.hypot(errparam);
+
+        PDFUncertainty {
+            central,
+            errplus: total(errplus),
+            errminus: total(errminus),
+            errsymm: total(errsymm),
+            errparam,
+        }
+    }
+}
+
+/// Knot values of several members of a PDF set, interleaved along the members.
+///
+/// The values of each subgrid are stored with the shape `[pids, x, Q2, members]`, i.e. the
+/// values of all the members at a given knot are contiguous. Interpolating all the members
+/// at a point then amounts to locating its subgrid and computing its interpolation weights
+/// once, followed by a sweep over the members of the 16 knots of its stencil, which is
+/// vectorized by the compiler.
+///
+/// The stack is a snapshot of the members at the time it is built: it holds a copy of their
+/// knot values and of their clipping methods, see [`PDF::set_force_positive`]. Only the 2D
+/// subgrids interpolated with a method linear in the knot values are supported, i.e.
+/// `LogBicubic`, `LogBilinear` and `Bilinear`.
+pub struct MemberStack {
+    /// The subgrids of the first member, used to locate the points.
+    knot_array: GridArray,
+    /// The knots of the axes of each subgrid.
+    axes: Vec<SubgridAxes>,
+    /// The interpolation method shared by all the members.
+    interpolator_type: InterpolatorType,
+    /// The knot values of each subgrid with the shape `[pids, x, Q2, members]`.
+    values: Vec<Vec<f64>>,
+    /// The clipping method of each member.
+    force_positive: Vec<ForcePositive>,
+    /// The error type of the set and the number of core members, if the members can be
+    /// combined into uncertainties.
+    error_type: Option<(ErrorType, usize)>,
+}
+
+impl MemberStack {
+    /// Creates a new `MemberStack` from the members of a PDF set.
+    ///
+    /// # Arguments
+    ///
+    /// * `members` - The members, e.g. a `&[PDF]`, which must share their flavors,
+    ///   interpolation method and the knots of their subgrids.
+    ///
+    /// # Returns
+    ///
+    /// A `Result` containing the `MemberStack` or an `Error` if the members are not
+    /// compatible or their interpolation method is not supported.
+    pub fn new<'a, I>(members: I) -> Result<Self, Error>
+    where
+        I: IntoIterator<Item = &'a PDF>,
+    {
+        let members: Vec<&PDF> = members.into_iter().collect();
+        let first = members
+            .first()
+            .ok_or_else(|| Error::InterpolationError("No members to stack".to_string()))?;
+        let interpolator_type = first.metadata().interpolator_type.clone();
+        let subgrids = first.subgrids();
+
+        let supported = AxisWeights::is_supported(&interpolator_type)
+            && subgrids
+                .iter()
+                .all(|sg| matches!(sg.interpolation_config(), InterpolationConfig::TwoD));
+        if !supported {
+            return Err(Error::InterpolationError(format!(
+                "Members cannot be stacked for the interpolator {interpolator_type:?}"
+            )));
+        }
+
+        // The stack holds its own copy of the knot values, which are read in double precision.
+        if let Some(idx) = members
+            .iter()
+            .position(|member| member.subgrids().iter().any(SubGrid::is_single_precision))
+        {
+            return Err(Error::InterpolationError(format!(
+                "Member {idx} is stored in single precision and cannot be stacked"
+            )));
+        }
+
+        for (idx, member) in members.iter().enumerate().skip(1) {
+            let shared =
+                member.metadata().interpolator_type == interpolator_type
+                    && member.pids() == first.pids()
+                    && member.subgrids().len() == subgrids.len()
+                    && member.subgrids().iter().zip(subgrids).all(|(a, b)| {
+                        a.xs == b.xs && a.q2s == b.q2s && a.grid.dim() == b.grid.dim()
+                    });
+            if !shared {
+                return Err(Error::InterpolationError(format!(
+                    "Member {idx} does not share the knots of the first member"
+                )));
+            }
+        }
+
+        let nmembers = members.len();
+        let values = (0..subgrids.len())
+            .map(|isg| {
+                let mut stacked = vec![0.0; subgrids[isg].grid.len() * nmembers];
+                for (m, member) in members.iter().enumerate() {
+                    let subgrid = &member.subgrids()[isg];
+                    // The knot values of a 2D subgrid are ordered as `[pids, x, Q2]`.
+                    for (knot, &value) in subgrid.grid.iter().enumerate() {
+                        stacked[knot * nmembers + m] = value;
+                    }
+                }
+                stacked
+            })
+            .collect();
+
+        // The members are the central one, the core ones and the pairs of variations of the
+        // parameters.
+        let error_type =
+            ErrorType::parse(&first.metadata().error_type).and_then(|(kind, nparams)| {
+                let ncore = nmembers.checked_sub(1 + 2 * nparams)?;
+                let valid = match kind {
+                    ErrorType::Replicas => ncore >= 2,
+                    ErrorType::Hessian => ncore >= 2 && ncore % 2 == 0,
+                    ErrorType::SymmHessian => ncore >= 1,
+                };
+                valid.then_some((kind, ncore))
+            });
+
+        Ok(Self {
+            knot_array: GridArray::from_subgrids(subgrids.clone(), first.pids().clone()),
+            axes: subgrids.iter().map(SubgridAxes::new).collect(),
+            interpolator_type,
+            values,
+            force_positive: members
+                .iter()
+                .map(|member| member.is_force_positive().clone())
+                .collect(),
+            error_type,
+        })
+    }
+
+    /// Returns the number of stacked members.
+    pub fn len(&self) -> usize {
+        self.force_positive.len()
+    }
+
+    /// Returns whether the stack holds no members.
+    pub fn is_empty(&self) -> bool {
+        self.force_positive.is_empty()
+    }
+
+    /// Interpolates the PDF value of a flavor at `(x, Q2)` for all the members.
+    ///
+    /// # Arguments
+    ///
+    /// * `flavor_id` - The flavor ID.
+    /// * `x` - The momentum fraction.
+    /// * `q2` - The energy scale squared.
+    /// * `out` - The output buffer, of length `MemberStack::len`.
+    ///
+    /// # Returns
+    ///
+    /// A `Result` which is `Ok(())` if all the values were computed or an `Error`.
+    pub fn xfxq2(&self, flavor_id: i32, x: f64, q2: f64, out: &mut [f64]) -> Result<(), Error> {
+        let nmembers = self.len();
+        if out.len() != nmembers {
+            return Err(Error::InterpolationError(format!(
+                "Inconsistent output size: {} values for {nmembers} members",
+                out.len()
+            )));
+        }
+
+        self.sweep(flavor_id, x, q2, |start, values| {
+            out[start..start + values.len()].copy_from_slice(values);
+        })
+    }
+
+    /// Interpolates the PDF value of a flavor at `(x, Q2)` for all the members and passes
+    /// them, clipped, to `visit` in consecutive chunks of at most `MEMBER_CHUNK` members,
+    /// together with the index of the first member of the chunk.
+    fn sweep<F>(&self, flavor_id: i32, x: f64, q2: f64, mut visit: F) -> Result<(), Error>
+    where
+        F: FnMut(usize, &[f64]),
+    {
+        let nmembers = self.len();
+        let pid_idx = self
+            .knot_array
+            .pid_index(flavor_id)
+            .ok_or_else(|| Error::InterpolationError(format!("Invalid flavor ID: {flavor_id}")))?;
+        let subgrid_idx = self
+            .knot_array
+            .find_subgrid(&[x, q2])
+            .ok_or(Error::SubgridNotFound { x, q2 })?;
+
+        let use_log = !matches!(self.interpolator_type, InterpolatorType::Bilinear);
+        let coords = if use_log { [x.ln(), q2.ln()] } else { [x, q2] };
+        let axes = &self.axes[subgrid_idx];
+        let x_knots = axes.xs(use_log).as_slice().unwrap();
+        let q2_knots = axes.q2s(use_log).as_slice().unwrap();
+        let to_error =
+            |e: ninterp::error::InterpolateError| Error::InterpolationError(e.to_string());
+        let wx = AxisWeights::new(&self.interpolator_type, x_knots, coords[0]).map_err(to_error)?;
+        let wq2 =
+            AxisWeights::new(&self.interpolator_type, q2_knots, coords[1]).map_err(to_error)?;
+
+        let (nx, nq2) = (x_knots.len(), q2_knots.len());
+        let values = &self.values[subgrid_idx];
+        // The offset of the values of the knot `(ix, iq2)` of the flavor.
+        let offset = |ix: usize, iq2: usize| ((pid_idx * nx + ix) * nq2 + iq2) * nmembers;
+
+        for start in (0..nmembers).step_by(MEMBER_CHUNK) {
+            let len = MEMBER_CHUNK.min(nmembers - start);
+            let mut result = [0.0; MEMBER_CHUNK];
+
+            // The rows of the stencil along `x` are summed first for each knot along `Q2`, in
+            // the same order as the `StencilKernel`.
+            for b in wq2.knots(nq2) {
+                let mut partial = [0.0; MEMBER_CHUNK];
+                for a in wx.knots(nx) {
+                    let base = offset(wx.index + a - 1, wq2.index + b - 1) + start;
+                    let w = wx.weights[a];
+                    for (p, &f) in partial[..len].iter_mut().zip(&values[base..base + len]) {
+                        *p += w * f;
+                    }
+                }
+                let w = wq2.weights[b];
+                for (r, &p) in result[..len].iter_mut().zip(&partial[..len]) {
+                    *r += p * w;
+                }
+            }
+
+            let clipping = &self.force_positive[start..start + len];
+            for (r, flag) in result[..len].iter_mut().zip(clipping) {
+                *r = flag.apply(*r);
+            }
+            visit(start, &result[..len]);
+        }
+
+        Ok(())
+    }
+
+    /// Interpolates the PDF value of a flavor on a batch of `(x, Q2)` points for all the
+    /// members.
+    ///
+    /// The results are written into `out` in row-major order with shape `[points, members]`,
+    /// i.e. `out[ipoint * MemberStack::len() + imember]`.
+    ///
+    /// # Arguments
+    ///
+    /// * `flavor_id` - The flavor ID.
+    /// * `xs` - A slice of momentum fractions `x`.
+    /// * `q2s` - A slice of energy scales `Q2`, with the same length as `xs`.
+    /// * `out` - The output buffer, of length `xs.len() * MemberStack::len()`.
+    ///
+    /// # Returns
+    ///
+    /// A `Result` which is `Ok(())` if all the values were computed or an `Error`. On error,
+    /// the values of the points preceding the failing one may already have been stored.
+    pub fn xfxq2_batch(
+        &self,
+        flavor_id: i32,
+        xs: &[f64],
+        q2s: &[f64],
+        out: &mut [f64],
+    ) -> Result<(), Error> {
+        let nmembers = self.len();
+        if q2s.len() != xs.len() || out.len() != xs.len() * nmembers {
+            return Err(Error::InterpolationError(format!(
+                "Inconsistent batch sizes: {} xs, {} q2s, {} outputs for {nmembers} members",
+                xs.len(),
+                q2s.len(),
+                out.len()
+            )));
+        }
+        if nmembers == 0 {
+            return Ok(());
+        }
+
+        for ((&x, &q2), values) in xs.iter().zip(q2s).zip(out.chunks_exact_mut(nmembers)) {
+            self.xfxq2(flavor_id, x, q2, values)?;
+        }
+
+        Ok(())
+    }
+
+    /// Returns the error type of the set, if its members can be combined into uncertainties.
+    pub fn error_type(&self) -> Option<ErrorType> {
+        self.error_type.map(|(kind, _)| kind)
+    }
+
+    /// Computes the central value and the uncertainties of the PDF value of a flavor at
+    /// `(x, Q2)`, according to the `ErrorType` of the set.
+    ///
+    /// The members are combined in a single pass as they are interpolated, without
+    /// storing their values.
+    ///
+    /// # Arguments
+    ///
+    /// * `flavor_id` - The flavor ID.
+    /// * `x` - The momentum fraction.
+    /// * `q2` - The energy scale squared.
+    ///
+    /// # Returns
+    ///
+    /// A `Result` containing the `PDFUncertainty` or an `Error` if the error type of the set
+    /// is not supported or does not match its number of members.
+    pub fn uncertainty(&self, flavor_id: i32, x: f64, q2: f64) -> Result<PDFUncertainty, Error> {
+        let (kind, ncore) = self.error_type.ok_or_else(|| {
+            Error::InterpolationError(
+                "The error type of the set does not match its members".to_string(),
+            )
+        })?;
+
+        let mut accumulator = UncertaintyAccumulator::new(kind, ncore);
+        self.sweep(flavor_id, x, q2, |start, values| {
+            for (imember, &value) in (start..).zip(values) {
+                accumulator.push(imember, value);
+            }
+        })?;
+
+        Ok(accumulator.finish())
+    }
+
+    /// Computes the central values and the uncertainties of a flavor on a batch of
+    /// `(x, Q2)` points, in parallel over the points.
+    ///
+    /// # Arguments
+    ///
+    /// * `flavor_id` - The flavor ID.
+    /// * `xs` - A slice of momentum fractions `x`.
+    /// * `q2s` - A slice of energy scales `Q2`, with the same length as `xs`.
+    /// * `out` - The output buffer, with the same length as `xs`.
+    ///
+    /// # Returns
+    ///
+    /// A `Result` which is `Ok(())` if all the uncertainties were computed or an `Error`.
+    pub fn uncertainty_batch(
+        &self,
+        flavor_id: i32,
+        xs: &[f64],
+        q2s: &[f64],
+        out: &mut [PDFUncertainty],
+    ) -> Result<(), Error> {
+        if q2s.len() != xs.len() || out.len() != xs.len() {
+            return Err(Error::InterpolationError(format!(
+                "Inconsistent batch sizes: {} xs, {} q2s, {} outputs",
+                xs.len(),
+                q2s.len(),
+                out.len()
+            )));
+        }
+
+        out.par_iter_mut()
+            .zip(xs.par_iter().zip(q2s))
+            .try_for_each(|(result, (&x, &q2))| {
+                *result = self.uncertainty(flavor_id, x, q2)?;
+                Ok(())
+            })
+    }
+
+    /// Computes the central values and the uncertainties of a flavor on the grid of points
+    /// spanned by `xs` and `q2s`, in parallel over the points.
+    ///
+    /// The results are written into `out` in row-major order with shape `[xs, q2s]`, i.e.
+    /// `out[ix * q2s.len() + iq2]` holds the result at `(xs[ix], q2s[iq2])`.
+    ///
+    /// # Arguments
+    ///
+    /// * `flavor_id` - The flavor ID.
+    /// * `xs` - A slice of momentum fractions `x`.
+    /// * `q2s` - A slice of energy scales `Q2`.
+    /// * `out` - The output buffer, of length `xs.len() * q2s.len()`.
+    ///
+    /// # Returns
+    ///
+    /// A `Result` which is `Ok(())` if all the uncertainties were computed or an `Error`.
+    pub fn uncertainty_grid(
+        &self,
+        flavor_id: i32,
+        xs: &[f64],
+        q2s: &[f64],
+        out: &mut [PDFUncertainty],
+    ) -> Result<(), Error> {
+        if out.len() != xs.len() * q2s.len() {
+            return Err(Error::InterpolationError(format!(
+                "Inconsistent grid sizes: {} xs, {} q2s, {} outputs",
+                xs.len(),
+                q2s.len(),
+                out.len()
+            )));
+        }
+
+        out.par_iter_mut()
+            .enumerate()
+            .try_for_each(|(idx, result)| {
+                let (x, q2) = (xs[idx / q2s.len()], q2s[idx % q2s.len()]);
+                *result = self.uncertainty(flavor_id, x, q2)?;
+                Ok(())
+            })
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn combine(error_type: &str, values: &[f64]) -> PDFUncertainty {
+        let (kind, nparams) = ErrorType::parse(error_type).unwrap();
+        let mut accumulator = UncertaintyAccumulator::new(kind, values.len() - 1 - 2 * nparams);
+        for (imember, &value) in values.iter().enumerate() {
+            accumulator.push(imember, value);
+        }
+        accumulator.finish()
+    }
+
+    #[test]
+    fn test_error_type_parse() {
+        assert_eq!(ErrorType::parse("replicas"), Some((ErrorType::Replicas, 0)));
+        assert_eq!(
+            ErrorType::parse("hessian+as"),
+            Some((ErrorType::Hessian, 1))
+        );
+        assert_eq!(
+            ErrorType::parse("symmhessian+as+mb"),
+            Some((ErrorType::SymmHessian, 2))
+        );
+        assert_eq!(ErrorType::parse("unknown"), None);
+    }
+
+    #[test]
+    fn test_uncertainty_accumulator() {
+        let replicas = combine("replicas", &[0.0, 1.0, 2.0, 3.0, 4.0]);
+        assert!((replicas.central - 2.5).abs() < 1e-15);
+        assert!((replicas.errsymm - (5.0f64 / 3.0).sqrt()).abs() < 1e-15);
+
+        let hessian = combine("hessian", &[1.0, 1.5, 0.8, 0.9, 1.2]);
+        assert_eq!(hessian.central, 1.0);
+        assert!((hessian.errplus - (0.5f64.powi(2) + 0.2f64.powi(2)).sqrt()).abs() < 1e-15);
+        assert!((hessian.errminus - (0.2f64.powi(2) + 0.1f64.powi(2)).sqrt()).abs() < 1e-15);
+        assert!((hessian.errsymm - 0.5 * (0.7f64.powi(2) + 0.3f64.powi(2)).sqrt()).abs() < 1e-15);
+
+        // The parameter variations are added in quadrature.
+        let symmhessian = combine("symmhessian+as", &[1.0, 1.3, 0.6, 0.9, 1.3]);
+        assert!((symmhessian.errparam - 0.2).abs() < 1e-15);
+        assert!((symmhessian.errsymm - (0.25f64 + 0.04).sqrt()).abs() < 1e-15);
+    }
+}
@@ -2,15 +2,21 @@
 //!
 //! It defines types and methods for loading, parsing, and representing both LHAPDF and NeoPDF
 //! set formats, including subgrid data extraction and metadata reading.
+use rayon::prelude::*;
 use serde::{Deserialize, Serialize};
-use std::fs;
+use std::fs::{self, File};
+use std::io::{BufRead, BufReader};
 use std::path::{Path, PathBuf};
+use std::sync::mpsc;
 
 use super::gridpdf::GridArray;
 use super::manage::{ManageData, PdfSetFormat};
 use super::metadata::MetaData;
 use super::writer::{GridArrayReader, LazyGridArrayIterator};
 
+/// Line separating the header and the subgrid blocks of an LHAPDF `.dat` file.
+const BLOCK_SEPARATOR: &str = "---";
+
 /// Represents the data for a single subgrid within a PDF data file.
 #[derive(Debug, Clone, Serialize, Deserialize)]
 pub struct SubgridData {
@@ -93,7 +99,7 @@ impl LhapdfSet {
         (info, knot_array)
     }
 
-    /// Reads the metadata and data for all members of the PDF set.
+    /// Reads the metadata and data for all members of the PDF set in parallel.
     ///
     /// # Returns
     ///
@@ -101,6 +107,7 @@ impl LhapdfSet {
     /// for a member of the set.
     pub fn members(&self) -> Vec<(MetaData, GridArray)> {
         (0..self.info.num_members as usize)
+            .into_par_iter()
             .map(|i| self.member(i))
             .collect()
     }
@@ -125,6 +132,10 @@ impl LhapdfSet {
     /// from the specified data file. It can handle files with multiple subgrids
     /// separated by "---".
     ///
+    /// The file is streamed one block at a time, and each subgrid block is parsed
+    /// on the rayon thread pool while the following ones are being read, such that
+    /// the text of a block is released as soon as it is parsed.
+    ///
     /// # Arguments
     ///
     /// * `path` - The path to the `.dat` file.
@@ -133,91 +144,62 @@ impl LhapdfSet {
     ///
     /// A `PdfData` struct containing the parsed subgrid data and flavor IDs.
     pub fn read_data(path: &Path) -> PdfData {
-        let content = fs::read_to_string(path).unwrap();
-        let mut subgrid_data = Vec::new();
-        let mut flavors = Vec::new();
+        let mut reader = BufReader::new(File::open(path).unwrap());
         let mut alphas_q_values: Option<Vec<f64>> = None;
         let mut alphas_vals: Option<Vec<f64>> = None;
 
-        let blocks: Vec<&str> = content.split("---").map(|s| s.trim()).collect();
+        let mut metadata_block = String::new();
+        let has_subgrids = Self::read_block(&mut reader, &mut metadata_block);
 
         // NOTE: support cases in which `AlphaS` grid info are in `.dat` files.
-        if !blocks.is_empty() {
-            #[derive(serde::Deserialize)]
-            struct DatMeta {
-                #[serde(rename = "AlphaS_Qs", default)]
-                alphas_q_values: Vec<f64>,
-                #[serde(rename = "AlphaS_Vals", default)]
-                alphas_vals: Vec<f64>,
-            }
+        #[derive(serde::Deserialize)]
+        struct DatMeta {
+            #[serde(rename = "AlphaS_Qs", default)]
+            alphas_q_values: Vec<f64>,
+            #[serde(rename = "AlphaS_Vals", default)]
+            alphas_vals: Vec<f64>,
+        }
 
-            let metadata_block = blocks[0];
-            if let Ok(dat_meta) = serde_yaml::from_str::<DatMeta>(metadata_block) {
-                if !dat_meta.alphas_q_values.is_empty() {
-                    alphas_q_values = Some(dat_meta.alphas_q_values);
-                }
-                if !dat_meta.alphas_vals.is_empty() {
-                    alphas_vals = Some(dat_meta.alphas_vals);
-                }
+        if let Ok(dat_meta) = serde_yaml::from_str::<DatMeta>(metadata_block.trim()) {
+            if !dat_meta.alphas_q_values.is_empty() {
+                alphas_q_values = Some(dat_meta.alphas_q_values);
+            }
+            if !dat_meta.alphas_vals.is_empty() {
+                alphas_vals = Some(dat_meta.alphas_vals);
             }
         }
 
-        for block in blocks.iter().skip(1) {
-            if block.is_empty() {
-                continue;
-            }
+        let (sender, receiver) = mpsc::channel();
+        rayon::scope(move |scope| {
+            let mut more_blocks = has_subgrids;
+            let mut index = 0;
+            while more_blocks {
+                let mut block = String::new();
+                more_blocks = Self::read_block(&mut reader, &mut block);
+                if block.trim().is_empty() {
+                    continue;
+                }
 
-            let mut lines = block.lines();
-
-            let x_knots_line = lines.next().unwrap();
-            let xs: Vec<f64> = x_knots_line
-                .split_whitespace()
-                .filter_map(|s| s.parse().ok())
-                .collect();
-
-            let q2_knots_line = lines.next().unwrap();
-            let q2s: Vec<f64> = q2_knots_line
-                .split_whitespace()
-                .filter_map(|s| s.parse().ok())
-                .map(|q: f64| q * q)
-                .collect();
-
-            // Read the flavors (only once from the first subgrid)
-            if flavors.is_empty() {
-                let flavors_line = lines.next().unwrap();
-                flavors = flavors_line
-                    .split_whitespace()
-                    .filter_map(|s| s.parse().ok())
-                    .collect();
-            } else {
-                // Skip the flavors line in subsequent subgrids
-                lines.next();
+                let sender = sender.clone();
+                scope.spawn(move |_| {
+                    sender.send((index, Self::parse_subgrid(&block))).unwrap();
+                });
+                index += 1;
             }
+        });
 
-            let mut grid_data = Vec::new();
-            for line in lines {
-                let values: Vec<f64> = line
-                    .split_whitespace()
-                    .filter_map(|s| s.parse().ok())
-                    .collect();
-                grid_data.extend(values);
-            }
+        let mut subgrids: Vec<_> = receiver.into_iter().collect();
+        subgrids.sort_unstable_by_key(|(index, _)| *index);
 
-            // NOTE: given that there isn't really a proper way to extract the
-            // following values from LHAPDF, their defaults are set to zeros.
-            let nucleons: Vec<f64> = vec![0.0];
-            let alphas: Vec<f64> = vec![0.0];
-            let kts: Vec<f64> = vec![0.0];
-
-            subgrid_data.push(SubgridData {
-                nucleons,
-                alphas,
-                kts,
-                xs,
-                q2s,
-                grid_data,
-            });
-        }
+        // The flavors are read from the first subgrid
+        let flavors = subgrids
+            .first()
+            .map(|(_, (_, flavors))| flavors.clone())
+            .unwrap_or_default();
+        let subgrid_data = subgrids
+            .into_iter()
+            .map(|(_, (subgrid, _))| subgrid)
+            .collect();
 
         PdfData {
             subgrid_data,
@@ -226,6 +208,88 @@ impl LhapdfSet {
             alphas_vals,
         }
     }
+
+    /// Appends the lines of `reader` to `block` up to the next block separator, which is
+    /// consumed but not appended.
+    ///
+    /// # Returns
+    ///
+    /// `true` if a separator was found, `false` if the end of the file was reached.
+    fn read_block<R: BufRead>(reader: &mut R, block: &mut String) -> bool {
+        loop {
+            let start = block.len();
+            if reader.read_line(block).unwrap() == 0 {
+                return false;
+            }
+            if block[start..].trim() == BLOCK_SEPARATOR {
+                block.truncate(start);
+                return true;
+            }
+        }
+    }
+
+    /// Parses a subgrid block of an LHAPDF `.dat` file.
+    ///
+    /// # Arguments
+    ///
+    /// * `block` - The text of the block, i.e. the `x` knots, the `Q` knots, the flavors
+    ///   and the grid values.
+    ///
+    /// # Returns
+    ///
+    /// The `SubgridData` of the block together with its flavors.
+    fn parse_subgrid(block: &str) -> (SubgridData, Vec<i32>) {
+        let mut lines = block.lines().map(str::trim).filter(|line| !line.is_empty());
+
+        let xs: Vec<f64> = lines
+            .next()
+            .unwrap()
+            .split_ascii_whitespace()
+            .filter_map(|s| s.parse().ok())
+            .collect();
+
+        let q2s: Vec<f64> = lines
+            .next()
+            .unwrap()
+            .split_ascii_whitespace()
+            .filter_map(|s| s.parse().ok())
+            .map(|q: f64| q * q)
+            .collect();
+
+        let flavors: Vec<i32> = lines
+            .next()
+            .unwrap()
+            .split_ascii_whitespace()
+            .filter_map(|s| s.parse().ok())
+            .collect();
+
+        // The number of values is known from the knots, such that the grid is filled
+        // without reallocations.
+        let mut grid_data = Vec::with_capacity(xs.len() * q2s.len() * flavors.len());
+        for line in lines {
+            grid_data.extend(
+                line.split_ascii_whitespace()
+                    .filter_map(|s| s.parse::<f64>().ok()),
+            );
+        }
+
+        // NOTE: given that there isn't really a proper way to extract the
+        // following values from LHAPDF, their defaults are set to zeros.
+        let nucleons: Vec<f64> = vec![0.0];
+        let alphas: Vec<f64> = vec![0.0];
+        let kts: Vec<f64> = vec![0.0];
+
+        let subgrid = SubgridData {
+            nucleons,
+            alphas,
+            kts,
+            xs,
+            q2s,
+            grid_data,
+        };
+
+        (subgrid, flavors)
+    }
 }
 
 /// Manages the loading and parsing of NeoPDF sets.
@@ -341,4 +405,55 @@ mod tests {
             vec![10.0, 11.0, 12.0, 13.0, 14.0, 15.0, 16.0, 17.0, 18.0]
         );
     }
+
+    #[test]
+    fn test_read_data_alphas_header() {
+        let data_content = "\
+PdfType: central
+AlphaS_Qs: [1.0, 10.0]
+AlphaS_Vals: [0.3, 0.2]
+---
+1.0e-9 1.0e-8
+1.0 10.0
+21 1
+1.0 2.0
+3.0 4.0
+5.0 6.0
+7.0 8.0
+---
+1.0e-8 1.0e-7
+10.0 100.0
+21 1
+9.0 10.0
+11.0 12.0
+13.0 14.0
+15.0 16.0
+---
+1.0e-7 1.0e-6
+100.0 1000.0
+21 1
+17.0 18.0
+19.0 20.0
+21.0 22.0
+23.0 24.0
+---
+";
+        let mut temp_file = NamedTempFile::new().unwrap();
+        write!(temp_file, "{}", data_content).unwrap();
+        let pdf_data = LhapdfSet::read_data(temp_file.path());
+
+        assert_eq!(pdf_data.alphas_q_values, Some(vec![1.0, 10.0]));
+        assert_eq!(pdf_data.alphas_vals, Some(vec![0.3, 0.2]));
+        assert_eq!(pdf_data.pids, vec![21, 1]);
+        assert_eq!(pdf_data.subgrid_data.len(), 3);
+
+        // The subgrids are kept in the order of the file
+        let x_mins = [1.0e-9, 1.0e-8, 1.0e-7];
+        for (i, subgrid) in pdf_data.subgrid_data.iter().enumerate() {
+            assert_eq!(subgrid.xs[0], x_mins[i]);
+            let expected: Vec<f64> = (0..8).map(|v| (8 * i + v + 1) as f64).collect();
+            assert_eq!(subgrid.grid_data, expected);
+            assert_eq!(subgrid.grid_data.capacity(), expected.len());
+        }
+    }
 }
@@ -16,26 +16,39 @@
 //!
 //! - [`PDF`]: Represents a single PDF member, providing methods for interpolation and metadata access.
 //! - [`PdfSet`]: Trait for abstracting over different PDF set backends.
+//! - [`PrecisionReport`]: Deviation of a member from a reference, e.g. a member whose knot
+//!   values are stored in single precision from the same member in double precision.
 //! - Loader functions: [`PDF::load`], [`PDF::load_pdfs`], and internal helpers for batch loading.
 //!
 //! See the documentation for [`PDF`] for more details on available methods and usage patterns.
 use ndarray::{Array1, Array2};
 use rayon::prelude::*;
+use std::fmt;
+use std::sync::{mpsc, Arc};
+use std::thread;
+use std::time::Instant;
 
-use super::gridpdf::{ForcePositive, GridArray, GridPDF};
+use super::executor::{BatchExecutor, PointStatus};
+use super::gridpdf::{Error, ForcePositive, GridArray, GridPDF, LoadOptions};
+use super::manage::PdfSetFormat;
 use super::metadata::MetaData;
 use super::parser::{LhapdfSet, NeopdfSet};
+use super::placement::{self, MemoryPolicy, NumaPolicy};
+use super::registry;
+use super::stats::EvalStatistics;
 use super::subgrid::{RangeParameters, SubGrid};
 
 /// Trait for abstracting over different PDF set backends (e.g., LHAPDF, NeoPDF).
 ///
 /// Provides a unified interface for accessing the number of members and retrieving individual
 /// members as metadata and grid arrays.
-trait PdfSet: Send + Sync {
+pub(crate) trait PdfSet: Send + Sync {
     /// Returns the number of members in the PDF set.
     fn num_members(&self) -> usize;
     /// Retrieves the metadata and grid array for the specified member index.
     fn member(&self, idx: usize) -> (MetaData, GridArray);
+    /// Returns the metadata of the PDF set.
+    fn info(&self) -> &MetaData;
 }
 
 impl PdfSet for LhapdfSet {
@@ -45,6 +58,9 @@ impl PdfSet for LhapdfSet {
     fn member(&self, idx: usize) -> (MetaData, GridArray) {
         self.member(idx)
     }
+    fn info(&self) -> &MetaData {
+        &self.info
+    }
 }
 
 impl PdfSet for NeopdfSet {
@@ -54,6 +70,25 @@ impl PdfSet for NeopdfSet {
     fn member(&self, idx: usize) -> (MetaData, GridArray) {
         self.member(idx)
     }
+    fn info(&self) -> &MetaData {
+        &self.info
+    }
+}
+
+/// Opens the PDF set backend matching the format of `pdf_name`.
+///
+/// # Arguments
+///
+/// * `pdf_name` - The name of the PDF set.
+///
+/// # Returns
+///
+/// The [`PdfSet`] backend from which the members of the set are read.
+pub(crate) fn open_pdfset(pdf_name: &str) -> Box<dyn PdfSet> {
+    match PdfSetFormat::from_set_name(pdf_name) {
+        PdfSetFormat::Neopdf => Box::new(NeopdfSet::new(pdf_name)),
+        PdfSetFormat::Lhapdf => Box::new(LhapdfSet::new(pdf_name)),
+    }
 }
 
 /// Loads a single PDF member from a generic PDF set backend.
@@ -62,17 +97,110 @@ impl PdfSet for NeopdfSet {
 ///
 /// * `set` - The PDF set backend implementing [`PdfSet`].
 /// * `member` - The index of the member to load.
+/// * `options` - The options used to build the interpolators of the member.
 ///
 /// # Returns
 ///
 /// A [`PDF`] instance for the specified member.
-fn pdfset_loader<T: PdfSet>(set: T, member: usize) -> PDF {
+pub(crate) fn pdfset_loader<T: PdfSet + ?Sized>(
+    set: &T,
+    member: usize,
+    options: LoadOptions,
+) -> PDF {
+    let started = Instant::now();
     let (info, knot_array) = set.member(member);
+    build_member(started, info, knot_array, options)
+}
+
+/// Builds a member from its grid, recording the time elapsed since `started` as the time
+/// spent loading the member, see [`PDF::stats`].
+fn build_member(
+    started: Instant,
+    info: MetaData,
+    knot_array: GridArray,
+    options: LoadOptions,
+) -> PDF {
+    if options.places_knots() {
+        return place_members(vec![(started, info, knot_array)], options)
+            .pop()
+            .expect("Failed to place the member");
+    }
+
+    let grid_pdf = GridPDF::with_options(info, knot_array, options);
+    grid_pdf.eval_stats().record_load(started.elapsed());
     PDF {
-        grid_pdf: GridPDF::new(info, knot_array),
+        grid_pdf,
+        replicas: Vec::new(),
     }
 }
 
+/// Builds members loaded together from their grids, whose knot values are first packed and
+/// placed in memory according to `options`, see [`placement`].
+///
+/// With [`NumaPolicy::Replicate`], one copy of every member is built per NUMA node, and the
+/// copies of a member share its evaluation counters.
+///
+/// # Arguments
+///
+/// * `members` - The time at which the loading of each member started, its metadata and
+///   its grid.
+/// * `options` - The options used to place the knot values and build the interpolators.
+///
+/// # Returns
+///
+/// A vector of [`PDF`] instances, one for each of the `members`.
+fn place_members(members: Vec<(Instant, MetaData, GridArray)>, options: LoadOptions) -> Vec<PDF> {
+    let mut started = Vec::with_capacity(members.len());
+    let mut infos = Vec::with_capacity(members.len());
+    let mut grids = Vec::with_capacity(members.len());
+    for (start, info, mut knot_array) in members {
+        GridPDF::prepare_knots(&info, &mut knot_array, &options);
+        started.push(start);
+        infos.push(info);
+        grids.push(knot_array);
+    }
+
+    let num_copies = match options.numa {
+        NumaPolicy::Replicate => placement::num_nodes(),
+        _ => 1,
+    };
+    let mut copies: Vec<_> = (0..num_copies)
+        .map(|node| {
+            let policy = match options.numa {
+                NumaPolicy::FirstTouch => MemoryPolicy::Default,
+                NumaPolicy::Interleave => MemoryPolicy::Interleave,
+                NumaPolicy::Replicate => MemoryPolicy::Node(node),
+            };
+            let mut placed = grids.clone();
+            placement::pack(&mut placed, options.huge_pages, policy);
+            infos
+                .par_iter()
+                .zip(placed)
+                .map(|(info, knot_array)| GridPDF::with_options(info.clone(), knot_array, options))
+                .collect::<Vec<_>>()
+                .into_iter()
+        })
+        .collect();
+    drop(grids);
+
+    started
+        .into_iter()
+        .map(|started| {
+            let grid_pdf = copies[0].next().expect("Missing placed member");
+            let replicas = copies[1..]
+                .iter_mut()
+                .map(|copy| {
+                    let mut replica = copy.next().expect("Missing replicated member");
+                    replica.share_stats(&grid_pdf);
+                    replica
+                })
+                .collect();
+            grid_pdf.eval_stats().record_load(started.elapsed());
+            PDF { grid_pdf, replicas }
+        })
+        .collect()
+}
+
 /// Loads all PDF members from a generic PDF set backend in sequential.
 ///
 /// # Arguments
@@ -84,12 +212,7 @@ fn pdfset_loader<T: PdfSet>(set: T, member: usize) -> PDF {
 /// A vector of [`PDF`] instances, one for each member in the set.
 fn pdfsets_seq_loader<T: PdfSet + Send + Sync>(set: T) -> Vec<PDF> {
     (0..set.num_members())
-        .map(|idx| {
-            let (info, knot_array) = set.member(idx);
-            PDF {
-                grid_pdf: GridPDF::new(info, knot_array),
-            }
-        })
+        .map(|idx| pdfset_loader(&set, idx, LoadOptions::default()))
         .collect()
 }
 
@@ -98,19 +221,27 @@ fn pdfsets_seq_loader<T: PdfSet + Send + Sync>(set: T) -> Vec<PDF> {
 /// # Arguments
 ///
 /// * `set` - The PDF set backend implementing [`PdfSet`].
+/// * `options` - The options used to build the interpolators of the members.
 ///
 /// # Returns
 ///
 /// A vector of [`PDF`] instances, one for each member in the set.
-fn pdfsets_par_loader<T: PdfSet + Send + Sync>(set: T) -> Vec<PDF> {
+fn pdfsets_par_loader<T: PdfSet + Send + Sync>(set: T, options: LoadOptions) -> Vec<PDF> {
+    if options.places_knots() {
+        let members = (0..set.num_members())
+            .into_par_iter()
+            .map(|idx| {
+                let started = Instant::now();
+                let (info, knot_array) = set.member(idx);
+                (started, info, knot_array)
+            })
+            .collect();
+        return place_members(members, options);
+    }
+
     (0..set.num_members())
         .into_par_iter()
-        .map(|idx| {
-            let (info, knot_array) = set.member(idx);
-            PDF {
-                grid_pdf: GridPDF::new(info, knot_array),
-            }
-        })
+        .map(|idx| pdfset_loader(&set, idx, options))
         .collect()
 }
 
@@ -119,11 +250,32 @@ fn pdfsets_par_loader<T: PdfSet + Send + Sync>(set: T) -> Vec<PDF> {
 /// This struct provides a high-level interface for accessing PDF data,
 /// including interpolation and metadata retrieval. It encapsulates the
 /// `GridPDF` struct, which handles the low-level grid operations.
+///
+/// Cloning a `PDF` is cheap, as the clone shares the knot values and the interpolators of
+/// the original.
+#[derive(Clone)]
 pub struct PDF {
     grid_pdf: GridPDF,
+    /// The copies of the member bound to the NUMA nodes other than the first one, if loaded
+    /// with [`NumaPolicy::Replicate`] on a machine with several nodes.
+    replicas: Vec<GridPDF>,
 }
 
 impl PDF {
+    /// Returns the copy of the member bound to the NUMA node of the calling thread, or the
+    /// member itself if it is not replicated. The node is cached by the thread, see
+    /// `placement::cached_node`.
+    #[inline]
+    fn grid(&self) -> &GridPDF {
+        if self.replicas.is_empty() {
+            return &self.grid_pdf;
+        }
+        match placement::cached_node() {
+            0 => &self.grid_pdf,
+            node => self.replicas.get(node - 1).unwrap_or(&self.grid_pdf),
+        }
+    }
+
     /// Loads a given member of the PDF set.
     ///
     /// This function reads the `.info` file and the corresponding `.dat` member file
@@ -138,13 +290,46 @@ impl PDF {
     ///
     /// A `PDF` instance representing the loaded PDF member.
     pub fn load(pdf_name: &str, member: usize) -> Self {
-        if pdf_name.ends_with(".neopdf.lz4") {
-            pdfset_loader(NeopdfSet::new(pdf_name), member)
-        } else {
-            pdfset_loader(LhapdfSet::new(pdf_name), member)
+        Self::load_with_options(pdf_name, member, LoadOptions::default())
+    }
+
+    /// Loads a given member of the PDF set, building its interpolators according to
+    /// `options`.
+    ///
+    /// # Arguments
+    ///
+    /// * `pdf_name` - The name of the PDF set (e.g., "NNPDF40_nnlo_as_01180").
+    /// * `member` - The ID of the PDF member to load (0-indexed).
+    /// * `options` - The `LoadOptions`, e.g. to precompute the bicubic coefficient tables.
+    ///
+    /// # Returns
+    ///
+    /// A `PDF` instance representing the loaded PDF member.
+    pub fn load_with_options(pdf_name: &str, member: usize, options: LoadOptions) -> Self {
+        match PdfSetFormat::from_set_name(pdf_name) {
+            PdfSetFormat::Neopdf => pdfset_loader(&NeopdfSet::new(pdf_name), member, options),
+            PdfSetFormat::Lhapdf => pdfset_loader(&LhapdfSet::new(pdf_name), member, options),
         }
     }
 
+    /// Returns a shared handle to a given member of the PDF set, which is only loaded if no
+    /// handle to the same member with the same `options` is alive in the process.
+    ///
+    /// Abstraction to the `registry::load_shared` function.
+    ///
+    /// # Arguments
+    ///
+    /// * `pdf_name` - The name of the PDF set (e.g., "NNPDF40_nnlo_as_01180").
+    /// * `member` - The ID of the PDF member to load (0-indexed).
+    /// * `options` - The `LoadOptions` used to build the member.
+    ///
+    /// # Returns
+    ///
+    /// An `Arc<PDF>` shared with the other handles to the same member.
+    pub fn load_shared(pdf_name: &str, member: usize, options: LoadOptions) -> Arc<Self> {
+        registry::load_shared(pdf_name, member, options)
+    }
+
     /// Loads all members of a PDF set in parallel.
     ///
     /// This function reads the `.info` file and all `.dat` member files
@@ -159,10 +344,24 @@ impl PDF {
     ///
     /// A `Vec<PDF>` where each element is a `PDF` instance for a member of the set.
     pub fn load_pdfs(pdf_name: &str) -> Vec<PDF> {
-        if pdf_name.ends_with(".neopdf.lz4") {
-            pdfsets_par_loader(NeopdfSet::new(pdf_name))
-        } else {
-            pdfsets_par_loader(LhapdfSet::new(pdf_name))
+        Self::load_pdfs_with_options(pdf_name, LoadOptions::default())
+    }
+
+    /// Loads all members of a PDF set in parallel, building their interpolators according
+    /// to `options`.
+    ///
+    /// # Arguments
+    ///
+    /// * `pdf_name` - The name of the PDF set.
+    /// * `options` - The `LoadOptions`, e.g. to precompute the bicubic coefficient tables.
+    ///
+    /// # Returns
+    ///
+    /// A `Vec<PDF>` where each element is a `PDF` instance for a member of the set.
+    pub fn load_pdfs_with_options(pdf_name: &str, options: LoadOptions) -> Vec<PDF> {
+        match PdfSetFormat::from_set_name(pdf_name) {
+            PdfSetFormat::Neopdf => pdfsets_par_loader(NeopdfSet::new(pdf_name), options),
+            PdfSetFormat::Lhapdf => pdfsets_par_loader(LhapdfSet::new(pdf_name), options),
         }
     }
 
@@ -180,22 +379,22 @@ impl PDF {
     ///
     /// A `Vec<PDF>` where each element is a `PDF` instance for a member of the set.
     pub fn load_pdfs_seq(pdf_name: &str) -> Vec<PDF> {
-        if pdf_name.ends_with(".neopdf.lz4") {
-            pdfsets_seq_loader(NeopdfSet::new(pdf_name))
-        } else {
-            pdfsets_seq_loader(LhapdfSet::new(pdf_name))
+        match PdfSetFormat::from_set_name(pdf_name) {
+            PdfSetFormat::Neopdf => pdfsets_seq_loader(NeopdfSet::new(pdf_name)),
+            PdfSetFormat::Lhapdf => pdfsets_seq_loader(LhapdfSet::new(pdf_name)),
         }
     }
 
     /// Creates an iterator that loads PDF members lazily.
     ///
-    /// This function is suitable for `.neopdf.lz4` files, which support lazy loading.
+    /// This function is suitable for `.neopdf.lz4` and `.neopdf` files, which support lazy
+    /// loading.
     /// It returns an iterator that yields `PDF` instances on demand, which is useful
     /// for reducing memory consumption when working with large PDF sets.
     ///
     /// # Arguments
     ///
-    /// * `pdf_name` - The name of the PDF set (must end with `.neopdf.lz4`).
+    /// * `pdf_name` - The name of the PDF set (must end with `.neopdf.lz4` or `.neopdf`).
     ///
     /// # Returns
     ///
@@ -204,29 +403,97 @@ impl PDF {
         pdf_name: &str,
     ) -> impl Iterator<Item = Result<PDF, Box<dyn std::error::Error>>> {
         assert!(
-            pdf_name.ends_with(".neopdf.lz4"),
-            "Lazy loading is only supported for .neopdf.lz4 files"
+            matches!(PdfSetFormat::from_set_name(pdf_name), PdfSetFormat::Neopdf),
+            "Lazy loading is only supported for .neopdf.lz4 and .neopdf files"
         );
 
         let iter_lazy = NeopdfSet::new(pdf_name).into_lazy_iterators();
 
         iter_lazy.map(|grid_array_with_metadata_result| {
+            let started = Instant::now();
             grid_array_with_metadata_result.map(|grid_array_with_metadata| {
                 let info = (*grid_array_with_metadata.metadata).clone();
                 let knot_array = grid_array_with_metadata.grid;
-                PDF {
-                    grid_pdf: GridPDF::new(info, knot_array),
-                }
+                build_member(started, info, knot_array, LoadOptions::default())
             })
         })
     }
 
+    /// Creates an iterator that loads PDF members lazily, decoding the following members
+    /// and building their interpolators on a background thread while the current one is
+    /// processed.
+    ///
+    /// At most `prefetch_depth` members ready to be consumed are queued, in addition to
+    /// the one being built, which bounds the memory held by the prefetched members. The
+    /// background thread stops after the first error or when the iterator is dropped. If it
+    /// panics, the panic is yielded as the last item of the iterator, as an error.
+    ///
+    /// # Arguments
+    ///
+    /// * `pdf_name` - The name of the PDF set (must end with `.neopdf.lz4` or `.neopdf`).
+    /// * `prefetch_depth` - The maximum number of members queued ahead of the consumer.
+    /// * `options` - The `LoadOptions` used to build the members.
+    ///
+    /// # Returns
+    ///
+    /// An iterator over `Result<PDF, Box<dyn std::error::Error>>`.
+    pub fn load_pdfs_lazy_prefetched(
+        pdf_name: &str,
+        prefetch_depth: usize,
+        options: LoadOptions,
+    ) -> impl Iterator<Item = Result<PDF, Box<dyn std::error::Error>>> {
+        assert!(
+            matches!(PdfSetFormat::from_set_name(pdf_name), PdfSetFormat::Neopdf),
+            "Lazy loading is only supported for .neopdf.lz4 and .neopdf files"
+        );
+
+        let iter_lazy = NeopdfSet::new(pdf_name).into_lazy_iterators();
+        let (sender, receiver) = mpsc::sync_channel(prefetch_depth);
+
+        let loader = thread::spawn(move || {
+            for grid_array_with_metadata_result in iter_lazy {
+                let started = Instant::now();
+                let pdf = grid_array_with_metadata_result
+                    .map(|grid_array_with_metadata| {
+                        let info = (*grid_array_with_metadata.metadata).clone();
+                        let knot_array = grid_array_with_metadata.grid;
+                        build_member(started, info, knot_array, options)
+                    })
+                    .map_err(|err| err.to_string());
+                let failed = pdf.is_err();
+
+                if sender.send(pdf).is_err() || failed {
+                    break;
+                }
+            }
+        });
+
+        // The channel is closed once the loader returns or unwinds, after which it is
+        // joined to tell both apart.
+        let mut loader = Some(loader);
+        let mut receiver = receiver.into_iter();
+        std::iter::from_fn(move || match receiver.next() {
+            Some(pdf) => Some(pdf.map_err(Into::into)),
+            None => loader.take()?.join().err().map(|payload| {
+                let message = payload
+                    .downcast_ref::<&str>()
+                    .map(|message| (*message).to_string())
+                    .or_else(|| payload.downcast_ref::<String>().cloned())
+                    .unwrap_or_else(|| "unknown panic".to_string());
+                Err(format!("The prefetching of the members panicked: {message}").into())
+            }),
+        })
+    }
+
     /// Clip the negative values for the `PDF` object.
     ///
     /// # Arguments
     ///
     /// * `option` - The method used to clip negative values.
     pub fn set_force_positive(&mut self, option: ForcePositive) {
+        for replica in &mut self.replicas {
+            replica.set_force_positive(option.clone());
+        }
         self.grid_pdf.set_force_positive(option);
     }
 
@@ -242,6 +509,48 @@ impl PDF {
         }
     }
 
+    /// Builds the interpolators of the given flavors ahead of the evaluations.
+    ///
+    /// The interpolators of a member are otherwise built on their first use, which then
+    /// takes longer than the following ones.
+    ///
+    /// Abstraction to the `GridPDF::warmup` method.
+    ///
+    /// # Arguments
+    ///
+    /// * `pids` - The flavor IDs whose interpolators are built.
+    ///
+    /// # Returns
+    ///
+    /// A `Result` which is `Ok(())` if all the flavors are part of the member.
+    pub fn warmup(&self, pids: &[i32]) -> Result<(), Error> {
+        self.replicas
+            .iter()
+            .try_for_each(|replica| replica.warmup(pids))?;
+        self.grid_pdf.warmup(pids)
+    }
+
+    /// Builds the interpolators of the given flavors for all the `PDF` objects in parallel.
+    ///
+    /// # Arguments
+    ///
+    /// * `pdfs` - A slice where each element is a `PDF` instance.
+    /// * `pids` - The flavor IDs whose interpolators are built.
+    ///
+    /// # Returns
+    ///
+    /// A `Result` which is `Ok(())` if all the flavors are part of all the members.
+    pub fn warmup_members(pdfs: &[PDF], pids: &[i32]) -> Result<(), Error> {
+        pdfs.par_iter().try_for_each(|pdf| pdf.warmup(pids))
+    }
+
+    /// Returns the number of interpolators of the member built so far.
+    ///
+    /// Abstraction to the `GridPDF::num_built_interpolators` method.
+    pub fn num_built_interpolators(&self) -> usize {
+        self.grid_pdf.num_built_interpolators()
+    }
+
     /// Returns the clipping method used for a single `PDF` object.
     ///
     /// # Returns
@@ -267,7 +576,33 @@ impl PDF {
     ///
     /// The interpolated PDF value `xf(nuclone, alphas, flavor, x, Q^2)`.
     pub fn xfxq2(&self, pid: i32, points: &[f64]) -> f64 {
-        self.grid_pdf.xfxq2(pid, points).unwrap()
+        self.grid().xfxq2(pid, points).unwrap()
+    }
+
+    /// Interpolates the PDF value (xf) of a flavor at several values of the leading
+    /// coordinate of a point, e.g. at several nucleon numbers `A` for a fixed `(x, Q2)`.
+    ///
+    /// Abstraction to the `GridPDF::xfxq2_scan` method.
+    ///
+    /// # Arguments
+    ///
+    /// * `pid` - The flavor ID (PDG ID).
+    /// * `points` - The coordinates of the point, whose leading coordinate is ignored.
+    /// * `values` - The values of the leading coordinate.
+    /// * `out` - The output buffer, with the same length as `values`.
+    ///
+    /// # Errors
+    ///
+    /// Returns an `Error` if the buffer size is inconsistent, if the flavor ID is not part
+    /// of the grid, or if the interpolation fails.
+    pub fn xfxq2_scan(
+        &self,
+        pid: i32,
+        points: &[f64],
+        values: &[f64],
+        out: &mut [f64],
+    ) -> Result<(), Error> {
+        self.grid().xfxq2_scan(pid, points, values, out)
     }
 
     /// Interpolates the PDF value (xf) for multiple nucleons, alphas, flavors, xs, and Q2s.
@@ -284,7 +619,167 @@ impl PDF {
     ///
     /// A 2D array of interpolated PDF values with shape `[flavors, N_knots]`.
     pub fn xfxq2s(&self, pids: Vec<i32>, slice_points: &[&[f64]]) -> Array2<f64> {
-        self.grid_pdf.xfxq2s(pids, slice_points)
+        self.grid().xfxq2s(pids, slice_points)
+    }
+
+    /// Interpolates the PDF values (xf) for multiple flavors and points into a caller-owned
+    /// buffer, with a status per value.
+    ///
+    /// Abstraction to the `GridPDF::xfxq2s_into` method.
+    ///
+    /// # Arguments
+    ///
+    /// * `pids` - A slice of flavor IDs.
+    /// * `slice_points` - A slice containing the collection of knots to interpolate on.
+    ///   A knot is a collection of points containing `(nucleon, alphas, x, Q2)`.
+    /// * `out` - The output buffer of shape `[pids, points]` flattened in row-major order.
+    /// * `status` - The status of each value, with the same length as `out`.
+    /// * `executor` - The executor running the chunks of the batch.
+    ///
+    /// # Errors
+    ///
+    /// Returns an `Error` if the buffer sizes are inconsistent.
+    pub fn xfxq2s_into(
+        &self,
+        pids: &[i32],
+        slice_points: &[&[f64]],
+        out: &mut [f64],
+        status: &mut [PointStatus],
+        executor: &dyn BatchExecutor,
+    ) -> Result<(), Error> {
+        self.grid()
+            .xfxq2s_into(pids, slice_points, out, status, executor)
+    }
+
+    /// Interpolates the PDF values (xf) for several flavors on a batch of `(x, Q2)` points.
+    ///
+    /// Abstraction to the `GridPDF::xfxq2_batch` method.
+    ///
+    /// # Arguments
+    ///
+    /// * `pids` - A slice of flavor IDs.
+    /// * `xs` - A slice of momentum fractions `x`.
+    /// * `q2s` - A slice of energy scales `Q2`, with the same length as `xs`.
+    /// * `out` - The output buffer of shape `[pids, points]` flattened in row-major order.
+    ///
+    /// # Errors
+    ///
+    /// Returns an `Error` if the buffer sizes are inconsistent, if a flavor ID is not
+    /// part of the grid, or if the interpolation fails.
+    pub fn xfxq2_batch(
+        &self,
+        pids: &[i32],
+        xs: &[f64],
+        q2s: &[f64],
+        out: &mut [f64],
+    ) -> Result<(), Error> {
+        self.grid().xfxq2_batch(pids, xs, q2s, out)
+    }
+
+    /// Interpolates the PDF values (xf) for several flavors on a batch of `(x, Q2)` points
+    /// into a single-precision output buffer.
+    ///
+    /// Abstraction to the `GridPDF::xfxq2_batch_f32` method.
+    ///
+    /// # Arguments
+    ///
+    /// * `pids` - A slice of flavor IDs.
+    /// * `xs` - A slice of momentum fractions `x`.
+    /// * `q2s` - A slice of energy scales `Q2`, with the same length as `xs`.
+    /// * `out` - The output buffer of shape `[pids, points]` flattened in row-major order.
+    ///
+    /// # Errors
+    ///
+    /// Returns an `Error` if the buffer sizes are inconsistent, if a flavor ID is not
+    /// part of the grid, or if the interpolation fails.
+    pub fn xfxq2_batch_f32(
+        &self,
+        pids: &[i32],
+        xs: &[f64],
+        q2s: &[f64],
+        out: &mut [f32],
+    ) -> Result<(), Error> {
+        self.grid().xfxq2_batch_f32(pids, xs, q2s, out)
+    }
+
+    /// Interpolates the PDF values (xf) for several flavors on the tensor product of a list
+    /// of momentum fractions and a list of energy scales.
+    ///
+    /// Abstraction to the `GridPDF::xfxq2_grid` method.
+    ///
+    /// # Arguments
+    ///
+    /// * `pids` - A slice of flavor IDs.
+    /// * `xs` - A slice of momentum fractions `x`.
+    /// * `q2s` - A slice of energy scales `Q2`.
+    /// * `out` - The output buffer of shape `[pids, xs, q2s]` flattened in row-major order.
+    ///
+    /// # Errors
+    ///
+    /// Returns an `Error` if the buffer size is inconsistent, if a flavor ID is not part of
+    /// the grid, or if the interpolation fails.
+    pub fn xfxq2_grid(
+        &self,
+        pids: &[i32],
+        xs: &[f64],
+        q2s: &[f64],
+        out: &mut [f64],
+    ) -> Result<(), Error> {
+        self.grid().xfxq2_grid(pids, xs, q2s, out)
+    }
+
+    /// Interpolates the PDF values (xf) for several flavors at a fixed momentum fraction
+    /// and several energy scales, together with `alpha_s` at these scales.
+    ///
+    /// Abstraction to the `GridPDF::xfxq2_fixed_x` method.
+    ///
+    /// # Arguments
+    ///
+    /// * `pids` - A slice of flavor IDs.
+    /// * `x` - The momentum fraction `x`.
+    /// * `q2s` - A slice of energy scales `Q2`.
+    /// * `out` - The output buffer of shape `[pids, q2s]` flattened in row-major order.
+    /// * `alphas` - The output buffer of `alpha_s`, with the same length as `q2s`.
+    ///
+    /// # Errors
+    ///
+    /// Returns an `Error` if the buffer sizes are inconsistent, if a flavor ID is not part
+    /// of the grid, or if the interpolation fails.
+    pub fn xfxq2_fixed_x(
+        &self,
+        pids: &[i32],
+        x: f64,
+        q2s: &[f64],
+        out: &mut [f64],
+        alphas: &mut [f64],
+    ) -> Result<(), Error> {
+        self.grid().xfxq2_fixed_x(pids, x, q2s, out, alphas)
+    }
+
+    /// Interpolates the PDF values (xf) for several flavors at several momentum fractions
+    /// and a fixed energy scale, and returns `alpha_s` at this scale.
+    ///
+    /// Abstraction to the `GridPDF::xfxq2_fixed_q2` method.
+    ///
+    /// # Arguments
+    ///
+    /// * `pids` - A slice of flavor IDs.
+    /// * `xs` - A slice of momentum fractions `x`.
+    /// * `q2` - The energy scale `Q2`.
+    /// * `out` - The output buffer of shape `[pids, xs]` flattened in row-major order.
+    ///
+    /// # Errors
+    ///
+    /// Returns an `Error` if the buffer size is inconsistent, if a flavor ID is not part of
+    /// the grid, or if the interpolation fails.
+    pub fn xfxq2_fixed_q2(
+        &self,
+        pids: &[i32],
+        xs: &[f64],
+        q2: f64,
+        out: &mut [f64],
+    ) -> Result<f64, Error> {
+        self.grid().xfxq2_fixed_q2(pids, xs, q2, out)
     }
 
     /// Interpolates the PDF value (xf) for multiple points using Chebyshev batch interpolation.
@@ -301,7 +796,37 @@ impl PDF {
     ///
     /// A `Vec<f64>` of interpolated PDF values.
     pub fn xfxq2_cheby_batch(&self, pid: i32, points: &[&[f64]]) -> Vec<f64> {
-        self.grid_pdf.xfxq2_cheby_batch(pid, points).unwrap()
+        self.grid().xfxq2_cheby_batch(pid, points).unwrap()
+    }
+
+    /// Interpolates the PDF value (xf) for multiple points into a caller-owned buffer using
+    /// Chebyshev batch interpolation, with a status per value.
+    ///
+    /// Abstraction to the `GridPDF::xfxq2_cheby_batch_into` method.
+    ///
+    /// # Arguments
+    ///
+    /// * `pid` - The flavor ID.
+    /// * `points` - A slice containing the collection of knots to interpolate on.
+    ///   A knot is a collection of points containing `(nucleon, alphas, x, Q2)`.
+    /// * `out` - The output buffer, with the same length as `points`.
+    /// * `status` - The status of each value, with the same length as `points`.
+    /// * `executor` - The executor running the chunks of the batch.
+    ///
+    /// # Errors
+    ///
+    /// Returns an `Error` if the buffer sizes are inconsistent, if the flavor ID is not part
+    /// of the grid, or if the interpolator is not `LogChebyshev`.
+    pub fn xfxq2_cheby_batch_into(
+        &self,
+        pid: i32,
+        points: &[&[f64]],
+        out: &mut [f64],
+        status: &mut [PointStatus],
+        executor: &dyn BatchExecutor,
+    ) -> Result<(), Error> {
+        self.grid()
+            .xfxq2_cheby_batch_into(pid, points, out, status, executor)
     }
 
     /// Interpolates the strong coupling constant `alpha_s` for a given Q2.
@@ -319,6 +844,23 @@ impl PDF {
         self.grid_pdf.alphas_q2(q2)
     }
 
+    /// Interpolates the strong coupling constant `alpha_s` for several values of Q2.
+    ///
+    /// Abstraction to the `GridPDF::alphas_q2_batch` method.
+    ///
+    /// # Arguments
+    ///
+    /// * `q2s` - A slice of squared energy scales.
+    /// * `out` - The output buffer, such that `out[i]` holds the value at `q2s[i]`.
+    ///
+    /// # Returns
+    ///
+    /// A `Result` which is `Ok(())` if the values were computed or an `Error` if the lengths
+    /// of `q2s` and `out` differ.
+    pub fn alphas_q2_batch(&self, q2s: &[f64], out: &mut [f64]) -> Result<(), Error> {
+        self.grid_pdf.alphas_q2_batch(q2s, out)
+    }
+
     /// Returns a reference to the PDF metadata.
     ///
     /// Abstraction to the `GridPDF::info` method.
@@ -361,6 +903,133 @@ impl PDF {
         &self.grid_pdf.knot_array.subgrids
     }
 
+    /// Returns the number of bytes held by the knot values, the knots and the interpolators
+    /// built so far of the member.
+    ///
+    /// Abstraction to the `GridPDF::resident_bytes` method.
+    ///
+    /// # Returns
+    ///
+    /// The number of bytes resident for the grid data of the member.
+    pub fn resident_bytes(&self) -> usize {
+        self.grid_pdf.resident_bytes()
+            + self
+                .replicas
+                .iter()
+                .map(GridPDF::resident_bytes)
+                .sum::<usize>()
+    }
+
+    /// Enables or disables the recording of the evaluations in the counters returned by
+    /// `PDF::stats`. The recording is disabled by default.
+    ///
+    /// The counters are shared by the clones of the member, see [`crate::stats`].
+    ///
+    /// # Arguments
+    ///
+    /// * `enabled` - Whether the evaluations are recorded.
+    pub fn enable_stats(&self, enabled: bool) {
+        self.grid_pdf.eval_stats().enable(enabled);
+    }
+
+    /// Returns a snapshot of the counters of the member, aggregated over all the threads.
+    ///
+    /// Abstraction to the `GridPDF::stats` method.
+    ///
+    /// # Returns
+    ///
+    /// The `EvalStatistics` of the load and of the recorded evaluations of the member.
+    pub fn stats(&self) -> EvalStatistics {
+        self.grid_pdf.stats()
+    }
+
+    /// Resets the counters of the member to zero, including those of its load.
+    pub fn reset_stats(&self) {
+        self.grid_pdf.eval_stats().reset();
+    }
+
+    /// Compares the values of this member with the ones of a `reference` member, e.g. the
+    /// same member loaded with and without `LoadOptions::single_precision`.
+    ///
+    /// Both members are evaluated for all their flavors on the knots of every subgrid of
+    /// this member and on the centers of its cells, i.e. the geometric means of consecutive
+    /// knots in `x` and `Q2`. The additional dimensions of the subgrids, if any, are fixed to
+    /// their first knot.
+    ///
+    /// # Arguments
+    ///
+    /// * `reference` - The member the values are compared to, with the same flavors.
+    ///
+    /// # Returns
+    ///
+    /// The maximum relative and absolute deviations per flavor.
+    pub fn precision_report(&self, reference: &Self) -> PrecisionReport {
+        let pids = self.pids().to_vec();
+        let mut report = PrecisionReport {
+            max_relative: vec![0.0; pids.len()],
+            max_absolute: vec![0.0; pids.len()],
+            pids,
+            num_points: 0,
+        };
+
+        let with_centers = |knots: &Array1<f64>| -> Vec<f64> {
+            let mut values = knots.to_vec();
+            values.extend(knots.windows(2).into_iter().map(|w| (w[0] * w[1]).sqrt()));
+            values
+        };
+
+        for subgrid in self.subgrids() {
+            let mut point: Vec<f64> = [&subgrid.nucleons, &subgrid.alphas, &subgrid.kts]
+                .into_iter()
+                .filter(|knots| knots.len() > 1)
+                .map(|knots| knots[0])
+                .collect();
+            point.extend([0.0, 0.0]);
+            let ndims = point.len();
+
+            for x in with_centers(&subgrid.xs) {
+                for q2 in with_centers(&subgrid.q2s) {
+                    point[ndims - 2] = x;
+                    point[ndims - 1] = q2;
+                    report.num_points += 1;
+
+                    for (ipid, &pid) in report.pids.iter().enumerate() {
+                        let (Ok(value), Ok(expected)) = (
+                            self.grid_pdf.xfxq2(pid, &point),
+                            reference.grid_pdf.xfxq2(pid, &point),
+                        ) else {
+                            continue;
+                        };
+                        let deviation = (value - expected).abs();
+                        report.max_absolute[ipid] = report.max_absolute[ipid].max(deviation);
+                        if expected != 0.0 {
+                            let relative = deviation / expected.abs();
+                            report.max_relative[ipid] = report.max_relative[ipid].max(relative);
+                        }
+                    }
+                }
+            }
+        }
+
+        report
+    }
+
+    /// Finds the index of the subgrid that contains the given point.
+    ///
+    /// Abstraction to the `GridArray::find_subgrid` method. If no subgrid contains the
+    /// point, the index of the closest subgrid is returned.
+    ///
+    /// # Arguments
+    ///
+    /// * `points` - A slice containing the coordinates of the point `(..., x, Q2)`.
+    ///
+    /// # Returns
+    ///
+    /// The index of the subgrid, or `None` if the grid does not have any subgrid.
+    pub fn find_subgrid(&self, points: &[f64]) -> Option<usize> {
+        self.grid_pdf.knot_array.find_subgrid(points)
+    }
+
     /// Returns the flavor PIDS of the PDG Grid.
     ///
     /// # Returns
@@ -410,8 +1079,43 @@ impl PDF {
         id: i32,
         subgrid_id: usize,
     ) -> f64 {
-        self.grid_pdf
+        self.grid()
             .knot_array
             .xf_from_index(i_nucleons, i_alphas, i_kt, ix, iq2, id, subgrid_id)
     }
 }
+
+/// Deviation of the values of a PDF member from the ones of a reference member, per flavor.
+///
+/// See [`PDF::precision_report`]. The report is printed as a table with a row per flavor.
+#[derive(Debug, Clone, PartialEq)]
+pub struct PrecisionReport {
+    /// The flavor IDs.
+    pub pids: Vec<i32>,
+    /// The maximum relative deviation of each flavor, ignoring the points where the
+    /// reference value vanishes.
+    pub max_relative: Vec<f64>,
+    /// The maximum absolute deviation of each flavor.
+    pub max_absolute: Vec<f64>,
+    /// The number of points at which the members are compared.
+    pub num_points: usize,
+}
+
+impl fmt::Display for PrecisionReport {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        writeln!(
+            f,
+            "{:>6}  {:>14}  {:>14}",
+            "PID", "max. rel. dev.", "max. abs. dev."
+        )?;
+        for ((pid, relative), absolute) in self
+            .pids
+            .iter()
+            .zip(&self.max_relative)
+            .zip(&self.max_absolute)
+        {
+            writeln!(f, "{pid:>6}  {relative:>14.6e}  {absolute:>14.6e}")?;
+        }
+        write!(f, "({} points)", self.num_points)
+    }
+}
@@ -0,0 +1,424 @@
+//! This module places the knot values of the loaded members in memory, on the NUMA nodes of
+//! the machine and on transparent huge pages.
+//!
+//! # Contents
+//!
+//! - [`NumaPolicy`]: The placement of the knot values on the NUMA nodes.
+//! - [`num_nodes`], [`current_node`]: The NUMA topology seen by the calling thread.
+//!
+//! # Note
+//!
+//! The knot values of a member are otherwise held by one allocation per subgrid, whose pages
+//! are placed by the kernel on the node of the thread first writing them, i.e. of the thread
+//! that happened to decode the member. When the members of a set are loaded in parallel,
+//! their pages end up scattered across the nodes, and every evaluation thread pays for the
+//! latency of the remote ones.
+//!
+//! When `LoadOptions::huge_pages` is set or the policy differs from
+//! [`NumaPolicy::FirstTouch`], the knot values of all the members loaded together are
+//! instead copied into a single buffer aligned to a huge page, which is advised and bound to
+//! its nodes before its pages are first written. The subgrids then hold slices of that
+//! buffer, which is released with the last of them. Both the advice and the binding are
+//! best-effort: they are ignored on other platforms than Linux, or if the kernel rejects
+//! them, e.g. without NUMA support or with transparent huge pages disabled.
+//!
+//! Only the knot values are placed: the knots of the axes, the interpolators and their
+//! coefficient tables are small, or allocated by the threads first using them.
+
+use ndarray::{s, ArcArray, ArcArray1, Array1, Ix6};
+use std::cell::Cell;
+use std::sync::OnceLock;
+
+use super::gridpdf::GridArray;
+use super::subgrid::SubGrid;
+
+/// The size of a transparent huge page, to which the packed knot values are aligned.
+const HUGE_PAGE_SIZE: usize = 2 << 20;
+
+/// The size of a regular page.
+const PAGE_SIZE: usize = 4 << 10;
+
+/// The placement of the knot values of the loaded members on the NUMA nodes.
+///
+/// The policy only matters on machines with several NUMA nodes, e.g. multi-socket nodes, on
+/// which it trades the resident memory of the set for the latency of its evaluations.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq, Hash)]
+pub enum NumaPolicy {
+    /// The pages are placed on the node of the thread first writing them, i.e. of the
+    /// threads decoding the members. This is the behaviour of the kernel.
+    #[default]
+    FirstTouch,
+    /// The pages are distributed round-robin over all the nodes, such that every thread
+    /// sees the same average latency and the bandwidth of all the nodes is used. The
+    /// resident memory is unchanged.
+    Interleave,
+    /// The knot values are copied once per node and bound to it, and every evaluation reads
+    /// the copy of the node of the calling thread. The resident memory of the knot values is
+    /// multiplied by the number of nodes.
+    Replicate,
+}
+
+/// The nodes of the machine and the node of each CPU.
+struct Topology {
+    /// The identifiers of the online nodes.
+    nodes: Vec<usize>,
+    /// The position in `nodes` of the node of each CPU.
+    cpu_nodes: Vec<usize>,
+}
+
+impl Topology {
+    /// Reads the topology from `/sys/devices/system/node`, or falls back to a single node.
+    fn detect() -> Self {
+        let read = |path: &str| std::fs::read_to_string(path).ok();
+        let nodes = read("/sys/devices/system/node/online")
+            .map(|list| parse_list(&list))
+            .filter(|nodes| !nodes.is_empty())
+            .unwrap_or_else(|| vec![0]);
+
+        let mut cpu_nodes = Vec::new();
+        for (position, node) in nodes.iter().enumerate() {
+            let cpus = read(&format!("/sys/devices/system/node/node{node}/cpulist"))
+                .map(|list| parse_list(&list))
+                .unwrap_or_default();
+            for cpu in cpus {
+                if cpu >= cpu_nodes.len() {
+                    cpu_nodes.resize(cpu + 1, 0);
+                }
+                cpu_nodes[cpu] = position;
+            }
+        }
+
+        Self { nodes, cpu_nodes }
+    }
+}
+
+/// Returns the topology of the machine, read on first use.
+fn topology() -> &'static Topology {
+    static TOPOLOGY: OnceLock<Topology> = OnceLock::new();
+    TOPOLOGY.get_or_init(Topology::detect)
+}
+
+/// Parses a list of ranges of the form `0-3,8,10-11`, as used by `sysfs`.
+fn parse_list(list: &str) -> Vec<usize> {
+    list.trim()
+        .split(',')
+        .filter(|range| !range.is_empty())
+        .filter_map(|range| match range.split_once('-') {
+            Some((first, last)) => Some(first.parse().ok()?..=last.parse().ok()?),
+            None => range.parse().ok().map(|value| value..=value),
+        })
+        .flatten()
+        .collect()
+}
+
+/// Returns the number of NUMA nodes of the machine, which is 1 on other platforms than
+/// Linux.
+pub fn num_nodes() -> usize {
+    topology().nodes.len()
+}
+
+/// Returns the position, among the [`num_nodes`] nodes, of the node of the CPU the calling
+/// thread is running on.
+///
+/// The thread may be migrated to another node right after, unless it is pinned to the CPUs
+/// of a node.
+pub fn current_node() -> usize {
+    #[cfg(target_os = "linux")]
+    {
+        // SAFETY: `sched_getcpu` has no preconditions.
+        let cpu = unsafe { sys::sched_getcpu() };
+        if let Ok(cpu) = usize::try_from(cpu) {
+            return topology().cpu_nodes.get(cpu).copied().unwrap_or(0);
+        }
+    }
+    0
+}
+
+/// The NUMA memory policy of a buffer of knot values.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub(crate) enum MemoryPolicy {
+    /// The policy of the calling thread, i.e. first touch by default.
+    Default,
+    /// Interleaved over all the nodes.
+    Interleave,
+    /// Placed on the node at the given position, if it has free memory.
+    Node(usize),
+}
+
+/// Copies the knot values of all the subgrids of `grids` into a single buffer per precision,
+/// placed according to `policy` and backed by transparent huge pages if `huge_pages` is set,
+/// and makes the subgrids hold slices of these buffers.
+pub(crate) fn pack(grids: &mut [GridArray], huge_pages: bool, policy: MemoryPolicy) {
+    let mut subgrids: Vec<&mut SubGrid> = grids
+        .iter_mut()
+        .flat_map(|grid| grid.subgrids.iter_mut())
+        .collect();
+
+    let arrays: Vec<_> = subgrids.iter().map(|subgrid| &subgrid.grid).collect();
+    let packed = pack_arrays(&arrays, huge_pages, policy);
+    let arrays: Vec<_> = subgrids
+        .iter()
+        .filter_map(|subgrid| subgrid.grid_f32.as_ref())
+        .collect();
+    let mut packed_f32 = pack_arrays(&arrays, huge_pages, policy).into_iter();
+
+    for (subgrid, grid) in subgrids.iter_mut().zip(packed) {
+        subgrid.grid = grid;
+        if let Some(grid_f32) = subgrid.grid_f32.as_mut() {
+            *grid_f32 = packed_f32.next().expect("Missing packed knot values");
+        }
+    }
+}
+
+/// Copies `arrays` into consecutive slices of a single buffer, see [`allocate`].
+///
+/// The arrays keep their layout in memory, e.g. the flavors innermost of the interleaved
+/// subgrids, see `SubGrid::interleave`.
+fn pack_arrays<T: Copy + Default>(
+    arrays: &[&ArcArray<T, Ix6>],
+    huge_pages: bool,
+    policy: MemoryPolicy,
+) -> Vec<ArcArray<T, Ix6>> {
+    let len: usize = arrays.iter().map(|array| array.len()).sum();
+    if len == 0 {
+        return arrays.iter().map(|&array| array.clone()).collect();
+    }
+
+    let values = arrays.iter().flat_map(|array| {
+        let in_memory_order = array.view().permuted_axes(memory_order(array));
+        in_memory_order.into_iter().copied()
+    });
+    let (buffer, mut start) = allocate(len, huge_pages, policy, values);
+
+    arrays
+        .iter()
+        .map(|array| {
+            let order = memory_order(array);
+            let mut inverse = [0; 6];
+            for (position, &axis) in order.iter().enumerate() {
+                inverse[axis] = position;
+            }
+
+            let packed = buffer
+                .clone()
+                .slice_move(s![start..start + array.len()])
+                .into_shape_with_order(array.view().permuted_axes(order).raw_dim())
+                .expect("Failed to reshape the packed knot values")
+                .permuted_axes(inverse);
+            start += array.len();
+            packed
+        })
+        .collect()
+}
+
+/// Returns the axes of `array` from the outermost to the innermost in memory.
+fn memory_order<T>(array: &ArcArray<T, Ix6>) -> [usize; 6] {
+    let mut order = [0, 1, 2, 3, 4, 5];
+    order.sort_by_key(|&axis| std::cmp::Reverse(array.strides()[axis]));
+    order
+}
+
+/// Allocates a buffer holding `len` values starting on a huge page, places it, and fills it
+/// with `values`, completed with default values if they are fewer than `len`.
+///
+/// The buffer is allocated uninitialised, such that none of its pages is touched before it
+/// is advised and bound, and its values are then written, which is when the kernel
+/// allocates the pages. It is padded such that the advised range, rounded up to whole pages,
+/// lies within the allocation.
+///
+/// # Returns
+///
+/// The buffer and the position of its first value.
+fn allocate<T: Copy + Default>(
+    len: usize,
+    huge_pages: bool,
+    policy: MemoryPolicy,
+    values: impl IntoIterator<Item = T>,
+) -> (ArcArray1<T>, usize) {
+    let size = std::mem::size_of::<T>();
+    let mut buffer = Vec::with_capacity(len + (HUGE_PAGE_SIZE + PAGE_SIZE) / size);
+    let spare = buffer.spare_capacity_mut();
+    let capacity = spare.len();
+    let address = spare.as_ptr() as usize;
+    let start = (address.next_multiple_of(HUGE_PAGE_SIZE) - address) / size;
+
+    let bytes = (len * size).next_multiple_of(PAGE_SIZE);
+    advise(
+        spare[start..].as_mut_ptr().cast(),
+        bytes,
+        huge_pages,
+        policy,
+    );
+
+    let mut values = values.into_iter();
+    for (index, slot) in spare.iter_mut().enumerate() {
+        let value = (start..start + len)
+            .contains(&index)
+            .then(|| values.next())
+            .flatten();
+        slot.write(value.unwrap_or_default());
+    }
+    // SAFETY: all the values of the spare capacity were written above.
+    unsafe { buffer.set_len(capacity) };
+
+    (Array1::from_vec(buffer).into_shared(), start)
+}
+
+/// Returns [`current_node`], cached by the calling thread and refreshed every
+/// `NODE_REFRESH_CALLS` calls, such that frequent callers, e.g. the evaluations of the
+/// replicated members, do not query the CPU each time.
+pub(crate) fn cached_node() -> usize {
+    /// The number of calls after which the cached node is refreshed, bounding how long a
+    /// migrated thread keeps reading the copy of its previous node.
+    const NODE_REFRESH_CALLS: u32 = 1024;
+
+    thread_local! {
+        /// The cached node and the number of calls left before it is refreshed.
+        static NODE: Cell<(usize, u32)> = const { Cell::new((0, 0)) };
+    }
+
+    NODE.with(|cached| {
+        let (node, calls) = match cached.get() {
+            (_, 0) => (current_node(), NODE_REFRESH_CALLS),
+            cached => cached,
+        };
+        cached.set((node, calls - 1));
+        node
+    })
+}
+
+/// Advises the kernel to back `bytes` bytes at `address` with transparent huge pages if
+/// `huge_pages` is set, and binds them according to `policy`.
+#[cfg(target_os = "linux")]
+fn advise(address: *mut std::ffi::c_void, bytes: usize, huge_pages: bool, policy: MemoryPolicy) {
+    if huge_pages {
+        // SAFETY: the range is page aligned and lies within a live allocation, and the
+        // advice does not change its contents. Failures are ignored.
+        unsafe { sys::madvise(address, bytes, sys::MADV_HUGEPAGE) };
+    }
+
+    let nodes = &topology().nodes;
+    let (mode, selected) = match policy {
+        MemoryPolicy::Default => return,
+        MemoryPolicy::Interleave => (sys::MPOL_INTERLEAVE, &nodes[..]),
+        MemoryPolicy::Node(position) => match nodes.get(position) {
+            Some(node) => (sys::MPOL_PREFERRED, std::slice::from_ref(node)),
+            None => return,
+        },
+    };
+    if nodes.len() > 1 {
+        sys::mbind(address, bytes, mode, selected);
+    }
+}
+
+#[cfg(not(target_os = "linux"))]
+fn advise(_: *mut std::ffi::c_void, _: usize, _: bool, _: MemoryPolicy) {}
+
+#[cfg(target_os = "linux")]
+mod sys {
+    use std::ffi::{c_int, c_void};
+
+    pub const MADV_HUGEPAGE: c_int = 14;
+    pub const MPOL_PREFERRED: c_int = 1;
+    pub const MPOL_INTERLEAVE: c_int = 3;
+
+    extern "C" {
+        pub fn madvise(addr: *mut c_void, len: usize, advice: c_int) -> c_int;
+        pub fn sched_getcpu() -> c_int;
+    }
+
+    /// Sets the memory policy of a page-aligned range to `mode` over the given nodes. The
+    /// `mbind` system call is issued directly, as it is not wrapped by the C library.
+    #[cfg(any(target_arch = "x86_64", target_arch = "aarch64"))]
+    pub fn mbind(address: *mut c_void, bytes: usize, mode: c_int, nodes: &[usize]) {
+        use std::ffi::{c_long, c_ulong};
+
+        #[cfg(target_arch = "x86_64")]
+        const SYS_MBIND: c_long = 237;
+        #[cfg(target_arch = "aarch64")]
+        const SYS_MBIND: c_long = 235;
+        /// The number of nodes representable in the node mask.
+        const MAX_NODES: usize = 1024;
+        const BITS: usize = c_ulong::BITS as usize;
+
+        extern "C" {
+            fn syscall(number: c_long, ...) -> c_long;
+        }
+
+        let mut mask = [0 as c_ulong; MAX_NODES / BITS];
+        for &node in nodes.iter().filter(|&&node| node < MAX_NODES) {
+            mask[node / BITS] |= 1 << (node % BITS);
+        }
+
+        // SAFETY: the range is page aligned and lies within a live allocation, `mask` holds
+        // `MAX_NODES` bits, of which the kernel reads one less than `maxnode`, and no flag
+        // moves the pages already in use. Failures are ignored.
+        unsafe {
+            syscall(
+                SYS_MBIND,
+                address,
+                bytes as c_ulong,
+                mode,
+                mask.as_ptr(),
+                (MAX_NODES + 1) as c_ulong,
+                0 as c_int,
+            );
+        }
+    }
+
+    #[cfg(not(any(target_arch = "x86_64", target_arch = "aarch64")))]
+    pub fn mbind(_: *mut c_void, _: usize, _: c_int, _: &[usize]) {}
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_parse_list() {
+        assert_eq!(parse_list("0\n"), vec![0]);
+        assert_eq!(parse_list("0-3,8,10-11\n"), vec![0, 1, 2, 3, 8, 10, 11]);
+        assert!(parse_list("\n").is_empty());
+    }
+
+    #[test]
+    fn test_topology() {
+        assert!(num_nodes() >= 1);
+        assert!(current_node() < num_nodes());
+        assert!((0..2048).all(|_| cached_node() < num_nodes()));
+    }
+
+    #[test]
+    fn test_allocate_aligned() {
+        let values: Vec<f64> = (0..1000).map(f64::from).collect();
+        let (buffer, start) =
+            allocate(values.len(), true, MemoryPolicy::Interleave, values.clone());
+        let region = buffer.slice(s![start..start + values.len()]);
+        assert_eq!(region.as_ptr() as usize % HUGE_PAGE_SIZE, 0);
+        assert_eq!(region.to_vec(), values);
+    }
+
+    #[test]
+    fn test_pack_keeps_layout() {
+        let values: Vec<f64> = (0..12).map(f64::from).collect();
+        let xs = vec![0.1, 0.2, 0.3];
+        let mut subgrid = SubGrid::new(
+            vec![1.0],
+            vec![0.118],
+            vec![0.0],
+            xs,
+            vec![1.0, 2.0],
+            2,
+            values,
+        );
+        subgrid.interleave();
+
+        let packed = pack_arrays(&[&subgrid.grid], false, MemoryPolicy::Default);
+        assert_eq!(packed[0], subgrid.grid);
+        assert_eq!(
+            packed[0].as_slice_memory_order(),
+            subgrid.grid.as_slice_memory_order()
+        );
+    }
+}
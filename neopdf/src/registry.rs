@@ -0,0 +1,186 @@
+//! This module provides a process-wide registry of the loaded members, such that a member
+//! requested several times is only loaded once.
+//!
+//! # Contents
+//!
+//! - [`load_shared`]: Returns a shared handle to a member, loading it only if needed.
+//! - [`report`]: Lists the members currently held by the registry.
+//! - [`RegistryEntry`], [`RegistryReport`]: Description of the registered members.
+//!
+//! # Note
+//!
+//! Applications made of several independent components, e.g. plugins, often load the same
+//! member of a set more than once, each time resolving the path of the set, parsing its files
+//! and building all the interpolators. The registry is keyed by the name of the set, the
+//! member and the `LoadOptions`, and only holds weak references: a member is dropped as soon
+//! as its last handle is, and is loaded again on the next request.
+
+use std::collections::HashMap;
+use std::fmt;
+use std::sync::{Arc, LazyLock, Mutex, PoisonError, Weak};
+
+use super::gridpdf::LoadOptions;
+use super::pdf::PDF;
+
+/// Identifies a member in the registry.
+type RegistryKey = (String, usize, LoadOptions);
+
+/// A registered member together with its number of resident bytes when it was loaded.
+struct RegisteredMember {
+    pdf: Weak<PDF>,
+    bytes: usize,
+}
+
+/// The registered members of the process.
+static REGISTRY: LazyLock<Mutex<HashMap<RegistryKey, RegisteredMember>>> =
+    LazyLock::new(|| Mutex::new(HashMap::new()));
+
+/// Returns the registry, without the members whose handles were all dropped.
+fn registry() -> std::sync::MutexGuard<'static, HashMap<RegistryKey, RegisteredMember>> {
+    let mut registry = REGISTRY.lock().unwrap_or_else(PoisonError::into_inner);
+    registry.retain(|_, member| member.pdf.strong_count() > 0);
+    registry
+}
+
+/// Returns a shared handle to a member of a PDF set, which is only loaded if no handle to
+/// the same member with the same `options` is alive in the process.
+///
+/// The member is loaded outside of the lock of the registry, such that different members
+/// are loaded concurrently. If the same member is requested concurrently while it is not
+/// registered, it may be loaded more than once, in which case the first one to finish is
+/// shared and the others are dropped.
+///
+/// # Arguments
+///
+/// * `pdf_name` - The name of the PDF set (e.g., "NNPDF40_nnlo_as_01180").
+/// * `member` - The ID of the PDF member to load (0-indexed).
+/// * `options` - The `LoadOptions` used to build the member.
+///
+/// # Returns
+///
+/// An `Arc<PDF>` shared with the other handles to the same member.
+pub fn load_shared(pdf_name: &str, member: usize, options: LoadOptions) -> Arc<PDF> {
+    let key = (pdf_name.to_string(), member, options);
+    if let Some(pdf) = registry().get(&key).and_then(|entry| entry.pdf.upgrade()) {
+        return pdf;
+    }
+
+    let pdf = Arc::new(PDF::load_with_options(pdf_name, member, options));
+    let bytes = pdf.resident_bytes();
+
+    let mut registry = registry();
+    if let Some(shared) = registry.get(&key).and_then(|entry| entry.pdf.upgrade()) {
+        return shared;
+    }
+    registry.insert(
+        key,
+        RegisteredMember {
+            pdf: Arc::downgrade(&pdf),
+            bytes,
+        },
+    );
+
+    pdf
+}
+
+/// Description of a member held by the registry.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct RegistryEntry {
+    /// The name of the PDF set.
+    pub set_name: String,
+    /// The ID of the member.
+    pub member: usize,
+    /// The options the member was built with.
+    pub options: LoadOptions,
+    /// The number of bytes held by the member, see `PDF::resident_bytes`.
+    pub resident_bytes: usize,
+    /// The number of live handles to the member.
+    pub num_handles: usize,
+}
+
+/// The members held by the registry, sorted by set name, member and options.
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct RegistryReport {
+    /// The registered members.
+    pub entries: Vec<RegistryEntry>,
+}
+
+impl RegistryReport {
+    /// Returns the number of bytes held by all the registered members.
+    pub fn resident_bytes(&self) -> usize {
+        self.entries.iter().map(|entry| entry.resident_bytes).sum()
+    }
+}
+
+impl fmt::Display for RegistryReport {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        writeln!(
+            f,
+            "{:<32}  {:>6}  {:>7}  {:>14}",
+            "Set", "Member", "Handles", "Bytes"
+        )?;
+        for entry in &self.entries {
+            let mut flags = Vec::new();
+            if entry.options.precompute_coeffs {
+                flags.push("precompute_coeffs");
+            }
+            if entry.options.single_precision {
+                flags.push("single_precision");
+            }
+            if entry.options.interleave_flavors {
+                flags.push("interleave_flavors");
+            }
+            writeln!(
+                f,
+                "{:<32}  {:>6}  {:>7}  {:>14}  {}",
+                entry.set_name,
+                entry.member,
+                entry.num_handles,
+                entry.resident_bytes,
+                flags.join(",")
+            )?;
+        }
+        write!(
+            f,
+            "({} members, {} bytes)",
+            self.entries.len(),
+            self.resident_bytes()
+        )
+    }
+}
+
+/// Lists the members currently held by the registry, i.e. those with at least one live
+/// handle.
+pub fn report() -> RegistryReport {
+    let mut entries: Vec<_> = registry()
+        .iter()
+        .map(|((set_name, member, options), registered)| RegistryEntry {
+            set_name: set_name.clone(),
+            member: *member,
+            options: *options,
+            resident_bytes: registered
+                .pdf
+                .upgrade()
+                .map_or(registered.bytes, |pdf| pdf.resident_bytes()),
+            num_handles: registered.pdf.strong_count(),
+        })
+        .collect();
+    entries.sort_by(|a, b| {
+        (
+            &a.set_name,
+            a.member,
+            a.options.precompute_coeffs,
+            a.options.single_precision,
+            a.options.interleave_flavors,
+        )
+            .cmp(&(
+                &b.set_name,
+                b.member,
+                b.options.precompute_coeffs,
+                b.options.single_precision,
+                b.options.interleave_flavors,
+            ))
+    });
+
+    RegistryReport { entries }
+}
@@ -0,0 +1,216 @@
+//! This module provides optional counters describing the evaluations of a PDF member.
+//!
+//! # Contents
+//!
+//! - [`EvalStats`]: The counters of a member, recorded by its evaluations once enabled.
+//! - [`EvalStatistics`]: A snapshot of the counters, aggregated over all threads.
+//!
+//! # Note
+//!
+//! The counters help to understand where the time of an evaluation goes, e.g. how often the
+//! points fall outside of every subgrid and are resolved to the nearest one, how often their
+//! coordinates are clamped to the knots of that subgrid by the interpolators, or how often
+//! `ForcePositive` modifies a value. They are disabled by default, in which case an
+//! evaluation only pays for a relaxed load of a flag. The counters are sharded over
+//! cache-line aligned slots, each thread incrementing its own slot, such that concurrent
+//! evaluations do not contend on the same cache line; the slots are only summed when a
+//! snapshot is requested.
+//!
+//! Building the crate without the `stats` feature compiles the recording out altogether,
+//! and all the counters then remain zero.
+
+use std::sync::atomic::{AtomicBool, AtomicU64, AtomicUsize, Ordering};
+use std::time::Duration;
+
+use super::subgrid::SubGrid;
+
+/// The number of slots the counters are sharded over.
+const NUM_SHARDS: usize = 16;
+
+/// The counters recorded by the evaluations, indexing the slots of a shard.
+#[derive(Clone, Copy)]
+enum Counter {
+    Points,
+    SubgridFallbacks,
+    XBelow,
+    XAbove,
+    Q2Below,
+    Q2Above,
+    ForcePositiveClips,
+}
+
+const NUM_COUNTERS: usize = Counter::ForcePositiveClips as usize + 1;
+
+/// The counters of one slot, aligned to a cache line to avoid false sharing.
+#[repr(align(64))]
+#[derive(Default)]
+struct Shard([AtomicU64; NUM_COUNTERS]);
+
+/// Hands out the slots to the threads in a round-robin fashion.
+static NEXT_SHARD: AtomicUsize = AtomicUsize::new(0);
+
+thread_local! {
+    /// The slot of the current thread, shared by the counters of all the members.
+    static SHARD: usize = NEXT_SHARD.fetch_add(1, Ordering::Relaxed) % NUM_SHARDS;
+}
+
+/// A snapshot of the counters of a member.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct EvalStatistics {
+    /// The number of points located in the subgrids.
+    pub points: u64,
+    /// The number of points contained in no subgrid, which were resolved to the nearest one.
+    pub subgrid_fallbacks: u64,
+    /// The number of points whose `x` was clamped to the first knot of their subgrid.
+    pub x_below: u64,
+    /// The number of points whose `x` was clamped to the last knot of their subgrid.
+    pub x_above: u64,
+    /// The number of points whose `Q2` was clamped to the first knot of their subgrid.
+    pub q2_below: u64,
+    /// The number of points whose `Q2` was clamped to the last knot of their subgrid.
+    pub q2_above: u64,
+    /// The number of values modified by the `ForcePositive` clipping.
+    pub force_positive_clips: u64,
+    /// The number of times the member was loaded, i.e. 1 unless the counters were reset.
+    pub member_loads: u64,
+    /// The time spent loading the member, in nanoseconds.
+    pub load_nanos: u64,
+}
+
+/// The evaluation counters of a member.
+///
+/// The load of the member is always recorded, while the evaluations are only recorded after
+/// `EvalStats::enable`.
+#[derive(Default)]
+pub struct EvalStats {
+    enabled: AtomicBool,
+    shards: [Shard; NUM_SHARDS],
+    member_loads: AtomicU64,
+    load_nanos: AtomicU64,
+}
+
+impl EvalStats {
+    /// Enables or disables the recording of the evaluations.
+    pub fn enable(&self, enabled: bool) {
+        self.enabled.store(enabled, Ordering::Relaxed);
+    }
+
+    /// Returns whether the evaluations are recorded.
+    #[inline]
+    pub fn is_enabled(&self) -> bool {
+        cfg!(feature = "stats") && self.enabled.load(Ordering::Relaxed)
+    }
+
+    /// Returns the counters summed over all the threads.
+    pub fn snapshot(&self) -> EvalStatistics {
+        let mut totals = [0; NUM_COUNTERS];
+        for shard in &self.shards {
+            for (total, counter) in totals.iter_mut().zip(&shard.0) {
+                *total += counter.load(Ordering::Relaxed);
+            }
+        }
+
+        EvalStatistics {
+            points: totals[Counter::Points as usize],
+            subgrid_fallbacks: totals[Counter::SubgridFallbacks as usize],
+            x_below: totals[Counter::XBelow as usize],
+            x_above: totals[Counter::XAbove as usize],
+            q2_below: totals[Counter::Q2Below as usize],
+            q2_above: totals[Counter::Q2Above as usize],
+            force_positive_clips: totals[Counter::ForcePositiveClips as usize],
+            member_loads: self.member_loads.load(Ordering::Relaxed),
+            load_nanos: self.load_nanos.load(Ordering::Relaxed),
+        }
+    }
+
+    /// Resets all the counters to zero, including those of the load.
+    pub fn reset(&self) {
+        for counter in self.shards.iter().flat_map(|shard| &shard.0) {
+            counter.store(0, Ordering::Relaxed);
+        }
+        self.member_loads.store(0, Ordering::Relaxed);
+        self.load_nanos.store(0, Ordering::Relaxed);
+    }
+
+    /// Records the load of the member.
+    pub(crate) fn record_load(&self, elapsed: Duration) {
+        if cfg!(feature = "stats") {
+            let nanos = u64::try_from(elapsed.as_nanos()).unwrap_or(u64::MAX);
+            self.member_loads.fetch_add(1, Ordering::Relaxed);
+            self.load_nanos.fetch_add(nanos, Ordering::Relaxed);
+        }
+    }
+
+    /// Records a point located in `subgrid`. The point is expected to be given in the
+    /// coordinates of the subgrid, i.e. with `x` and `Q2` as its last two coordinates.
+    pub(crate) fn record_point(&self, subgrid: &SubGrid, points: &[f64]) {
+        if !self.is_enabled() {
+            return;
+        }
+        self.add(Counter::Points);
+        if subgrid.contains_point(points) || points.len() < 2 {
+            return;
+        }
+
+        self.add(Counter::SubgridFallbacks);
+        let ranges = subgrid.ranges();
+        let (x, q2) = (points[points.len() - 2], points[points.len() - 1]);
+        if x < ranges.x.min {
+            self.add(Counter::XBelow);
+        } else if x > ranges.x.max {
+            self.add(Counter::XAbove);
+        }
+        if q2 < ranges.q2.min {
+            self.add(Counter::Q2Below);
+        } else if q2 > ranges.q2.max {
+            self.add(Counter::Q2Above);
+        }
+    }
+
+    /// Records a value modified by the `ForcePositive` clipping.
+    pub(crate) fn record_force_positive(&self) {
+        if self.is_enabled() {
+            self.add(Counter::ForcePositiveClips);
+        }
+    }
+
+    fn add(&self, counter: Counter) {
+        let shard = SHARD.with(|&shard| shard);
+        self.shards[shard].0[counter as usize].fetch_add(1, Ordering::Relaxed);
+    }
+}
+
+#[cfg(all(test, feature = "stats"))]
+mod tests {
+    use super::*;
+    use std::sync::Arc;
+    use std::thread;
+
+    #[test]
+    fn test_counters_aggregate_over_threads() {
+        let stats = Arc::new(EvalStats::default());
+        stats.record_force_positive();
+        assert_eq!(stats.snapshot(), EvalStatistics::default());
+
+        stats.enable(true);
+        let handles: Vec<_> = (0..4)
+            .map(|_| {
+                let stats = Arc::clone(&stats);
+                thread::spawn(move || (0..100).for_each(|_| stats.record_force_positive()))
+            })
+            .collect();
+        handles
+            .into_iter()
+            .for_each(|handle| handle.join().unwrap());
+        stats.record_load(Duration::from_nanos(42));
+
+        let snapshot = stats.snapshot();
+        assert_eq!(snapshot.force_positive_clips, 400);
+        assert_eq!(snapshot.member_loads, 1);
+        assert_eq!(snapshot.load_nanos, 42);
+
+        stats.reset();
+        assert_eq!(stats.snapshot(), EvalStatistics::default());
+    }
+}
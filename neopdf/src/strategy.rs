@@ -6,6 +6,8 @@
 //!   coordinates, suitable for data that exhibits linear behavior in log-log plots.
 //! - `LogBicubicInterpolation`: Bicubic interpolation with logarithmic coordinate scaling,
 //!   providing C1 continuity and higher accuracy for 2D data.
+//! - `LogBicubicTableInterpolation`: The same bicubic interpolation evaluated from per-cell
+//!   coefficient tables precomputed at construction.
 //! - `LogTricubicInterpolation`: Tricubic interpolation with logarithmic coordinate scaling,
 //!   extending bicubic interpolation to 3D data with C1 continuity.
 //! - `AlphaSCubicInterpolation`: A specialized 1D cubic interpolation strategy for alpha_s values,
@@ -14,12 +16,14 @@
 //! All interpolation strategies are designed to work with `ninterp`'s data structures and traits,
 //! ensuring compatibility and extensibility.
 
-use ndarray::{Array2, Axis, Data, RawDataClone};
+use ndarray::{Array2, ArrayBase, ArrayView1, Data, Ix1, RawDataClone};
 use ninterp::data::{InterpData1D, InterpData2D, InterpData3D};
 use ninterp::error::{InterpolateError, ValidateError};
 use ninterp::strategy::traits::{Strategy1D, Strategy2D, Strategy3D};
 use serde::{Deserialize, Serialize};
+use std::collections::HashMap;
 use std::f64::consts::PI;
+use std::hash::Hash;
 
 use super::utils;
 
@@ -211,6 +215,11 @@ pub struct LogBicubicInterpolation {
 }
 
 impl LogBicubicInterpolation {
+    /// Returns the number of bytes held by the coefficients of the cubics in `x`.
+    pub fn resident_bytes(&self) -> usize {
+        self.coeffs.len() * std::mem::size_of::<f64>()
+    }
+
     /// Find the interval for bicubic interpolation.
     ///
     /// This function determines the appropriate interval index `i` within a set of
@@ -391,6 +400,80 @@ impl LogBicubicInterpolation {
 
         utils::hermite_cubic_interpolate(v, vl, vdl, vh, vdh)
     }
+
+    /// Computes the derivatives at the edges of an interval as linear combinations of the
+    /// values of the surrounding knots.
+    ///
+    /// The derivatives, scaled by the width of the interval `[i, i + 1]`, are estimated by
+    /// finite differences: central ones at the inner knots and one-sided ones at the first
+    /// and last knots of the axis, as done by [`LogBicubicInterpolation::calculate_ddx`]
+    /// in `x` and by the evaluation in `Q2`.
+    ///
+    /// # Arguments
+    ///
+    /// * `coords` - The knots of the axis, with at least 3 entries.
+    /// * `i` - The index of the interval.
+    ///
+    /// # Returns
+    ///
+    /// The weights `(vdl, vdh)` of the knots `i - 1`, `i`, `i + 1` and `i + 2` in the
+    /// derivatives at the lower and upper edges of the interval.
+    fn derivative_weights(coords: &[f64], i: usize) -> ([f64; 4], [f64; 4]) {
+        let width = coords[i + 1] - coords[i];
+
+        let vdl = if i == 0 {
+            [0.0, -1.0, 1.0, 0.0]
+        } else {
+            let ratio = width / (coords[i] - coords[i - 1]);
+            [-0.5 * ratio, 0.5 * ratio - 0.5, 0.5, 0.0]
+        };
+        let vdh = if i == coords.len() - 2 {
+            [0.0, -1.0, 1.0, 0.0]
+        } else {
+            let ratio = width / (coords[i + 2] - coords[i + 1]);
+            [0.0, -0.5, 0.5 - 0.5 * ratio, 0.5 * ratio]
+        };
+
+        (vdl, vdh)
+    }
+
+    /// Computes the weights of the knots in the interpolation along one axis.
+    ///
+    /// The log-bicubic interpolation is linear in the knot values and separable: the value
+    /// at a point of the cell `(i, j)` is `sum_ab wx[a] * wq2[b] * f[i - 1 + a][j - 1 + b]`,
+    /// where `wx` and `wq2` are the weights along each axis. The weights do not depend on
+    /// the knot values, so that they can be shared by all the grids defined on the same
+    /// knots, e.g. by all the flavors of a subgrid.
+    ///
+    /// # Arguments
+    ///
+    /// * `coords` - The knots of the axis, with at least 3 entries.
+    /// * `i` - The index of the interval containing the point.
+    /// * `t` - The fractional position of the point in the interval.
+    ///
+    /// # Returns
+    ///
+    /// The weights of the knots `i - 1`, `i`, `i + 1` and `i + 2`. The weights of the knots
+    /// outside of the axis are zero.
+    pub fn knot_weights(coords: &[f64], i: usize, t: f64) -> [f64; 4] {
+        let (vdl, vdh) = Self::derivative_weights(coords, i);
+
+        let t2 = t * t;
+        let t3 = t2 * t;
+        let h00 = 2.0 * t3 - 3.0 * t2 + 1.0;
+        let h10 = t3 - 2.0 * t2 + t;
+        let h01 = -2.0 * t3 + 3.0 * t2;
+        let h11 = t3 - t2;
+
+        std::array::from_fn(|k| {
+            let value = match k {
+                1 => h00,
+                2 => h01,
+                _ => 0.0,
+            };
+            value + h10 * vdl[k] + h11 * vdh[k]
+        })
+    }
 }
 
 impl<D> Strategy2D<D> for LogBicubicInterpolation
@@ -450,6 +533,161 @@ where
     }
 }
 
+/// The 16 coefficients of the bicubic polynomial of a cell of a [`LogBicubicTableInterpolation`].
+///
+/// The coefficient `c[4 * p + q]` multiplies `u^(3 - p) * v^(3 - q)`, where `u` and `v` are the
+/// fractional positions of the point in the cell along `x` and `Q2`. The alignment makes each
+/// cell span exactly two cache lines.
+#[repr(C, align(64))]
+#[derive(Debug, Clone, Copy, Default, Deserialize, Serialize)]
+struct BicubicCell([f64; 16]);
+
+impl BicubicCell {
+    /// Evaluates the polynomial of the cell at the fractional position `(u, v)`.
+    fn evaluate(&self, u: f64, v: f64) -> f64 {
+        let c = &self.0;
+        let row = |p: usize| ((c[4 * p] * v + c[4 * p + 1]) * v + c[4 * p + 2]) * v + c[4 * p + 3];
+
+        ((row(0) * u + row(1)) * u + row(2)) * u + row(3)
+    }
+}
+
+/// LogBicubic interpolation strategy with precomputed per-cell coefficient tables.
+///
+/// This strategy yields the same interpolant as [`LogBicubicInterpolation`], up to rounding,
+/// but expands it at construction into one bicubic polynomial per `(x, Q2)` cell: the Hermite
+/// steps in `x` and `Q2` and the finite-difference derivatives are all linear in the knot
+/// values, such that they fold into 16 coefficients. An evaluation is then a cell lookup
+/// followed by the evaluation of a single polynomial.
+///
+/// The table holds `16 * (nx - 1) * (nq2 - 1)` values, about four times the memory of the
+/// coefficients of [`LogBicubicInterpolation`], which is why it is only used on request.
+#[derive(Debug, Clone, Default, Deserialize, Serialize)]
+pub struct LogBicubicTableInterpolation {
+    cells: Vec<BicubicCell>,
+}
+
+impl LogBicubicTableInterpolation {
+    /// The coefficients of the Hermite basis functions `h00`, `h10`, `h01` and `h11`, ordered
+    /// from the cubic to the constant term.
+    const HERMITE_BASIS: [[f64; 4]; 4] = [
+        [2.0, -3.0, 0.0, 1.0],
+        [1.0, -2.0, 1.0, 0.0],
+        [-2.0, 3.0, 0.0, 0.0],
+        [1.0, -1.0, 0.0, 0.0],
+    ];
+
+    /// Returns the number of bytes held by the coefficients of the cells.
+    pub fn resident_bytes(&self) -> usize {
+        self.cells.len() * std::mem::size_of::<BicubicCell>()
+    }
+
+    /// Computes the coefficients of all the cells from the coefficients of the cubics in `x`
+    /// computed by [`LogBicubicInterpolation`].
+    fn compute_cells<D>(data: &InterpData2D<D>) -> Vec<BicubicCell>
+    where
+        D: Data<Elem = f64> + RawDataClone + Clone,
+    {
+        let nxknots = data.grid[0].len();
+        let nq2knots = data.grid[1].len();
+        let q2_coords = data.grid[1].as_slice().unwrap();
+        let x_coeffs = LogBicubicInterpolation::compute_polynomial_coefficients(data);
+
+        // The weights of the knots `iq2 - 1 + k` in the interpolation in `Q2`, as cubics in
+        // `v`, only depend on the interval.
+        let q2_weights: Vec<[[f64; 4]; 4]> = (0..nq2knots - 1)
+            .map(|iq2| {
+                let (vdl, vdh) = LogBicubicInterpolation::derivative_weights(q2_coords, iq2);
+                std::array::from_fn(|k| {
+                    let (vl, vh) = match k {
+                        1 => (1.0, 0.0),
+                        2 => (0.0, 1.0),
+                        _ => (0.0, 0.0),
+                    };
+                    let basis = Self::HERMITE_BASIS;
+                    std::array::from_fn(|q| {
+                        vl * basis[0][q]
+                            + vdl[k] * basis[1][q]
+                            + vh * basis[2][q]
+                            + vdh[k] * basis[3][q]
+                    })
+                })
+            })
+            .collect();
+
+        let mut cells = Vec::with_capacity((nxknots - 1) * (nq2knots - 1));
+        for ix in 0..nxknots - 1 {
+            for (iq2, weights) in q2_weights.iter().enumerate() {
+                let mut cell = BicubicCell::default();
+                for (k, weight) in weights.iter().enumerate() {
+                    // The knots outside of the axis have vanishing weights.
+                    let Some(knot) = (iq2 + k).checked_sub(1).filter(|&j| j < nq2knots) else {
+                        continue;
+                    };
+                    let base_idx = (ix * nq2knots + knot) * 4;
+                    let coeffs = &x_coeffs[base_idx..base_idx + 4];
+                    for (p, &a) in coeffs.iter().enumerate() {
+                        for (q, &w) in weight.iter().enumerate() {
+                            cell.0[4 * p + q] += a * w;
+                        }
+                    }
+                }
+                cells.push(cell);
+            }
+        }
+        cells
+    }
+}
+
+impl<D> Strategy2D<D> for LogBicubicTableInterpolation
+where
+    D: Data<Elem = f64> + RawDataClone + Clone,
+{
+    fn init(&mut self, data: &InterpData2D<D>) -> Result<(), ValidateError> {
+        let x_coords = data.grid[0].as_slice().unwrap();
+        let y_coords = data.grid[1].as_slice().unwrap();
+
+        if x_coords.len() < 4 || y_coords.len() < 4 {
+            return Err(ValidateError::Other(
+                "Need at least 4x4 grid for bicubic interpolation".to_string(),
+            ));
+        }
+
+        self.cells = Self::compute_cells(data);
+        Ok(())
+    }
+
+    fn interpolate(
+        &self,
+        data: &InterpData2D<D>,
+        point: &[f64; 2],
+    ) -> Result<f64, InterpolateError> {
+        let [x, y] = *point;
+
+        let x_coords = data.grid[0].as_slice().unwrap();
+        let y_coords = data.grid[1].as_slice().unwrap();
+
+        let i = utils::find_interval_index(x_coords, x)?;
+        let j = utils::find_interval_index(y_coords, y)?;
+
+        let dx = x_coords[i + 1] - x_coords[i];
+        let dy = y_coords[j + 1] - y_coords[j];
+
+        if dx == 0.0 || dy == 0.0 {
+            return Err(InterpolateError::Other("Grid spacing is zero".to_string()));
+        }
+
+        let u = (x - x_coords[i]) / dx;
+        let v = (y - y_coords[j]) / dy;
+
+        Ok(self.cells[i * (y_coords.len() - 1) + j].evaluate(u, v))
+    }
+
+    fn allow_extrapolate(&self) -> bool {
+        true
+    }
+}
+
 /// LogTricubic interpolation strategy for PDF-like data
 ///
 /// This strategy implements tricubic interpolation with logarithmic coordinate scaling:
@@ -597,53 +835,47 @@ impl LogTricubicInterpolation {
         let ddz = |dx, dy, dz| Self::calculate_ddz(data, ix + dx, iq2 + dy, iz + dz);
 
         // Step 1: X-interpolation for each (y, z) pair
-        let interp_y: [[f64; 2]; 4] = [0, 1]
-            .iter()
-            .flat_map(|&y_offset| {
-                [0, 1].iter().map(move |&z_offset| {
-                    let (f0, f1) = (get(0, y_offset, z_offset), get(1, y_offset, z_offset));
-                    let (d0, d1) = (
-                        ddx(0, y_offset, z_offset) * dx,
-                        ddx(1, y_offset, z_offset) * dx,
-                    );
-                    let interp_val = Self::cubic_interpolate(u, f0, d0, f1, d1);
-
-                    let (df0, df1) = (
-                        ddy(0, y_offset, z_offset) * dy,
-                        ddy(1, y_offset, z_offset) * dy,
-                    );
-                    let interp_deriv = (1.0 - u) * df0 + u * df1;
-
-                    [interp_val, interp_deriv]
-                })
-            })
-            .collect::<Vec<_>>()
-            .try_into()
-            .unwrap();
+        let interp_x = |y_offset, z_offset| {
+            let (f0, f1) = (get(0, y_offset, z_offset), get(1, y_offset, z_offset));
+            let (d0, d1) = (
+                ddx(0, y_offset, z_offset) * dx,
+                ddx(1, y_offset, z_offset) * dx,
+            );
+            let interp_val = Self::cubic_interpolate(u, f0, d0, f1, d1);
+
+            let (df0, df1) = (
+                ddy(0, y_offset, z_offset) * dy,
+                ddy(1, y_offset, z_offset) * dy,
+            );
+            let interp_deriv = (1.0 - u) * df0 + u * df1;
+
+            [interp_val, interp_deriv]
+        };
+        let interp_y: [[f64; 2]; 4] = [
+            interp_x(0, 0),
+            interp_x(0, 1),
+            interp_x(1, 0),
+            interp_x(1, 1),
+        ];
 
         // Step 2: Y-interpolation for each z
-        let interp_z: [[f64; 2]; 2] = [0, 1]
-            .iter()
-            .enumerate()
-            .map(|(iz_, &z_offset)| {
-                let (f0, f1) = (interp_y[iz_][0], interp_y[2 + iz_][0]);
-                let (d0, d1) = (interp_y[iz_][1], interp_y[2 + iz_][1]);
-                let interp_val = Self::cubic_interpolate(v, f0, d0, f1, d1);
-
-                let calc_z_deriv = |y_offset| {
-                    let (df0, df1) = (
-                        ddz(0, y_offset, z_offset) * dz,
-                        ddz(1, y_offset, z_offset) * dz,
-                    );
-                    (1.0 - u) * df0 + u * df1
-                };
-
-                let interp_deriv = (1.0 - v) * calc_z_deriv(0) + v * calc_z_deriv(1);
-                [interp_val, interp_deriv]
-            })
-            .collect::<Vec<_>>()
-            .try_into()
-            .unwrap();
+        let interp_along_y = |z_offset: usize| {
+            let (f0, f1) = (interp_y[z_offset][0], interp_y[2 + z_offset][0]);
+            let (d0, d1) = (interp_y[z_offset][1], interp_y[2 + z_offset][1]);
+            let interp_val = Self::cubic_interpolate(v, f0, d0, f1, d1);
+
+            let calc_z_deriv = |y_offset| {
+                let (df0, df1) = (
+                    ddz(0, y_offset, z_offset) * dz,
+                    ddz(1, y_offset, z_offset) * dz,
+                );
+                (1.0 - u) * df0 + u * df1
+            };
+
+            let interp_deriv = (1.0 - v) * calc_z_deriv(0) + v * calc_z_deriv(1);
+            [interp_val, interp_deriv]
+        };
+        let interp_z: [[f64; 2]; 2] = [interp_along_y(0), interp_along_y(1)];
 
         // Step 3: Z-interpolation
         let (f0, f1) = (interp_z[0][0], interp_z[1][0]);
@@ -653,16 +885,103 @@ impl LogTricubicInterpolation {
 
     /// Hermite cubic interpolation with derivatives
     fn cubic_interpolate(t: f64, f0: f64, f0_prime: f64, f1: f64, f1_prime: f64) -> f64 {
+        let [h00, h10, h01, h11] = Self::hermite_basis(t);
+
+        h00 * f0 + h10 * f0_prime + h01 * f1 + h11 * f1_prime
+    }
+
+    /// Hermite basis functions `[h00, h10, h01, h11]` at `t`.
+    fn hermite_basis(t: f64) -> [f64; 4] {
         let t2 = t * t;
         let t3 = t2 * t;
 
-        // Hermite basis functions
-        let h00 = 2.0 * t3 - 3.0 * t2 + 1.0;
-        let h10 = t3 - 2.0 * t2 + t;
-        let h01 = -2.0 * t3 + 3.0 * t2;
-        let h11 = t3 - t2;
+        [
+            2.0 * t3 - 3.0 * t2 + 1.0,
+            t3 - 2.0 * t2 + t,
+            -2.0 * t3 + 3.0 * t2,
+            t3 - t2,
+        ]
+    }
 
-        h00 * f0 + h10 * f0_prime + h01 * f1 + h11 * f1_prime
+    /// Contracts the interpolation along the second and third axes at the fixed coordinates
+    /// `(y, z)`, for the interval `[i, i + 1]` of the first axis.
+    ///
+    /// The interpolation is linear in the knot values and in the derivatives at the knots.
+    /// For a fixed `(y, z)` it thus reduces to a combination of the six functions
+    /// `[h00(u), h10(u), h01(u), h11(u), 1 - u, u]` of the coordinate `u` along the first
+    /// axis, whose coefficients are returned and evaluated by
+    /// [`LogTricubicInterpolation::interpolate_leading`]. The coordinates `(y, z)` are
+    /// clamped to the grid.
+    ///
+    /// # Errors
+    ///
+    /// Returns an `InterpolateError` if the spacing of a knot interval is zero.
+    pub fn leading_coefficients<D>(
+        data: &InterpData3D<D>,
+        i: usize,
+        y: f64,
+        z: f64,
+    ) -> Result<[f64; 6], InterpolateError>
+    where
+        D: Data<Elem = f64> + RawDataClone + Clone,
+    {
+        let x_coords = data.grid[0].as_slice().unwrap();
+        let y_coords = data.grid[1].as_slice().unwrap();
+        let z_coords = data.grid[2].as_slice().unwrap();
+        let y = y.clamp(y_coords[0], y_coords[y_coords.len() - 1]);
+        let z = z.clamp(z_coords[0], z_coords[z_coords.len() - 1]);
+
+        let j = Self::find_tricubic_interval(y_coords, y)?;
+        let k = Self::find_tricubic_interval(z_coords, z)?;
+
+        let dx = x_coords[i + 1] - x_coords[i];
+        let dy = y_coords[j + 1] - y_coords[j];
+        let dz = z_coords[k + 1] - z_coords[k];
+
+        if dx == 0.0 || dy == 0.0 || dz == 0.0 {
+            return Err(InterpolateError::Other("Grid spacing is zero".to_string()));
+        }
+
+        let v = (y - y_coords[j]) / dy;
+        let w = (z - z_coords[k]) / dz;
+        let [hv00, hv10, hv01, hv11] = Self::hermite_basis(v);
+        let [hw00, hw10, hw01, hw11] = Self::hermite_basis(w);
+
+        // Each corner of the cell contributes its value and its derivative along the first
+        // axis to the coefficients of `h00`/`h01` and `h10`/`h11` respectively, and its
+        // derivatives along `y` and `z` to the coefficient of `1 - u` or `u`.
+        let mut coeffs = [0.0; 6];
+        for x_offset in 0..2 {
+            for (z_offset, w_value, w_deriv) in [(0, hw00, hw10), (1, hw01, hw11)] {
+                for (y_offset, v_value, v_deriv, v_linear) in
+                    [(0, hv00, hv10, 1.0 - v), (1, hv01, hv11, v)]
+                {
+                    let (ix, iy, iz) = (i + x_offset, j + y_offset, k + z_offset);
+                    let weight = w_value * v_value;
+                    coeffs[2 * x_offset] += weight * data.values[[ix, iy, iz]];
+                    coeffs[2 * x_offset + 1] += weight * Self::calculate_ddx(data, ix, iy, iz) * dx;
+                    coeffs[4 + x_offset] +=
+                        w_value * v_deriv * Self::calculate_ddy(data, ix, iy, iz) * dy
+                            + w_deriv * v_linear * Self::calculate_ddz(data, ix, iy, iz) * dz;
+                }
+            }
+        }
+
+        Ok(coeffs)
+    }
+
+    /// Evaluates the interpolation contracted by
+    /// [`LogTricubicInterpolation::leading_coefficients`] at the coordinate `u` in `[0, 1]`
+    /// normalized to its interval of the first axis.
+    pub fn interpolate_leading(coeffs: &[f64; 6], u: f64) -> f64 {
+        let [h00, h10, h01, h11] = Self::hermite_basis(u);
+
+        coeffs[0] * h00
+            + coeffs[1] * h10
+            + coeffs[2] * h01
+            + coeffs[3] * h11
+            + coeffs[4] * (1.0 - u)
+            + coeffs[5] * u
     }
 }
 
@@ -867,52 +1186,219 @@ where
     }
 }
 
-/// Implements a global N-dimensional interpolation using Chebyshev polynomials with logarithmic
-/// coordinate scaling.
+/// Maximum number of Chebyshev nodes per dimension whose coefficients are kept on the stack.
+const MAX_STACK_NODES: usize = 64;
+
+/// Barycentric coefficients along one dimension.
 ///
-/// This strategy, inspired by the method described in arXiv:2112.09703, first transforms the input
-/// coordinates to their natural logarithms, and then fits a single, high-degree Chebyshev polynomial
-/// to the entire dataset in the log-transformed space.
+/// The coefficients are stored in a fixed-size stack buffer for grids with at most
+/// `MAX_STACK_NODES` nodes per dimension so that single-point evaluations do not touch
+/// the heap, and fall back to a heap allocation for larger grids.
+enum Coefficients {
+    Stack([f64; MAX_STACK_NODES], usize),
+    Heap(Vec<f64>),
+}
+
+impl Coefficients {
+    fn zeros(n: usize) -> Self {
+        if n <= MAX_STACK_NODES {
+            Self::Stack([0.0; MAX_STACK_NODES], n)
+        } else {
+            Self::Heap(vec![0.0; n])
+        }
+    }
+}
+
+impl std::ops::Deref for Coefficients {
+    type Target = [f64];
+
+    fn deref(&self) -> &[f64] {
+        match self {
+            Self::Stack(buffer, n) => &buffer[..*n],
+            Self::Heap(buffer) => buffer,
+        }
+    }
+}
+
+impl std::ops::DerefMut for Coefficients {
+    fn deref_mut(&mut self) -> &mut [f64] {
+        match self {
+            Self::Stack(buffer, n) => &mut buffer[..*n],
+            Self::Heap(buffer) => buffer,
+        }
+    }
+}
+
+/// Number of `f64` values in a cache line.
+const CACHE_LINE_VALUES: usize = 8;
+
+/// A cache line of `f64` values, used to align the buffers of the Chebyshev nodes.
+#[repr(C, align(64))]
+#[derive(Debug, Clone, Copy, Default)]
+struct CacheLine([f64; CACHE_LINE_VALUES]);
+
+/// Returns the number of values taken by `n` values padded to whole cache lines.
+const fn padded_len(n: usize) -> usize {
+    n.div_ceil(CACHE_LINE_VALUES) * CACHE_LINE_VALUES
+}
+
+/// The Chebyshev nodes in the t-domain `[-1, 1]` and their barycentric weights along each
+/// dimension.
 ///
-/// Key features:
-/// - **Logarithmic Scaling**: Coordinates are transformed via `x -> ln(x)` before interpolation.
-/// - **Global Nature**: The interpolation at any point depends on all data points in the grid.
-/// - **High Degree**: The degree of the interpolating polynomial is `N-1`, where `N` is the
-///   number of grid points in each dimension.
-/// - **Grid Requirement**: For optimal stability and to avoid Runge's phenomenon, the grid
-///   points should correspond to the roots or extrema of Chebyshev polynomials.
+/// The nodes and the weights of all the dimensions are stored in a single 64-byte aligned
+/// buffer laid out as `[t_coords_0, weights_0, t_coords_1, weights_1, ...]`, in which each
+/// slice starts on its own cache line.
 #[derive(Debug, Clone)]
-pub struct LogChebyshevInterpolation<const DIM: usize> {
-    // Pre-computed weights for the barycentric formula for each dimension.
-    weights: [Vec<f64>; DIM],
-    // Grid points in the t-domain [-1, 1] for each dimension.
-    t_coords: [Vec<f64>; DIM],
+struct ChebyshevNodes<const DIM: usize> {
+    buffer: Vec<CacheLine>,
+    /// The number of nodes along each dimension.
+    sizes: [usize; DIM],
+    /// The offset of the nodes of each dimension in the values of `buffer`.
+    offsets: [usize; DIM],
 }
 
-impl<const DIM: usize> Default for LogChebyshevInterpolation<DIM> {
+impl<const DIM: usize> Default for ChebyshevNodes<DIM> {
     fn default() -> Self {
         Self {
-            weights: std::array::from_fn(|_| Vec::new()),
-            t_coords: std::array::from_fn(|_| Vec::new()),
+            buffer: Vec::new(),
+            sizes: [0; DIM],
+            offsets: [0; DIM],
         }
     }
 }
 
-impl<const DIM: usize> Serialize for LogChebyshevInterpolation<DIM> {
-    fn serialize<S>(&self, serializer: S) -> Result<S::Ok, S::Error>
+impl<const DIM: usize> ChebyshevNodes<DIM> {
+    /// Allocates zeroed nodes and weights for the given numbers of nodes per dimension.
+    fn zeros(sizes: [usize; DIM]) -> Self {
+        let mut offsets = [0; DIM];
+        let mut total = 0;
+        for (offset, &n) in offsets.iter_mut().zip(&sizes) {
+            *offset = total;
+            total += 2 * padded_len(n);
+        }
+
+        Self {
+            buffer: vec![CacheLine::default(); total / CACHE_LINE_VALUES],
+            sizes,
+            offsets,
+        }
+    }
+
+    /// Computes the Chebyshev extrema and their barycentric weights for the given numbers of
+    /// nodes per dimension, each of which must be at least 2.
+    ///
+    /// The formula for the weights is `w_j = (-1)^j * delta_j`, where `delta_j` is 1/2 for the
+    /// first and last points, and 1 otherwise.
+    fn new(sizes: [usize; DIM]) -> Self {
+        let mut nodes = Self::zeros(sizes);
+
+        for (dim, &n) in sizes.iter().enumerate() {
+            let (t_coords, weights) = nodes.parts_mut(dim);
+            for (j, (t, w)) in t_coords.iter_mut().zip(weights.iter_mut()).enumerate() {
+                *t = (PI * (n - 1 - j) as f64 / (n - 1) as f64).cos();
+                *w = if j % 2 == 1 { -1.0 } else { 1.0 };
+            }
+            weights[0] *= 0.5;
+            weights[n - 1] *= 0.5;
+        }
+
+        nodes
+    }
+
+    /// Builds the nodes from their values and weights along each dimension.
+    fn from_parts(t_coords: &[Vec<f64>], weights: &[Vec<f64>]) -> Result<Self, String> {
+        if t_coords.len() != DIM || weights.len() != DIM {
+            return Err(format!("expected the nodes of {DIM} dimensions"));
+        }
+        if t_coords
+            .iter()
+            .zip(weights)
+            .any(|(t, w)| t.len() != w.len())
+        {
+            return Err("inconsistent numbers of nodes and weights".to_string());
+        }
+
+        let mut nodes = Self::zeros(std::array::from_fn(|dim| t_coords[dim].len()));
+        for dim in 0..DIM {
+            let (t, w) = nodes.parts_mut(dim);
+            t.copy_from_slice(&t_coords[dim]);
+            w.copy_from_slice(&weights[dim]);
+        }
+
+        Ok(nodes)
+    }
+
+    /// Returns the values of the buffer.
+    fn values(&self) -> &[f64] {
+        // SAFETY: `CacheLine` is a `repr(C)` array of `CACHE_LINE_VALUES` values, whose
+        // alignment is a multiple of the one of `f64`, without any padding.
+        unsafe {
+            std::slice::from_raw_parts(
+                self.buffer.as_ptr().cast::<f64>(),
+                self.buffer.len() * CACHE_LINE_VALUES,
+            )
+        }
+    }
+
+    /// Returns the nodes and the weights of a dimension.
+    fn parts_mut(&mut self, dim: usize) -> (&mut [f64], &mut [f64]) {
+        let (n, offset) = (self.sizes[dim], self.offsets[dim]);
+        // SAFETY: see `ChebyshevNodes::values`.
+        let values = unsafe {
+            std::slice::from_raw_parts_mut(
+                self.buffer.as_mut_ptr().cast::<f64>(),
+                self.buffer.len() * CACHE_LINE_VALUES,
+            )
+        };
+        let (t_coords, weights) =
+            values[offset..offset + 2 * padded_len(n)].split_at_mut(padded_len(n));
+
+        (&mut t_coords[..n], &mut weights[..n])
+    }
+
+    /// The nodes in the t-domain `[-1, 1]` along a dimension.
+    fn t_coords(&self, dim: usize) -> &[f64] {
+        &self.values()[self.offsets[dim]..][..self.sizes[dim]]
+    }
+
+    /// The barycentric weights of the nodes along a dimension.
+    fn weights(&self, dim: usize) -> &[f64] {
+        let n = self.sizes[dim];
+        &self.values()[self.offsets[dim] + padded_len(n)..][..n]
+    }
+
+    /// Computes the nodes for the knots of `grid`, which must count at least 2 per dimension.
+    fn for_grid<S>(grid: &[ArrayBase<S, Ix1>], strategy: &str) -> Result<Self, ValidateError>
+    where
+        S: Data<Elem = f64>,
+    {
+        if grid.iter().take(DIM).any(|knots| knots.len() < 2) {
+            let per_dimension = if DIM > 1 { " per dimension" } else { "" };
+            return Err(ValidateError::Other(format!(
+                "{strategy} requires at least 2 grid points{per_dimension}."
+            )));
+        }
+
+        Ok(Self::new(std::array::from_fn(|dim| grid[dim].len())))
+    }
+
+    /// Serializes the nodes as the fields `weights` and `t_coords` of a struct.
+    fn serialize<S>(&self, name: &'static str, serializer: S) -> Result<S::Ok, S::Error>
     where
         S: serde::Serializer,
     {
         use serde::ser::SerializeStruct;
-        let mut state = serializer.serialize_struct("LogChebyshevInterpolation", 2)?;
-        state.serialize_field("weights", &self.weights.as_slice())?;
-        state.serialize_field("t_coords", &self.t_coords.as_slice())?;
+        let weights: Vec<&[f64]> = (0..DIM).map(|dim| self.weights(dim)).collect();
+        let t_coords: Vec<&[f64]> = (0..DIM).map(|dim| self.t_coords(dim)).collect();
+
+        let mut state = serializer.serialize_struct(name, 2)?;
+        state.serialize_field("weights", &weights)?;
+        state.serialize_field("t_coords", &t_coords)?;
         state.end()
     }
-}
 
-impl<'de, const DIM: usize> Deserialize<'de> for LogChebyshevInterpolation<DIM> {
-    fn deserialize<D>(deserializer: D) -> Result<Self, D::Error>
+    /// Deserializes the nodes from the fields `weights` and `t_coords` of a struct.
+    fn deserialize<'de, D>(deserializer: D) -> Result<Self, D::Error>
     where
         D: serde::Deserializer<'de>,
     {
@@ -923,57 +1409,82 @@ impl<'de, const DIM: usize> Deserialize<'de> for LogChebyshevInterpolation<DIM>
         }
 
         let helper = Helper::deserialize(deserializer)?;
-        let weights = helper.weights.try_into().map_err(|v: Vec<Vec<f64>>| {
-            serde::de::Error::invalid_length(v.len(), &"an array of the correct length")
-        })?;
-        let t_coords = helper.t_coords.try_into().map_err(|v: Vec<Vec<f64>>| {
-            serde::de::Error::invalid_length(v.len(), &"an array of the correct length")
-        })?;
-
-        Ok(Self { weights, t_coords })
+        Self::from_parts(&helper.t_coords, &helper.weights).map_err(serde::de::Error::custom)
     }
 }
 
-impl<const DIM: usize> LogChebyshevInterpolation<DIM> {
-    /// Computes the barycentric weights for a given set of Chebyshev points.
-    /// The formula for the weights is `w_j = (-1)^j * delta_j`, where `delta_j`
-    /// is 1/2 for the first and last points, and 1 otherwise.
-    fn compute_barycentric_weights(n: usize) -> Vec<f64> {
-        let mut weights = vec![1.0; n];
-        (0..n).for_each(|j| {
-            if j % 2 == 1 {
-                weights[j] = -1.0;
-            }
-        });
-        weights[0] *= 0.5;
-        if n > 1 {
-            weights[n - 1] *= 0.5;
-        }
-        weights
+/// Computes the normalized barycentric coefficients of `t` into `coeffs`, which sum to 1.
+fn barycentric_row(t: f64, t_coords: &[f64], weights: &[f64], coeffs: &mut [f64]) {
+    if let Some(j) = t_coords.iter().position(|&t_j| (t - t_j).abs() < 1e-15) {
+        // t is exactly at grid point j - return unit vector
+        coeffs.fill(0.0);
+        coeffs[j] = 1.0;
+        return;
     }
 
-    /// Computes normalized barycentric coefficients for interpolation
-    /// Returns a vector of coefficients that sum to 1
-    fn barycentric_coefficients(t: f64, t_coords: &[f64], weights: &[f64]) -> Vec<f64> {
-        let mut coeffs = vec![0.0; t_coords.len()];
+    let mut sum = 0.0;
+    for ((coeff, &t_j), &w_j) in coeffs.iter_mut().zip(t_coords).zip(weights) {
+        *coeff = w_j / (t - t_j);
+        sum += *coeff;
+    }
 
-        for (j, &t_j) in t_coords.iter().enumerate() {
-            if (t - t_j).abs() < 1e-15 {
-                // t is exactly at grid point j - return unit vector
-                coeffs[j] = 1.0;
-                return coeffs;
-            }
-        }
+    coeffs.iter_mut().for_each(|c| *c /= sum);
+}
 
-        let mut terms = Vec::with_capacity(t_coords.len());
-        for (j, &t_j) in t_coords.iter().enumerate() {
-            terms.push(weights[j] / (t - t_j));
-        }
+/// Maps the coordinate `x` of the domain `[x_min, x_max]` spanned by `knots` to `[-1, 1]`.
+fn to_t_domain(x: f64, knots: &[f64]) -> f64 {
+    let (x_min, x_max) = (knots[0], knots[knots.len() - 1]);
+    2.0 * (x - x_min) / (x_max - x_min) - 1.0
+}
 
-        let sum: f64 = terms.iter().sum();
-        for (j, &term) in terms.iter().enumerate() {
-            coeffs[j] = term / sum;
-        }
+/// Implements a global N-dimensional interpolation using Chebyshev polynomials with logarithmic
+/// coordinate scaling.
+///
+/// This strategy, inspired by the method described in arXiv:2112.09703, first transforms the input
+/// coordinates to their natural logarithms, and then fits a single, high-degree Chebyshev polynomial
+/// to the entire dataset in the log-transformed space.
+///
+/// Key features:
+/// - **Logarithmic Scaling**: Coordinates are transformed via `x -> ln(x)` before interpolation.
+/// - **Global Nature**: The interpolation at any point depends on all data points in the grid.
+/// - **High Degree**: The degree of the interpolating polynomial is `N-1`, where `N` is the
+///   number of grid points in each dimension.
+/// - **Grid Requirement**: For optimal stability and to avoid Runge's phenomenon, the grid
+///   points should correspond to the roots or extrema of Chebyshev polynomials.
+#[derive(Debug, Clone, Default)]
+pub struct LogChebyshevInterpolation<const DIM: usize> {
+    // Pre-computed grid points in the t-domain [-1, 1] and weights for the barycentric formula
+    // for each dimension.
+    nodes: ChebyshevNodes<DIM>,
+}
+
+impl<const DIM: usize> Serialize for LogChebyshevInterpolation<DIM> {
+    fn serialize<S>(&self, serializer: S) -> Result<S::Ok, S::Error>
+    where
+        S: serde::Serializer,
+    {
+        self.nodes
+            .serialize("LogChebyshevInterpolation", serializer)
+    }
+}
+
+impl<'de, const DIM: usize> Deserialize<'de> for LogChebyshevInterpolation<DIM> {
+    fn deserialize<D>(deserializer: D) -> Result<Self, D::Error>
+    where
+        D: serde::Deserializer<'de>,
+    {
+        Ok(Self {
+            nodes: ChebyshevNodes::deserialize(deserializer)?,
+        })
+    }
+}
+
+impl<const DIM: usize> LogChebyshevInterpolation<DIM> {
+    /// Computes normalized barycentric coefficients for interpolation
+    /// Returns the coefficients that sum to 1, stored on the stack for the usual grid sizes
+    fn barycentric_coefficients(t: f64, t_coords: &[f64], weights: &[f64]) -> Coefficients {
+        let mut coeffs = Coefficients::zeros(t_coords.len());
+        barycentric_row(t, t_coords, weights, &mut coeffs);
 
         coeffs
     }
@@ -1002,19 +1513,7 @@ where
     D: Data<Elem = f64> + RawDataClone + Clone,
 {
     fn init(&mut self, data: &InterpData1D<D>) -> Result<(), ValidateError> {
-        let x_coords = data.grid[0].as_slice().unwrap();
-        let n = x_coords.len();
-        if n < 2 {
-            return Err(ValidateError::Other(
-                "LogChebyshevInterpolation requires at least 2 grid points.".to_string(),
-            ));
-        }
-
-        self.t_coords[0] = (0..n)
-            .map(|j| (PI * (n - 1 - j) as f64 / (n - 1) as f64).cos())
-            .collect();
-
-        self.weights[0] = Self::compute_barycentric_weights(n);
+        self.nodes = ChebyshevNodes::for_grid(&data.grid, "LogChebyshevInterpolation")?;
 
         Ok(())
     }
@@ -1034,13 +1533,13 @@ where
         if (x_max - x_min).abs() < 1e-15 {
             return Ok(f_values[0]);
         }
-        let t = 2.0 * (x - x_min) / (x_max - x_min) - 1.0;
+        let t = to_t_domain(x, x_coords);
 
         Ok(Self::barycentric_interpolate(
             t,
-            &self.t_coords[0],
+            self.nodes.t_coords(0),
             f_values,
-            &self.weights[0],
+            self.nodes.weights(0),
         ))
     }
 
@@ -1054,20 +1553,8 @@ where
     D: Data<Elem = f64> + RawDataClone + Clone,
 {
     fn init(&mut self, data: &InterpData2D<D>) -> Result<(), ValidateError> {
-        for dim in 0..2 {
-            let x_coords = data.grid[dim].as_slice().unwrap();
-            let n = x_coords.len();
-            if n < 2 {
-                return Err(ValidateError::Other(
-                    "LogChebyshevInterpolation requires at least 2 grid points per dimension."
-                        .to_string(),
-                ));
-            }
-            self.t_coords[dim] = (0..n)
-                .map(|j| (PI * (n - 1 - j) as f64 / (n - 1) as f64).cos())
-                .collect();
-            self.weights[dim] = Self::compute_barycentric_weights(n);
-        }
+        self.nodes = ChebyshevNodes::for_grid(&data.grid, "LogChebyshevInterpolation")?;
+
         Ok(())
     }
 
@@ -1077,19 +1564,12 @@ where
         point: &[f64; 2],
     ) -> Result<f64, InterpolateError> {
         let [x, y] = *point;
-        let x_coords = data.grid[0].as_slice().unwrap();
-        let y_coords = data.grid[1].as_slice().unwrap();
+        let t_x = to_t_domain(x, data.grid[0].as_slice().unwrap());
+        let t_y = to_t_domain(y, data.grid[1].as_slice().unwrap());
 
-        let x_min = *x_coords.first().unwrap();
-        let x_max = *x_coords.last().unwrap();
-        let y_min = *y_coords.first().unwrap();
-        let y_max = *y_coords.last().unwrap();
-
-        let t_x = 2.0 * (x - x_min) / (x_max - x_min) - 1.0;
-        let t_y = 2.0 * (y - y_min) / (y_max - y_min) - 1.0;
-
-        let x_coeffs = Self::barycentric_coefficients(t_x, &self.t_coords[0], &self.weights[0]);
-        let y_coeffs = Self::barycentric_coefficients(t_y, &self.t_coords[1], &self.weights[1]);
+        let nodes = &self.nodes;
+        let x_coeffs = Self::barycentric_coefficients(t_x, nodes.t_coords(0), nodes.weights(0));
+        let y_coeffs = Self::barycentric_coefficients(t_y, nodes.t_coords(1), nodes.weights(1));
 
         let mut result = 0.0;
         for (i, &x_coeff) in x_coeffs.iter().enumerate() {
@@ -1111,20 +1591,8 @@ where
     D: Data<Elem = f64> + RawDataClone + Clone,
 {
     fn init(&mut self, data: &InterpData3D<D>) -> Result<(), ValidateError> {
-        for dim in 0..3 {
-            let x_coords = data.grid[dim].as_slice().unwrap();
-            let n = x_coords.len();
-            if n < 2 {
-                return Err(ValidateError::Other(
-                    "LogChebyshevInterpolation requires at least 2 grid points per dimension."
-                        .to_string(),
-                ));
-            }
-            self.t_coords[dim] = (0..n)
-                .map(|j| (PI * (n - 1 - j) as f64 / (n - 1) as f64).cos())
-                .collect();
-            self.weights[dim] = Self::compute_barycentric_weights(n);
-        }
+        self.nodes = ChebyshevNodes::for_grid(&data.grid, "LogChebyshevInterpolation")?;
+
         Ok(())
     }
 
@@ -1134,24 +1602,14 @@ where
         point: &[f64; 3],
     ) -> Result<f64, InterpolateError> {
         let [x, y, z] = *point;
-        let x_coords = data.grid[0].as_slice().unwrap();
-        let y_coords = data.grid[1].as_slice().unwrap();
-        let z_coords = data.grid[2].as_slice().unwrap();
+        let t_x = to_t_domain(x, data.grid[0].as_slice().unwrap());
+        let t_y = to_t_domain(y, data.grid[1].as_slice().unwrap());
+        let t_z = to_t_domain(z, data.grid[2].as_slice().unwrap());
 
-        let x_min = *x_coords.first().unwrap();
-        let x_max = *x_coords.last().unwrap();
-        let y_min = *y_coords.first().unwrap();
-        let y_max = *y_coords.last().unwrap();
-        let z_min = *z_coords.first().unwrap();
-        let z_max = *z_coords.last().unwrap();
-
-        let t_x = 2.0 * (x - x_min) / (x_max - x_min) - 1.0;
-        let t_y = 2.0 * (y - y_min) / (y_max - y_min) - 1.0;
-        let t_z = 2.0 * (z - z_min) / (z_max - z_min) - 1.0;
-
-        let x_coeffs = Self::barycentric_coefficients(t_x, &self.t_coords[0], &self.weights[0]);
-        let y_coeffs = Self::barycentric_coefficients(t_y, &self.t_coords[1], &self.weights[1]);
-        let z_coeffs = Self::barycentric_coefficients(t_z, &self.t_coords[2], &self.weights[2]);
+        let nodes = &self.nodes;
+        let x_coeffs = Self::barycentric_coefficients(t_x, nodes.t_coords(0), nodes.weights(0));
+        let y_coeffs = Self::barycentric_coefficients(t_y, nodes.t_coords(1), nodes.weights(1));
+        let z_coeffs = Self::barycentric_coefficients(t_z, nodes.t_coords(2), nodes.weights(2));
 
         let mut result = 0.0;
         for (i, &x_coeff) in x_coeffs.iter().enumerate() {
@@ -1170,28 +1628,95 @@ where
     }
 }
 
+/// Deduplicates a sequence of keys.
+///
+/// Returns the distinct keys in order of first appearance, and for each key of the sequence
+/// the index of its distinct key. Consecutive equal keys, e.g. a scan along another axis, are
+/// resolved without a hash lookup.
+fn dedup_keys<K>(keys: impl ExactSizeIterator<Item = K>) -> (Vec<K>, Vec<usize>)
+where
+    K: Copy + Eq + Hash,
+{
+    let mut distinct = Vec::new();
+    let mut index = Vec::with_capacity(keys.len());
+    let mut lookup: HashMap<K, usize> = HashMap::new();
+    let mut previous: Option<(K, usize)> = None;
+
+    for key in keys {
+        let row = match previous {
+            Some((prev, row)) if prev == key => row,
+            _ => *lookup.entry(key).or_insert_with(|| {
+                distinct.push(key);
+                distinct.len() - 1
+            }),
+        };
+        previous = Some((key, row));
+        index.push(row);
+    }
+
+    (distinct, index)
+}
+
+/// The barycentric coefficients of a batch of points along one dimension.
+///
+/// The coefficients are computed once per distinct coordinate of the batch: `rows` holds the
+/// coefficients of the distinct coordinates and `index[p]` is the row of the point `p`.
+struct BatchBasis {
+    rows: Array2<f64>,
+    index: Vec<usize>,
+}
+
+impl BatchBasis {
+    /// Computes the coefficients of the coordinates `t_values` in the t-domain.
+    fn new(t_values: &[f64], t_coords: &[f64], weights: &[f64]) -> Self {
+        let (distinct, index) = dedup_keys(t_values.iter().map(|t| t.to_bits()));
+
+        let mut rows = Array2::<f64>::zeros((distinct.len(), t_coords.len()));
+        for (mut row, &bits) in rows.rows_mut().into_iter().zip(&distinct) {
+            let coeffs = row.as_slice_mut().unwrap();
+            barycentric_row(f64::from_bits(bits), t_coords, weights, coeffs);
+        }
+
+        Self { rows, index }
+    }
+
+    /// Computes the coefficients of the coordinates of `points` along `dim`.
+    fn along<const DIM: usize, const N: usize>(
+        points: &[[f64; N]],
+        dim: usize,
+        knots: &[f64],
+        nodes: &ChebyshevNodes<DIM>,
+    ) -> Self {
+        let t_values: Vec<f64> = points.iter().map(|p| to_t_domain(p[dim], knots)).collect();
+        Self::new(&t_values, nodes.t_coords(dim), nodes.weights(dim))
+    }
+
+    /// The number of distinct coordinates.
+    fn len(&self) -> usize {
+        self.rows.nrows()
+    }
+
+    /// The coefficients of the point `p`.
+    fn row(&self, p: usize) -> ArrayView1<f64> {
+        self.rows.row(self.index[p])
+    }
+}
+
 /// Implements a global N-dimensional batch interpolation using Chebyshev polynomials
 /// with logarithmic coordinate scaling.
 ///
 /// This strategy is optimized for interpolating multiple points at once by leveraging
-/// matrix operations with `ndarray`.
+/// matrix operations with `ndarray`. The barycentric coefficients are only computed once per
+/// distinct coordinate along each dimension, and the knot values are first contracted along
+/// the dimensions over which the batch has the fewest distinct coordinates, e.g. `x` and `Q2`
+/// for a scan in `kT`.
 ///
 /// TODO: Potentially merge this with `LogChebyshevInterpolation`.
-#[derive(Debug, Clone)]
+#[derive(Debug, Clone, Default)]
 pub struct LogChebyshevBatchInterpolation<const DIM: usize> {
-    // Pre-computed weights for the barycentric formula for each dimension.
-    weights: [Vec<f64>; DIM],
-    // Grid points in the t-domain [-1, 1] for each dimension.
-    t_coords: [Vec<f64>; DIM],
-}
-
-impl<const DIM: usize> Default for LogChebyshevBatchInterpolation<DIM> {
-    fn default() -> Self {
-        Self {
-            weights: std::array::from_fn(|_| Vec::new()),
-            t_coords: std::array::from_fn(|_| Vec::new()),
-        }
-    }
+    // Pre-computed grid points in the t-domain [-1, 1] and weights for the barycentric formula
+    // for each dimension.
+    nodes: ChebyshevNodes<DIM>,
 }
 
 impl<const DIM: usize> Serialize for LogChebyshevBatchInterpolation<DIM> {
@@ -1199,11 +1724,8 @@ impl<const DIM: usize> Serialize for LogChebyshevBatchInterpolation<DIM> {
     where
         S: serde::Serializer,
     {
-        use serde::ser::SerializeStruct;
-        let mut state = serializer.serialize_struct("LogChebyshevBatchInterpolation", 2)?;
-        state.serialize_field("weights", &self.weights.as_slice())?;
-        state.serialize_field("t_coords", &self.t_coords.as_slice())?;
-        state.end()
+        self.nodes
+            .serialize("LogChebyshevBatchInterpolation", serializer)
     }
 }
 
@@ -1212,79 +1734,9 @@ impl<'de, const DIM: usize> Deserialize<'de> for LogChebyshevBatchInterpolation<
     where
         D: serde::Deserializer<'de>,
     {
-        #[derive(Deserialize)]
-        struct Helper {
-            weights: Vec<Vec<f64>>,
-            t_coords: Vec<Vec<f64>>,
-        }
-
-        let helper = Helper::deserialize(deserializer)?;
-        let weights = helper.weights.try_into().map_err(|v: Vec<Vec<f64>>| {
-            serde::de::Error::invalid_length(v.len(), &"an array of the correct length")
-        })?;
-        let t_coords = helper.t_coords.try_into().map_err(|v: Vec<Vec<f64>>| {
-            serde::de::Error::invalid_length(v.len(), &"an array of the correct length")
-        })?;
-
-        Ok(Self { weights, t_coords })
-    }
-}
-
-impl<const DIM: usize> LogChebyshevBatchInterpolation<DIM> {
-    /// Computes the barycentric weights for a given set of Chebyshev points.
-    /// The formula for the weights is `w_j = (-1)^j * delta_j`, where `delta_j`
-    /// is 1/2 for the first and last points, and 1 otherwise.
-    fn compute_barycentric_weights(n: usize) -> Vec<f64> {
-        let mut weights = vec![1.0; n];
-        (0..n).for_each(|j| {
-            if j % 2 == 1 {
-                weights[j] = -1.0;
-            }
-        });
-        weights[0] *= 0.5;
-
-        if n > 1 {
-            weights[n - 1] *= 0.5;
-        }
-
-        weights
-    }
-
-    /// Compute barycentric coefficients for multiple points in batch
-    fn barycentric_coefficients(
-        t_values: &[f64],
-        t_coords: &[f64],
-        weights: &[f64],
-    ) -> Array2<f64> {
-        let num_points = t_values.len();
-        let num_coords = t_coords.len();
-        let mut coeffs = Array2::<f64>::zeros((num_points, num_coords));
-
-        for (p, &t) in t_values.iter().enumerate() {
-            let mut found_exact = false;
-            for (j, &t_j) in t_coords.iter().enumerate() {
-                if (t - t_j).abs() < 1e-15 {
-                    coeffs[[p, j]] = 1.0;
-                    found_exact = true;
-                    break;
-                }
-            }
-
-            if !found_exact {
-                let mut terms = Vec::with_capacity(num_coords);
-                for (j, &t_j) in t_coords.iter().enumerate() {
-                    terms.push(weights[j] / (t - t_j));
-                }
-
-                let sum: f64 = terms.iter().sum();
-
-                for (j, &term) in terms.iter().enumerate() {
-                    coeffs[[p, j]] = term / sum;
-                }
-            }
-        }
-
-        coeffs
+        Ok(Self {
+            nodes: ChebyshevNodes::deserialize(deserializer)?,
+        })
     }
 }
 
@@ -1293,19 +1745,7 @@ impl LogChebyshevBatchInterpolation<1> {
     where
         D: Data<Elem = f64> + RawDataClone + Clone,
     {
-        let x_coords = data.grid[0].as_slice().unwrap();
-        let n = x_coords.len();
-        if n < 2 {
-            return Err(ValidateError::Other(
-                "LogChebyshevBatchInterpolation requires at least 2 grid points.".to_string(),
-            ));
-        }
-
-        self.t_coords[0] = (0..n)
-            .map(|j| (PI * (n - 1 - j) as f64 / (n - 1) as f64).cos())
-            .collect();
-
-        self.weights[0] = Self::compute_barycentric_weights(n);
+        self.nodes = ChebyshevNodes::for_grid(&data.grid, "LogChebyshevBatchInterpolation")?;
 
         Ok(())
     }
@@ -1319,20 +1759,10 @@ impl LogChebyshevBatchInterpolation<1> {
         D: Data<Elem = f64> + RawDataClone + Clone,
     {
         let x_coords = data.grid[0].as_slice().unwrap();
-        let f_values = data.values.to_owned();
-
-        let x_min = *x_coords.first().unwrap();
-        let x_max = *x_coords.last().unwrap();
-
-        let mut t_x_vals = Vec::with_capacity(points.len());
-        for &[x] in points {
-            t_x_vals.push(2.0 * (x - x_min) / (x_max - x_min) - 1.0);
-        }
-
-        let c_x = Self::barycentric_coefficients(&t_x_vals, &self.t_coords[0], &self.weights[0]);
-        let results = c_x.dot(&f_values);
+        let c_x = BatchBasis::along(points, 0, x_coords, &self.nodes);
+        let distinct = c_x.rows.dot(&data.values);
 
-        Ok(results.to_vec())
+        Ok(c_x.index.iter().map(|&row| distinct[row]).collect())
     }
 }
 
@@ -1341,20 +1771,7 @@ impl LogChebyshevBatchInterpolation<2> {
     where
         D: Data<Elem = f64> + RawDataClone + Clone,
     {
-        for dim in 0..2 {
-            let x_coords = data.grid[dim].as_slice().unwrap();
-            let n = x_coords.len();
-            if n < 2 {
-                return Err(ValidateError::Other(
-                    "LogChebyshevBatchInterpolation requires at least 2 grid points per dimension."
-                        .to_string(),
-                ));
-            }
-            self.t_coords[dim] = (0..n)
-                .map(|j| (PI * (n - 1 - j) as f64 / (n - 1) as f64).cos())
-                .collect();
-            self.weights[dim] = Self::compute_barycentric_weights(n);
-        }
+        self.nodes = ChebyshevNodes::for_grid(&data.grid, "LogChebyshevBatchInterpolation")?;
 
         Ok(())
     }
@@ -1369,25 +1786,29 @@ impl LogChebyshevBatchInterpolation<2> {
     {
         let x_coords = data.grid[0].as_slice().unwrap();
         let y_coords = data.grid[1].as_slice().unwrap();
+        let (nx, ny) = (x_coords.len(), y_coords.len());
 
-        let x_min = *x_coords.first().unwrap();
-        let x_max = *x_coords.last().unwrap();
-        let y_min = *y_coords.first().unwrap();
-        let y_max = *y_coords.last().unwrap();
-
-        let mut t_x_vals = Vec::with_capacity(points.len());
-        let mut t_y_vals = Vec::with_capacity(points.len());
-        for &[x, y] in points {
-            t_x_vals.push(2.0 * (x - x_min) / (x_max - x_min) - 1.0);
-            t_y_vals.push(2.0 * (y - y_min) / (y_max - y_min) - 1.0);
-        }
+        let c_x = BatchBasis::along(points, 0, x_coords, &self.nodes);
+        let c_y = BatchBasis::along(points, 1, y_coords, &self.nodes);
+
+        // The knot values are contracted first along the dimension with the lowest cost,
+        // once per distinct coordinate, and the partial sums are then shared by the points.
+        let cost_x = c_x.len() * nx * ny + points.len() * ny;
+        let cost_y = c_y.len() * nx * ny + points.len() * nx;
 
-        let c_x = Self::barycentric_coefficients(&t_x_vals, &self.t_coords[0], &self.weights[0]);
-        let c_y = Self::barycentric_coefficients(&t_y_vals, &self.t_coords[1], &self.weights[1]);
-        let v = data.values.to_owned();
-        let results = (&c_x.dot(&v) * &c_y).sum_axis(Axis(1));
+        let results = if cost_x <= cost_y {
+            let partial = c_x.rows.dot(&data.values);
+            (0..points.len())
+                .map(|p| partial.row(c_x.index[p]).dot(&c_y.row(p)))
+                .collect()
+        } else {
+            let partial = c_y.rows.dot(&data.values.t());
+            (0..points.len())
+                .map(|p| partial.row(c_y.index[p]).dot(&c_x.row(p)))
+                .collect()
+        };
 
-        Ok(results.to_vec())
+        Ok(results)
     }
 }
 
@@ -1396,20 +1817,8 @@ impl LogChebyshevBatchInterpolation<3> {
     where
         D: Data<Elem = f64> + RawDataClone + Clone,
     {
-        for dim in 0..3 {
-            let x_coords = data.grid[dim].as_slice().unwrap();
-            let n = x_coords.len();
-            if n < 2 {
-                return Err(ValidateError::Other(
-                    "LogChebyshevBatchInterpolation requires at least 2 grid points per dimension."
-                        .to_string(),
-                ));
-            }
-            self.t_coords[dim] = (0..n)
-                .map(|j| (PI * (n - 1 - j) as f64 / (n - 1) as f64).cos())
-                .collect();
-            self.weights[dim] = Self::compute_barycentric_weights(n);
-        }
+        self.nodes = ChebyshevNodes::for_grid(&data.grid, "LogChebyshevBatchInterpolation")?;
+
         Ok(())
     }
 
@@ -1424,47 +1833,53 @@ impl LogChebyshevBatchInterpolation<3> {
         let x_coords = data.grid[0].as_slice().unwrap();
         let y_coords = data.grid[1].as_slice().unwrap();
         let z_coords = data.grid[2].as_slice().unwrap();
+        let (nx, ny, nz) = (x_coords.len(), y_coords.len(), z_coords.len());
 
-        let x_min = *x_coords.first().unwrap();
-        let x_max = *x_coords.last().unwrap();
-        let y_min = *y_coords.first().unwrap();
-        let y_max = *y_coords.last().unwrap();
-        let z_min = *z_coords.first().unwrap();
-        let z_max = *z_coords.last().unwrap();
-
-        let mut t_x_vals = Vec::with_capacity(points.len());
-        let mut t_y_vals = Vec::with_capacity(points.len());
-        let mut t_z_vals = Vec::with_capacity(points.len());
-
-        for &[x, y, z] in points {
-            t_x_vals.push(2.0 * (x - x_min) / (x_max - x_min) - 1.0);
-            t_y_vals.push(2.0 * (y - y_min) / (y_max - y_min) - 1.0);
-            t_z_vals.push(2.0 * (z - z_min) / (z_max - z_min) - 1.0);
-        }
-
-        let c_x = Self::barycentric_coefficients(&t_x_vals, &self.t_coords[0], &self.weights[0]);
-        let c_y = Self::barycentric_coefficients(&t_y_vals, &self.t_coords[1], &self.weights[1]);
-        let c_z = Self::barycentric_coefficients(&t_z_vals, &self.t_coords[2], &self.weights[2]);
-
-        let v = &data.values;
+        let c_x = BatchBasis::along(points, 0, x_coords, &self.nodes);
+        let c_y = BatchBasis::along(points, 1, y_coords, &self.nodes);
+        let c_z = BatchBasis::along(points, 2, z_coords, &self.nodes);
 
+        // The knot values are only copied if they are not contiguous in standard layout.
+        let v = data.values.as_standard_layout();
         let num_points = points.len();
-        let (nx, ny, nz) = (x_coords.len(), y_coords.len(), z_coords.len());
 
-        let v_flat = v.to_owned().into_shape_with_order((nx, ny * nz)).unwrap();
-        let temp1 = c_x.dot(&v_flat);
-        let temp1_3d = temp1.into_shape_with_order((num_points, ny, nz)).unwrap();
+        // The knot values are either contracted along `x` and then `y`, or along `z` and then
+        // `y`, whichever requires the fewest operations given the distinct coordinates and
+        // pairs of coordinates of the batch. The partial sums are shared by the points.
+        let (xy_pairs, xy_index) =
+            dedup_keys((0..num_points).map(|p| (c_x.index[p], c_y.index[p])));
+        let (zy_pairs, zy_index) =
+            dedup_keys((0..num_points).map(|p| (c_z.index[p], c_y.index[p])));
+        let cost_x = c_x.len() * nx * ny * nz + xy_pairs.len() * ny * nz + num_points * nz;
+        let cost_z = c_z.len() * nx * ny * nz + zy_pairs.len() * nx * ny + num_points * nx;
+
+        let results = if cost_x <= cost_z {
+            let v_flat = v.view().into_shape_with_order((nx, ny * nz)).unwrap();
+            let temp1 = c_x.rows.dot(&v_flat);
+
+            let mut temp2 = Array2::<f64>::zeros((xy_pairs.len(), nz));
+            for (mut row, &(ix, iy)) in temp2.rows_mut().into_iter().zip(&xy_pairs) {
+                let temp_slice = temp1.row(ix).to_shape((ny, nz)).unwrap();
+                row.assign(&c_y.rows.row(iy).dot(&temp_slice));
+            }
 
-        let mut results = Vec::with_capacity(num_points);
-        for p in 0..num_points {
-            let temp_slice = temp1_3d.index_axis(Axis(0), p);
-            let cy_slice = c_y.row(p);
-            let cz_slice = c_z.row(p);
+            (0..num_points)
+                .map(|p| c_z.row(p).dot(&temp2.row(xy_index[p])))
+                .collect()
+        } else {
+            let v_flat = v.view().into_shape_with_order((nx * ny, nz)).unwrap();
+            let temp1 = c_z.rows.dot(&v_flat.t());
 
-            let temp2 = cy_slice.dot(&temp_slice);
-            let result = cz_slice.dot(&temp2);
-            results.push(result);
-        }
+            let mut temp2 = Array2::<f64>::zeros((zy_pairs.len(), nx));
+            for (mut row, &(iz, iy)) in temp2.rows_mut().into_iter().zip(&zy_pairs) {
+                let temp_slice = temp1.row(iz).to_shape((nx, ny)).unwrap();
+                row.assign(&temp_slice.dot(&c_y.rows.row(iy)));
+            }
+
+            (0..num_points)
+                .map(|p| c_x.row(p).dot(&temp2.row(zy_index[p])))
+                .collect()
+        };
 
         Ok(results)
     }
@@ -1763,6 +2178,94 @@ mod tests {
         }
     }
 
+    #[test]
+    fn test_log_bicubic_knot_weights() {
+        let xs = create_logspaced(1e-5, 1.0, 10)
+            .iter()
+            .map(|x| x.ln())
+            .collect_vec();
+        let q2s = create_logspaced(1.65, 1e5, 7)
+            .iter()
+            .map(|q2| q2.ln())
+            .collect_vec();
+        let values = xs
+            .iter()
+            .cartesian_product(&q2s)
+            .map(|(x, q2)| (x.exp() * (1.0 - x.exp()).powi(3) + 0.1) * q2.sqrt())
+            .collect_vec();
+        let data = create_test_data_2d(xs.clone(), q2s.clone(), values.clone());
+
+        let mut log_bicubic = LogBicubicInterpolation::default();
+        log_bicubic.init(&data).unwrap();
+
+        for (ix, iq2) in (0..=25).cartesian_product(0..=25) {
+            let x = (xs[0] + (xs[9] - xs[0]) * ix as f64 / 25.0).min(xs[9]);
+            let q2 = (q2s[0] + (q2s[6] - q2s[0]) * iq2 as f64 / 25.0).min(q2s[6]);
+
+            let i = utils::find_interval_index(&xs, x).unwrap();
+            let j = utils::find_interval_index(&q2s, q2).unwrap();
+            let wx =
+                LogBicubicInterpolation::knot_weights(&xs, i, (x - xs[i]) / (xs[i + 1] - xs[i]));
+            let wq2 = LogBicubicInterpolation::knot_weights(
+                &q2s,
+                j,
+                (q2 - q2s[j]) / (q2s[j + 1] - q2s[j]),
+            );
+
+            // The knots outside of the grid must not contribute.
+            assert!(i > 0 || wx[0] == 0.0);
+            assert!(i + 2 < xs.len() || wx[3] == 0.0);
+            assert!(j > 0 || wq2[0] == 0.0);
+            assert!(j + 2 < q2s.len() || wq2[3] == 0.0);
+
+            let mut result = 0.0;
+            for (a, b) in (0..4).cartesian_product(0..4) {
+                if wx[a] != 0.0 && wq2[b] != 0.0 {
+                    result += wx[a] * wq2[b] * values[(i + a - 1) * q2s.len() + j + b - 1];
+                }
+            }
+
+            let expected = log_bicubic.interpolate(&data, &[x, q2]).unwrap();
+            assert_close(result, expected, 1e-12 * expected.abs());
+        }
+    }
+
+    #[test]
+    fn test_log_bicubic_table_interpolation() {
+        let xs = create_logspaced(1e-5, 1.0, 10)
+            .iter()
+            .map(|x| x.ln())
+            .collect_vec();
+        let q2s = create_logspaced(1.65, 1e5, 7)
+            .iter()
+            .map(|q2| q2.ln())
+            .collect_vec();
+        let values = xs
+            .iter()
+            .cartesian_product(&q2s)
+            .map(|(x, q2)| (x.exp() * (1.0 - x.exp()).powi(3) + 0.1) * q2.sqrt())
+            .collect_vec();
+        let data = create_test_data_2d(xs.clone(), q2s.clone(), values);
+
+        let mut log_bicubic = LogBicubicInterpolation::default();
+        log_bicubic.init(&data).unwrap();
+        let mut log_bicubic_table = LogBicubicTableInterpolation::default();
+        log_bicubic_table.init(&data).unwrap();
+
+        assert_eq!(std::mem::align_of::<BicubicCell>(), 64);
+        assert_eq!(log_bicubic_table.cells.len(), 9 * 6);
+
+        // The points cover the inner cells as well as the cells at the edges of both axes.
+        for (ix, iq2) in (0..=25).cartesian_product(0..=25) {
+            let x = (xs[0] + (xs[9] - xs[0]) * ix as f64 / 25.0).min(xs[9]);
+            let q2 = (q2s[0] + (q2s[6] - q2s[0]) * iq2 as f64 / 25.0).min(q2s[6]);
+
+            let result = log_bicubic_table.interpolate(&data, &[x, q2]).unwrap();
+            let expected = log_bicubic.interpolate(&data, &[x, q2]).unwrap();
+            assert_close(result, expected, 1e-12 * expected.abs());
+        }
+    }
+
     #[test]
     fn test_ddlogq_derivatives() {
         let data = create_test_data_1d(
@@ -2028,4 +2531,93 @@ mod tests {
             assert_close(*res, *exp, EPSILON);
         }
     }
+
+    #[test]
+    fn test_chebyshev_nodes() {
+        let nodes = ChebyshevNodes::<2>::new([5, 11]);
+
+        for (dim, &n) in [5, 11].iter().enumerate() {
+            // Each slice of the buffer starts on a cache line.
+            assert_eq!(nodes.t_coords(dim).as_ptr() as usize % 64, 0);
+            assert_eq!(nodes.weights(dim).as_ptr() as usize % 64, 0);
+            assert_eq!(nodes.t_coords(dim).len(), n);
+            assert_close(nodes.t_coords(dim)[0], -1.0, EPSILON);
+            assert_close(nodes.t_coords(dim)[n - 1], 1.0, EPSILON);
+            assert_eq!(nodes.weights(dim)[0], 0.5);
+            assert_eq!(nodes.weights(dim)[1], -1.0);
+        }
+
+        let t_coords: Vec<Vec<f64>> = (0..2).map(|d| nodes.t_coords(d).to_vec()).collect();
+        let weights: Vec<Vec<f64>> = (0..2).map(|d| nodes.weights(d).to_vec()).collect();
+        let rebuilt = ChebyshevNodes::<2>::from_parts(&t_coords, &weights).unwrap();
+        assert_eq!(rebuilt.values(), nodes.values());
+        assert!(ChebyshevNodes::<3>::from_parts(&t_coords, &weights).is_err());
+    }
+
+    #[test]
+    fn test_log_chebyshev_batch_repeated_coordinates() {
+        let n = 9;
+        let coords: Vec<f64> = create_cheby_grid(n, 0.1, 10.0)
+            .iter()
+            .map(|v| v.ln())
+            .collect();
+        let f = |x: f64, y: f64, z: f64| (x * y).sin() + z * z * x + y.cos();
+
+        let f_values_2d: Vec<f64> = coords
+            .iter()
+            .cartesian_product(&coords)
+            .map(|(&x, &y)| f(x, y, 0.3))
+            .collect();
+        let data_2d = create_test_data_2d(coords.clone(), coords.clone(), f_values_2d);
+        let mut batch_2d = LogChebyshevBatchInterpolation::<2>::default();
+        batch_2d.init(&data_2d).unwrap();
+        let mut scalar_2d = LogChebyshevInterpolation::<2>::default();
+        scalar_2d.init(&data_2d).unwrap();
+
+        let f_values_3d: Vec<f64> = coords
+            .iter()
+            .cartesian_product(&coords)
+            .cartesian_product(&coords)
+            .map(|((&x, &y), &z)| f(x, y, z))
+            .collect();
+        let data_3d =
+            create_test_data_3d(coords.clone(), coords.clone(), coords.clone(), f_values_3d);
+        let mut batch_3d = LogChebyshevBatchInterpolation::<3>::default();
+        batch_3d.init(&data_3d).unwrap();
+        let mut scalar_3d = LogChebyshevInterpolation::<3>::default();
+        scalar_3d.init(&data_3d).unwrap();
+
+        // Scans along each axis at fixed values of the others, which are contracted along
+        // different dimensions first, including points exactly on the nodes.
+        let scan: Vec<f64> = (0..40).map(|i| -2.0 + 0.1 * f64::from(i)).collect();
+        let fixed = [0.7, coords[3]];
+        for axis in 0..3 {
+            let points: Vec<[f64; 3]> = scan
+                .iter()
+                .chain(&coords)
+                .flat_map(|&t| {
+                    fixed.iter().map(move |&c| {
+                        let mut point = [c, 0.25, c];
+                        point[axis] = t;
+                        point
+                    })
+                })
+                .collect();
+
+            let results = batch_3d.interpolate(&data_3d, &points).unwrap();
+            for (point, result) in points.iter().zip(results) {
+                let expected = scalar_3d.interpolate(&data_3d, point).unwrap();
+                assert_close(result, expected, 1e-12);
+            }
+
+            if axis < 2 {
+                let points: Vec<[f64; 2]> = points.iter().map(|p| [p[0], p[1]]).collect();
+                let results = batch_2d.interpolate(&data_2d, &points).unwrap();
+                for (point, result) in points.iter().zip(results) {
+                    let expected = scalar_2d.interpolate(&data_2d, point).unwrap();
+                    assert_close(result, expected, 1e-12);
+                }
+            }
+        }
+    }
 }
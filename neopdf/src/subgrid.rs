@@ -6,13 +6,13 @@
 //! - [`SubGrid`]: Represents a region of phase space with a consistent grid and provides
 //!   methods for subgrid logic.
 
-use ndarray::{s, Array1, Array6, ArrayView2};
+use ndarray::{s, ArcArray, Array1, Array3, Array6, ArrayView2, Axis, CowArray, Ix2, Ix6};
 use serde::{Deserialize, Serialize};
 
 use super::interpolator::InterpolationConfig;
 
 /// Represents the valid range of a parameter, with a minimum and maximum value.
-#[derive(Debug, Clone, Copy, Deserialize, Serialize)]
+#[derive(Debug, Clone, Copy, PartialEq, Deserialize, Serialize)]
 pub struct ParamRange {
     /// The minimum value of the parameter.
     pub min: f64,
@@ -99,7 +99,18 @@ pub struct SubGrid {
     /// Array of `kT` values (transverse momentum).
     pub kts: Array1<f64>,
     /// 6-dimensional grid data: [nucleons, alphas, pids, kT, x, Q²].
-    pub grid: Array6<f64>,
+    ///
+    /// The data is reference-counted such that the interpolators of the flavors share it
+    /// instead of holding copies of their slices. The indices always follow this order,
+    /// whereas the layout in memory may differ, see [`SubGrid::interleave`]. The array is
+    /// empty when the subgrid is stored in single precision, hence the knot values are read
+    /// through [`SubGrid::grid`], [`SubGrid::grid_slice`] or [`SubGrid::knot_value`], which
+    /// account for both the precision and the strides.
+    pub(crate) grid: ArcArray<f64, Ix6>,
+    /// The knot values rounded to single precision, in which case `grid` is released, see
+    /// [`SubGrid::to_single_precision`]. They are never serialized as such.
+    #[serde(skip)]
+    pub(crate) grid_f32: Option<ArcArray<f32, Ix6>>,
     /// Array of nucleon number values.
     pub nucleons: Array1<f64>,
     /// Array of alpha_s values.
@@ -167,13 +178,15 @@ impl SubGrid {
         .expect("Failed to create grid")
         .permuted_axes([0, 1, 5, 2, 3, 4])
         .as_standard_layout()
-        .to_owned();
+        .to_owned()
+        .into_shared();
 
         Self {
             xs: Array1::from_vec(x_subgrid),
             q2s: Array1::from_vec(q2_subgrid),
             kts: Array1::from_vec(kt_subgrid),
             grid: subgrid,
+            grid_f32: None,
             nucleons: Array1::from_vec(nucleon_numbers),
             alphas: Array1::from_vec(alphas_values),
             nucleons_range: ncs_range,
@@ -184,6 +197,38 @@ impl SubGrid {
         }
     }
 
+    /// Creates a new `SubGrid` from knot values already ordered as
+    /// `[nucleons, alphas, pids, kT, x, Q2]`.
+    ///
+    /// # Panics
+    ///
+    /// Panics if any of the knot vectors is empty.
+    pub fn from_grid(
+        nucleon_numbers: Vec<f64>,
+        alphas_values: Vec<f64>,
+        kt_subgrid: Vec<f64>,
+        x_subgrid: Vec<f64>,
+        q2_subgrid: Vec<f64>,
+        grid: Array6<f64>,
+    ) -> Self {
+        let range = |knots: &[f64]| ParamRange::new(knots[0], knots[knots.len() - 1]);
+
+        Self {
+            nucleons_range: range(&nucleon_numbers),
+            alphas_range: range(&alphas_values),
+            kt_range: range(&kt_subgrid),
+            x_range: range(&x_subgrid),
+            q2_range: range(&q2_subgrid),
+            xs: Array1::from_vec(x_subgrid),
+            q2s: Array1::from_vec(q2_subgrid),
+            kts: Array1::from_vec(kt_subgrid),
+            grid: grid.into_shared(),
+            grid_f32: None,
+            nucleons: Array1::from_vec(nucleon_numbers),
+            alphas: Array1::from_vec(alphas_values),
+        }
+    }
+
     /// Checks if a point (..., `x`, `q2`) is within the boundaries of this subgrid.
     ///
     /// # Arguments
@@ -196,26 +241,10 @@ impl SubGrid {
     ///
     /// `true` if the point is within the subgrid, `false` otherwise.
     pub fn contains_point(&self, points: &[f64]) -> bool {
-        let (expected_len, ranges) = match self.interpolation_config() {
-            InterpolationConfig::TwoD => (2, vec![]),
-            InterpolationConfig::ThreeDNucleons => (3, vec![&self.nucleons_range]),
-            InterpolationConfig::ThreeDAlphas => (3, vec![&self.alphas_range]),
-            InterpolationConfig::ThreeDKt => (3, vec![&self.kt_range]),
-            InterpolationConfig::FourDNucleonsAlphas => {
-                (4, vec![&self.nucleons_range, &self.alphas_range])
-            }
-            InterpolationConfig::FourDNucleonsKt => (4, vec![&self.nucleons_range, &self.kt_range]),
-            InterpolationConfig::FourDAlphasKt => (4, vec![&self.alphas_range, &self.kt_range]),
-            InterpolationConfig::FiveD => (
-                5,
-                vec![&self.nucleons_range, &self.alphas_range, &self.kt_range],
-            ),
-        };
+        let (ranges, ndims) = self.parameter_ranges();
 
-        points.len() == expected_len
-            && self.x_range.contains(points[expected_len - 2])
-            && self.q2_range.contains(points[expected_len - 1])
-            && ranges
+        points.len() == ndims
+            && ranges[..ndims]
                 .iter()
                 .zip(points)
                 .all(|(range, &point)| range.contains(point))
@@ -223,7 +252,9 @@ impl SubGrid {
 
     /// Calculates the squared distance from a point to the subgrid's bounding box.
     pub fn distance_to_point(&self, points: &[f64]) -> f64 {
-        self.parameter_ranges()
+        let (ranges, ndims) = self.parameter_ranges();
+
+        ranges[..ndims]
             .iter()
             .zip(points)
             .map(|(range, &point)| match point {
@@ -235,23 +266,24 @@ impl SubGrid {
     }
 
     /// Gathers the parameter ranges for the subgrid based on its configuration.
-    fn parameter_ranges(&self) -> Vec<ParamRange> {
-        let mut ranges = match self.interpolation_config() {
-            InterpolationConfig::TwoD => vec![],
-            InterpolationConfig::ThreeDNucleons => vec![self.nucleons_range],
-            InterpolationConfig::ThreeDAlphas => vec![self.alphas_range],
-            InterpolationConfig::ThreeDKt => vec![self.kt_range],
-            InterpolationConfig::FourDNucleonsAlphas => {
-                vec![self.nucleons_range, self.alphas_range]
-            }
-            InterpolationConfig::FourDNucleonsKt => vec![self.nucleons_range, self.kt_range],
-            InterpolationConfig::FourDAlphasKt => vec![self.alphas_range, self.kt_range],
-            InterpolationConfig::FiveD => {
-                vec![self.nucleons_range, self.alphas_range, self.kt_range]
-            }
-        };
-        ranges.extend([self.x_range, self.q2_range]);
-        ranges
+    ///
+    /// The ranges are returned in a fixed-size buffer, in the order `(A, alpha_s, kT, x, Q2)`
+    /// restricted to the dimensions present in the grid, together with the number of
+    /// dimensions in use. The unused trailing entries are unspecified.
+    pub(crate) fn parameter_ranges(&self) -> ([ParamRange; 5], usize) {
+        let (nc, als, kt) = (self.nucleons_range, self.alphas_range, self.kt_range);
+        let (x, q2) = (self.x_range, self.q2_range);
+
+        match self.interpolation_config() {
+            InterpolationConfig::TwoD => ([x, q2, q2, q2, q2], 2),
+            InterpolationConfig::ThreeDNucleons => ([nc, x, q2, q2, q2], 3),
+            InterpolationConfig::ThreeDAlphas => ([als, x, q2, q2, q2], 3),
+            InterpolationConfig::ThreeDKt => ([kt, x, q2, q2, q2], 3),
+            InterpolationConfig::FourDNucleonsAlphas => ([nc, als, x, q2, q2], 4),
+            InterpolationConfig::FourDNucleonsKt => ([nc, kt, x, q2, q2], 4),
+            InterpolationConfig::FourDAlphasKt => ([als, kt, x, q2, q2], 4),
+            InterpolationConfig::FiveD => ([nc, als, kt, x, q2], 5),
+        }
     }
 
     /// Gets the interpolation configuration for this subgrid.
@@ -270,9 +302,30 @@ impl SubGrid {
         )
     }
 
+    /// Returns the knot values indexed as `[nucleons, alphas, pids, kT, x, Q2]` in double
+    /// precision.
+    ///
+    /// The values are borrowed, unless the subgrid is stored in single precision, in which
+    /// case they are converted into a new array.
+    pub fn grid(&self) -> CowArray<'_, f64, Ix6> {
+        self.grid_f32.as_ref().map_or_else(
+            || CowArray::from(self.grid.view()),
+            |grid| CowArray::from(grid.mapv(f64::from)),
+        )
+    }
+
+    /// Returns the dimensions of the knot values, whatever the precision they are stored in.
+    pub fn grid_dim(&self) -> (usize, usize, usize, usize, usize, usize) {
+        self.grid_f32
+            .as_ref()
+            .map_or_else(|| self.grid.dim(), |grid| grid.dim())
+    }
+
     /// Gets a 2D slice of the grid for interpolation.
     ///
-    /// This method is only valid for 2D interpolation configurations.
+    /// This method is only valid for 2D interpolation configurations. The values are
+    /// borrowed, unless the subgrid is stored in single precision, in which case they are
+    /// converted into a new array, see [`SubGrid::grid_slice_f32`].
     ///
     /// # Arguments
     ///
@@ -281,12 +334,114 @@ impl SubGrid {
     /// # Panics
     ///
     /// Panics if called on a subgrid that is not 2D.
-    pub fn grid_slice(&self, pid_index: usize) -> ArrayView2<f64> {
+    pub fn grid_slice(&self, pid_index: usize) -> CowArray<'_, f64, Ix2> {
         match self.interpolation_config() {
-            InterpolationConfig::TwoD => self.grid.slice(s![0, 0, pid_index, 0, .., ..]),
+            InterpolationConfig::TwoD => match &self.grid_f32 {
+                Some(grid) => {
+                    CowArray::from(grid.slice(s![0, 0, pid_index, 0, .., ..]).mapv(f64::from))
+                }
+                None => CowArray::from(self.grid.slice(s![0, 0, pid_index, 0, .., ..])),
+            },
             _ => panic!("grid_slice only valid for 2D interpolation"),
         }
     }
+
+    /// Gets a 2D slice of the single-precision grid for interpolation, or `None` if the
+    /// subgrid is stored in double precision.
+    ///
+    /// # Arguments
+    ///
+    /// * `pid_index` - The index of the particle ID (flavor).
+    ///
+    /// # Panics
+    ///
+    /// Panics if called on a subgrid that is not 2D.
+    pub fn grid_slice_f32(&self, pid_index: usize) -> Option<ArrayView2<f32>> {
+        match self.interpolation_config() {
+            InterpolationConfig::TwoD => self
+                .grid_f32
+                .as_ref()
+                .map(|grid| grid.slice(s![0, 0, pid_index, 0, .., ..])),
+            _ => panic!("grid_slice_f32 only valid for 2D interpolation"),
+        }
+    }
+
+    /// Returns whether the knot values are stored in single precision.
+    pub fn is_single_precision(&self) -> bool {
+        self.grid_f32.is_some()
+    }
+
+    /// Returns the knot value at `[nucleon, alpha_s, pid, kT, x, Q2]` indices, whatever the
+    /// precision it is stored in.
+    pub fn knot_value(&self, index: [usize; 6]) -> f64 {
+        self.grid_f32
+            .as_ref()
+            .map_or_else(|| self.grid[index], |grid| f64::from(grid[index]))
+    }
+
+    /// Returns the number of bytes held by the knot values.
+    pub fn knot_values_bytes(&self) -> usize {
+        self.grid.len() * std::mem::size_of::<f64>()
+            + self
+                .grid_f32
+                .as_ref()
+                .map_or(0, |grid| grid.len() * std::mem::size_of::<f32>())
+    }
+
+    /// Stores the knot values of a 2D subgrid with the flavors innermost in memory, i.e. in
+    /// `[x, Q2, pids]` order, while keeping the order of the indices of `grid` and
+    /// `grid_f32`.
+    ///
+    /// The knot values of all the flavors at a knot are then adjacent, such that a stencil
+    /// is gathered once for all the flavors of an evaluation, see
+    /// `interpolator::InterleavedKnots`. The knot values of a flavor are strided instead of
+    /// contiguous. The other subgrids, and the ones already interleaved, are left as they
+    /// are.
+    pub fn interleave(&mut self) {
+        if matches!(self.interpolation_config(), InterpolationConfig::TwoD) {
+            self.grid = interleave_flavors(&self.grid);
+            if let Some(grid) = &self.grid_f32 {
+                self.grid_f32 = Some(interleave_flavors(grid));
+            }
+        }
+    }
+
+    /// Stores the knot values in single precision, halving their memory footprint.
+    ///
+    /// The values are rounded to the nearest `f32` and the double-precision storage is
+    /// released. The values read through [`SubGrid::grid`] and [`SubGrid::grid_slice`] are
+    /// then converted back to `f64`, and the interpolators still accumulate in double
+    /// precision. Calling this method again has no effect.
+    #[allow(clippy::cast_possible_truncation)]
+    pub fn to_single_precision(&mut self) {
+        if self.grid_f32.is_none() {
+            self.grid_f32 = Some(self.grid.mapv(|value| value as f32).into_shared());
+            self.grid = ArcArray::from_shape_vec((0, 0, 0, 0, 0, 0), Vec::new())
+                .expect("Failed to release grid");
+        }
+    }
+}
+
+/// Copies the knot values of a 2D subgrid into the `[x, Q2, pids]` memory order, keeping
+/// the `[nucleons, alphas, pids, kT, x, Q2]` order of the indices, see
+/// [`SubGrid::interleave`].
+fn interleave_flavors<T: Copy>(grid: &ArcArray<T, Ix6>) -> ArcArray<T, Ix6> {
+    if grid.is_empty() {
+        return grid.clone();
+    }
+
+    let knot_values = grid.slice(s![0, 0, .., 0, .., ..]).permuted_axes([1, 2, 0]);
+    if knot_values.is_standard_layout() {
+        return grid.clone();
+    }
+
+    Array3::from_shape_vec(knot_values.raw_dim(), knot_values.iter().copied().collect())
+        .expect("Failed to interleave the knot values")
+        .permuted_axes([2, 0, 1])
+        .insert_axis(Axis(0))
+        .insert_axis(Axis(0))
+        .insert_axis(Axis(3))
+        .into_shared()
 }
 
 #[cfg(test)]
@@ -299,4 +454,67 @@ mod tests {
         assert!(range.contains(5.0));
         assert!(!range.contains(15.0));
     }
+
+    #[test]
+    fn test_single_precision() {
+        let values: Vec<f64> = (0..6).map(|i| 1.0 + f64::from(i) / 3.0).collect();
+        let mut subgrid = SubGrid::new(
+            vec![1.0],
+            vec![0.118],
+            vec![0.0],
+            vec![0.1, 0.2, 0.3],
+            vec![1.0, 2.0],
+            1,
+            values.clone(),
+        );
+        assert!(!subgrid.is_single_precision());
+        assert_eq!(subgrid.knot_values_bytes(), 6 * 8);
+
+        subgrid.to_single_precision();
+        assert!(subgrid.is_single_precision());
+        assert_eq!(subgrid.grid.len(), 0);
+        assert_eq!(subgrid.knot_values_bytes(), 6 * 4);
+        assert_eq!(subgrid.grid_dim(), (1, 1, 1, 1, 3, 2));
+        assert_eq!(subgrid.grid().dim(), (1, 1, 1, 1, 3, 2));
+
+        let slice = subgrid.grid_slice_f32(0).unwrap();
+        assert_eq!(slice.dim(), (3, 2));
+        for (i, &value) in values.iter().enumerate() {
+            let index = [0, 0, 0, 0, i / 2, i % 2];
+            assert_eq!(slice[[i / 2, i % 2]], value as f32);
+            assert_eq!(
+                subgrid.grid_slice(0)[[i / 2, i % 2]],
+                f64::from(value as f32)
+            );
+            assert_eq!(subgrid.grid()[index], f64::from(value as f32));
+            assert!((subgrid.knot_value(index) - value).abs() <= value * f64::from(f32::EPSILON));
+        }
+    }
+
+    #[test]
+    fn test_interleave() {
+        let values: Vec<f64> = (0..12).map(f64::from).collect();
+        let mut subgrid = SubGrid::new(
+            vec![1.0],
+            vec![0.118],
+            vec![0.0],
+            vec![0.1, 0.2, 0.3],
+            vec![1.0, 2.0],
+            2,
+            values.clone(),
+        );
+        let expected = subgrid.grid.clone();
+
+        subgrid.interleave();
+        assert_eq!(subgrid.grid, expected);
+        assert_eq!(subgrid.grid.shape(), &[1, 1, 2, 1, 3, 2]);
+        // The flavors are innermost in memory, as in the data the subgrid was created from.
+        assert_eq!(subgrid.grid.as_slice_memory_order(), Some(&values[..]));
+        assert_eq!(subgrid.grid_slice(1)[[2, 1]], 11.0);
+        assert_eq!(subgrid.knot_value([0, 0, 1, 0, 1, 0]), 5.0);
+
+        subgrid.to_single_precision();
+        subgrid.interleave();
+        assert_eq!(subgrid.grid_slice_f32(1).unwrap()[[2, 1]], 11.0);
+    }
 }
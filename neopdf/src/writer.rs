@@ -12,26 +12,60 @@
 //! - Random access to individual grid members without loading the entire collection into memory.
 //! - Extraction of metadata without full decompression.
 //! - Lazy iteration over grid members for memory-efficient processing of large sets.
+//! - Members stored in independent blocks, such that a single member is read and decoded
+//!   without touching the others.
+//!
+//! # File Layouts
+//!
+//! Files are written in the block layout, which starts with magic bytes identifying the
+//! codec of the blocks, the metadata and the number of members, followed by one block per
+//! member and a trailing index of the block offsets:
+//!
+//! - [`GridArrayCollection::compress`] compresses every block independently with LZ4, such
+//!   that loading a member only decompresses its own block.
+//! - [`GridArrayCollection::write_uncompressed`] stores the blocks as they are, with the knot
+//!   values of the subgrids as little-endian `f64` aligned to `BLOCK_ALIGNMENT` bytes, such
+//!   that loading a member only reads its own block, without any decompression. The knot
+//!   values are still copied from the block into the subgrids of the member, i.e. every
+//!   process reading the file holds its own copy of the members it loaded.
+//!
+//! Since the index is at the end of the file, the members can also be written one at a time
+//! with a [`GridArrayWriter`], which encodes each member straight to the file as soon as it is
+//! pushed, such that only one member is held in memory at any time. Its
+//! [`GridArrayWriter::push_subgrids`] writes members from borrowed buffers, see
+//! [`SubGridView`], without building the [`SubGrid`]s.
+//!
+//! Files written before the block layout was introduced consist of a single LZ4 frame over
+//! the metadata, an offset table and the bincode-serialized grids. They are still read, but
+//! the whole frame has to be decompressed before any member can be accessed.
 //!
 //! # Key Types
 //!
 //! - [`GridArrayWithMetadata`]: Container for a grid and its associated metadata.
 //! - [`GridArrayCollection`]: Static interface for compressing and decompressing collections of grids.
+//! - [`GridArrayWriter`]: Writes the members of a set one at a time.
+//! - [`SubGridView`]: Borrowed knots and values of a subgrid, written without copies.
 //! - [`GridArrayReader`]: Provides random access to individual grids in a compressed file.
 //! - [`LazyGridArrayIterator`]: Enables lazy, sequential iteration over grid members.
 //!
 //! See the documentation for each type for more details on available methods and usage patterns.
 use std::env;
 use std::fs::File;
-use std::io::{BufReader, BufWriter, Read, Write};
+use std::io::{self, BufReader, BufWriter, Cursor, Read, Seek, SeekFrom, Write};
 use std::path::Path;
-use std::sync::Arc;
+use std::sync::mpsc::{self, Receiver};
+use std::sync::{Arc, Mutex};
+use std::thread;
 
 use git_version::git_version;
-use lz4_flex::frame::{FrameDecoder, FrameEncoder};
+use lz4_flex::block::{compress_prepend_size, decompress_size_prepended};
+use lz4_flex::frame::FrameDecoder;
+use ndarray::{ArcArray, Array1, ArrayView6};
+use serde::{Deserialize, Serialize};
 
 use super::gridpdf::GridArray;
 use super::metadata::MetaData;
+use super::subgrid::{ParamRange, SubGrid};
 
 const GIT_VERSION: &str = git_version!(
     args = ["--always", "--dirty", "--long", "--tags"],
@@ -40,6 +74,18 @@ const GIT_VERSION: &str = git_version!(
 );
 const CODE_VERSION: &str = env!("CARGO_PKG_VERSION");
 
+/// Magic bytes at the start and at the end of a file in the block layout with raw blocks.
+const RAW_BLOCK_MAGIC: [u8; 8] = *b"NEOPDF\x00\x01";
+/// Magic bytes at the start and at the end of a file in the block layout with LZ4 blocks.
+const LZ4_BLOCK_MAGIC: [u8; 8] = *b"NEOPDF\x00\x02";
+/// Alignment, in bytes, of the member blocks and of the knot values in the block layout.
+const BLOCK_ALIGNMENT: u64 = 64;
+/// Number of decoded members the lazy iterator keeps ready ahead of the one being consumed.
+const PREFETCH_DEPTH: usize = 1;
+
+/// File extension selecting the uncompressed block layout in [`GridArrayCollection::write`].
+pub const UNCOMPRESSED_EXTENSION: &str = ".neopdf";
+
 /// Container for a [`GridArray`] with a shared reference to its associated metadata.
 ///
 /// Used to bundle grid data and metadata together for convenient access after decompression
@@ -56,8 +102,44 @@ pub struct GridArrayWithMetadata {
 pub struct GridArrayCollection;
 
 impl GridArrayCollection {
+    /// Writes a collection of [`GridArray`]s and shared metadata to a file, in the layout
+    /// selected by the extension of the file.
+    ///
+    /// Files ending with [`UNCOMPRESSED_EXTENSION`] are written in the uncompressed block
+    /// layout, see [`GridArrayCollection::write_uncompressed`], and all the others in the
+    /// LZ4 layout, see [`GridArrayCollection::compress`].
+    ///
+    /// # Arguments
+    ///
+    /// * `grids` - Slice of grid arrays to write.
+    /// * `metadata` - Shared metadata for all grids.
+    /// * `path` - Output file path.
+    ///
+    /// # Returns
+    ///
+    /// `Ok(())` on success, or an error if writing fails.
+    pub fn write<P: AsRef<Path>>(
+        grids: &[&GridArray],
+        metadata: &MetaData,
+        path: P,
+    ) -> Result<(), Box<dyn std::error::Error>> {
+        if path
+            .as_ref()
+            .to_string_lossy()
+            .ends_with(UNCOMPRESSED_EXTENSION)
+        {
+            Self::write_uncompressed(grids, metadata, path)
+        } else {
+            Self::compress(grids, metadata, path)
+        }
+    }
+
     /// Compresses and writes a collection of [`GridArray`]s and shared metadata to a file.
     ///
+    /// Each member is compressed into its own block, and the offsets of the blocks are
+    /// stored in an index at the end of the file, such that the members can be loaded
+    /// individually.
+    ///
     /// # Arguments
     ///
     /// * `grids` - Slice of grid arrays to compress.
@@ -72,164 +154,687 @@ impl GridArrayCollection {
         metadata: &MetaData,
         path: P,
     ) -> Result<(), Box<dyn std::error::Error>> {
-        let file = File::create(path)?;
-        let buf_writer = BufWriter::new(file);
-        let mut encoder = FrameEncoder::new(buf_writer);
+        Self::write_blocks(grids, metadata, path, BlockCodec::Lz4)
+    }
+
+    /// Writes a collection of [`GridArray`]s and shared metadata to a file in the
+    /// uncompressed block layout.
+    ///
+    /// Each member is stored in its own block, with the knot values aligned such that they
+    /// are decoded without decompression. The offsets of the blocks are stored in an index
+    /// at the end of the file.
+    ///
+    /// # Arguments
+    ///
+    /// * `grids` - Slice of grid arrays to write.
+    /// * `metadata` - Shared metadata for all grids.
+    /// * `path` - Output file path.
+    ///
+    /// # Returns
+    ///
+    /// `Ok(())` on success, or an error if writing fails.
+    pub fn write_uncompressed<P: AsRef<Path>>(
+        grids: &[&GridArray],
+        metadata: &MetaData,
+        path: P,
+    ) -> Result<(), Box<dyn std::error::Error>> {
+        Self::write_blocks(grids, metadata, path, BlockCodec::Raw)
+    }
+
+    /// Decompresses and loads all [`GridArray`]s and shared metadata from a file.
+    ///
+    /// # Arguments
+    ///
+    /// * `path` - Input file path.
+    ///
+    /// # Returns
+    ///
+    /// A vector of [`GridArrayWithMetadata`] on success, or an error if reading fails.
+    pub fn decompress<P: AsRef<Path>>(
+        path: P,
+    ) -> Result<Vec<GridArrayWithMetadata>, Box<dyn std::error::Error>> {
+        let reader = GridArrayReader::from_file(path)?;
+        (0..reader.len())
+            .map(|index| reader.load_grid(index))
+            .collect()
+    }
+
+    /// Extracts just the metadata from a compressed file without loading the grids.
+    ///
+    /// # Arguments
+    ///
+    /// * `path` - Input file path.
+    ///
+    /// # Returns
+    ///
+    /// The [`MetaData`] struct on success, or an error if reading fails.
+    pub fn extract_metadata<P: AsRef<Path>>(
+        path: P,
+    ) -> Result<MetaData, Box<dyn std::error::Error>> {
+        let mut file = File::open(path)?;
+        if BlockCodec::from_magic(&read_magic(&mut file)?).is_some() {
+            let (metadata, _, _) = read_block_header(&mut BufReader::new(file))?;
+            return Ok(metadata);
+        }
+        file.rewind()?;
+
+        let buf_reader = BufReader::new(file);
+        let mut decoder = FrameDecoder::new(buf_reader);
+
+        let mut decompressed = Vec::new();
+        decoder.read_to_end(&mut decompressed)?;
 
+        let mut cursor = std::io::Cursor::new(decompressed);
+
+        let metadata_size: u64 = bincode::deserialize_from(&mut cursor)?;
+        let mut metadata_bytes = vec![0u8; metadata_size as usize];
+        cursor.read_exact(&mut metadata_bytes)?;
+        let metadata: MetaData = bincode::deserialize(&metadata_bytes)?;
+
+        Ok(metadata)
+    }
+
+    /// Writes the members in the block layout, with blocks encoded by `codec`.
+    fn write_blocks<P: AsRef<Path>>(
+        grids: &[&GridArray],
+        metadata: &MetaData,
+        path: P,
+        codec: BlockCodec,
+    ) -> Result<(), Box<dyn std::error::Error>> {
+        let mut writer = GridArrayWriter::with_codec(path, metadata, codec)?;
+        for grid in grids {
+            writer.push(grid)?;
+        }
+        writer.finish()
+    }
+
+    /// Returns the metadata to be written, stamped with the versions of the code.
+    fn stamped_metadata(metadata: &MetaData) -> MetaData {
         let mut metadata_mut = metadata.as_latest();
         metadata_mut.git_version = GIT_VERSION.to_string();
         metadata_mut.code_version = CODE_VERSION.to_string();
 
-        let updated_metadata = MetaData::new_v1(metadata_mut);
-        let metadata_serialized = bincode::serialize(&updated_metadata)?;
-        let metadata_size = metadata_serialized.len() as u64;
+        MetaData::new_v1(metadata_mut)
+    }
+}
+
+/// Layout of a [`SubGrid`] within a member block, with its knot values stored apart.
+#[derive(Serialize, Deserialize)]
+struct SubGridLayout {
+    xs: Array1<f64>,
+    q2s: Array1<f64>,
+    kts: Array1<f64>,
+    nucleons: Array1<f64>,
+    alphas: Array1<f64>,
+    /// The ranges of the parameters `(A, alpha_s, kT, x, Q2)`.
+    ranges: [ParamRange; 5],
+    /// The shape of the knot values.
+    shape: [usize; 6],
+    /// The offset of the knot values from the start of the block, in bytes.
+    offset: u64,
+}
+
+/// Layout of a [`GridArray`] within a member block.
+#[derive(Serialize, Deserialize)]
+struct GridArrayLayout {
+    pids: Array1<i32>,
+    subgrids: Vec<SubGridLayout>,
+}
 
-        let metadata_size_bytes = bincode::serialize(&metadata_size)?;
-        encoder.write_all(&metadata_size_bytes)?;
-        encoder.write_all(&metadata_serialized)?;
+/// Rounds a position up to the next multiple of `BLOCK_ALIGNMENT`.
+fn align(position: u64) -> u64 {
+    position.next_multiple_of(BLOCK_ALIGNMENT)
+}
 
-        // Write number of grids
-        let count = grids.len() as u64;
-        let count_bytes = bincode::serialize(&count)?;
-        encoder.write_all(&count_bytes)?;
+/// Reads a little-endian `u64`.
+fn read_u64<R: Read>(reader: &mut R) -> io::Result<u64> {
+    let mut bytes = [0; 8];
+    reader.read_exact(&mut bytes)?;
+    Ok(u64::from_le_bytes(bytes))
+}
 
-        // Serialize all grids first
-        let mut serialized_grids = Vec::new();
-        for grid in grids {
-            let serialized = bincode::serialize(grid)?;
-            serialized_grids.push(serialized);
+/// Reads the magic bytes at the current position.
+fn read_magic<R: Read>(reader: &mut R) -> io::Result<[u8; 8]> {
+    let mut magic = [0; 8];
+    reader.read_exact(&mut magic)?;
+    Ok(magic)
+}
+
+/// Reads the metadata and the number of members following the magic bytes of the block layout,
+/// together with the position in the file at which the header ends.
+fn read_block_header<R: Read>(
+    reader: &mut R,
+) -> Result<(MetaData, u64, u64), Box<dyn std::error::Error>> {
+    let metadata_size = read_u64(reader)?;
+    let mut metadata_bytes = vec![0u8; metadata_size as usize];
+    reader.read_exact(&mut metadata_bytes)?;
+    let metadata: MetaData = bincode::deserialize(&metadata_bytes)?;
+    let count = read_u64(reader)?;
+    let header_end = RAW_BLOCK_MAGIC.len() as u64 + 16 + metadata_size;
+
+    Ok((metadata, count, header_end))
+}
+
+/// Encoding of the member blocks in the block layout.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+enum BlockCodec {
+    /// The blocks are stored as they are.
+    Raw,
+    /// The blocks are compressed independently with LZ4.
+    Lz4,
+}
+
+impl BlockCodec {
+    /// Determines the codec from the magic bytes of a file, or `None` if the file is not in
+    /// the block layout.
+    fn from_magic(magic: &[u8; 8]) -> Option<Self> {
+        match *magic {
+            RAW_BLOCK_MAGIC => Some(Self::Raw),
+            LZ4_BLOCK_MAGIC => Some(Self::Lz4),
+            _ => None,
         }
+    }
 
-        // Calculate offsets relative to start of data section
-        let mut offsets = Vec::new();
-        let mut current_offset = 0u64;
+    /// Returns the magic bytes of the files using this codec.
+    fn magic(self) -> [u8; 8] {
+        match self {
+            Self::Raw => RAW_BLOCK_MAGIC,
+            Self::Lz4 => LZ4_BLOCK_MAGIC,
+        }
+    }
 
-        // Each grid entry has: 8 bytes for size + data
-        for serialized in &serialized_grids {
-            offsets.push(current_offset);
-            current_offset += 8; // size field
-            current_offset += serialized.len() as u64;
+    /// Decodes the bytes stored for a block into a [`GridArray`].
+    fn decode(self, bytes: &[u8]) -> Result<GridArray, Box<dyn std::error::Error>> {
+        match self {
+            Self::Raw => decode_block(bytes),
+            Self::Lz4 => decode_block(&decompress_size_prepended(bytes)?),
         }
+    }
+}
 
-        // Write offset table size and offsets
-        let offset_table_size = (serialized_grids.len() * 8) as u64;
-        let offset_table_size_bytes = bincode::serialize(&offset_table_size)?;
-        encoder.write_all(&offset_table_size_bytes)?;
+/// A member which can be written as a block, see `write_block`.
+trait BlockMember {
+    /// Returns the layout of the member, with the offsets of the knot values left unset.
+    fn layout(&self) -> GridArrayLayout;
 
-        for offset in &offsets {
-            let offset_bytes = bincode::serialize(offset)?;
-            encoder.write_all(&offset_bytes)?;
+    /// Writes the knot values of the `index`-th subgrid in standard order over
+    /// `[nucleons, alphas, pids, kT, x, Q2]`, as little-endian `f64`.
+    fn write_values<W: Write>(&self, index: usize, writer: &mut W) -> io::Result<()>;
+}
+
+impl BlockMember for GridArray {
+    fn layout(&self) -> GridArrayLayout {
+        GridArrayLayout {
+            pids: self.pids.clone(),
+            subgrids: self
+                .subgrids
+                .iter()
+                .map(|sg| {
+                    let mut shape = [0; 6];
+                    shape.copy_from_slice(
+                        sg.grid_f32.as_ref().map_or(sg.grid.shape(), |g| g.shape()),
+                    );
+                    SubGridLayout {
+                        xs: sg.xs.clone(),
+                        q2s: sg.q2s.clone(),
+                        kts: sg.kts.clone(),
+                        nucleons: sg.nucleons.clone(),
+                        alphas: sg.alphas.clone(),
+                        ranges: [
+                            sg.nucleons_range,
+                            sg.alphas_range,
+                            sg.kt_range,
+                            sg.x_range,
+                            sg.q2_range,
+                        ],
+                        shape,
+                        offset: 0,
+                    }
+                })
+                .collect(),
         }
+    }
 
-        // Write grid data
-        for serialized in &serialized_grids {
-            let size = serialized.len() as u64;
-            let size_bytes = bincode::serialize(&size)?;
-            encoder.write_all(&size_bytes)?;
-            encoder.write_all(serialized)?;
+    fn write_values<W: Write>(&self, index: usize, writer: &mut W) -> io::Result<()> {
+        let sg = &self.subgrids[index];
+        // The subgrids stored in single precision are written with their rounded values.
+        if let Some(grid) = &sg.grid_f32 {
+            write_f64s(writer, grid.iter().map(|&value| f64::from(value)))?;
         }
+        write_f64s(writer, sg.grid.iter().copied())
+    }
+}
+
+/// Borrowed knots and values of a subgrid, written by [`GridArrayWriter::push_subgrids`]
+/// without being copied into a [`SubGrid`].
+///
+/// The values are laid out as the `grid_data` of [`SubGrid::new`], i.e. in standard order
+/// over `[nucleons, alphas, kT, x, Q2, flavors]`, and are reordered while being written.
+#[derive(Clone, Copy, Debug)]
+pub struct SubGridView<'a> {
+    /// The nucleon numbers `A`.
+    pub nucleons: &'a [f64],
+    /// The values of `alpha_s`.
+    pub alphas: &'a [f64],
+    /// The values of `kT`.
+    pub kts: &'a [f64],
+    /// The values of `x`.
+    pub xs: &'a [f64],
+    /// The values of `Q2`.
+    pub q2s: &'a [f64],
+    /// The knot values.
+    pub values: &'a [f64],
+}
+
+impl SubGridView<'_> {
+    /// Returns the shape of the values, in the order in which they are laid out.
+    fn shape(&self, nflav: usize) -> [usize; 6] {
+        [
+            self.nucleons.len(),
+            self.alphas.len(),
+            self.kts.len(),
+            self.xs.len(),
+            self.q2s.len(),
+            nflav,
+        ]
+    }
+}
 
-        encoder.finish()?;
+/// A member made of borrowed subgrids.
+struct ViewMember<'a, 'b> {
+    pids: &'a [i32],
+    subgrids: &'a [SubGridView<'b>],
+}
+
+impl ViewMember<'_, '_> {
+    /// Checks that the subgrids have knots along all the axes and as many values as knots.
+    fn validate(&self) -> Result<(), Box<dyn std::error::Error>> {
+        for (index, sg) in self.subgrids.iter().enumerate() {
+            let shape = sg.shape(self.pids.len());
+            if shape[..5].contains(&0) {
+                return Err(format!("Subgrid {index} has no knots along some axis").into());
+            }
+            if sg.values.len() != shape.iter().product::<usize>() {
+                return Err(format!(
+                    "Subgrid {index} has {} values instead of {}",
+                    sg.values.len(),
+                    shape.iter().product::<usize>()
+                )
+                .into());
+            }
+        }
         Ok(())
     }
+}
 
-    /// Decompresses and loads all [`GridArray`]s and shared metadata from a file.
+impl BlockMember for ViewMember<'_, '_> {
+    fn layout(&self) -> GridArrayLayout {
+        let range = |knots: &[f64]| ParamRange::new(knots[0], knots[knots.len() - 1]);
+
+        GridArrayLayout {
+            pids: Array1::from(self.pids.to_vec()),
+            subgrids: self
+                .subgrids
+                .iter()
+                .map(|sg| {
+                    let [nnuc, nalphas, nkts, nxs, nq2s, nflav] = sg.shape(self.pids.len());
+                    SubGridLayout {
+                        xs: Array1::from(sg.xs.to_vec()),
+                        q2s: Array1::from(sg.q2s.to_vec()),
+                        kts: Array1::from(sg.kts.to_vec()),
+                        nucleons: Array1::from(sg.nucleons.to_vec()),
+                        alphas: Array1::from(sg.alphas.to_vec()),
+                        ranges: [
+                            range(sg.nucleons),
+                            range(sg.alphas),
+                            range(sg.kts),
+                            range(sg.xs),
+                            range(sg.q2s),
+                        ],
+                        shape: [nnuc, nalphas, nflav, nkts, nxs, nq2s],
+                        offset: 0,
+                    }
+                })
+                .collect(),
+        }
+    }
+
+    fn write_values<W: Write>(&self, index: usize, writer: &mut W) -> io::Result<()> {
+        let sg = &self.subgrids[index];
+        let values = ArrayView6::from_shape(sg.shape(self.pids.len()), sg.values)
+            .map_err(|err| io::Error::new(io::ErrorKind::InvalidInput, err))?;
+        write_f64s(
+            writer,
+            values.permuted_axes([0, 1, 5, 2, 3, 4]).iter().copied(),
+        )
+    }
+}
+
+/// Writes values as little-endian `f64`, in chunks of a few kilobytes.
+fn write_f64s<W: Write>(writer: &mut W, values: impl IntoIterator<Item = f64>) -> io::Result<()> {
+    let mut chunk = [0u8; 4096];
+    let mut len = 0;
+    for value in values {
+        chunk[len..len + 8].copy_from_slice(&value.to_le_bytes());
+        len += 8;
+        if len == chunk.len() {
+            writer.write_all(&chunk)?;
+            len = 0;
+        }
+    }
+    writer.write_all(&chunk[..len])
+}
+
+/// Writes `count` zero bytes.
+fn write_zeros<W: Write>(writer: &mut W, count: u64) -> io::Result<()> {
+    io::copy(&mut io::repeat(0).take(count), writer).map(|_| ())
+}
+
+/// Sets the offsets of the knot values in `layout`, and returns the size of the serialized
+/// layout together with the size of the block.
+fn place_values(layout: &mut GridArrayLayout) -> Result<(u64, u64), Box<dyn std::error::Error>> {
+    // The size of the layout does not depend on the values of the offsets.
+    let layout_size = bincode::serialized_size(layout)?;
+    let mut position = align(8 + layout_size);
+    for sg_layout in &mut layout.subgrids {
+        sg_layout.offset = position;
+        let nvalues = sg_layout.shape.iter().product::<usize>() as u64;
+        position = align(position + 8 * nvalues);
+    }
+
+    Ok((layout_size, position))
+}
+
+/// Writes a member block, whose `layout` was completed by `place_values`.
+///
+/// The block starts with the size of a bincode-serialized [`GridArrayLayout`] and the layout
+/// itself, followed by the knot values of each subgrid in standard order as little-endian
+/// `f64`, each starting at a multiple of `BLOCK_ALIGNMENT` bytes from the start of the block.
+fn write_block<M: BlockMember + ?Sized, W: Write>(
+    member: &M,
+    layout: &GridArrayLayout,
+    (layout_size, block_size): (u64, u64),
+    writer: &mut W,
+) -> Result<(), Box<dyn std::error::Error>> {
+    writer.write_all(&layout_size.to_le_bytes())?;
+    bincode::serialize_into(&mut *writer, layout)?;
+
+    let mut position = 8 + layout_size;
+    for (index, sg_layout) in layout.subgrids.iter().enumerate() {
+        write_zeros(writer, sg_layout.offset - position)?;
+        member.write_values(index, writer)?;
+        position = sg_layout.offset + 8 * sg_layout.shape.iter().product::<usize>() as u64;
+    }
+    write_zeros(writer, block_size - position)?;
+
+    Ok(())
+}
+
+/// Decodes a member block written by `write_block` into a [`GridArray`].
+///
+/// The knot values are copied out of `block`, which can therefore be reused for the next
+/// member.
+fn decode_block(block: &[u8]) -> Result<GridArray, Box<dyn std::error::Error>> {
+    let mut cursor = Cursor::new(block);
+    let layout_size = read_u64(&mut cursor)? as usize;
+    let layout_bytes = block
+        .get(8..8 + layout_size)
+        .ok_or("Truncated member block")?;
+    let layout: GridArrayLayout = bincode::deserialize(layout_bytes)?;
+
+    let subgrids = layout
+        .subgrids
+        .into_iter()
+        .map(|sg_layout| -> Result<SubGrid, Box<dyn std::error::Error>> {
+            let start = sg_layout.offset as usize;
+            let nvalues: usize = sg_layout.shape.iter().product();
+            let bytes = block
+                .get(start..start + 8 * nvalues)
+                .ok_or("Truncated member block")?;
+            let values = bytes
+                .chunks_exact(8)
+                .map(|value| f64::from_le_bytes(value.try_into().unwrap()))
+                .collect();
+            let [nucleons_range, alphas_range, kt_range, x_range, q2_range] = sg_layout.ranges;
+
+            Ok(SubGrid {
+                xs: sg_layout.xs,
+                q2s: sg_layout.q2s,
+                kts: sg_layout.kts,
+                grid: ArcArray::from_shape_vec(sg_layout.shape, values)?,
+                grid_f32: None,
+                nucleons: sg_layout.nucleons,
+                alphas: sg_layout.alphas,
+                nucleons_range,
+                alphas_range,
+                kt_range,
+                x_range,
+                q2_range,
+            })
+        })
+        .collect::<Result<Vec<_>, _>>()?;
+
+    Ok(GridArray::from_subgrids(subgrids, layout.pids))
+}
+
+/// Writes the members of a set one at a time in the block layout.
+///
+/// Each member is encoded and written to the file as soon as it is pushed, such that the
+/// memory used by the writer does not grow with the number of members. The file is only
+/// complete once [`GridArrayWriter::finish`] has written the index of the blocks; a file whose
+/// writer was dropped before is rejected by the readers.
+pub struct GridArrayWriter {
+    writer: BufWriter<File>,
+    codec: BlockCodec,
+    /// The position in the file of the number of members, written by `finish`.
+    count_position: u64,
+    /// The position in the file at which the next block is written.
+    position: u64,
+    offsets: Vec<u64>,
+    /// The uncompressed block of the last member, reused across the members.
+    buffer: Vec<u8>,
+}
+
+impl GridArrayWriter {
+    /// Creates a file and writes its header, in the layout selected by the extension of the
+    /// file as in [`GridArrayCollection::write`].
     ///
     /// # Arguments
     ///
-    /// * `path` - Input file path.
+    /// * `path` - Output file path.
+    /// * `metadata` - Shared metadata for all the members.
     ///
     /// # Returns
     ///
-    /// A vector of [`GridArrayWithMetadata`] on success, or an error if reading fails.
-    pub fn decompress<P: AsRef<Path>>(
+    /// A [`GridArrayWriter`] on success, or an error if writing fails.
+    pub fn create<P: AsRef<Path>>(
         path: P,
-    ) -> Result<Vec<GridArrayWithMetadata>, Box<dyn std::error::Error>> {
-        let file = File::open(path)?;
-        let buf_reader = BufReader::new(file);
-        let mut decoder = FrameDecoder::new(buf_reader);
+        metadata: &MetaData,
+    ) -> Result<Self, Box<dyn std::error::Error>> {
+        let codec = if path
+            .as_ref()
+            .to_string_lossy()
+            .ends_with(UNCOMPRESSED_EXTENSION)
+        {
+            BlockCodec::Raw
+        } else {
+            BlockCodec::Lz4
+        };
 
-        let mut decompressed = Vec::new();
-        decoder.read_to_end(&mut decompressed)?;
+        Self::with_codec(path, metadata, codec)
+    }
 
-        let mut cursor = std::io::Cursor::new(decompressed);
+    /// Creates a file in the LZ4 block layout and writes its header, see
+    /// [`GridArrayCollection::compress`].
+    pub fn create_compressed<P: AsRef<Path>>(
+        path: P,
+        metadata: &MetaData,
+    ) -> Result<Self, Box<dyn std::error::Error>> {
+        Self::with_codec(path, metadata, BlockCodec::Lz4)
+    }
 
-        // Read versioned metadata
-        let metadata_size: u64 = bincode::deserialize_from(&mut cursor)?;
-        let mut metadata_bytes = vec![0u8; metadata_size as usize];
-        cursor.read_exact(&mut metadata_bytes)?;
+    /// Creates a file in the uncompressed block layout and writes its header, see
+    /// [`GridArrayCollection::write_uncompressed`].
+    pub fn create_uncompressed<P: AsRef<Path>>(
+        path: P,
+        metadata: &MetaData,
+    ) -> Result<Self, Box<dyn std::error::Error>> {
+        Self::with_codec(path, metadata, BlockCodec::Raw)
+    }
 
-        // Deserialize versioned metadata and convert to latest
-        let versioned_metadata: MetaData = bincode::deserialize(&metadata_bytes)?;
-        let shared_metadata = Arc::new(versioned_metadata);
-        let count: u64 = bincode::deserialize_from(&mut cursor)?;
+    /// Creates a file and writes its header, with blocks encoded by `codec`.
+    fn with_codec<P: AsRef<Path>>(
+        path: P,
+        metadata: &MetaData,
+        codec: BlockCodec,
+    ) -> Result<Self, Box<dyn std::error::Error>> {
+        let file = File::create(path)?;
+        let mut writer = BufWriter::new(file);
 
-        // Read offset table size (but don't skip it!)
-        let _offset_table_size: u64 = bincode::deserialize_from(&mut cursor)?;
+        let metadata_serialized =
+            bincode::serialize(&GridArrayCollection::stamped_metadata(metadata))?;
+        writer.write_all(&codec.magic())?;
+        writer.write_all(&(metadata_serialized.len() as u64).to_le_bytes())?;
+        writer.write_all(&metadata_serialized)?;
+        // The number of members is only known once all of them are written.
+        writer.write_all(&0u64.to_le_bytes())?;
 
-        // Read the actual offsets
-        let mut offsets = Vec::with_capacity(count as usize);
-        for _ in 0..count {
-            let offset: u64 = bincode::deserialize_from(&mut cursor)?;
-            offsets.push(offset);
-        }
+        let count_position = (RAW_BLOCK_MAGIC.len() + 8 + metadata_serialized.len()) as u64;
 
-        // Now read the grid data
-        let mut grids = Vec::with_capacity(count as usize);
-        for _ in 0..count {
-            let size: u64 = bincode::deserialize_from(&mut cursor)?;
-            let mut grid_bytes = vec![0u8; size as usize];
-            cursor.read_exact(&mut grid_bytes)?;
-
-            let grid: GridArray = bincode::deserialize(&grid_bytes)?;
-            grids.push(GridArrayWithMetadata {
-                grid,
-                metadata: Arc::clone(&shared_metadata),
-            });
-        }
+        Ok(Self {
+            writer,
+            codec,
+            count_position,
+            position: count_position + 8,
+            offsets: Vec::new(),
+            buffer: Vec::new(),
+        })
+    }
 
-        Ok(grids)
+    /// Returns the number of members written so far.
+    pub fn len(&self) -> usize {
+        self.offsets.len()
     }
 
-    /// Extracts just the metadata from a compressed file without loading the grids.
+    /// Returns true if no member was written so far.
+    pub fn is_empty(&self) -> bool {
+        self.offsets.is_empty()
+    }
+
+    /// Writes a member.
     ///
     /// # Arguments
     ///
-    /// * `path` - Input file path.
+    /// * `grid` - The grid of the member.
     ///
     /// # Returns
     ///
-    /// The [`MetaData`] struct on success, or an error if reading fails.
-    pub fn extract_metadata<P: AsRef<Path>>(
-        path: P,
-    ) -> Result<MetaData, Box<dyn std::error::Error>> {
-        let file = File::open(path)?;
-        let buf_reader = BufReader::new(file);
-        let mut decoder = FrameDecoder::new(buf_reader);
+    /// `Ok(())` on success, or an error if writing fails.
+    pub fn push(&mut self, grid: &GridArray) -> Result<(), Box<dyn std::error::Error>> {
+        self.push_member(grid)
+    }
 
-        let mut decompressed = Vec::new();
-        decoder.read_to_end(&mut decompressed)?;
+    /// Writes a member from borrowed subgrids, without copying their values.
+    ///
+    /// # Arguments
+    ///
+    /// * `pids` - The flavors of the member.
+    /// * `subgrids` - The subgrids of the member, whose values are laid out as described in
+    ///   [`SubGridView`].
+    ///
+    /// # Returns
+    ///
+    /// `Ok(())` on success, or an error if a subgrid is inconsistent or writing fails.
+    pub fn push_subgrids(
+        &mut self,
+        pids: &[i32],
+        subgrids: &[SubGridView<'_>],
+    ) -> Result<(), Box<dyn std::error::Error>> {
+        let member = ViewMember { pids, subgrids };
+        member.validate()?;
+        self.push_member(&member)
+    }
 
-        let mut cursor = std::io::Cursor::new(decompressed);
+    /// Encodes a member and writes its block.
+    fn push_member<M: BlockMember + ?Sized>(
+        &mut self,
+        member: &M,
+    ) -> Result<(), Box<dyn std::error::Error>> {
+        let mut layout = member.layout();
+        let sizes = place_values(&mut layout)?;
+
+        match self.codec {
+            // Raw blocks are streamed to the file without being assembled in memory.
+            BlockCodec::Raw => {
+                self.start_block(sizes.1)?;
+                write_block(member, &layout, sizes, &mut self.writer)?;
+            }
+            BlockCodec::Lz4 => {
+                self.buffer.clear();
+                self.buffer.reserve(sizes.1 as usize);
+                write_block(member, &layout, sizes, &mut self.buffer)?;
+                let block = compress_prepend_size(&self.buffer);
+                self.start_block(block.len() as u64)?;
+                self.writer.write_all(&block)?;
+            }
+        }
 
-        let metadata_size: u64 = bincode::deserialize_from(&mut cursor)?;
-        let mut metadata_bytes = vec![0u8; metadata_size as usize];
-        cursor.read_exact(&mut metadata_bytes)?;
-        let metadata: MetaData = bincode::deserialize(&metadata_bytes)?;
+        Ok(())
+    }
 
-        Ok(metadata)
+    /// Writes the size of the next block, such that the block itself starts aligned.
+    fn start_block(&mut self, size: u64) -> io::Result<()> {
+        let start = align(self.position + 8);
+        write_zeros(&mut self.writer, start - 8 - self.position)?;
+        self.writer.write_all(&size.to_le_bytes())?;
+
+        self.offsets.push(start);
+        self.position = start + size;
+        Ok(())
+    }
+
+    /// Writes the index of the blocks and the number of members, completing the file.
+    ///
+    /// # Returns
+    ///
+    /// `Ok(())` on success, or an error if writing fails.
+    pub fn finish(mut self) -> Result<(), Box<dyn std::error::Error>> {
+        for offset in &self.offsets {
+            self.writer.write_all(&offset.to_le_bytes())?;
+        }
+        self.writer.write_all(&self.position.to_le_bytes())?;
+        self.writer.write_all(&self.codec.magic())?;
+
+        self.writer.seek(SeekFrom::Start(self.count_position))?;
+        self.writer
+            .write_all(&(self.offsets.len() as u64).to_le_bytes())?;
+
+        self.writer.flush()?;
+        Ok(())
     }
 }
 
+/// Where a [`GridArrayReader`] reads the members from.
+enum ReaderSource {
+    /// The decompressed LZ4 frame, in which the offsets are relative to `data_start`.
+    Frame { data: Vec<u8>, data_start: u64 },
+    /// The file in the block layout, in which the offsets are those of the blocks.
+    Blocks {
+        file: Mutex<File>,
+        codec: BlockCodec,
+    },
+}
+
 /// Provides random access to individual [`GridArray`]s in a compressed file without loading the entire collection.
 ///
 /// Useful for efficient access to large PDF sets where only a subset of members is needed.
+/// Files in the block layout are not read beyond their metadata and index until a member
+/// is requested, and then only the block of that member is read and decoded.
 pub struct GridArrayReader {
-    data: Vec<u8>,
+    source: ReaderSource,
     metadata: Arc<MetaData>,
     offsets: Vec<u64>,
     count: u64,
-    data_start: u64,
 }
 
 impl GridArrayReader {
@@ -243,7 +848,12 @@ impl GridArrayReader {
     ///
     /// A [`GridArrayReader`] instance on success, or an error if reading fails.
     pub fn from_file<P: AsRef<Path>>(path: P) -> Result<Self, Box<dyn std::error::Error>> {
-        let file = File::open(path)?;
+        let mut file = File::open(path)?;
+        if let Some(codec) = BlockCodec::from_magic(&read_magic(&mut file)?) {
+            return Self::from_blocks(file, codec);
+        }
+        file.rewind()?;
+
         let buf_reader = BufReader::new(file);
         let mut decoder = FrameDecoder::new(buf_reader);
 
@@ -273,11 +883,38 @@ impl GridArrayReader {
         let data_start = cursor.position();
 
         Ok(Self {
-            data,
+            source: ReaderSource::Frame { data, data_start },
             metadata: shared_metadata,
             offsets,
             count,
-            data_start,
+        })
+    }
+
+    /// Creates a new reader from a file in the block layout, positioned after its magic bytes.
+    fn from_blocks(file: File, codec: BlockCodec) -> Result<Self, Box<dyn std::error::Error>> {
+        let mut buf_reader = BufReader::new(file);
+        let (metadata, count, _) = read_block_header(&mut buf_reader)?;
+
+        // The index of the blocks is located through the trailer of the file.
+        buf_reader.seek(SeekFrom::End(-16))?;
+        let index_offset = read_u64(&mut buf_reader)?;
+        if read_magic(&mut buf_reader)? != codec.magic() {
+            return Err("Truncated NeoPDF file: missing block index".into());
+        }
+
+        buf_reader.seek(SeekFrom::Start(index_offset))?;
+        let offsets = (0..count)
+            .map(|_| read_u64(&mut buf_reader))
+            .collect::<io::Result<Vec<_>>>()?;
+
+        Ok(Self {
+            source: ReaderSource::Blocks {
+                file: Mutex::new(buf_reader.into_inner()),
+                codec,
+            },
+            metadata: Arc::new(metadata),
+            offsets,
+            count,
         })
     }
 
@@ -318,15 +955,32 @@ impl GridArrayReader {
             .into());
         }
 
-        let offset = self.data_start + self.offsets[index];
-        let mut cursor = std::io::Cursor::new(&self.data);
-        cursor.set_position(offset);
-        let size: u64 = bincode::deserialize_from(&mut cursor)?;
-
-        let mut grid_bytes = vec![0u8; size as usize];
-        cursor.read_exact(&mut grid_bytes)?;
-
-        let grid: GridArray = bincode::deserialize(&grid_bytes)?;
+        let grid = match &self.source {
+            ReaderSource::Frame { data, data_start } => {
+                let offset = data_start + self.offsets[index];
+                let mut cursor = std::io::Cursor::new(data);
+                cursor.set_position(offset);
+                let size: u64 = bincode::deserialize_from(&mut cursor)?;
+
+                let mut grid_bytes = vec![0u8; size as usize];
+                cursor.read_exact(&mut grid_bytes)?;
+
+                bincode::deserialize(&grid_bytes)?
+            }
+            ReaderSource::Blocks { file, codec } => {
+                let block = {
+                    let mut file = file.lock().map_err(|_| "Poisoned NeoPDF file lock")?;
+                    file.seek(SeekFrom::Start(self.offsets[index] - 8))?;
+                    let size = read_u64(&mut *file)?;
+
+                    let mut block = vec![0u8; size as usize];
+                    file.read_exact(&mut block)?;
+                    block
+                };
+
+                codec.decode(&block)?
+            }
+        };
 
         Ok(GridArrayWithMetadata {
             grid,
@@ -335,11 +989,22 @@ impl GridArrayReader {
     }
 }
 
+/// Where a [`LazyGridArrayIterator`] reads the members from.
+enum LazySource {
+    /// The decompressed LZ4 frame, positioned at the next member.
+    Frame(Cursor<Vec<u8>>),
+    /// The members of a file in the block layout, decoded ahead by a background thread.
+    Blocks(Receiver<Result<GridArray, String>>),
+}
+
 /// Iterator for lazily reading [`GridArrayWithMetadata`] members from a compressed file.
 ///
-/// Useful for memory-efficient sequential processing of large PDF sets.
+/// Useful for memory-efficient sequential processing of large PDF sets. Files in the block
+/// layout are streamed one member at a time, the next member being read and decoded on a
+/// background thread while the current one is processed. Files consisting of a single LZ4
+/// frame are decompressed upfront.
 pub struct LazyGridArrayIterator {
-    cursor: std::io::Cursor<Vec<u8>>,
+    source: LazySource,
     remaining: u64,
     metadata: Arc<MetaData>,
     buffer: Vec<u8>,
@@ -355,8 +1020,22 @@ impl LazyGridArrayIterator {
     /// # Returns
     ///
     /// A [`LazyGridArrayIterator`] instance on success, or an error if reading fails.
-    pub fn new<R: Read>(reader: R) -> Result<Self, Box<dyn std::error::Error>> {
-        let mut decoder = FrameDecoder::new(reader);
+    pub fn new<R: Read + Send + 'static>(
+        mut reader: R,
+    ) -> Result<Self, Box<dyn std::error::Error>> {
+        let magic = read_magic(&mut reader)?;
+        if let Some(codec) = BlockCodec::from_magic(&magic) {
+            let (metadata, count, position) = read_block_header(&mut reader)?;
+
+            return Ok(Self {
+                source: LazySource::Blocks(prefetch_blocks(reader, position, count, codec)),
+                remaining: count,
+                metadata: Arc::new(metadata),
+                buffer: Vec::new(),
+            });
+        }
+
+        let mut decoder = FrameDecoder::new(Cursor::new(magic).chain(reader));
         let mut decompressed = Vec::new();
         decoder.read_to_end(&mut decompressed)?;
 
@@ -376,7 +1055,7 @@ impl LazyGridArrayIterator {
         cursor.read_exact(&mut offset_table_bytes)?;
 
         Ok(Self {
-            cursor,
+            source: LazySource::Frame(cursor),
             remaining: count,
             metadata: shared_metadata,
             buffer: Vec::new(),
@@ -402,6 +1081,74 @@ impl LazyGridArrayIterator {
     pub fn metadata(&self) -> &Arc<MetaData> {
         &self.metadata
     }
+
+    /// Reads the next member from the source.
+    fn read_next(&mut self) -> Result<GridArray, Box<dyn std::error::Error>> {
+        match &mut self.source {
+            LazySource::Frame(cursor) => {
+                // Read size
+                let size: u64 = bincode::deserialize_from(&mut *cursor)?;
+
+                // Read grid data
+                self.buffer.resize(size as usize, 0);
+                cursor.read_exact(&mut self.buffer)?;
+
+                Ok(bincode::deserialize(&self.buffer)?)
+            }
+            LazySource::Blocks(receiver) => match receiver.recv() {
+                Ok(grid) => Ok(grid?),
+                Err(_) => Err("NeoPDF prefetch thread stopped before the last member".into()),
+            },
+        }
+    }
+}
+
+/// Spawns a thread reading and decoding the `count` blocks of a stream in the block layout,
+/// positioned at `position` after the header of the file.
+///
+/// The decoded members are sent through a channel holding at most `PREFETCH_DEPTH` of them.
+/// The thread stops after the first error, or as soon as the receiver is dropped.
+fn prefetch_blocks<R: Read + Send + 'static>(
+    mut reader: R,
+    mut position: u64,
+    count: u64,
+    codec: BlockCodec,
+) -> Receiver<Result<GridArray, String>> {
+    let (sender, receiver) = mpsc::sync_channel(PREFETCH_DEPTH);
+
+    thread::spawn(move || {
+        let mut buffer = Vec::new();
+        for _ in 0..count {
+            let grid = read_block(&mut reader, &mut position, &mut buffer)
+                .map_err(Into::into)
+                .and_then(|()| codec.decode(&buffer))
+                .map_err(|err| err.to_string());
+            let failed = grid.is_err();
+
+            if sender.send(grid).is_err() || failed {
+                break;
+            }
+        }
+    });
+
+    receiver
+}
+
+/// Reads the next block of a stream in the block layout into `buffer`, skipping the padding
+/// which precedes it, and advances `position` to the end of the block.
+fn read_block<R: Read>(reader: &mut R, position: &mut u64, buffer: &mut Vec<u8>) -> io::Result<()> {
+    let start = align(*position + 8);
+    io::copy(
+        &mut reader.by_ref().take(start - 8 - *position),
+        &mut io::sink(),
+    )?;
+    let size = read_u64(reader)?;
+
+    buffer.resize(size as usize, 0);
+    reader.read_exact(buffer)?;
+    *position = start + size;
+
+    Ok(())
 }
 
 impl Iterator for LazyGridArrayIterator {
@@ -412,21 +1159,10 @@ impl Iterator for LazyGridArrayIterator {
             return None;
         }
 
-        let result = (|| -> Result<GridArrayWithMetadata, Box<dyn std::error::Error>> {
-            // Read size
-            let size: u64 = bincode::deserialize_from(&mut self.cursor)?;
-
-            // Read grid data
-            self.buffer.resize(size as usize, 0);
-            self.cursor.read_exact(&mut self.buffer)?;
-
-            let grid: GridArray = bincode::deserialize(&self.buffer)?;
-
-            Ok(GridArrayWithMetadata {
-                grid,
-                metadata: Arc::clone(&self.metadata),
-            })
-        })();
+        let result = self.read_next().map(|grid| GridArrayWithMetadata {
+            grid,
+            metadata: Arc::clone(&self.metadata),
+        });
 
         self.remaining -= 1;
         Some(result)
@@ -450,6 +1186,146 @@ mod tests {
 
     #[test]
     fn test_collection_with_metadata() {
+        let metadata = test_metadata();
+
+        let test_grid = test_grid();
+        let grids = vec![&test_grid, &test_grid];
+        let temp_file = NamedTempFile::new().unwrap();
+        let path = temp_file.path();
+
+        GridArrayCollection::compress(&grids, &metadata, path).unwrap();
+        let extracted = GridArrayCollection::extract_metadata(path).unwrap();
+        assert_eq!(metadata.set_desc, extracted.set_desc);
+        assert_eq!(metadata.set_index, extracted.set_index);
+
+        let decompressed = GridArrayCollection::decompress(path).unwrap();
+        assert_eq!(decompressed.len(), 2);
+        for g in &decompressed {
+            assert_eq!(g.metadata.set_desc, "Test PDF");
+            assert_eq!(g.grid.pids, Array1::from(vec![1, 2, 3]));
+        }
+
+        let g_iter = LazyGridArrayIterator::from_file(path).unwrap();
+        assert_eq!(g_iter.metadata().set_index, 1);
+        assert_eq!(g_iter.count(), 2);
+    }
+
+    #[test]
+    fn test_block_round_trip() {
+        let metadata = test_metadata();
+        let subgrid = SubGrid::new(
+            vec![1.0],
+            vec![0.118],
+            vec![0.0],
+            vec![1e-5, 1e-3, 1e-1],
+            vec![2.0, 10.0],
+            3,
+            (0..18).map(|i| i as f64 * 0.25).collect(),
+        );
+        let grid = GridArray::from_subgrids(vec![subgrid], Array1::from(vec![1, 2, 3]));
+        let grids = vec![&grid, &grid, &grid];
+        let temp_dir = tempfile::tempdir().unwrap();
+
+        let check = |loaded: &GridArray| {
+            assert_eq!(loaded.pids, grid.pids);
+            assert_eq!(loaded.subgrids.len(), 1);
+            let (expected, actual) = (&grid.subgrids[0], &loaded.subgrids[0]);
+            assert_eq!(actual.grid, expected.grid);
+            assert_eq!(actual.xs, expected.xs);
+            assert_eq!(actual.q2s, expected.q2s);
+            assert_eq!(actual.x_range, expected.x_range);
+            assert_eq!(actual.q2_range, expected.q2_range);
+        };
+
+        for (extension, codec) in [
+            (UNCOMPRESSED_EXTENSION, BlockCodec::Raw),
+            (".neopdf.lz4", BlockCodec::Lz4),
+        ] {
+            let path = temp_dir.path().join(format!("test{extension}"));
+
+            GridArrayCollection::write(&grids, &metadata, &path).unwrap();
+            let mut file = File::open(&path).unwrap();
+            assert_eq!(
+                BlockCodec::from_magic(&read_magic(&mut file).unwrap()),
+                Some(codec)
+            );
+            let extracted = GridArrayCollection::extract_metadata(&path).unwrap();
+            assert_eq!(metadata.set_desc, extracted.set_desc);
+
+            let reader = GridArrayReader::from_file(&path).unwrap();
+            assert_eq!(reader.len(), 3);
+            assert_eq!(reader.metadata().set_index, 1);
+            check(&reader.load_grid(2).unwrap().grid);
+            assert!(reader.load_grid(3).is_err());
+
+            let decompressed = GridArrayCollection::decompress(&path).unwrap();
+            assert_eq!(decompressed.len(), 3);
+            decompressed.iter().for_each(|g| check(&g.grid));
+
+            let g_iter = LazyGridArrayIterator::from_file(&path).unwrap();
+            assert_eq!(g_iter.len(), 3);
+            g_iter.for_each(|g| check(&g.unwrap().grid));
+
+            // Dropping a partially consumed iterator stops its prefetch thread.
+            let mut g_iter = LazyGridArrayIterator::from_file(&path).unwrap();
+            check(&g_iter.next().unwrap().unwrap().grid);
+        }
+    }
+
+    #[test]
+    fn test_streaming_writer() {
+        let metadata = test_metadata();
+        let (nucleons, alphas, kts) = (vec![1.0], vec![0.118], vec![0.0]);
+        let (xs, q2s) = (vec![1e-5, 1e-3, 1e-1], vec![2.0, 10.0]);
+        let values: Vec<f64> = (0..18).map(|i| i as f64 * 0.25).collect();
+        let subgrid = SubGrid::new(
+            nucleons.clone(),
+            alphas.clone(),
+            kts.clone(),
+            xs.clone(),
+            q2s.clone(),
+            3,
+            values.clone(),
+        );
+        let grid = GridArray::from_subgrids(vec![subgrid], Array1::from(vec![1, 2, 3]));
+        let view = SubGridView {
+            nucleons: &nucleons,
+            alphas: &alphas,
+            kts: &kts,
+            xs: &xs,
+            q2s: &q2s,
+            values: &values,
+        };
+        let temp_dir = tempfile::tempdir().unwrap();
+
+        for extension in [UNCOMPRESSED_EXTENSION, ".neopdf.lz4"] {
+            let path = temp_dir.path().join(format!("test{extension}"));
+
+            let mut writer = GridArrayWriter::create(&path, &metadata).unwrap();
+            writer.push(&grid).unwrap();
+            writer.push_subgrids(&[1, 2, 3], &[view]).unwrap();
+            assert!(writer
+                .push_subgrids(&[1, 2], &[view])
+                .is_err_and(|err| err.to_string().contains("values instead of")));
+            assert_eq!(writer.len(), 2);
+            writer.finish().unwrap();
+
+            let reader = GridArrayReader::from_file(&path).unwrap();
+            assert_eq!(reader.len(), 2);
+            for index in 0..2 {
+                let loaded = reader.load_grid(index).unwrap().grid;
+                assert_eq!(loaded.pids, grid.pids);
+                let (expected, actual) = (&grid.subgrids[0], &loaded.subgrids[0]);
+                assert_eq!(actual.grid, expected.grid);
+                assert_eq!(actual.xs, expected.xs);
+                assert_eq!(actual.x_range, expected.x_range);
+                assert_eq!(actual.q2_range, expected.q2_range);
+            }
+            assert_eq!(LazyGridArrayIterator::from_file(&path).unwrap().len(), 2);
+        }
+    }
+
+    fn test_metadata() -> MetaData {
         let metadata_v1 = MetaDataV1 {
             set_desc: "Test PDF".into(),
             set_index: 1,
@@ -483,34 +1359,10 @@ mod tests {
             alphas_type: String::new(),
             number_flavors: 0,
         };
-        let metadata = MetaData::new_v1(metadata_v1);
-
-        let test_grid = test_grid();
-        let grids = vec![&test_grid, &test_grid];
-        let temp_file = NamedTempFile::new().unwrap();
-        let path = temp_file.path();
-
-        GridArrayCollection::compress(&grids, &metadata, path).unwrap();
-        let extracted = GridArrayCollection::extract_metadata(path).unwrap();
-        assert_eq!(metadata.set_desc, extracted.set_desc);
-        assert_eq!(metadata.set_index, extracted.set_index);
-
-        let decompressed = GridArrayCollection::decompress(path).unwrap();
-        assert_eq!(decompressed.len(), 2);
-        for g in &decompressed {
-            assert_eq!(g.metadata.set_desc, "Test PDF");
-            assert_eq!(g.grid.pids, Array1::from(vec![1, 2, 3]));
-        }
-
-        let g_iter = LazyGridArrayIterator::from_file(path).unwrap();
-        assert_eq!(g_iter.metadata().set_index, 1);
-        assert_eq!(g_iter.count(), 2);
+        MetaData::new_v1(metadata_v1)
     }
 
     fn test_grid() -> GridArray {
-        GridArray {
-            pids: Array1::from(vec![1, 2, 3]),
-            subgrids: vec![],
-        }
+        GridArray::from_subgrids(vec![], Array1::from(vec![1, 2, 3]))
     }
 }
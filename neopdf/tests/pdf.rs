@@ -1,5 +1,13 @@
 use ndarray::Array2;
+use neopdf::cache::MemberCache;
+use neopdf::executor::{BatchExecutor, PointStatus, RayonExecutor, SequentialExecutor};
+use neopdf::gridpdf::{ForcePositive, LoadOptions};
+use neopdf::members::{ErrorType, MemberStack, PDFUncertainty};
 use neopdf::pdf::PDF;
+use neopdf::placement::{self, NumaPolicy};
+use neopdf::registry;
+use neopdf::stats::EvalStatistics;
+use std::sync::Arc;
 
 const PRECISION: f64 = 1e-16;
 const LOW_PRECISION: f64 = 1e-12;
@@ -105,6 +113,32 @@ fn test_combined_npdfs_range() {
     assert_eq!(a_range.max, 208.0);
 }
 
+#[test]
+fn test_xfxq2_scan_nucleons() {
+    let pdf = PDF::load("nNNPDF30_nlo_as_0118.neopdf.lz4", 0);
+
+    // The scan shares the interpolation in `(x, Q2)` across the nucleon numbers, hence the
+    // results agree with `xfxq2` up to rounding, including at and beyond the boundaries.
+    let nucleons = [1.0, 2.0, 4.0, 12.0, 40.0, 56.0, 56.0, 100.0, 208.0, 300.0];
+    for (x, q2) in [(1e-3, 1e2), (0.1, 1e4), (0.5, 10.0)] {
+        let mut results = vec![0.0; nucleons.len()];
+        pdf.xfxq2_scan(21, &[0.0, x, q2], &nucleons, &mut results)
+            .unwrap();
+        for (&result, &a) in results.iter().zip(nucleons.iter()) {
+            let expected = pdf.xfxq2(21, &[a, x, q2]);
+            assert!((result - expected).abs() <= LOW_PRECISION * expected.abs().max(1.0));
+        }
+    }
+
+    let mut results = vec![0.0; 2];
+    assert!(pdf
+        .xfxq2_scan(21, &[0.0, 1e-3, 1e2], &nucleons, &mut results)
+        .is_err());
+    assert!(pdf
+        .xfxq2_scan(21, &[1e-3, 1e2], &nucleons[..2], &mut results)
+        .is_err());
+}
+
 #[test]
 fn test_alphas_q2_interpolations() {
     let pdf = PDF::load("NNPDF40_nnlo_as_01180", 0);
@@ -136,6 +170,27 @@ fn test_alphas_q2_interpolations_abmp16() {
     }
 }
 
+#[test]
+fn test_alphas_q2_batch() {
+    for (pdf_name, member) in [("NNPDF40_nnlo_as_01180", 0), ("ABMP16als118_5_nnlo", 10)] {
+        let pdf = PDF::load(pdf_name, member);
+
+        // The scales are evaluated in a shuffled order to exercise the interval hint.
+        let mut q2s: Vec<f64> = (0..=400)
+            .map(|i| 1.65 * 1.65 * (1e10 / (1.65 * 1.65)).powf(f64::from(i) / 400.0))
+            .collect();
+        q2s.extend(q2s.clone().iter().rev().step_by(3));
+        q2s.extend([0.5, 1e12]);
+        let mut results = vec![0.0; q2s.len()];
+        pdf.alphas_q2_batch(&q2s, &mut results).unwrap();
+
+        for (&q2, &result) in q2s.iter().zip(&results) {
+            assert_eq!(result.to_bits(), pdf.alphas_q2(q2).to_bits());
+        }
+        assert!(pdf.alphas_q2_batch(&q2s, &mut results[1..]).is_err());
+    }
+}
+
 #[test]
 pub fn test_xfxq2s() {
     let expected = vec![
@@ -281,6 +336,40 @@ pub fn test_multi_members_lazy_loader() {
     });
 }
 
+#[test]
+pub fn test_multi_members_lazy_loader_prefetched() {
+    let pdfs: Vec<_> = PDF::load_pdfs_lazy("NNPDF40_nnlo_as_01180.neopdf.lz4")
+        .map(Result::unwrap)
+        .collect();
+
+    for prefetch_depth in [0, 4] {
+        let lazy_pdfs = PDF::load_pdfs_lazy_prefetched(
+            "NNPDF40_nnlo_as_01180.neopdf.lz4",
+            prefetch_depth,
+            LoadOptions::default(),
+        );
+
+        let mut num_members = 0;
+        for (lazy_pdf, pdf) in lazy_pdfs.zip(&pdfs) {
+            let lazy_pdf = lazy_pdf.unwrap();
+            assert_eq!(
+                lazy_pdf.xfxq2(21, &[1e-5, 1e4]),
+                pdf.xfxq2(21, &[1e-5, 1e4])
+            );
+            num_members += 1;
+        }
+        assert_eq!(num_members, pdfs.len());
+    }
+
+    // Dropping the iterator early stops the background thread.
+    let mut lazy_pdfs = PDF::load_pdfs_lazy_prefetched(
+        "NNPDF40_nnlo_as_01180.neopdf.lz4",
+        2,
+        LoadOptions::default(),
+    );
+    assert!(lazy_pdfs.next().unwrap().is_ok());
+}
+
 #[test]
 pub fn test_boundary_extraction() {
     let pdf = PDF::load("NNPDF40_nnlo_as_01180", 0);
@@ -338,3 +427,630 @@ pub fn test_xfxq2_cheby_batch() {
         }
     }
 }
+
+/// Runs the chunks of a batch on scoped threads, standing in for the thread pool of an
+/// application.
+struct ScopedExecutor;
+
+impl BatchExecutor for ScopedExecutor {
+    fn execute(&self, num_tasks: usize, task: &(dyn Fn(usize) + Sync)) {
+        std::thread::scope(|scope| {
+            for itask in 0..num_tasks {
+                scope.spawn(move || task(itask));
+            }
+        });
+    }
+
+    fn chunk_size(&self) -> usize {
+        5
+    }
+}
+
+#[test]
+pub fn test_xfxq2s_into() {
+    let pdf = PDF::load("NNPDF40_nnlo_as_01180", 0);
+
+    let points: Vec<[f64; 2]> = vec![[1e-6, 4.0], [1e-3, 1e2], [0.1, 1e4], [0.5, 10.0]];
+    let slice_points: Vec<&[f64]> = points.iter().map(|p| p.as_slice()).collect();
+    // The flavor `99` is not part of the set and its values must be flagged as failures.
+    let pids: Vec<i32> = vec![-2, 21, 99, 1];
+
+    let executors: [&dyn BatchExecutor; 3] = [
+        &RayonExecutor::new().with_chunk_size(3),
+        &SequentialExecutor,
+        &ScopedExecutor,
+    ];
+    for executor in executors {
+        let mut out = vec![0.0; pids.len() * points.len()];
+        let mut status = vec![PointStatus::Success; out.len()];
+        pdf.xfxq2s_into(&pids, &slice_points, &mut out, &mut status, executor)
+            .unwrap();
+
+        for (ipid, &pid) in pids.iter().enumerate() {
+            for (ipoint, point) in slice_points.iter().enumerate() {
+                let idx = ipid * points.len() + ipoint;
+                if pid == 99 {
+                    assert!(out[idx].is_nan());
+                    assert_eq!(status[idx], PointStatus::InterpolationError);
+                } else {
+                    assert_eq!(out[idx], pdf.xfxq2(pid, point));
+                    assert_eq!(status[idx], PointStatus::Success);
+                }
+            }
+        }
+    }
+
+    let mut out = vec![0.0; 3];
+    let mut status = vec![PointStatus::Success; 3];
+    assert!(pdf
+        .xfxq2s_into(
+            &pids,
+            &slice_points,
+            &mut out,
+            &mut status,
+            &SequentialExecutor
+        )
+        .is_err());
+}
+
+#[test]
+pub fn test_xfxq2_cheby_batch_into() {
+    let pdf = PDF::load("MAP22_grids_FF_Km_N3LL.neopdf.lz4", 0);
+
+    let points: Vec<Vec<f64>> = (0..50)
+        .map(|i| vec![1e-4 + 0.1 * f64::from(i), 0.1 + 0.01 * f64::from(i), 10.0])
+        .collect();
+    let slice_points: Vec<&[f64]> = points.iter().map(Vec::as_slice).collect();
+
+    let expected = pdf.xfxq2_cheby_batch(2, &slice_points);
+    let mut out = vec![0.0; points.len()];
+    let mut status = vec![PointStatus::InterpolationError; points.len()];
+    pdf.xfxq2_cheby_batch_into(2, &slice_points, &mut out, &mut status, &ScopedExecutor)
+        .unwrap();
+
+    assert!(status.iter().all(|&s| s == PointStatus::Success));
+    for (res, exp) in out.iter().zip(&expected) {
+        assert!((res - exp).abs() < LOW_PRECISION);
+    }
+
+    // The batch interpolation requires a `LogChebyshev` set.
+    let pdf = PDF::load("NNPDF40_nnlo_as_01180", 0);
+    assert!(pdf
+        .xfxq2_cheby_batch_into(2, &slice_points, &mut out, &mut status, &SequentialExecutor)
+        .is_err());
+}
+
+#[test]
+pub fn test_xfxq2_batch() {
+    let pdf = PDF::load("NNPDF40_nnlo_as_01180", 0);
+
+    let xs: Vec<f64> = vec![1e-9, 1e-6, 1e-3, 0.1, 0.5, 1.0];
+    let q2s: Vec<f64> = vec![1.65 * 1.65, 4.0, 4.93 * 4.93, 1e2, 1e4, 1e10];
+    let pids: Vec<i32> = vec![-5, -4, -3, -2, -1, 21, 1, 2, 3, 4, 5];
+
+    // The flavors share the interpolation weights of the points, hence the results agree
+    // with `xfxq2` up to rounding.
+    let mut results = vec![0.0; pids.len() * xs.len()];
+    pdf.xfxq2_batch(&pids, &xs, &q2s, &mut results).unwrap();
+
+    for (ipid, &pid) in pids.iter().enumerate() {
+        for (ipoint, (&x, &q2)) in xs.iter().zip(q2s.iter()).enumerate() {
+            let expected = pdf.xfxq2(pid, &[x, q2]);
+            let result = results[ipid * xs.len() + ipoint];
+            assert!((result - expected).abs() <= LOW_PRECISION * expected.abs().max(1.0));
+        }
+    }
+
+    // Long lists of flavors are evaluated in several groups.
+    let many_pids: Vec<i32> = pids.iter().copied().cycle().take(4 * pids.len()).collect();
+    let mut many_results = vec![0.0; many_pids.len() * xs.len()];
+    pdf.xfxq2_batch(&many_pids, &xs, &q2s, &mut many_results)
+        .unwrap();
+    for chunk in many_results.chunks_exact(results.len()) {
+        assert_eq!(chunk, results.as_slice());
+    }
+
+    // A single flavor goes through the same kernel, with bit-identical results.
+    let igluon = pids.iter().position(|&pid| pid == 21).unwrap();
+    let mut gluon = vec![0.0; xs.len()];
+    pdf.xfxq2_batch(&[21], &xs, &q2s, &mut gluon).unwrap();
+    assert_eq!(gluon, &results[igluon * xs.len()..][..xs.len()]);
+    pdf.xfxq2_batch(&pids, &[], &[], &mut []).unwrap();
+
+    let mut wrong_size = vec![0.0; xs.len()];
+    assert!(pdf.xfxq2_batch(&pids, &xs, &q2s, &mut wrong_size).is_err());
+}
+
+#[test]
+pub fn test_xfxq2_batch_interleaved() {
+    let options = LoadOptions {
+        interleave_flavors: true,
+        ..LoadOptions::default()
+    };
+    let pdf = PDF::load_with_options("NNPDF40_nnlo_as_01180", 0, options);
+    let reference = PDF::load("NNPDF40_nnlo_as_01180", 0);
+
+    let xs: Vec<f64> = vec![1e-9, 1e-6, 1e-3, 0.1, 0.5, 1.0];
+    let q2s: Vec<f64> = vec![1.65 * 1.65, 4.0, 4.93 * 4.93, 1e2, 1e4, 1e10];
+    let pids: Vec<i32> = vec![-5, -4, -3, -2, -1, 21, 1, 2, 3, 4, 5];
+
+    // Many flavors are evaluated from the knot values with the flavors innermost, whereas
+    // pairs of flavors are evaluated flavor by flavor, with bit-identical results.
+    let mut results = vec![0.0; pids.len() * xs.len()];
+    pdf.xfxq2_batch(&pids, &xs, &q2s, &mut results).unwrap();
+    for (ipid, &pid) in pids.iter().enumerate() {
+        let mut pair = vec![0.0; 2 * xs.len()];
+        pdf.xfxq2_batch(&[pid, 21], &xs, &q2s, &mut pair).unwrap();
+        assert_eq!(&pair[..xs.len()], &results[ipid * xs.len()..][..xs.len()]);
+    }
+
+    // The layout of the knot values changes neither the results nor the memory held.
+    let mut expected = vec![0.0; pids.len() * xs.len()];
+    reference
+        .xfxq2_batch(&pids, &xs, &q2s, &mut expected)
+        .unwrap();
+    assert_eq!(results, expected);
+    pdf.warmup(&pids).unwrap();
+    reference.warmup(&pids).unwrap();
+    assert_eq!(pdf.resident_bytes(), reference.resident_bytes());
+}
+
+#[test]
+pub fn test_resident_bytes() {
+    let pdf = PDF::load("NNPDF40_nnlo_as_01180", 0);
+
+    // The interpolators share the knot values and the knots of the subgrids, which are
+    // therefore only accounted for once, with the knots kept as is and log-transformed.
+    let expected: usize = pdf
+        .subgrids()
+        .iter()
+        .map(|sg| {
+            let nknots = sg.nucleons.len() + sg.alphas.len() + sg.kts.len();
+            let nknots = nknots + sg.xs.len() + sg.q2s.len();
+            (sg.grid().len() + 2 * nknots) * std::mem::size_of::<f64>()
+        })
+        .sum();
+    assert_eq!(pdf.resident_bytes(), expected);
+
+    // The coefficients of the `LogBicubic` interpolators are their own, and are counted
+    // once the interpolators are built.
+    pdf.warmup(&[21]).unwrap();
+    let coeffs: usize = pdf
+        .subgrids()
+        .iter()
+        .map(|sg| 4 * (sg.xs.len() - 1) * sg.q2s.len() * std::mem::size_of::<f64>())
+        .sum();
+    assert_eq!(pdf.resident_bytes(), expected + coeffs);
+}
+
+#[test]
+pub fn test_precomputed_coefficients() {
+    let pdf = PDF::load("NNPDF40_nnlo_as_01180", 0);
+    let options = LoadOptions {
+        precompute_coeffs: true,
+        ..LoadOptions::default()
+    };
+    let pdf_table = PDF::load_with_options("NNPDF40_nnlo_as_01180", 0, options);
+
+    // The coefficient tables expand the same interpolant, hence the results agree up to
+    // rounding, including in the cells at the edges of the subgrids.
+    let xs: Vec<f64> = vec![1e-9, 2e-7, 1e-6, 1e-3, 0.1, 0.5, 0.9, 1.0];
+    let q2s: Vec<f64> = vec![1.65 * 1.65, 3.0, 4.93 * 4.93, 1e2, 1e4, 1e8, 1e10];
+    for (&x, &q2) in xs.iter().flat_map(|x| q2s.iter().map(move |q2| (x, q2))) {
+        for pid in [-5, -4, -3, -2, -1, 21, 1, 2, 3, 4, 5] {
+            let expected = pdf.xfxq2(pid, &[x, q2]);
+            let result = pdf_table.xfxq2(pid, &[x, q2]);
+            assert!((result - expected).abs() <= LOW_PRECISION * expected.abs().max(1.0));
+        }
+    }
+}
+
+#[test]
+pub fn test_single_precision() {
+    let pdf = PDF::load("NNPDF40_nnlo_as_01180", 0);
+    let options = LoadOptions {
+        single_precision: true,
+        ..LoadOptions::default()
+    };
+    let pdf_single = PDF::load_with_options("NNPDF40_nnlo_as_01180", 0, options);
+    assert!(pdf_single
+        .subgrids()
+        .iter()
+        .all(|sg| sg.is_single_precision()));
+    assert!(pdf_single.resident_bytes() < pdf.resident_bytes());
+
+    // The results only differ by the rounding of the knot values to single precision.
+    let xs: Vec<f64> = vec![1e-9, 2e-7, 1e-6, 1e-3, 0.1, 0.5, 0.9, 1.0];
+    let q2s: Vec<f64> = vec![1.65 * 1.65, 3.0, 4.93 * 4.93, 1e2, 1e4, 1e8, 1e10];
+    let pids = [-5, -4, -3, -2, -1, 21, 1, 2, 3, 4, 5];
+    let (xs, q2s): (Vec<f64>, Vec<f64>) = xs
+        .iter()
+        .flat_map(|&x| q2s.iter().map(move |&q2| (x, q2)))
+        .unzip();
+    let mut results = vec![0.0; pids.len() * xs.len()];
+    let mut results_f32 = vec![0.0_f32; pids.len() * xs.len()];
+    pdf_single
+        .xfxq2_batch(&pids, &xs, &q2s, &mut results)
+        .unwrap();
+    pdf_single
+        .xfxq2_batch_f32(&pids, &xs, &q2s, &mut results_f32)
+        .unwrap();
+    for (ipid, &pid) in pids.iter().enumerate() {
+        for (ipoint, (&x, &q2)) in xs.iter().zip(&q2s).enumerate() {
+            let expected = pdf.xfxq2(pid, &[x, q2]);
+            let result = pdf_single.xfxq2(pid, &[x, q2]);
+            assert!((result - expected).abs() <= 1e-6 * expected.abs().max(1.0));
+
+            let index = ipid * xs.len() + ipoint;
+            assert!((results[index] - result).abs() <= LOW_PRECISION * result.abs().max(1.0));
+            assert_eq!(results_f32[index], results[index] as f32);
+        }
+    }
+
+    let report = pdf_single.precision_report(&pdf);
+    assert_eq!(report.pids, pdf.pids().to_vec());
+    assert!(report.num_points > 0);
+    assert!(report.max_absolute.iter().all(|&dev| dev < 1e-5));
+    assert!(pdf
+        .precision_report(&pdf)
+        .max_relative
+        .iter()
+        .all(|&dev| dev == 0.0));
+    assert!(report.to_string().starts_with("   PID"));
+
+    // The members stored in single precision cannot be stacked.
+    assert!(MemberStack::new([&pdf, &pdf_single]).is_err());
+}
+
+#[test]
+pub fn test_placed_knot_values() {
+    let pdfs = PDF::load_pdfs("NNPDF40_nnlo_as_01180");
+    let num_nodes = placement::num_nodes();
+
+    for numa in [
+        NumaPolicy::FirstTouch,
+        NumaPolicy::Interleave,
+        NumaPolicy::Replicate,
+    ] {
+        let options = LoadOptions {
+            huge_pages: true,
+            numa,
+            ..LoadOptions::default()
+        };
+        let placed = PDF::load_pdfs_with_options("NNPDF40_nnlo_as_01180", options);
+        let member = PDF::load_with_options("NNPDF40_nnlo_as_01180", 1, options);
+        assert_eq!(placed.len(), pdfs.len());
+
+        // The knot values are copied as they are, hence the results are identical.
+        let copies = if numa == NumaPolicy::Replicate {
+            num_nodes
+        } else {
+            1
+        };
+        let pids = [-2, -1, 21, 1, 2];
+        for (pdf, placed) in [(&pdfs[1], &member)]
+            .into_iter()
+            .chain(pdfs.iter().zip(&placed))
+        {
+            // The same interpolators are built, such that their tables are counted alike.
+            pdf.warmup(&pids).unwrap();
+            placed.warmup(&pids).unwrap();
+            assert_eq!(placed.resident_bytes(), copies * pdf.resident_bytes());
+            for (&x, &q2) in [(1e-5, 10.0), (0.1, 1e2), (0.5, 1e4)].iter() {
+                for pid in pids {
+                    assert_eq!(placed.xfxq2(pid, &[x, q2]), pdf.xfxq2(pid, &[x, q2]));
+                }
+            }
+        }
+    }
+}
+
+#[test]
+pub fn test_xfxq2_grid() {
+    let pdf = PDF::load("NNPDF40_nnlo_as_01180", 0);
+    let options = LoadOptions {
+        single_precision: true,
+        ..LoadOptions::default()
+    };
+    let pdf_single = PDF::load_with_options("NNPDF40_nnlo_as_01180", 0, options);
+
+    // The product spans several subgrids, as well as points outside of the grid.
+    let xs: Vec<f64> = vec![1e-10, 1e-9, 2e-7, 1e-6, 1e-3, 0.1, 0.5, 0.9, 1.0];
+    let q2s: Vec<f64> = vec![1.0, 1.65 * 1.65, 3.0, 4.93 * 4.93, 1e2, 1e4, 1e8, 1e10];
+    let pids = [-5, -2, 21, 1, 2, 5];
+    for pdf in [&pdf, &pdf_single] {
+        let mut results = vec![0.0; pids.len() * xs.len() * q2s.len()];
+        pdf.xfxq2_grid(&pids, &xs, &q2s, &mut results).unwrap();
+        for (ipid, &pid) in pids.iter().enumerate() {
+            for (ix, &x) in xs.iter().enumerate() {
+                for (iq2, &q2) in q2s.iter().enumerate() {
+                    let expected = pdf.xfxq2(pid, &[x, q2]);
+                    let result = results[(ipid * xs.len() + ix) * q2s.len() + iq2];
+                    assert!((result - expected).abs() <= LOW_PRECISION * expected.abs().max(1.0));
+                }
+            }
+        }
+    }
+
+    let mut results = vec![0.0; xs.len() * q2s.len()];
+    assert!(pdf.xfxq2_grid(&[99], &xs, &q2s, &mut results).is_err());
+    assert!(pdf.xfxq2_grid(&[21, 1], &xs, &q2s, &mut results).is_err());
+    pdf.xfxq2_grid(&[], &xs, &q2s, &mut []).unwrap();
+}
+
+#[test]
+pub fn test_xfxq2_scale_variations() {
+    let pdf = PDF::load("NNPDF40_nnlo_as_01180", 0);
+
+    // Seven-point variation of the scale `Q2 = 100` at fixed `x`, and the reverse.
+    let x = 1e-3;
+    let q2s: Vec<f64> = [0.25, 0.5, 1.0, 2.0, 4.0, 0.25, 4.0]
+        .iter()
+        .map(|factor| factor * 100.0)
+        .collect();
+    let pids = [-2, 21, 1, 2];
+    let mut results = vec![0.0; pids.len() * q2s.len()];
+    let mut alphas = vec![0.0; q2s.len()];
+    pdf.xfxq2_fixed_x(&pids, x, &q2s, &mut results, &mut alphas)
+        .unwrap();
+    let mut expected = vec![0.0; pids.len() * q2s.len()];
+    pdf.xfxq2_grid(&pids, &[x], &q2s, &mut expected).unwrap();
+    assert_eq!(results, expected);
+    for (&alpha, &q2) in alphas.iter().zip(q2s.iter()) {
+        assert_eq!(alpha, pdf.alphas_q2(q2));
+    }
+
+    let xs: Vec<f64> = vec![1e-6, 1e-3, 0.1, 0.5];
+    let mut results = vec![0.0; pids.len() * xs.len()];
+    let alpha = pdf.xfxq2_fixed_q2(&pids, &xs, 100.0, &mut results).unwrap();
+    let mut expected = vec![0.0; pids.len() * xs.len()];
+    pdf.xfxq2_grid(&pids, &xs, &[100.0], &mut expected).unwrap();
+    // The knot values are summed along `Q2` first, hence the results agree up to rounding.
+    for (result, expected) in results.iter().zip(&expected) {
+        assert!((result - expected).abs() <= 1e-14 * expected.abs().max(1.0));
+    }
+    assert_eq!(alpha, pdf.alphas_q2(100.0));
+
+    let mut wrong_size = vec![0.0; 1];
+    assert!(pdf
+        .xfxq2_fixed_x(&pids, x, &q2s, &mut results, &mut wrong_size)
+        .is_err());
+
+    // The flavors are resolved before any point is evaluated, in groups for long lists.
+    let mut results = vec![0.0; 2 * xs.len()];
+    assert!(pdf
+        .xfxq2_fixed_q2(&[21, 42], &xs, 100.0, &mut results)
+        .is_err());
+    let many: Vec<i32> = pids.iter().copied().cycle().take(40).collect();
+    let mut results = vec![0.0; many.len() * xs.len()];
+    pdf.xfxq2_fixed_q2(&many, &xs, 100.0, &mut results).unwrap();
+    for (ipid, &pid) in many.iter().enumerate() {
+        let row = &results[ipid * xs.len()..][..xs.len()];
+        let mut expected = vec![0.0; xs.len()];
+        pdf.xfxq2_fixed_q2(&[pid], &xs, 100.0, &mut expected)
+            .unwrap();
+        assert_eq!(row, expected.as_slice());
+    }
+}
+
+#[test]
+pub fn test_member_stack() {
+    let mut pdfs = PDF::load_pdfs("NNPDF40_nnlo_as_01180");
+    pdfs[3].set_force_positive(ForcePositive::ClipNegative);
+    let stack = MemberStack::new(&pdfs).unwrap();
+    assert_eq!(stack.len(), pdfs.len());
+
+    // The members share the interpolation weights of the points, hence the results agree
+    // with `xfxq2` up to rounding, including the clipping of the members.
+    let xs: Vec<f64> = vec![1e-9, 1e-6, 1e-3, 0.1, 0.5, 1.0];
+    let q2s: Vec<f64> = vec![1.65 * 1.65, 4.0, 4.93 * 4.93, 1e2, 1e4, 1e10];
+    for pid in [-5, -1, 21, 1, 2, 5] {
+        let mut results = vec![0.0; xs.len() * pdfs.len()];
+        stack.xfxq2_batch(pid, &xs, &q2s, &mut results).unwrap();
+
+        for (ipoint, (&x, &q2)) in xs.iter().zip(q2s.iter()).enumerate() {
+            for (imember, pdf) in pdfs.iter().enumerate() {
+                let expected = pdf.xfxq2(pid, &[x, q2]);
+                let result = results[ipoint * pdfs.len() + imember];
+                assert!((result - expected).abs() <= LOW_PRECISION * expected.abs().max(1.0));
+            }
+        }
+    }
+
+    let mut wrong_size = vec![0.0; pdfs.len() - 1];
+    assert!(stack.xfxq2(21, 0.1, 1e2, &mut wrong_size).is_err());
+    assert!(MemberStack::new(&pdfs[..0]).is_err());
+}
+
+#[test]
+pub fn test_member_stack_uncertainty() {
+    let pdfs = PDF::load_pdfs("NNPDF40_nnlo_as_01180");
+    let stack = MemberStack::new(&pdfs).unwrap();
+    assert_eq!(stack.error_type(), Some(ErrorType::Replicas));
+
+    let xs: Vec<f64> = vec![1e-6, 1e-3, 0.1, 0.5];
+    let q2s: Vec<f64> = vec![4.0, 1e2, 1e4];
+
+    let mut grid = vec![PDFUncertainty::default(); xs.len() * q2s.len()];
+    stack.uncertainty_grid(21, &xs, &q2s, &mut grid).unwrap();
+
+    for (ix, &x) in xs.iter().enumerate() {
+        for (iq2, &q2) in q2s.iter().enumerate() {
+            // The mean and the standard deviation of the replicas, excluding the member 0.
+            let values: Vec<f64> = pdfs[1..]
+                .iter()
+                .map(|pdf| pdf.xfxq2(21, &[x, q2]))
+                .collect();
+            let n = values.len() as f64;
+            let mean = values.iter().sum::<f64>() / n;
+            let sd = (values.iter().map(|v| (v - mean).powi(2)).sum::<f64>() / (n - 1.0)).sqrt();
+
+            let result = stack.uncertainty(21, x, q2).unwrap();
+            assert!((result.central - mean).abs() <= LOW_PRECISION * mean.abs());
+            assert!((result.errsymm - sd).abs() <= 1e-8 * sd);
+            assert_eq!(result.errplus, result.errminus);
+            assert_eq!(result.errparam, 0.0);
+            assert_eq!(grid[ix * q2s.len() + iq2], result);
+        }
+    }
+
+    let batch_xs = vec![1e-3; 3];
+    let mut batch = vec![PDFUncertainty::default(); batch_xs.len()];
+    stack
+        .uncertainty_batch(21, &batch_xs, &q2s, &mut batch)
+        .unwrap();
+    for (result, iq2) in batch.iter().zip(0..) {
+        assert_eq!(*result, grid[q2s.len() + iq2]);
+    }
+}
+
+#[test]
+pub fn test_member_cache() {
+    // The size of a member includes the interpolators of the gluon, which is evaluated.
+    let pdf = PDF::load("NNPDF40_nnlo_as_01180", 1);
+    pdf.xfxq2(21, &[0.1, 1e2]);
+    let member_bytes = pdf.resident_bytes();
+    let cache = MemberCache::new("NNPDF40_nnlo_as_01180", 2 * member_bytes);
+    assert_eq!(cache.num_members(), 101);
+
+    let first = cache.get(1).unwrap();
+    assert_eq!(first.xfxq2(21, &[0.1, 1e2]), pdf.xfxq2(21, &[0.1, 1e2]));
+    let _ = cache.get(2);
+    let _ = cache.get(1);
+    assert_eq!(cache.stats().hits, 1);
+
+    // A member out of range is not counted as a request.
+    assert!(cache.get(101).is_none());
+    assert_eq!(cache.stats().misses, 2);
+
+    // Member 2 is the least recently used one, hence it is evicted to make room for 3.
+    let _ = cache.get(3);
+    assert!(cache.contains(1) && cache.contains(3) && !cache.contains(2));
+    let stats = cache.stats();
+    assert_eq!((stats.hits, stats.misses, stats.evictions), (1, 3, 1));
+    assert_eq!(stats.num_resident, 2);
+    assert!(stats.resident_bytes <= cache.max_bytes());
+
+    // The handles stay valid after the eviction of their member.
+    cache.clear();
+    assert_eq!(cache.stats().num_resident, 0);
+    assert_eq!(first.xfxq2(21, &[0.1, 1e2]), pdf.xfxq2(21, &[0.1, 1e2]));
+
+    // The cache is shared by several threads.
+    std::thread::scope(|scope| {
+        for thread in 0..4 {
+            let cache = &cache;
+            scope.spawn(move || {
+                for member in (thread..20).step_by(4) {
+                    assert!(cache.get(member % 5).unwrap().xfxq2(21, &[0.1, 1e2]) > 0.0);
+                }
+            });
+        }
+    });
+    let stats = cache.stats();
+    assert_eq!(stats.hits + stats.misses, 4 + 20);
+    assert!(stats.resident_bytes <= cache.max_bytes());
+
+    // The last requested member is kept, even if it alone exceeds the budget.
+    let cache = MemberCache::new("NNPDF40_nnlo_as_01180", member_bytes / 2);
+    let _ = cache.get(1);
+    assert!(cache.contains(1));
+    let _ = cache.get(2);
+    assert!(cache.contains(2) && !cache.contains(1));
+    let stats = cache.stats();
+    assert_eq!((stats.evictions, stats.num_resident), (1, 1));
+    assert!(stats.resident_bytes > cache.max_bytes());
+}
+
+#[test]
+pub fn test_load_shared() {
+    let options = LoadOptions {
+        precompute_coeffs: true,
+        ..LoadOptions::default()
+    };
+    let pdf = PDF::load_shared("NNPDF40_nnlo_as_01180", 2, options);
+    let same = PDF::load_shared("NNPDF40_nnlo_as_01180", 2, options);
+    let other = PDF::load_shared("NNPDF40_nnlo_as_01180", 2, LoadOptions::default());
+    assert!(Arc::ptr_eq(&pdf, &same));
+    assert!(!Arc::ptr_eq(&pdf, &other));
+
+    let report = registry::report();
+    let entry = report
+        .entries
+        .iter()
+        .find(|entry| entry.member == 2 && entry.options == options)
+        .unwrap();
+    assert_eq!(entry.set_name, "NNPDF40_nnlo_as_01180");
+    assert_eq!(entry.num_handles, 2);
+    assert_eq!(entry.resident_bytes, pdf.resident_bytes());
+    assert!(report.resident_bytes() >= pdf.resident_bytes() + other.resident_bytes());
+
+    // A clone shares the grid of the member but can be modified independently.
+    let mut clipped = PDF::clone(&pdf);
+    clipped.set_force_positive(ForcePositive::ClipNegative);
+    assert!(matches!(pdf.is_force_positive(), ForcePositive::NoClipping));
+
+    // The registry does not keep the members alive once all their handles are dropped.
+    drop((pdf, same));
+    assert!(!registry::report()
+        .entries
+        .iter()
+        .any(|entry| entry.member == 2 && entry.options == options));
+}
+
+#[test]
+fn test_eval_statistics() {
+    let mut pdf = PDF::load("NNPDF40_nnlo_as_01180", 3);
+    let stats = pdf.stats();
+    assert_eq!(stats.member_loads, 1);
+    assert!(stats.load_nanos > 0);
+
+    // The evaluations are only recorded once enabled.
+    pdf.xfxq2(21, &[1e-12, 100.0]);
+    assert_eq!(pdf.stats().points, 0);
+
+    pdf.enable_stats(true);
+    pdf.xfxq2(21, &[0.01, 100.0]);
+    pdf.xfxq2(21, &[1e-12, 100.0]);
+    pdf.xfxq2(21, &[0.01, 1e12]);
+    let stats = pdf.stats();
+    assert_eq!(stats.points, 3);
+    assert_eq!(stats.subgrid_fallbacks, 2);
+    assert_eq!((stats.x_below, stats.x_above), (1, 0));
+    assert_eq!((stats.q2_below, stats.q2_above), (0, 1));
+    assert_eq!(stats.force_positive_clips, 0);
+
+    let raw = pdf.xfxq2(3, &[1.0, 100.0]);
+    pdf.set_force_positive(ForcePositive::ClipSmall);
+    pdf.xfxq2(3, &[1.0, 100.0]);
+    assert_eq!(pdf.stats().force_positive_clips, u64::from(raw < 1e-10));
+
+    pdf.reset_stats();
+    assert_eq!(pdf.stats(), EvalStatistics::default());
+}
+
+#[test]
+fn test_lazy_interpolators() {
+    let pdf = PDF::load("NNPDF40_nnlo_as_01180", 4);
+    let num_subgrids = pdf.num_subgrids();
+    assert_eq!(pdf.num_built_interpolators(), 0);
+
+    // Only the interpolator of the evaluated flavor in the subgrid of the point is built.
+    let gluon = pdf.xfxq2(21, &[1e-3, 100.0]);
+    assert_eq!(pdf.num_built_interpolators(), 1);
+
+    pdf.warmup(&[21, 1, 2]).unwrap();
+    assert_eq!(pdf.num_built_interpolators(), 3 * num_subgrids);
+    assert!(pdf.warmup(&[42]).is_err());
+    assert_eq!(pdf.num_built_interpolators(), 3 * num_subgrids);
+
+    let eager = PDF::load("NNPDF40_nnlo_as_01180", 4);
+    eager.warmup(&eager.pids().to_vec()).unwrap();
+    assert_eq!(eager.xfxq2(21, &[1e-3, 100.0]), gluon);
+
+    let pdfs = PDF::load_pdfs("NNPDF40_nnlo_as_01180");
+    PDF::warmup_members(&pdfs[..3], &[21]).unwrap();
+    assert!(pdfs[..3]
+        .iter()
+        .all(|pdf| pdf.num_built_interpolators() == num_subgrids));
+}
@@ -0,0 +1,266 @@
+// Benchmark of the C++ interfaces of NeoPDF against LHAPDF.
+//
+// Each invocation measures a single backend on a single set, such that the peak resident
+// memory reported at the end only accounts for that backend and set:
+//
+//     bench-lhapdf <backend> <set> [<coordinate>]
+//
+// where `<backend>` is one of `lhapdf`, `neopdf` (the `neopdf::NeoPDF` classes) or
+// `neolhapdf` (the `NEOLHAPDF::mkPDF` compatibility layer). Sets with more than two
+// dimensions, e.g. nuclear sets with an explicit `A` dependence or TMD sets, are evaluated
+// with `neopdf::NeoPDF::xfxQ2_ND` by passing the value of their leading coordinate.
+//
+// The results are printed as one JSON object per line, see `compare-results.py`.
+
+#include <LHAPDF/PDF.h>
+#include <NeoPDF.hpp>
+#include <sys/resource.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Number of points per evaluation benchmark.
+const size_t NPOINTS = 10000;
+// Number of points of the sweep over all the members.
+const size_t NPOINTS_MEMBERS = 1000;
+// Number of repetitions of each benchmark, of which the fastest is reported.
+const int REPETITIONS = 5;
+// Flavours evaluated at every point.
+const std::vector<int32_t> PIDS = {-5, -4, -3, -2, -1, 21, 1, 2, 3, 4, 5};
+
+// Sink for the computed values, preventing the evaluations from being optimized away.
+volatile double sink = 0.0;
+
+struct Points {
+    std::vector<double> xs;
+    std::vector<double> q2s;
+};
+
+// Draws points uniformly in `log(x)` and `log(Q2)` within the ranges of a set.
+Points make_points(size_t npoints, double x_min, double x_max, double q2_min, double q2_max) {
+    std::mt19937_64 rng(12345);
+    std::uniform_real_distribution<double> lx(std::log(std::max(x_min, 1e-7)), std::log(std::min(x_max, 0.9)));
+    std::uniform_real_distribution<double> lq2(std::log(q2_min * 1.01), std::log(std::min(q2_max, 1e8)));
+
+    Points points;
+    for (size_t i = 0; i < npoints; ++i) {
+        points.xs.push_back(std::exp(lx(rng)));
+        points.q2s.push_back(std::exp(lq2(rng)));
+    }
+    return points;
+}
+
+// Returns the fastest of `REPETITIONS` runs of `run`, in nanoseconds.
+double time_ns(const std::function<void()>& run, int repetitions = REPETITIONS) {
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < repetitions; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        auto stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count());
+    }
+    return best;
+}
+
+long peak_rss_kb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+class Reporter {
+    public:
+        Reporter(const std::string& backend, const std::string& set) : backend(backend), set(set) {}
+
+        void report(const std::string& benchmark, double value, const std::string& unit, size_t count) const {
+            std::cout << "{\"set\": \"" << set << "\", \"backend\": \"" << backend
+                      << "\", \"benchmark\": \"" << benchmark << "\", \"value\": " << value
+                      << ", \"unit\": \"" << unit << "\", \"count\": " << count << "}" << std::endl;
+        }
+
+    private:
+        std::string backend;
+        std::string set;
+};
+
+void bench_lhapdf(const std::string& set, const Reporter& reporter) {
+    LHAPDF::setVerbosity(0);
+
+    std::unique_ptr<LHAPDF::PDF> pdf;
+    double load = time_ns([&]() { pdf.reset(LHAPDF::mkPDF(set, 0)); }, 1);
+    reporter.report("load", load, "ns", 1);
+
+    std::vector<std::unique_ptr<LHAPDF::PDF>> members;
+    double load_all = time_ns([&]() {
+        for (LHAPDF::PDF* member : LHAPDF::mkPDFs(set)) {
+            members.emplace_back(member);
+        }
+    }, 1);
+    reporter.report("load_all", load_all, "ns", members.size());
+
+    Points points = make_points(NPOINTS, pdf->xMin(), pdf->xMax(), pdf->q2Min(), pdf->q2Max());
+    double scalar = time_ns([&]() {
+        double sum = 0.0;
+        for (size_t i = 0; i < NPOINTS; ++i) {
+            for (int32_t pid : PIDS) {
+                sum += pdf->xfxQ2(pid, points.xs[i], points.q2s[i]);
+            }
+        }
+        sink = sink + sum;
+    });
+    reporter.report("scalar", scalar / (NPOINTS * PIDS.size()), "ns/eval", NPOINTS * PIDS.size());
+
+    // LHAPDF evaluates all the flavours of a point at once.
+    std::vector<double> xfs;
+    double batch = time_ns([&]() {
+        double sum = 0.0;
+        for (size_t i = 0; i < NPOINTS; ++i) {
+            pdf->xfxQ2(points.xs[i], points.q2s[i], xfs);
+            sum += xfs[0];
+        }
+        sink = sink + sum;
+    });
+    reporter.report("batch", batch / (NPOINTS * PIDS.size()), "ns/eval", NPOINTS * PIDS.size());
+
+    double sweep = time_ns([&]() {
+        double sum = 0.0;
+        for (size_t i = 0; i < NPOINTS_MEMBERS; ++i) {
+            for (const auto& member : members) {
+                sum += member->xfxQ2(21, points.xs[i], points.q2s[i]);
+            }
+        }
+        sink = sink + sum;
+    });
+    size_t nsweep = NPOINTS_MEMBERS * members.size();
+    reporter.report("all_members", sweep / nsweep, "ns/eval", nsweep);
+}
+
+void bench_neolhapdf(const std::string& set, const Reporter& reporter) {
+    NEOLHAPDF::setVerbosity(0);
+
+    std::unique_ptr<NEOLHAPDF::PDF> pdf;
+    double load = time_ns([&]() { pdf.reset(NEOLHAPDF::mkPDF(set, 0)); }, 1);
+    reporter.report("load", load, "ns", 1);
+
+    Points points = make_points(NPOINTS, pdf->xMin(), pdf->xMax(), pdf->q2Min(), pdf->q2Max());
+    double scalar = time_ns([&]() {
+        double sum = 0.0;
+        for (size_t i = 0; i < NPOINTS; ++i) {
+            for (int32_t pid : PIDS) {
+                sum += pdf->xfxQ2(pid, points.xs[i], points.q2s[i]);
+            }
+        }
+        sink = sink + sum;
+    });
+    reporter.report("scalar", scalar / (NPOINTS * PIDS.size()), "ns/eval", NPOINTS * PIDS.size());
+}
+
+void bench_neopdf(const std::string& set, const std::vector<double>& coordinates, const Reporter& reporter) {
+    std::unique_ptr<neopdf::NeoPDF> pdf;
+    double load = time_ns([&]() { pdf.reset(new neopdf::NeoPDF(set, 0)); }, 1);
+    reporter.report("load", load, "ns", 1);
+
+    std::unique_ptr<neopdf::NeoPDFs> members;
+    double load_all = time_ns([&]() { members.reset(new neopdf::NeoPDFs(set)); }, 1);
+    reporter.report("load_all", load_all, "ns", members->size());
+
+    Points points = make_points(NPOINTS, pdf->x_min(), pdf->x_max(), pdf->q2_min(), pdf->q2_max());
+    size_t nsweep = NPOINTS_MEMBERS * members->size();
+
+    if (!coordinates.empty()) {
+        // The flavours of e.g. fragmentation functions differ from those of `PIDS`. The
+        // leading coordinates are fixed and followed by `x` and `Q2`.
+        std::vector<int32_t> pids = pdf->pids();
+        std::vector<double> params(coordinates);
+        params.resize(coordinates.size() + 2);
+        double scalar = time_ns([&]() {
+            double sum = 0.0;
+            for (size_t i = 0; i < NPOINTS; ++i) {
+                params[coordinates.size()] = points.xs[i];
+                params[coordinates.size() + 1] = points.q2s[i];
+                for (int32_t pid : pids) {
+                    sum += pdf->xfxQ2_ND(pid, params);
+                }
+            }
+            sink = sink + sum;
+        });
+        reporter.report("scalar", scalar / (NPOINTS * pids.size()), "ns/eval", NPOINTS * pids.size());
+
+        double sweep = time_ns([&]() {
+            double sum = 0.0;
+            for (size_t i = 0; i < NPOINTS_MEMBERS; ++i) {
+                params[coordinates.size()] = points.xs[i];
+                params[coordinates.size() + 1] = points.q2s[i];
+                for (size_t m = 0; m < members->size(); ++m) {
+                    sum += (*members)[m].xfxQ2_ND(pids.front(), params);
+                }
+            }
+            sink = sink + sum;
+        });
+        reporter.report("all_members", sweep / nsweep, "ns/eval", nsweep);
+        return;
+    }
+
+    double scalar = time_ns([&]() {
+        double sum = 0.0;
+        for (size_t i = 0; i < NPOINTS; ++i) {
+            for (int32_t pid : PIDS) {
+                sum += pdf->xfxQ2(pid, points.xs[i], points.q2s[i]);
+            }
+        }
+        sink = sink + sum;
+    });
+    reporter.report("scalar", scalar / (NPOINTS * PIDS.size()), "ns/eval", NPOINTS * PIDS.size());
+
+    std::vector<double> out(PIDS.size() * NPOINTS);
+    double batch = time_ns([&]() {
+        pdf->xfxQ2_batch(PIDS, points.xs, points.q2s, out);
+        sink = sink + out[0];
+    });
+    reporter.report("batch", batch / (NPOINTS * PIDS.size()), "ns/eval", NPOINTS * PIDS.size());
+
+    std::vector<double> sweep_out(nsweep);
+    double sweep = time_ns([&]() {
+        members->xfxQ2_all_members(21, points.xs.data(), points.q2s.data(), NPOINTS_MEMBERS, sweep_out.data());
+        sink = sink + sweep_out[0];
+    });
+    reporter.report("all_members", sweep / nsweep, "ns/eval", nsweep);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <lhapdf|neopdf|neolhapdf> <set> [<coordinate>...]\n";
+        return EXIT_FAILURE;
+    }
+
+    std::string backend = argv[1];
+    std::string set = argv[2];
+    std::vector<double> coordinates;
+    for (int i = 3; i < argc; ++i) {
+        coordinates.push_back(std::atof(argv[i]));
+    }
+
+    Reporter reporter(backend, set);
+    if (backend == "lhapdf" && coordinates.empty()) {
+        bench_lhapdf(set, reporter);
+    } else if (backend == "neolhapdf" && coordinates.empty()) {
+        bench_neolhapdf(set, reporter);
+    } else if (backend == "neopdf") {
+        bench_neopdf(set, coordinates, reporter);
+    } else {
+        std::cerr << "Unsupported backend `" << backend << "` for the set `" << set << "`\n";
+        return EXIT_FAILURE;
+    }
+    reporter.report("peak_rss", peak_rss_kb(), "kB", 1);
+
+    return EXIT_SUCCESS;
+}
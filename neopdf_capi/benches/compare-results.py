@@ -0,0 +1,76 @@
+"""Compare the results of two runs of `bench-lhapdf` and flag the regressions.
+
+The results are read as one JSON object per line, as printed by `bench-lhapdf`. The
+measurements are matched by set, backend and benchmark. As they are all either times or
+memory sizes, a measurement regresses if its value exceeds the one of the baseline by
+more than the given relative threshold. The script exits with a non-zero status if any
+of the measurements regressed, such that it can gate a release or a pull request.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_results(path):
+    results = {}
+    with open(path) as file:
+        for line in file:
+            if not line.strip():
+                continue
+            entry = json.loads(line)
+            key = (entry["set"], entry["backend"], entry["benchmark"])
+            results[key] = entry
+    return results
+
+
+def row(key, baseline, current, change):
+    set_name, backend, benchmark = key
+    return f"{set_name:<36} {backend:<10} {benchmark:<12} {baseline:>12} {current:>12} {change:>8}"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline", help="results of the reference run")
+    parser.add_argument("current", help="results of the run to check")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.1,
+        help="maximal relative increase of a measurement (default: 0.1)",
+    )
+    args = parser.parse_args()
+
+    baseline = load_results(args.baseline)
+    current = load_results(args.current)
+
+    regressions = 0
+    header = row(("Set", "Backend", "Benchmark"), "Baseline", "Current", "Change")
+    print(header)
+    print("-" * len(header))
+    for key in sorted(current):
+        entry = current[key]
+        if key not in baseline:
+            print(row(key, "-", f"{entry['value']:.4g}", "new"))
+            continue
+
+        reference = baseline[key]["value"]
+        change = entry["value"] / reference - 1.0 if reference > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            regressions += 1
+            flag = "  REGRESSION"
+        values = (f"{reference:.4g}", f"{entry['value']:.4g}", f"{change:+.1%}")
+        print(row(key, *values) + flag)
+
+    for key in sorted(set(baseline) - set(current)):
+        print(row(key, f"{baseline[key]['value']:.4g}", "-", "missing"))
+
+    if regressions:
+        print(f"\n{regressions} measurement(s) regressed by more than {args.threshold:.0%}")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,12 +1,15 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <neopdf_capi.h>
 #include <string>
 #include <sys/types.h>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 
 /** @brief Object Oriented interface to NeoPDF. */
@@ -95,6 +98,64 @@ struct MetaData {
     }
 };
 
+/**
+ * @brief Executor running the tasks `0..num_tasks` of a batch evaluation.
+ *
+ * It must call `task(i)` once for every `i` in `0..num_tasks`, possibly concurrently,
+ * e.g. with `tbb::parallel_for`, and return once all the calls have completed. It must
+ * not throw.
+ */
+typedef std::function<void(size_t num_tasks, const std::function<void(size_t)>& task)> Executor;
+
+namespace detail {
+    /** @brief Forwards the tasks of a batch to the `Executor` passed as `context`. */
+    inline void run_executor(
+        void* context, size_t num_tasks, neopdf_task task, void* task_context
+    ) {
+        const Executor& executor = *static_cast<const Executor*>(context);
+        executor(num_tasks, [task, task_context](size_t index) { task(task_context, index); });
+    }
+
+    /** @brief Wraps an `Executor` into its C representation. */
+    inline NeoPDFExecutor to_c_executor(const Executor& executor) {
+        NeoPDFExecutor c_executor;
+        c_executor.context = const_cast<Executor*>(&executor);
+        c_executor.run = run_executor;
+        return c_executor;
+    }
+
+    /** @brief Collects the pointers to and the lengths of a list of points. */
+    inline void points_to_c(
+        const std::vector<std::vector<double>>& points,
+        std::vector<const double*>& c_points,
+        std::vector<size_t>& lengths
+    ) {
+        c_points.resize(points.size());
+        lengths.resize(points.size());
+        for (size_t i = 0; i < points.size(); ++i) {
+            c_points[i] = points[i].data();
+            lengths[i] = points[i].size();
+        }
+    }
+}
+
+/**
+ * @brief List the members shared through the registry of the process, i.e. those loaded
+ * with the `NeoPDF` constructors, with their number of handles and of resident bytes.
+ */
+inline std::string registry_report() {
+    std::string report(neopdf_registry_report(nullptr, 0), '\0');
+    if (!report.empty()) {
+        std::vector<char> buffer(report.size() + 1);
+        size_t length = neopdf_registry_report(buffer.data(), buffer.size());
+        report.assign(buffer.data(), std::min(length, buffer.size() - 1));
+    }
+    return report;
+}
+
+/** @brief Get the number of bytes held by the members of the registry of the process. */
+inline size_t registry_resident_bytes() { return neopdf_registry_resident_bytes(); }
+
 class NeoPDFs; // Forward declaration
 
 /** @brief Base PDF class that instantiates the PDF object. */
@@ -122,6 +183,10 @@ class NeoPDF {
 
         /**
          * @brief Constructor of the PDF object.
+         *
+         * The member is shared with the other live `NeoPDF` objects of the same member,
+         * in which case it is not loaded again, see `registry_report`.
+         *
          * @brief `pdf_name` Name of the PDF set.
          * @brief `member` ID number of the PDF member.
          */
@@ -129,6 +194,19 @@ class NeoPDF {
             this->raw = neopdf_pdf_load(pdf_name.c_str(), member);
         }
 
+        /**
+         * @brief Constructor of the PDF object with custom load options.
+         * @brief `pdf_name` Name of the PDF set.
+         * @brief `member` ID number of the PDF member.
+         * @brief `options` Options refining the construction of the interpolators, e.g.
+         * `precompute_coeffs` to precompute the bicubic coefficient tables,
+         * `single_precision` to store the knot values in single precision or
+         * `interleave_flavors` to store the flavors innermost for `xfxQ2_batch`.
+         */
+        NeoPDF(const std::string& pdf_name, size_t member, neopdf_load_options options) {
+            this->raw = neopdf_pdf_load_with_options(pdf_name.c_str(), member, options);
+        }
+
         // Needed for `PDFs` to call the protected constructor
         // Static factory method to create PDF objects from NeoPDFWrapper*
         static std::unique_ptr<NeoPDF> from_raw(NeoPDFWrapper* pdf) {
@@ -157,28 +235,446 @@ class NeoPDF {
             return neopdf_pdf_xfxq2_nd(this->raw, pid, params.data(), params.size());
         }
 
+        /**
+         * @brief Compute the `xf` value of a PID at several values of the leading
+         * parameter, e.g. at several nucleon numbers A or values of `alphas` for a fixed
+         * (x, Q2).
+         *
+         * The interpolation along x and Q2 is shared by the values, such that a scan
+         * over A costs little more than a single evaluation. The leading entry of `params`
+         * is ignored and `out[i]` holds the value at `values[i]`. An empty scan is a no-op,
+         * such that the pointers may then be null.
+         *
+         * @param pid The PID.
+         * @param params The parameters of the point, as passed to `xfxQ2_ND`.
+         * @param values Pointer to the `nvalues` values of the leading parameter.
+         * @param nvalues Number of values.
+         * @param out Pointer to the `nvalues` output values.
+         */
+        void xfxQ2_ND(
+            int pid,
+            const std::vector<double>& params,
+            const double* values, size_t nvalues,
+            double* out
+        ) const {
+            if (nvalues == 0) {
+                return;
+            }
+            NeopdfResult result = neopdf_pdf_xfxq2_nd_scan(
+                this->raw, pid, params.data(), params.size(), values, nvalues, out
+            );
+            if (result != NeopdfResult::NEOPDF_RESULT_SUCCESS) {
+                throw std::runtime_error("Failed to compute the scan of `xf` values");
+            }
+        }
+
+        /**
+         * @brief Compute the `xf` value of a PID at several values of the leading
+         * parameter, for fixed values of the other parameters.
+         */
+        std::vector<double> xfxQ2_ND(
+            int pid,
+            const std::vector<double>& params,
+            const std::vector<double>& values
+        ) const {
+            std::vector<double> out(values.size());
+            xfxQ2_ND(pid, params, values.data(), values.size(), out.data());
+            return out;
+        }
+
+        /**
+         * @brief Compute the `xf` values for several PIDs on a batch of (x, Q2) points.
+         *
+         * The results are written into the caller-owned `out` buffer in row-major
+         * order with shape `[npids, npoints]`, i.e. `out[i * npoints + j]` holds the
+         * value of `pids[i]` at `(xs[j], q2s[j])`. An empty batch is a no-op, such that the
+         * pointers may then be null. If the evaluation fails, `out` is left partly written.
+         *
+         * @param pids Pointer to the `npids` PIDs.
+         * @param npids Number of PIDs.
+         * @param xs Pointer to the `npoints` momentum fractions.
+         * @param q2s Pointer to the `npoints` energy scales.
+         * @param npoints Number of points.
+         * @param out Pointer to the `npids * npoints` output values.
+         */
+        void xfxQ2_batch(
+            const int32_t* pids, size_t npids,
+            const double* xs, const double* q2s, size_t npoints,
+            double* out
+        ) const {
+            if (npids == 0 || npoints == 0) {
+                return;
+            }
+            NeopdfResult result = neopdf_pdf_xfxq2_batch(
+                this->raw, pids, npids, xs, q2s, npoints, out
+            );
+            if (result != NeopdfResult::NEOPDF_RESULT_SUCCESS) {
+                throw std::runtime_error("Failed to compute the batch of `xf` values");
+            }
+        }
+
+        /** @brief Compute the `xf` values for several PIDs on a batch of (x, Q2) points. */
+        void xfxQ2_batch(
+            const std::vector<int32_t>& pids,
+            const std::vector<double>& xs,
+            const std::vector<double>& q2s,
+            std::vector<double>& out
+        ) const {
+            if (xs.size() != q2s.size() || out.size() != pids.size() * xs.size()) {
+                throw std::invalid_argument("Inconsistent sizes of the batch inputs/outputs");
+            }
+            xfxQ2_batch(pids.data(), pids.size(), xs.data(), q2s.data(), xs.size(), out.data());
+        }
+
+        /**
+         * @brief Compute the `xf` values for several PIDs on the tensor product of a list
+         * of x values and a list of Q2 values.
+         *
+         * The results are written into the caller-owned `out` buffer in row-major order
+         * with shape `[npids, nxs, nq2s]`, i.e. `out[(i * nxs + j) * nq2s + k]` holds the
+         * value of `pids[i]` at `(xs[j], q2s[k])`. The knot intervals and interpolation
+         * weights are computed once per x and once per Q2 value instead of once per point.
+         * An empty grid is a no-op, such that the pointers may then be null.
+         *
+         * @param pids Pointer to the `npids` PIDs.
+         * @param npids Number of PIDs.
+         * @param xs Pointer to the `nxs` momentum fractions.
+         * @param nxs Number of momentum fractions.
+         * @param q2s Pointer to the `nq2s` energy scales.
+         * @param nq2s Number of energy scales.
+         * @param out Pointer to the `npids * nxs * nq2s` output values.
+         */
+        void xfxQ2_grid(
+            const int32_t* pids, size_t npids,
+            const double* xs, size_t nxs,
+            const double* q2s, size_t nq2s,
+            double* out
+        ) const {
+            if (npids == 0 || nxs == 0 || nq2s == 0) {
+                return;
+            }
+            NeopdfResult result = neopdf_pdf_xfxq2_grid(
+                this->raw, pids, npids, xs, nxs, q2s, nq2s, out
+            );
+            if (result != NeopdfResult::NEOPDF_RESULT_SUCCESS) {
+                throw std::runtime_error("Failed to compute the grid of `xf` values");
+            }
+        }
+
+        /**
+         * @brief Compute the `xf` values for several PIDs on the tensor product of a list
+         * of x values and a list of Q2 values.
+         */
+        void xfxQ2_grid(
+            const std::vector<int32_t>& pids,
+            const std::vector<double>& xs,
+            const std::vector<double>& q2s,
+            std::vector<double>& out
+        ) const {
+            if (out.size() != pids.size() * xs.size() * q2s.size()) {
+                throw std::invalid_argument("Inconsistent sizes of the grid inputs/outputs");
+            }
+            xfxQ2_grid(
+                pids.data(), pids.size(), xs.data(), xs.size(), q2s.data(), q2s.size(),
+                out.data()
+            );
+        }
+
+        /**
+         * @brief Compute the `xf` values for several PIDs at a fixed x and several Q2
+         * values, together with `alphas` at these Q2 values.
+         *
+         * Suited to scale variations: the knot interval and interpolation weights along x
+         * are computed once and shared by all the Q2 values. The results are written into
+         * `out` in row-major order with shape `[npids, nq2s]`, i.e. `out[i * nq2s + k]`
+         * holds the value of `pids[i]` at `(x, q2s[k])`, and `alphas[k]` the value of
+         * `alphas` at `q2s[k]`. An empty list is a no-op, such that the pointers may then
+         * be null.
+         *
+         * @param pids Pointer to the `npids` PIDs.
+         * @param npids Number of PIDs.
+         * @param x The momentum fraction.
+         * @param q2s Pointer to the `nq2s` energy scales.
+         * @param nq2s Number of energy scales.
+         * @param out Pointer to the `npids * nq2s` output values.
+         * @param alphas Pointer to the `nq2s` values of `alphas`.
+         */
+        void xfxQ2_fixed_x(
+            const int32_t* pids, size_t npids,
+            double x,
+            const double* q2s, size_t nq2s,
+            double* out,
+            double* alphas
+        ) const {
+            if (npids == 0 || nq2s == 0) {
+                return;
+            }
+            NeopdfResult result = neopdf_pdf_xfxq2_fixed_x(
+                this->raw, pids, npids, x, q2s, nq2s, out, alphas
+            );
+            if (result != NeopdfResult::NEOPDF_RESULT_SUCCESS) {
+                throw std::runtime_error("Failed to compute the `xf` values at fixed x");
+            }
+        }
+
+        /**
+         * @brief Compute the `xf` values for several PIDs at a fixed x and several Q2
+         * values, together with `alphas` at these Q2 values.
+         */
+        void xfxQ2_fixed_x(
+            const std::vector<int32_t>& pids,
+            double x,
+            const std::vector<double>& q2s,
+            std::vector<double>& out,
+            std::vector<double>& alphas
+        ) const {
+            if (out.size() != pids.size() * q2s.size() || alphas.size() != q2s.size()) {
+                throw std::invalid_argument("Inconsistent sizes of the inputs/outputs");
+            }
+            xfxQ2_fixed_x(
+                pids.data(), pids.size(), x, q2s.data(), q2s.size(), out.data(), alphas.data()
+            );
+        }
+
+        /**
+         * @brief Compute the `xf` values for several PIDs at several x values and a fixed
+         * Q2, and return `alphas` at this Q2.
+         *
+         * The knot interval and interpolation weights along Q2 are computed once and shared
+         * by all the x values. The results are written into `out` in row-major order with
+         * shape `[npids, nxs]`, i.e. `out[i * nxs + j]` holds the value of `pids[i]` at
+         * `(xs[j], q2)`. An empty list only computes `alphas`, such that the pointers may
+         * then be null.
+         *
+         * @param pids Pointer to the `npids` PIDs.
+         * @param npids Number of PIDs.
+         * @param xs Pointer to the `nxs` momentum fractions.
+         * @param nxs Number of momentum fractions.
+         * @param q2 The energy scale.
+         * @param out Pointer to the `npids * nxs` output values.
+         * @return The value of `alphas` at `q2`.
+         */
+        double xfxQ2_fixed_Q2(
+            const int32_t* pids, size_t npids,
+            const double* xs, size_t nxs,
+            double q2,
+            double* out
+        ) const {
+            if (npids == 0 || nxs == 0) {
+                return alphasQ2(q2);
+            }
+            double alphas = 0.0;
+            NeopdfResult result = neopdf_pdf_xfxq2_fixed_q2(
+                this->raw, pids, npids, xs, nxs, q2, out, &alphas
+            );
+            if (result != NeopdfResult::NEOPDF_RESULT_SUCCESS) {
+                throw std::runtime_error("Failed to compute the `xf` values at fixed Q2");
+            }
+            return alphas;
+        }
+
+        /**
+         * @brief Compute the `xf` values for several PIDs at several x values and a fixed
+         * Q2, and return `alphas` at this Q2.
+         */
+        double xfxQ2_fixed_Q2(
+            const std::vector<int32_t>& pids,
+            const std::vector<double>& xs,
+            double q2,
+            std::vector<double>& out
+        ) const {
+            if (out.size() != pids.size() * xs.size()) {
+                throw std::invalid_argument("Inconsistent sizes of the inputs/outputs");
+            }
+            return xfxQ2_fixed_Q2(pids.data(), pids.size(), xs.data(), xs.size(), q2, out.data());
+        }
+
+        /**
+         * @brief Compute the `xf` values for several PIDs on a batch of (x, Q2) points in
+         * single precision.
+         *
+         * The values are computed in double precision and rounded as they are stored into
+         * `out`, with the same layout as the double-precision overload.
+         */
+        void xfxQ2_batch(
+            const int32_t* pids, size_t npids,
+            const double* xs, const double* q2s, size_t npoints,
+            float* out
+        ) const {
+            if (npids == 0 || npoints == 0) {
+                return;
+            }
+            NeopdfResult result = neopdf_pdf_xfxq2_batch_f32(
+                this->raw, pids, npids, xs, q2s, npoints, out
+            );
+            if (result != NeopdfResult::NEOPDF_RESULT_SUCCESS) {
+                throw std::runtime_error("Failed to compute the batch of `xf` values");
+            }
+        }
+
+        /**
+         * @brief Compute the `xf` values for several PIDs on a batch of (x, Q2) points in
+         * single precision.
+         */
+        void xfxQ2_batch(
+            const std::vector<int32_t>& pids,
+            const std::vector<double>& xs,
+            const std::vector<double>& q2s,
+            std::vector<float>& out
+        ) const {
+            if (xs.size() != q2s.size() || out.size() != pids.size() * xs.size()) {
+                throw std::invalid_argument("Inconsistent sizes of the batch inputs/outputs");
+            }
+            xfxQ2_batch(pids.data(), pids.size(), xs.data(), q2s.data(), xs.size(), out.data());
+        }
+
+        /**
+         * @brief Compute the `xf` values for several PIDs on a list of generic points.
+         *
+         * The values are written into `results` with shape `[npids, npoints]`. They are
+         * computed in parallel, on `executor` if given or on the internal thread pool (see
+         * `set_num_threads`) otherwise. A value which cannot be computed is set to NaN and
+         * the reason is recorded in the corresponding entry of `status`.
+         *
+         * @return Whether all the values were computed.
+         */
+        bool xfxQ2s(
+            const int32_t* pids, size_t npids,
+            const double* const* points, const size_t* lengths, size_t npoints,
+            double* results, neopdf_point_status* status,
+            const Executor* executor = nullptr
+        ) const {
+            NeoPDFExecutor c_executor = NeoPDFExecutor();
+            if (executor != nullptr) {
+                c_executor = detail::to_c_executor(*executor);
+            }
+            NeopdfResult result = neopdf_pdf_xfxq2s(
+                this->raw, pids, npids, points, lengths, npoints,
+                executor != nullptr ? &c_executor : nullptr, results, status
+            );
+            if (result == NeopdfResult::NEOPDF_RESULT_ERROR_POINT_FAILURE) {
+                return false;
+            }
+            if (result != NeopdfResult::NEOPDF_RESULT_SUCCESS) {
+                throw std::runtime_error("Failed to compute the batch of `xf` values");
+            }
+            return true;
+        }
+
+        /** @brief Compute the `xf` values for several PIDs on a list of generic points. */
+        std::vector<double> xfxQ2s(
+            const std::vector<int32_t>& pids,
+            const std::vector<std::vector<double>>& points,
+            std::vector<neopdf_point_status>& status,
+            const Executor* executor = nullptr
+        ) const {
+            std::vector<const double*> c_points;
+            std::vector<size_t> lengths;
+            detail::points_to_c(points, c_points, lengths);
+
+            std::vector<double> results(pids.size() * points.size());
+            status.resize(results.size());
+            xfxQ2s(pids.data(), pids.size(), c_points.data(), lengths.data(), points.size(),
+                   results.data(), status.data(), executor);
+            return results;
+        }
+
+        /**
+         * @brief Compute the `xf` value for a generic set of parameters using batch Chebyshev
+         * interpolation, with a status per value.
+         *
+         * The values are computed in parallel, on `executor` if given or on the internal
+         * thread pool (see `set_num_threads`) otherwise. A value which cannot be computed is
+         * set to NaN and the reason is recorded in the corresponding entry of `status`.
+         *
+         * @return Whether all the values were computed.
+         */
+        bool xfxQ2_cheby_batch(
+            int pid, const double* const* points, const size_t* lengths, size_t npoints,
+            double* results, neopdf_point_status* status,
+            const Executor* executor = nullptr
+        ) const {
+            NeoPDFExecutor c_executor = NeoPDFExecutor();
+            if (executor != nullptr) {
+                c_executor = detail::to_c_executor(*executor);
+            }
+            NeopdfResult result = neopdf_pdf_xfxq2_cheby_batch_into(
+                this->raw, pid, points, lengths, npoints,
+                executor != nullptr ? &c_executor : nullptr, results, status
+            );
+            if (result == NeopdfResult::NEOPDF_RESULT_ERROR_POINT_FAILURE) {
+                return false;
+            }
+            if (result != NeopdfResult::NEOPDF_RESULT_SUCCESS) {
+                throw std::runtime_error("Failed to compute the Chebyshev batch of `xf` values");
+            }
+            return true;
+        }
+
         /** @brief Compute the `xf` value for a generic set of parameters using batch Chebyshev interpolation. */
         std::vector<double>
-        xfxQ2_cheby_batch(int pid, const std::vector<std::vector<double>> &points) const {
-            std::vector<const double *> c_points(points.size());
-            std::vector<size_t> lengths(points.size());
-            for (size_t i = 0; i < points.size(); ++i) {
-                c_points[i] = points[i].data();
-                lengths[i] = points[i].size();
-            }
+        xfxQ2_cheby_batch(
+            int pid,
+            const std::vector<std::vector<double>> &points,
+            const Executor* executor = nullptr
+        ) const {
+            std::vector<const double *> c_points;
+            std::vector<size_t> lengths;
+            detail::points_to_c(points, c_points, lengths);
 
             std::vector<double> results(points.size());
-            neopdf_pdf_xfxq2_cheby_batch(this->raw, pid, c_points.data(), lengths.data(),
-                                        points.size(), results.data());
+            std::vector<neopdf_point_status> status(points.size());
+            if (!xfxQ2_cheby_batch(pid, c_points.data(), lengths.data(), points.size(),
+                                   results.data(), status.data(), executor)) {
+                throw std::runtime_error("Failed to compute the Chebyshev batch of `xf` values");
+            }
 
             return results;
         }
 
+        /**
+         * @brief Set the number of threads used by the batch evaluations without executor.
+         *
+         * A value of zero restores the default number of threads.
+         */
+        static void set_num_threads(size_t num_threads) {
+            if (neopdf_set_num_threads(num_threads) != NeopdfResult::NEOPDF_RESULT_SUCCESS) {
+                throw std::runtime_error("Failed to set the number of threads");
+            }
+        }
+
         /** @brief Compute the value of `alphas` at the Q2 value. */
         double alphasQ2(double q2) const {
             return neopdf_pdf_alphas_q2(this->raw, q2);
         }
 
+        /**
+         * @brief Compute the values of `alphas` at several Q2 values.
+         *
+         * An empty batch is a no-op, such that the pointers may then be null.
+         *
+         * @param q2s Pointer to the `npoints` energy scales.
+         * @param npoints Number of energy scales.
+         * @param out Pointer to the `npoints` output values.
+         */
+        void alphasQ2_batch(const double* q2s, size_t npoints, double* out) const {
+            if (npoints == 0) {
+                return;
+            }
+            NeopdfResult result = neopdf_pdf_alphas_q2_batch(this->raw, q2s, npoints, out);
+            if (result != NeopdfResult::NEOPDF_RESULT_SUCCESS) {
+                throw std::runtime_error("Failed to compute the batch of `alphas` values");
+            }
+        }
+
+        /** @brief Compute the values of `alphas` at several Q2 values. */
+        void alphasQ2_batch(const std::vector<double>& q2s, std::vector<double>& out) const {
+            if (out.size() != q2s.size()) {
+                throw std::invalid_argument("Inconsistent sizes of the batch inputs/outputs");
+            }
+            alphasQ2_batch(q2s.data(), q2s.size(), out.data());
+        }
+
         /** @brief Get the number of PIDs. */
         size_t num_pids() const {
             return neopdf_pdf_num_pids(this->raw);
@@ -197,6 +693,41 @@ class NeoPDF {
             return neopdf_pdf_num_subgrids(this->raw);
         }
 
+        /**
+         * @brief Get the index of the subgrid containing a point `(..., x, Q2)`.
+         *
+         * If no subgrid contains the point, the index of the closest subgrid (which
+         * is used for the extrapolation) is returned.
+         */
+        size_t find_subgrid(const std::vector<double>& params) const {
+            size_t index = 0;
+            NeopdfResult result = neopdf_pdf_find_subgrid(
+                this->raw, params.data(), params.size(), &index
+            );
+            if (result != NeopdfResult::NEOPDF_RESULT_SUCCESS) {
+                throw std::runtime_error("Failed to find the subgrid of the point");
+            }
+            return index;
+        }
+
+        /** @brief Get the indices of the subgrids containing a batch of (x, Q2) points. */
+        std::vector<size_t> find_subgrids(
+            const std::vector<double>& xs,
+            const std::vector<double>& q2s
+        ) const {
+            if (xs.size() != q2s.size()) {
+                throw std::invalid_argument("Inconsistent sizes of the x and Q2 inputs");
+            }
+            std::vector<size_t> indices(xs.size());
+            NeopdfResult result = neopdf_pdf_find_subgrids(
+                this->raw, xs.data(), q2s.data(), xs.size(), indices.data()
+            );
+            if (result != NeopdfResult::NEOPDF_RESULT_SUCCESS) {
+                throw std::runtime_error("Failed to find the subgrids of the points");
+            }
+            return indices;
+        }
+
         /** @brief Get the minimum and maximum value for a given parameter. */
         std::vector<double> param_range(NeopdfSubgridParams param) const {
             std::vector<double> range(2);
@@ -236,6 +767,42 @@ class NeoPDF {
         neopdf_force_positive is_force_positive() const {
             return neopdf_pdf_is_force_positive(this->raw);
         }
+
+        /**
+         * @brief Enables or disables the recording of the evaluations in `stats()`.
+         *
+         * The recording is disabled by default. The counters are shared by all the
+         * handles to the same member.
+         */
+        void enable_stats(bool enabled = true) {
+            neopdf_pdf_enable_stats(this->raw, enabled);
+        }
+
+        /**
+         * @brief Returns the counters of the load and of the recorded evaluations.
+         *
+         * @return The number of located points, of fallbacks to the nearest subgrid, of
+         * clamped coordinates and of clipped values, together with the load time.
+         */
+        neopdf_eval_stats stats() const { return neopdf_pdf_statistics(this->raw); }
+
+        /** @brief Resets the counters of the member to zero. */
+        void reset_stats() { neopdf_pdf_reset_stats(this->raw); }
+
+        /**
+         * @brief Builds the interpolators of the given PIDs ahead of the evaluations.
+         *
+         * The interpolators are otherwise built on their first use, which then takes
+         * longer than the following ones.
+         *
+         * @param pids The PIDs whose interpolators are built.
+         */
+        void warmup(const std::vector<int32_t>& pids) const {
+            if (neopdf_pdf_warmup(this->raw, pids.data(), pids.size())
+                    != NeopdfResult::NEOPDF_RESULT_SUCCESS) {
+                throw std::invalid_argument("Invalid PIDs to warm up");
+            }
+        }
 };
 
 /** @brief Class to load and manage multiple PDF members. */
@@ -243,6 +810,57 @@ class NeoPDFs {
     private:
         std::vector<std::unique_ptr<NeoPDF>> pdf_members;
 
+        /** @brief Deleter of the stack of the members. */
+        struct MemberStackDeleter {
+            void operator()(NeoPDFMemberStack* stack) const { neopdf_member_stack_free(stack); }
+        };
+
+        /**
+         * @brief Stack of the members, built on first use by `xfxQ2_all_members` and the
+         * uncertainties, together with the mutex guarding its construction.
+         *
+         * The stack holds its own copy of the knot values of all the members, which doubles
+         * the memory held by the set once built.
+         */
+        struct LazyMemberStack {
+            std::mutex mutex;
+            std::unique_ptr<NeoPDFMemberStack, MemberStackDeleter> stack;
+            /** @brief Whether the stack was built, or failed to be. */
+            bool built = false;
+        };
+
+        /** @brief The stack of the members, held by pointer to keep `NeoPDFs` movable. */
+        std::unique_ptr<LazyMemberStack> member_stack{new LazyMemberStack()};
+
+        /**
+         * @brief Returns the stack of the members, or `nullptr` if they cannot be stacked.
+         *
+         * The stack is built once, also when several threads evaluate the members at the
+         * same time.
+         */
+        NeoPDFMemberStack* stack() const {
+            std::lock_guard<std::mutex> lock(member_stack->mutex);
+            if (!member_stack->built) {
+                std::vector<NeoPDFWrapper*> raw_pdfs;
+                for (const auto& pdf : pdf_members) {
+                    raw_pdfs.push_back(pdf->raw);
+                }
+                member_stack->stack.reset(
+                    neopdf_member_stack_new(raw_pdfs.data(), raw_pdfs.size())
+                );
+                member_stack->built = true;
+            }
+            return member_stack->stack.get();
+        }
+
+        /** @brief Returns the default load options with the given placement of the knot values. */
+        static neopdf_load_options placement_options(neopdf_numa_policy numa, bool huge_pages) {
+            neopdf_load_options options = neopdf_load_options();
+            options.huge_pages = huge_pages;
+            options.numa = numa;
+            return options;
+        }
+
     public:
         /**
          * @brief Constructor that loads all PDF members for a given PDF set.
@@ -256,6 +874,37 @@ class NeoPDFs {
             }
         }
 
+        /**
+         * @brief Constructor that loads all PDF members with custom load options.
+         * @param pdf_name Name of the PDF set.
+         * @param options Options refining the construction of the interpolators.
+         */
+        NeoPDFs(const std::string& pdf_name, neopdf_load_options options) {
+            NeoPDFMembers raw_pdfs = neopdf_pdf_load_all_with_options(pdf_name.c_str(), options);
+
+            for (size_t i = 0; i < raw_pdfs.size; ++i) {
+                pdf_members.push_back(NeoPDF::from_raw(raw_pdfs.pdfs[i]));
+            }
+        }
+
+        /**
+         * @brief Constructor that loads all PDF members and places their knot values in memory.
+         *
+         * The knot values of all the members are copied into a single buffer, which is bound
+         * to the NUMA nodes according to `numa` and, if `huge_pages` is set, backed by
+         * transparent huge pages. With `NEOPDF_NUMA_POLICY_INTERLEAVE` the resident memory is
+         * unchanged, while with `NEOPDF_NUMA_POLICY_REPLICATE` the knot values are held once
+         * per node and every evaluation reads the copy of the node of the calling thread. The
+         * huge pages add at most 2 MiB of padding. Both are ignored on other platforms than
+         * Linux.
+         *
+         * @param pdf_name Name of the PDF set.
+         * @param numa The placement of the knot values on the NUMA nodes.
+         * @param huge_pages Whether to back the knot values by transparent huge pages.
+         */
+        NeoPDFs(const std::string& pdf_name, neopdf_numa_policy numa, bool huge_pages = true)
+            : NeoPDFs(pdf_name, placement_options(numa, huge_pages)) {}
+
         /** @brief Get the number of loaded PDF members. */
         size_t size() const { return pdf_members.size(); }
 
@@ -281,10 +930,175 @@ class NeoPDFs {
             }
             members.pdfs = raw_pdfs.data();
             neopdf_pdf_set_force_positive_members(&members, option);
+
+            // The stack holds a copy of the clipping methods of the members.
+            std::lock_guard<std::mutex> lock(member_stack->mutex);
+            member_stack->stack.reset();
+            member_stack->built = false;
+        }
+
+        /** @brief Builds the interpolators of the given PIDs for all members, see `NeoPDF::warmup`. */
+        void warmup(const std::vector<int32_t>& pids) const {
+            for (const auto& pdf : pdf_members) {
+                pdf->warmup(pids);
+            }
+        }
+
+        /**
+         * @brief Compute the `xf` values of a PID on a batch of (x, Q2) points for all members.
+         *
+         * The members sharing the same knots, the subgrid and the interpolation weights of
+         * each point are computed once and applied to the knot values of all the members,
+         * which are copied contiguously into a stack on the first call: the stack holds a
+         * second copy of the knot values of every member. The clipping methods of the members
+         * are captured at that time, except when set through `set_force_positive_members`. If
+         * the members cannot be stacked, they are evaluated one after the other. The method
+         * can be called from several threads at the same time.
+         *
+         * The results are written into `out` in row-major order with shape
+         * `[npoints, size()]`, i.e. `out[j * size() + m]` holds the value of the member `m`
+         * at `(xs[j], q2s[j])`.
+         *
+         * @param pid The PID.
+         * @param xs Pointer to the `npoints` momentum fractions.
+         * @param q2s Pointer to the `npoints` energy scales.
+         * @param npoints Number of points.
+         * @param out Pointer to the `npoints * size()` output values.
+         */
+        void xfxQ2_all_members(
+            int32_t pid, const double* xs, const double* q2s, size_t npoints, double* out
+        ) const {
+            if (npoints == 0 || pdf_members.empty()) {
+                return;
+            }
+
+            NeoPDFMemberStack* raw_stack = stack();
+            if (raw_stack == nullptr) {
+                for (size_t j = 0; j < npoints; ++j) {
+                    for (size_t m = 0; m < pdf_members.size(); ++m) {
+                        out[j * pdf_members.size() + m] = pdf_members[m]->xfxQ2(pid, xs[j], q2s[j]);
+                    }
+                }
+                return;
+            }
+
+            NeopdfResult result = neopdf_member_stack_xfxq2_batch(
+                raw_stack, pid, xs, q2s, npoints, out
+            );
+            if (result != NeopdfResult::NEOPDF_RESULT_SUCCESS) {
+                throw std::runtime_error("Failed to compute the `xf` values of the members");
+            }
+        }
+
+        /** @brief Compute the `xf` values of a PID at (x, Q2) for all members. */
+        void xfxQ2_all_members(int32_t pid, double x, double q2, double* out) const {
+            xfxQ2_all_members(pid, &x, &q2, 1, out);
+        }
+
+        /** @brief Compute the `xf` values of a PID at (x, Q2) for all members. */
+        std::vector<double> xfxQ2_all_members(int32_t pid, double x, double q2) const {
+            std::vector<double> out(pdf_members.size());
+            xfxQ2_all_members(pid, &x, &q2, 1, out.data());
+            return out;
+        }
+
+        /** @brief Compute the `xf` values of a PID on a batch of (x, Q2) points for all members. */
+        void xfxQ2_all_members(
+            int32_t pid,
+            const std::vector<double>& xs,
+            const std::vector<double>& q2s,
+            std::vector<double>& out
+        ) const {
+            if (xs.size() != q2s.size() || out.size() != xs.size() * pdf_members.size()) {
+                throw std::invalid_argument("Inconsistent sizes of the batch inputs/outputs");
+            }
+            xfxQ2_all_members(pid, xs.data(), q2s.data(), xs.size(), out.data());
+        }
+
+        /**
+         * @brief Compute the central values and uncertainties of a PID on a batch of (x, Q2)
+         * points.
+         *
+         * The members are combined according to the `ErrorType` of the set, i.e. `replicas`,
+         * `hessian` or `symmhessian`, possibly with parameter variations such as `+as`, in a
+         * single pass as they are interpolated. The points are processed in parallel. The
+         * members are read from their stack, which is built on the first call as by
+         * `xfxQ2_all_members` and holds a second copy of their knot values.
+         *
+         * @param pid The PID.
+         * @param xs Pointer to the `npoints` momentum fractions.
+         * @param q2s Pointer to the `npoints` energy scales.
+         * @param npoints Number of points.
+         * @param out Pointer to the `npoints` output uncertainties.
+         * @throws std::runtime_error if the members cannot be stacked or combined.
+         */
+        void uncertainty(
+            int32_t pid, const double* xs, const double* q2s, size_t npoints,
+            neopdf_uncertainty* out
+        ) const {
+            if (npoints == 0) {
+                return;
+            }
+            NeoPDFMemberStack* raw_stack = stack();
+            if (raw_stack == nullptr) {
+                throw std::runtime_error("The PDF members cannot be combined into uncertainties");
+            }
+            NeopdfResult result = neopdf_member_stack_uncertainty_batch(
+                raw_stack, pid, xs, q2s, npoints, out
+            );
+            if (result != NeopdfResult::NEOPDF_RESULT_SUCCESS) {
+                throw std::runtime_error("Failed to compute the PDF uncertainties");
+            }
+        }
+
+        /** @brief Compute the central value and uncertainties of a PID at (x, Q2). */
+        neopdf_uncertainty uncertainty(int32_t pid, double x, double q2) const {
+            neopdf_uncertainty out;
+            uncertainty(pid, &x, &q2, 1, &out);
+            return out;
+        }
+
+        /** @brief Compute the central values and uncertainties of a PID on a batch of (x, Q2) points. */
+        std::vector<neopdf_uncertainty> uncertainty(
+            int32_t pid, const std::vector<double>& xs, const std::vector<double>& q2s
+        ) const {
+            if (xs.size() != q2s.size()) {
+                throw std::invalid_argument("Inconsistent sizes of the batch inputs");
+            }
+            std::vector<neopdf_uncertainty> out(xs.size());
+            uncertainty(pid, xs.data(), q2s.data(), xs.size(), out.data());
+            return out;
+        }
+
+        /**
+         * @brief Compute the central values and uncertainties of a PID on the grid spanned
+         * by `xs` and `q2s`.
+         *
+         * The results are returned in row-major order with shape `[xs, q2s]`, i.e. the
+         * entry `i * q2s.size() + j` holds the result at `(xs[i], q2s[j])`.
+         */
+        std::vector<neopdf_uncertainty> uncertainty_grid(
+            int32_t pid, const std::vector<double>& xs, const std::vector<double>& q2s
+        ) const {
+            std::vector<neopdf_uncertainty> out(xs.size() * q2s.size());
+            if (out.empty()) {
+                return out;
+            }
+            NeoPDFMemberStack* raw_stack = stack();
+            if (raw_stack == nullptr) {
+                throw std::runtime_error("The PDF members cannot be combined into uncertainties");
+            }
+            NeopdfResult result = neopdf_member_stack_uncertainty_grid(
+                raw_stack, pid, xs.data(), xs.size(), q2s.data(), q2s.size(), out.data()
+            );
+            if (result != NeopdfResult::NEOPDF_RESULT_SUCCESS) {
+                throw std::runtime_error("Failed to compute the PDF uncertainties");
+            }
+            return out;
         }
 };
 
-/** @brief Class for lazily loading PDF members from a .neopdf.lz4 file. */
+/** @brief Class for lazily loading PDF members from a .neopdf.lz4 or .neopdf file. */
 class NeoPDFLazy {
     private:
         ::NeoPDFLazyIterator* raw_iter;
@@ -292,13 +1106,32 @@ class NeoPDFLazy {
     public:
         /**
          * @brief Constructor that initializes the lazy iterator for a given PDF set.
-         * @param pdf_name Name of the PDF set (must be a .neopdf.lz4 file).
+         * @param pdf_name Name of the PDF set (must be a .neopdf.lz4 or .neopdf file).
          * @throws std::runtime_error if the iterator cannot be created.
          */
         explicit NeoPDFLazy(const std::string& pdf_name) {
             raw_iter = neopdf_pdf_load_lazy(pdf_name.c_str());
             if (!raw_iter) {
-                throw std::runtime_error("Failed to create lazy iterator. Check if file is a .neopdf.lz4 file.");
+                throw std::runtime_error("Failed to create lazy iterator. Check if file is a .neopdf.lz4 or .neopdf file.");
+            }
+        }
+
+        /**
+         * @brief Constructor that initializes a lazy iterator decoding the following
+         * members and building their interpolators on a background thread.
+         * @param pdf_name Name of the PDF set (must be a .neopdf.lz4 or .neopdf file).
+         * @param prefetch_depth Maximum number of members queued ahead of `next()`.
+         * @param options Options refining the construction of the members.
+         * @throws std::runtime_error if the iterator cannot be created.
+         */
+        NeoPDFLazy(
+            const std::string& pdf_name,
+            size_t prefetch_depth,
+            neopdf_load_options options = neopdf_load_options()
+        ) {
+            raw_iter = neopdf_pdf_load_lazy_prefetched(pdf_name.c_str(), prefetch_depth, options);
+            if (!raw_iter) {
+                throw std::runtime_error("Failed to create lazy iterator. Check if file is a .neopdf.lz4 or .neopdf file.");
             }
         }
 
@@ -346,6 +1179,133 @@ class NeoPDFLazy {
         }
 };
 
+/**
+ * @brief Class giving random access to the members of a PDF set under a memory budget.
+ *
+ * The members are decoded when they are first requested and the least recently used ones
+ * are evicted whenever the resident members exceed the budget. The methods can be called
+ * concurrently from several threads.
+ */
+class NeoPDFCache {
+    private:
+        ::NeoPDFMemberCache* raw;
+
+    public:
+        /**
+         * @brief Constructor that creates the cache over the members of a PDF set.
+         * @param pdf_name Name of the PDF set.
+         * @param max_bytes Maximum number of bytes held by the resident members.
+         */
+        NeoPDFCache(const std::string& pdf_name, size_t max_bytes) {
+            raw = neopdf_cache_new(pdf_name.c_str(), max_bytes);
+            if (!raw) {
+                throw std::runtime_error("Failed to create `NeoPDFCache`");
+            }
+        }
+
+        /**
+         * @brief Constructor that creates the cache with custom load options.
+         * @param pdf_name Name of the PDF set.
+         * @param max_bytes Maximum number of bytes held by the resident members.
+         * @param options Options refining the construction of the members.
+         */
+        NeoPDFCache(const std::string& pdf_name, size_t max_bytes, neopdf_load_options options) {
+            raw = neopdf_cache_new_with_options(pdf_name.c_str(), max_bytes, options);
+            if (!raw) {
+                throw std::runtime_error("Failed to create `NeoPDFCache`");
+            }
+        }
+
+        /** @brief Destructor. */
+        ~NeoPDFCache() {
+            if (raw) {
+                neopdf_cache_free(raw);
+            }
+        }
+
+        /** @brief Move constructor. */
+        NeoPDFCache(NeoPDFCache&& other) noexcept : raw(other.raw) {
+            other.raw = nullptr;
+        }
+
+        /** @brief Move assignment operator. */
+        NeoPDFCache& operator=(NeoPDFCache&& other) noexcept {
+            if (this != &other) {
+                if (raw) {
+                    neopdf_cache_free(raw);
+                }
+                raw = other.raw;
+                other.raw = nullptr;
+            }
+            return *this;
+        }
+
+        /** @brief Deleted copy semantics. */
+        NeoPDFCache(const NeoPDFCache&) = delete;
+        NeoPDFCache& operator=(const NeoPDFCache&) = delete;
+
+        /** @brief Get the number of members of the PDF set. */
+        size_t size() const { return neopdf_cache_num_members(raw); }
+
+        /** @brief Compute the `xf` value of a member for a given PID, x, and Q2. */
+        double xfxQ2(size_t member, int32_t pid, double x, double q2) const {
+            double out = 0.0;
+            xfxQ2_batch(member, &pid, 1, &x, &q2, 1, &out);
+            return out;
+        }
+
+        /**
+         * @brief Compute the `xf` values of a member for several PIDs on a batch of
+         * (x, Q2) points, with the layout of `NeoPDF::xfxQ2_batch`.
+         */
+        void xfxQ2_batch(
+            size_t member,
+            const int32_t* pids, size_t npids,
+            const double* xs, const double* q2s, size_t npoints,
+            double* out
+        ) const {
+            if (npids == 0 || npoints == 0) {
+                return;
+            }
+            NeopdfResult result = neopdf_cache_xfxq2_batch(
+                raw, member, pids, npids, xs, q2s, npoints, out
+            );
+            if (result != NeopdfResult::NEOPDF_RESULT_SUCCESS) {
+                throw std::runtime_error("Failed to compute the batch of `xf` values");
+            }
+        }
+
+        /** @brief Compute the `xf` values of a member for several PIDs on a batch of (x, Q2) points. */
+        void xfxQ2_batch(
+            size_t member,
+            const std::vector<int32_t>& pids,
+            const std::vector<double>& xs,
+            const std::vector<double>& q2s,
+            std::vector<double>& out
+        ) const {
+            if (xs.size() != q2s.size() || out.size() != pids.size() * xs.size()) {
+                throw std::invalid_argument("Inconsistent sizes of the batch inputs/outputs");
+            }
+            xfxQ2_batch(member, pids.data(), pids.size(), xs.data(), q2s.data(), xs.size(), out.data());
+        }
+
+        /** @brief Compute the value of `alpha_s` of a member at a given Q2. */
+        double alphasQ2(size_t member, double q2) const {
+            double out = 0.0;
+            NeopdfResult result = neopdf_cache_alphas_q2(raw, member, q2, &out);
+            if (result != NeopdfResult::NEOPDF_RESULT_SUCCESS) {
+                throw std::out_of_range("Member index out of range");
+            }
+            return out;
+        }
+
+        /** @brief Get the hit, miss and eviction counters and the resident members and bytes. */
+        neopdf_cache_stats stats() const { return neopdf_cache_statistics(raw); }
+
+        /** @brief Drop all the resident members, keeping the counters. */
+        void clear() { neopdf_cache_clear(raw); }
+};
+
 /** @brief Class for writing NeoPDF grid data to a file. */
 class GridWriter {
     private:
@@ -470,6 +1430,134 @@ class GridWriter {
         }
 };
 
+/**
+ * @brief Class writing the members of a set to a file one at a time.
+ *
+ * Unlike `GridWriter`, which keeps copies of all the grids until `compress()`, each member
+ * is written to the file as soon as it is pushed, straight from the buffers of the caller.
+ */
+class GridStreamWriter {
+    private:
+        NeoPDFGridWriter* raw;
+        std::vector<NeoPDFSubgridView> subgrids;
+
+    public:
+        /**
+         * @brief Constructor that creates the output file.
+         *
+         * The file is written uncompressed if its name ends with `.neopdf`, and compressed
+         * otherwise.
+         *
+         * @param metadata The metadata for the PDF set.
+         * @param output_path The path to the output file.
+         */
+        GridStreamWriter(const MetaData& metadata, const std::string& output_path) {
+            NeoPDFMetaData c_meta = metadata.to_c();
+            raw = neopdf_grid_writer_new(&c_meta, output_path.c_str());
+            if (!raw) {
+                throw std::runtime_error("Failed to create the output file");
+            }
+        }
+
+        /** @brief Destructor, which leaves the file incomplete if `finish()` was not called. */
+        ~GridStreamWriter() {
+            if (raw) {
+                neopdf_grid_writer_free(raw);
+            }
+        }
+
+        // Prevent copying
+        GridStreamWriter(const GridStreamWriter&) = delete;
+        GridStreamWriter& operator=(const GridStreamWriter&) = delete;
+
+        /**
+         * @brief Adds a subgrid to the current member, without copying its data.
+         *
+         * The arrays must stay valid until the member is pushed with `push_grid()`. The
+         * layout of `grid_data` is the same as in `GridWriter::add_subgrid`.
+         */
+        void add_subgrid(
+            const double* nucleons, size_t num_nucleons,
+            const double* alphas, size_t num_alphas,
+            const double* kts, size_t num_kts,
+            const double* xs, size_t num_xs,
+            const double* q2s, size_t num_q2s,
+            const double* grid_data, size_t grid_data_len
+        ) {
+            NeoPDFSubgridView subgrid;
+            subgrid.nucleons = nucleons;
+            subgrid.num_nucleons = num_nucleons;
+            subgrid.alphas = alphas;
+            subgrid.num_alphas = num_alphas;
+            subgrid.kts = kts;
+            subgrid.num_kts = num_kts;
+            subgrid.xs = xs;
+            subgrid.num_xs = num_xs;
+            subgrid.q2s = q2s;
+            subgrid.num_q2s = num_q2s;
+            subgrid.grid_data = grid_data;
+            subgrid.grid_data_len = grid_data_len;
+            subgrids.push_back(subgrid);
+        }
+
+        /**
+         * @brief Adds a subgrid to the current member, without copying its data.
+         *
+         * The vectors must stay alive and unmodified until the member is pushed with
+         * `push_grid()`.
+         */
+        void add_subgrid(
+            const std::vector<double>& nucleons,
+            const std::vector<double>& alphas,
+            const std::vector<double>& kts,
+            const std::vector<double>& xs,
+            const std::vector<double>& q2s,
+            const std::vector<double>& grid_data
+        ) {
+            add_subgrid(
+                nucleons.data(), nucleons.size(),
+                alphas.data(), alphas.size(),
+                kts.data(), kts.size(),
+                xs.data(), xs.size(),
+                q2s.data(), q2s.size(),
+                grid_data.data(), grid_data.size()
+            );
+        }
+
+        /**
+         * @brief Writes the current member, made of the subgrids added since the last push.
+         *
+         * @param flavors Vector of flavor IDs.
+         */
+        void push_grid(const std::vector<int32_t>& flavors) {
+            if (!raw) {
+                throw std::runtime_error("The writer was already finished");
+            }
+            NeopdfResult result = neopdf_grid_writer_push_subgrids(
+                raw, flavors.data(), flavors.size(), subgrids.data(), subgrids.size()
+            );
+            subgrids.clear();
+            if (result != NeopdfResult::NEOPDF_RESULT_SUCCESS) {
+                throw std::runtime_error("Failed to write the member");
+            }
+        }
+
+        /** @brief Get the number of members written so far. */
+        size_t size() const { return raw ? neopdf_grid_writer_num_members(raw) : 0; }
+
+        /** @brief Completes the file. No member can be pushed afterwards. */
+        void finish() {
+            if (!raw) {
+                throw std::runtime_error("The writer was already finished");
+            }
+            NeopdfResult result = neopdf_grid_writer_finish(raw);
+            raw = nullptr;
+            if (result != NeopdfResult::NEOPDF_RESULT_SUCCESS) {
+                throw std::runtime_error("Failed to complete the output file");
+            }
+        }
+};
+
 } // namespace neopdf
 
 /** @brief LHAPDF compatibility for no-code migration. */
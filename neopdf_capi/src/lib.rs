@@ -1,14 +1,23 @@
 //! The C-language interface for `NeoPDF`
 
+use std::cell::RefCell;
 use std::ffi::CStr;
-use std::os::raw::{c_char, c_double, c_int};
+use std::os::raw::{c_char, c_double, c_float, c_int, c_void};
 use std::slice;
-
-use neopdf::gridpdf::{ForcePositive, GridArray};
+use std::sync::atomic::{AtomicU64, AtomicUsize, Ordering};
+use std::sync::{Arc, PoisonError, RwLock};
+
+use neopdf::cache::{CacheStats, MemberCache};
+use neopdf::executor::{BatchExecutor, PointStatus, RayonExecutor};
+use neopdf::gridpdf::{ForcePositive, LoadOptions};
+use neopdf::manage::PdfSetFormat;
+use neopdf::members::{MemberStack, PDFUncertainty};
 use neopdf::metadata::{InterpolatorType, MetaData, MetaDataV1, SetType};
 use neopdf::parser::SubgridData;
 use neopdf::pdf::PDF;
-use neopdf::writer::GridArrayCollection;
+use neopdf::registry;
+use neopdf::stats::EvalStatistics;
+use neopdf::writer::{GridArrayWriter, SubGridView};
 
 const DEFAULT_PIDS: [i32; 14] = [21, -6, -5, -4, -3, -2, -1, 1, 2, 3, 4, 5, 6, 22];
 
@@ -26,6 +35,8 @@ pub enum NeopdfResult {
     ErrorMemoryError = -3,
     /// The provided length or size argument was invalid.
     ErrorInvalidLength = -4,
+    /// Some of the values of a batch could not be computed, as recorded in their status.
+    ErrorPointFailure = -5,
 }
 
 impl From<NeopdfResult> for c_int {
@@ -35,7 +46,11 @@ impl From<NeopdfResult> for c_int {
 }
 
 /// Opaque pointer to a PDF object.
-pub struct NeoPDFWrapper(PDF);
+///
+/// The members loaded with `neopdf_pdf_load` are shared through the registry of the process
+/// with the other handles to the same member. A handle which is modified, e.g. by
+/// `neopdf_pdf_set_force_positive`, is detached from the shared member beforehand.
+pub struct NeoPDFWrapper(Arc<PDF>);
 
 /// Structure to hold an array of PDF pointers and its length.
 #[repr(C)]
@@ -48,6 +63,9 @@ pub struct NeoPDFMembers {
 
 /// Loads a given member of the PDF set.
 ///
+/// The member is shared with the other live handles to the same member, in which case it is
+/// not loaded again, see `neopdf_registry_report`.
+///
 /// # Panics
 ///
 /// This function will panic if the provided C string is not valid UTF-8.
@@ -62,7 +80,31 @@ pub unsafe extern "C" fn neopdf_pdf_load(
 ) -> *mut NeoPDFWrapper {
     let c_str = unsafe { CStr::from_ptr(pdf_name) };
     let pdf_name = c_str.to_str().expect("Invalid UTF-8 string");
-    let pdf = PDF::load(pdf_name, member);
+    let pdf = PDF::load_shared(pdf_name, member, LoadOptions::default());
+    Box::into_raw(Box::new(NeoPDFWrapper(pdf)))
+}
+
+/// Loads a given member of the PDF set, building its interpolators according to `options`.
+///
+/// As for `neopdf_pdf_load`, the member is shared with the other live handles to the same
+/// member built with the same `options`.
+///
+/// # Panics
+///
+/// This function will panic if the provided C string is not valid UTF-8.
+///
+/// # Safety
+///
+/// The `pdf_name` C string must be null-terminated and valid UTF-8.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_pdf_load_with_options(
+    pdf_name: *const c_char,
+    member: usize,
+    options: LoadOptions,
+) -> *mut NeoPDFWrapper {
+    let c_str = unsafe { CStr::from_ptr(pdf_name) };
+    let pdf_name = c_str.to_str().expect("Invalid UTF-8 string");
+    let pdf = PDF::load_shared(pdf_name, member, options);
     Box::into_raw(Box::new(NeoPDFWrapper(pdf)))
 }
 
@@ -80,15 +122,35 @@ pub unsafe extern "C" fn neopdf_pdf_load(
 /// The `pdf_name` C string must be null-terminated and valid UTF-8.
 #[no_mangle]
 pub unsafe extern "C" fn neopdf_pdf_load_all(pdf_name: *const c_char) -> NeoPDFMembers {
+    unsafe { neopdf_pdf_load_all_with_options(pdf_name, LoadOptions::default()) }
+}
+
+/// Loads all members of the PDF set, building their interpolators according to `options`.
+///
+/// Returns a `NeoPDFMembers` containing pointers to all PDF objects in the set.
+/// The caller is responsible for freeing the memory using `neopdf_pdf_array_free`.
+///
+/// # Panics
+///
+/// This function will panic if the provided C string is not valid UTF-8.
+///
+/// # Safety
+///
+/// The `pdf_name` C string must be null-terminated and valid UTF-8.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_pdf_load_all_with_options(
+    pdf_name: *const c_char,
+    options: LoadOptions,
+) -> NeoPDFMembers {
     let c_str = unsafe { CStr::from_ptr(pdf_name) };
     let pdf_name = c_str.to_str().expect("Invalid UTF-8 string");
 
-    let pdfs = PDF::load_pdfs(pdf_name);
+    let pdfs = PDF::load_pdfs_with_options(pdf_name, options);
     let length = pdfs.len();
 
     let mut pdf_pointers: Vec<*mut NeoPDFWrapper> = pdfs
         .into_iter()
-        .map(|pdf| Box::into_raw(Box::new(NeoPDFWrapper(pdf))))
+        .map(|pdf| Box::into_raw(Box::new(NeoPDFWrapper(Arc::new(pdf)))))
         .collect();
 
     let pdfs_ptr = pdf_pointers.as_mut_ptr();
@@ -145,7 +207,7 @@ pub struct NeoPDFLazyIterator(Box<dyn Iterator<Item = Result<PDF, Box<dyn std::e
 
 /// Loads a PDF set for lazy iteration.
 ///
-/// This function is only supported for `.neopdf.lz4` files.
+/// This function is only supported for `.neopdf.lz4` and `.neopdf` files.
 /// Returns a pointer to a `NeoPDFLazyIterator`. The caller is responsible for
 /// freeing the memory using `neopdf_lazy_iterator_free`.
 ///
@@ -161,7 +223,7 @@ pub unsafe extern "C" fn neopdf_pdf_load_lazy(pdf_name: *const c_char) -> *mut N
     let c_str = unsafe { CStr::from_ptr(pdf_name) };
     let pdf_name = c_str.to_str().expect("Invalid UTF-8 string");
 
-    if !pdf_name.ends_with(".neopdf.lz4") {
+    if !matches!(PdfSetFormat::from_set_name(pdf_name), PdfSetFormat::Neopdf) {
         return std::ptr::null_mut();
     }
 
@@ -172,6 +234,40 @@ pub unsafe extern "C" fn neopdf_pdf_load_lazy(pdf_name: *const c_char) -> *mut N
     Box::into_raw(Box::new(NeoPDFLazyIterator(boxed_iter)))
 }
 
+/// Loads a PDF set for lazy iteration, decoding the following members and building their
+/// interpolators on a background thread while the current one is processed.
+///
+/// At most `prefetch_depth` members are queued ahead of the consumer. This function is only
+/// supported for `.neopdf.lz4` and `.neopdf` files, and returns `NULL` otherwise. The caller
+/// is responsible for freeing the memory using `neopdf_lazy_iterator_free`.
+///
+/// # Panics
+///
+/// This function will panic if the provided C string is not valid UTF-8.
+///
+/// # Safety
+///
+/// The `pdf_name` C string must be null-terminated and valid UTF-8.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_pdf_load_lazy_prefetched(
+    pdf_name: *const c_char,
+    prefetch_depth: usize,
+    options: LoadOptions,
+) -> *mut NeoPDFLazyIterator {
+    let c_str = unsafe { CStr::from_ptr(pdf_name) };
+    let pdf_name = c_str.to_str().expect("Invalid UTF-8 string");
+
+    if !matches!(PdfSetFormat::from_set_name(pdf_name), PdfSetFormat::Neopdf) {
+        return std::ptr::null_mut();
+    }
+
+    let lazy_iter = PDF::load_pdfs_lazy_prefetched(pdf_name, prefetch_depth, options);
+    let boxed_iter: Box<dyn Iterator<Item = Result<PDF, Box<dyn std::error::Error>>>> =
+        Box::new(lazy_iter);
+
+    Box::into_raw(Box::new(NeoPDFLazyIterator(boxed_iter)))
+}
+
 /// Retrieves the next PDF member from the lazy iterator.
 ///
 /// Returns a pointer to a `NeoPDFWrapper` for the next member, or `NULL` if the
@@ -191,7 +287,7 @@ pub unsafe extern "C" fn neopdf_lazy_iterator_next(
     let iter_wrapper = unsafe { &mut (*iter).0 };
 
     match iter_wrapper.next() {
-        Some(Ok(pdf)) => Box::into_raw(Box::new(NeoPDFWrapper(pdf))),
+        Some(Ok(pdf)) => Box::into_raw(Box::new(NeoPDFWrapper(Arc::new(pdf)))),
         Some(Err(_)) | None => std::ptr::null_mut(),
     }
 }
@@ -209,6 +305,227 @@ pub unsafe extern "C" fn neopdf_lazy_iterator_free(iter: *mut NeoPDFLazyIterator
     }
 }
 
+/// Writes the list of the members held by the registry of the process, with their number
+/// of live handles and of resident bytes, as a null-terminated table into `buffer`.
+///
+/// At most `size` bytes, including the terminating null character, are written, such that
+/// the table is truncated if it does not fit. A null `buffer` can be given together with a
+/// `size` of zero to query the required size.
+///
+/// Returns the length of the complete table, excluding the terminating null character.
+///
+/// # Safety
+///
+/// The `buffer` pointer must be valid for writing `size` bytes, or `size` must be zero.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_registry_report(buffer: *mut c_char, size: usize) -> usize {
+    let report = registry::report().to_string();
+    if !buffer.is_null() && size > 0 {
+        let len = report.len().min(size - 1);
+        let buffer = unsafe { slice::from_raw_parts_mut(buffer.cast::<u8>(), size) };
+        buffer[..len].copy_from_slice(&report.as_bytes()[..len]);
+        buffer[len] = 0;
+    }
+    report.len()
+}
+
+/// Returns the number of bytes held by the members of the registry of the process.
+#[no_mangle]
+pub extern "C" fn neopdf_registry_resident_bytes() -> usize {
+    registry::report().resident_bytes()
+}
+
+/// Opaque pointer to a cache of the members of a PDF set.
+pub struct NeoPDFMemberCache(MemberCache);
+
+/// Creates a cache over the members of a PDF set, which decodes the members on demand and
+/// keeps the most recently used ones resident within `max_bytes`.
+///
+/// Returns a pointer to a `NeoPDFMemberCache`, or `NULL` if `pdf_name` is null. The caller
+/// is responsible for freeing the memory using `neopdf_cache_free`.
+///
+/// # Panics
+///
+/// This function will panic if the provided C string is not valid UTF-8.
+///
+/// # Safety
+///
+/// The `pdf_name` C string must be null-terminated and valid UTF-8.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_cache_new(
+    pdf_name: *const c_char,
+    max_bytes: usize,
+) -> *mut NeoPDFMemberCache {
+    unsafe { neopdf_cache_new_with_options(pdf_name, max_bytes, LoadOptions::default()) }
+}
+
+/// Creates a cache over the members of a PDF set, whose members are built according to
+/// `options`.
+///
+/// Returns `NULL` if `pdf_name` is null.
+///
+/// # Panics
+///
+/// This function will panic if the provided C string is not valid UTF-8.
+///
+/// # Safety
+///
+/// The `pdf_name` C string must be null-terminated and valid UTF-8.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_cache_new_with_options(
+    pdf_name: *const c_char,
+    max_bytes: usize,
+    options: LoadOptions,
+) -> *mut NeoPDFMemberCache {
+    if pdf_name.is_null() {
+        return std::ptr::null_mut();
+    }
+    let c_str = unsafe { CStr::from_ptr(pdf_name) };
+    let pdf_name = c_str.to_str().expect("Invalid UTF-8 string");
+    let cache = MemberCache::with_options(pdf_name, max_bytes, options);
+    Box::into_raw(Box::new(NeoPDFMemberCache(cache)))
+}
+
+/// Frees a cache of PDF members.
+///
+/// # Safety
+///
+/// The `cache` pointer must be a valid pointer to a `NeoPDFMemberCache` object previously
+/// allocated by `neopdf_cache_new` or `neopdf_cache_new_with_options`.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_cache_free(cache: *mut NeoPDFMemberCache) {
+    if !cache.is_null() {
+        unsafe { drop(Box::from_raw(cache)) };
+    }
+}
+
+/// Returns the number of members of the PDF set of a cache.
+///
+/// # Panics
+///
+/// This function will panic if the `cache` pointer is null.
+///
+/// # Safety
+///
+/// The `cache` pointer must be a valid pointer to a `NeoPDFMemberCache` object.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_cache_num_members(cache: *const NeoPDFMemberCache) -> usize {
+    assert!(!cache.is_null());
+    unsafe { (*cache).0.num_members() }
+}
+
+/// Interpolates the PDF values (xf) of a member of a cache for several flavors on a batch
+/// of `(x, Q2)` points, decoding the member if it is not resident.
+///
+/// The results are stored with the layout of `neopdf_pdf_xfxq2_batch`. The cache can be
+/// used concurrently from several threads. Returns `ErrorInvalidLength` if `member` is out
+/// of range.
+///
+/// # Panics
+///
+/// This function will panic if the `cache` pointer is null.
+///
+/// # Safety
+///
+/// The `cache` pointer must be a valid pointer to a `NeoPDFMemberCache` object. The `pids`
+/// pointer must be valid for reading `num_pids` elements, the `xs` and `q2s` pointers must
+/// be valid for reading `num_points` elements, and the `results` pointer must be valid for
+/// writing `num_pids * num_points` elements.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_cache_xfxq2_batch(
+    cache: *const NeoPDFMemberCache,
+    member: usize,
+    pids: *const i32,
+    num_pids: usize,
+    xs: *const c_double,
+    q2s: *const c_double,
+    num_points: usize,
+    results: *mut c_double,
+) -> NeopdfResult {
+    assert!(!cache.is_null());
+    if pids.is_null() || xs.is_null() || q2s.is_null() || results.is_null() {
+        return NeopdfResult::ErrorNullPointer;
+    }
+    let Some(num_results) = num_pids.checked_mul(num_points) else {
+        return NeopdfResult::ErrorInvalidLength;
+    };
+
+    let Some(pdf) = (unsafe { &(*cache).0 }).get(member) else {
+        return NeopdfResult::ErrorInvalidLength;
+    };
+    let pids = unsafe { slice::from_raw_parts(pids, num_pids) };
+    let xs = unsafe { slice::from_raw_parts(xs, num_points) };
+    let q2s = unsafe { slice::from_raw_parts(q2s, num_points) };
+    let results = unsafe { slice::from_raw_parts_mut(results, num_results) };
+
+    match pdf.xfxq2_batch(pids, xs, q2s, results) {
+        Ok(()) => NeopdfResult::Success,
+        Err(_) => NeopdfResult::ErrorInvalidData,
+    }
+}
+
+/// Computes the strong coupling `alpha_s` of a member of a cache at a given `Q2`,
+/// decoding the member if it is not resident.
+///
+/// Returns `ErrorInvalidLength` if `member` is out of range.
+///
+/// # Panics
+///
+/// This function will panic if the `cache` pointer is null.
+///
+/// # Safety
+///
+/// The `cache` pointer must be a valid pointer to a `NeoPDFMemberCache` object, and the
+/// `result` pointer must be valid for writing one element.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_cache_alphas_q2(
+    cache: *const NeoPDFMemberCache,
+    member: usize,
+    q2: f64,
+    result: *mut c_double,
+) -> NeopdfResult {
+    assert!(!cache.is_null());
+    if result.is_null() {
+        return NeopdfResult::ErrorNullPointer;
+    }
+
+    unsafe { (*cache).0.get(member) }.map_or(NeopdfResult::ErrorInvalidLength, |pdf| {
+        unsafe { *result = pdf.alphas_q2(q2) };
+        NeopdfResult::Success
+    })
+}
+
+/// Returns the hit, miss and eviction counters of a cache, together with its resident
+/// members and bytes.
+///
+/// # Panics
+///
+/// This function will panic if the `cache` pointer is null.
+///
+/// # Safety
+///
+/// The `cache` pointer must be a valid pointer to a `NeoPDFMemberCache` object.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_cache_statistics(cache: *const NeoPDFMemberCache) -> CacheStats {
+    assert!(!cache.is_null());
+    unsafe { (*cache).0.stats() }
+}
+
+/// Drops all the resident members of a cache, keeping its counters.
+///
+/// # Panics
+///
+/// This function will panic if the `cache` pointer is null.
+///
+/// # Safety
+///
+/// The `cache` pointer must be a valid pointer to a `NeoPDFMemberCache` object.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_cache_clear(cache: *const NeoPDFMemberCache) {
+    assert!(!cache.is_null());
+    unsafe { (*cache).0.clear() }
+}
+
 /// Retrieves the `x_min` for this PDF set.
 ///
 /// # Panics
@@ -317,47 +634,932 @@ pub unsafe extern "C" fn neopdf_pdf_xfxq2_nd(
     pdf_obj.xfxq2(id, params)
 }
 
-/// Interpolates PDF values for multiple points in parallel using Chebyshev batch interpolation.
+/// Interpolates the PDF value (xf) of a flavor at several values of the leading parameter
+/// of a generic set of parameters, e.g. at several nucleon numbers `A` for a fixed
+/// `(x, Q2)`, such that `results[i]` holds the value at `values[i]`.
+///
+/// The leading entry of `params` is ignored.
+///
+/// # Panics
+///
+/// This function will panic if the `pdf` pointer is null.
 ///
 /// # Safety
 ///
-/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object.
-/// The `points` pointer must be a valid pointer to an array of pointers to `c_double`.
-/// The `lengths` pointer must be a valid pointer to an array of `usize`.
-/// `num_points` must be the correct number of points.
-/// The `results` pointer must be valid for writing `num_points` elements.
+/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object. The `params` pointer
+/// must be valid for reading `num_params` elements, the `values` pointer must be valid for
+/// reading `num_values` elements and the `results` pointer must be valid for writing
+/// `num_values` elements.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_pdf_xfxq2_nd_scan(
+    pdf: *mut NeoPDFWrapper,
+    id: i32,
+    params: *const c_double,
+    num_params: usize,
+    values: *const c_double,
+    num_values: usize,
+    results: *mut c_double,
+) -> NeopdfResult {
+    assert!(!pdf.is_null());
+    if params.is_null() || values.is_null() || results.is_null() {
+        return NeopdfResult::ErrorNullPointer;
+    }
+
+    let pdf_obj = unsafe { &(*pdf).0 };
+    let params = unsafe { slice::from_raw_parts(params, num_params) };
+    let values = unsafe { slice::from_raw_parts(values, num_values) };
+    let results = unsafe { slice::from_raw_parts_mut(results, num_values) };
+
+    match pdf_obj.xfxq2_scan(id, params, values, results) {
+        Ok(()) => NeopdfResult::Success,
+        Err(_) => NeopdfResult::ErrorInvalidData,
+    }
+}
+
+/// Interpolates the PDF values (xf) for several flavors on a batch of `(x, Q2)` points.
+///
+/// The results are written into `results` in row-major order with shape
+/// `[num_pids, num_points]`, i.e. `results[i * num_points + j]` holds the value of
+/// `pids[i]` at `(xs[j], q2s[j])`. No memory is allocated for the outputs.
 ///
 /// # Panics
 ///
-/// TODO
+/// This function will panic if the `pdf` pointer is null.
+///
+/// # Safety
+///
+/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object. The `pids` pointer
+/// must be valid for reading `num_pids` elements, the `xs` and `q2s` pointers must be
+/// valid for reading `num_points` elements, and the `results` pointer must be valid for
+/// writing `num_pids * num_points` elements.
 #[no_mangle]
-pub unsafe extern "C" fn neopdf_pdf_xfxq2_cheby_batch(
+pub unsafe extern "C" fn neopdf_pdf_xfxq2_batch(
     pdf: *mut NeoPDFWrapper,
-    pid: i32,
-    points: *const *const c_double,
-    lengths: *const usize,
+    pids: *const i32,
+    num_pids: usize,
+    xs: *const c_double,
+    q2s: *const c_double,
     num_points: usize,
     results: *mut c_double,
-) {
+) -> NeopdfResult {
     assert!(!pdf.is_null());
+    if pids.is_null() || xs.is_null() || q2s.is_null() || results.is_null() {
+        return NeopdfResult::ErrorNullPointer;
+    }
+    let Some(num_results) = num_pids.checked_mul(num_points) else {
+        return NeopdfResult::ErrorInvalidLength;
+    };
+
     let pdf_obj = unsafe { &(*pdf).0 };
+    let pids = unsafe { slice::from_raw_parts(pids, num_pids) };
+    let xs = unsafe { slice::from_raw_parts(xs, num_points) };
+    let q2s = unsafe { slice::from_raw_parts(q2s, num_points) };
+    let results = unsafe { slice::from_raw_parts_mut(results, num_results) };
 
-    let points_slices: &[*const c_double] = unsafe { slice::from_raw_parts(points, num_points) };
-    let lengths_slice: &[usize] = unsafe { slice::from_raw_parts(lengths, num_points) };
+    match pdf_obj.xfxq2_batch(pids, xs, q2s, results) {
+        Ok(()) => NeopdfResult::Success,
+        Err(_) => NeopdfResult::ErrorInvalidData,
+    }
+}
 
-    let rust_points: Vec<&[f64]> = points_slices
-        .iter()
-        .zip(lengths_slice)
-        .map(|(&p, &l)| unsafe { slice::from_raw_parts(p, l) })
-        .collect();
+/// Interpolates the PDF values (xf) for several flavors on a batch of `(x, Q2)` points into
+/// a single-precision output buffer.
+///
+/// The values are computed in double precision and rounded as they are stored into
+/// `results`, with the layout of `neopdf_pdf_xfxq2_batch`.
+///
+/// # Panics
+///
+/// This function will panic if the `pdf` pointer is null.
+///
+/// # Safety
+///
+/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object. The `pids` pointer
+/// must be valid for reading `num_pids` elements, the `xs` and `q2s` pointers must be
+/// valid for reading `num_points` elements, and the `results` pointer must be valid for
+/// writing `num_pids * num_points` elements.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_pdf_xfxq2_batch_f32(
+    pdf: *mut NeoPDFWrapper,
+    pids: *const i32,
+    num_pids: usize,
+    xs: *const c_double,
+    q2s: *const c_double,
+    num_points: usize,
+    results: *mut c_float,
+) -> NeopdfResult {
+    assert!(!pdf.is_null());
+    if pids.is_null() || xs.is_null() || q2s.is_null() || results.is_null() {
+        return NeopdfResult::ErrorNullPointer;
+    }
+    let Some(num_results) = num_pids.checked_mul(num_points) else {
+        return NeopdfResult::ErrorInvalidLength;
+    };
+
+    let pdf_obj = unsafe { &(*pdf).0 };
+    let pids = unsafe { slice::from_raw_parts(pids, num_pids) };
+    let xs = unsafe { slice::from_raw_parts(xs, num_points) };
+    let q2s = unsafe { slice::from_raw_parts(q2s, num_points) };
+    let results = unsafe { slice::from_raw_parts_mut(results, num_results) };
+
+    match pdf_obj.xfxq2_batch_f32(pids, xs, q2s, results) {
+        Ok(()) => NeopdfResult::Success,
+        Err(_) => NeopdfResult::ErrorInvalidData,
+    }
+}
+
+/// Interpolates the PDF values (xf) for several flavors on the tensor product of a list of
+/// momentum fractions and a list of energy scales.
+///
+/// The results are written into `results` in row-major order with shape
+/// `[num_pids, num_xs, num_q2s]`, i.e. `results[(i * num_xs + j) * num_q2s + k]` holds the
+/// value of `pids[i]` at `(xs[j], q2s[k])`.
+///
+/// # Panics
+///
+/// This function will panic if the `pdf` pointer is null.
+///
+/// # Safety
+///
+/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object. The `pids`, `xs` and
+/// `q2s` pointers must be valid for reading `num_pids`, `num_xs` and `num_q2s` elements
+/// respectively, and the `results` pointer must be valid for writing
+/// `num_pids * num_xs * num_q2s` elements.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_pdf_xfxq2_grid(
+    pdf: *mut NeoPDFWrapper,
+    pids: *const i32,
+    num_pids: usize,
+    xs: *const c_double,
+    num_xs: usize,
+    q2s: *const c_double,
+    num_q2s: usize,
+    results: *mut c_double,
+) -> NeopdfResult {
+    assert!(!pdf.is_null());
+    if pids.is_null() || xs.is_null() || q2s.is_null() || results.is_null() {
+        return NeopdfResult::ErrorNullPointer;
+    }
+    let Some(num_results) = num_pids
+        .checked_mul(num_xs)
+        .and_then(|n| n.checked_mul(num_q2s))
+    else {
+        return NeopdfResult::ErrorInvalidLength;
+    };
+
+    let pdf_obj = unsafe { &(*pdf).0 };
+    let pids = unsafe { slice::from_raw_parts(pids, num_pids) };
+    let xs = unsafe { slice::from_raw_parts(xs, num_xs) };
+    let q2s = unsafe { slice::from_raw_parts(q2s, num_q2s) };
+    let results = unsafe { slice::from_raw_parts_mut(results, num_results) };
+
+    match pdf_obj.xfxq2_grid(pids, xs, q2s, results) {
+        Ok(()) => NeopdfResult::Success,
+        Err(_) => NeopdfResult::ErrorInvalidData,
+    }
+}
+
+/// Interpolates the PDF values (xf) for several flavors at a fixed momentum fraction and
+/// several energy scales, together with `alpha_s` at these scales.
+///
+/// The results are written into `results` in row-major order with shape
+/// `[num_pids, num_q2s]`, i.e. `results[i * num_q2s + k]` holds the value of `pids[i]` at
+/// `(x, q2s[k])`, and `alphas[k]` holds the value of `alpha_s` at `q2s[k]`.
+///
+/// # Panics
+///
+/// This function will panic if the `pdf` pointer is null.
+///
+/// # Safety
+///
+/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object. The `pids` and `q2s`
+/// pointers must be valid for reading `num_pids` and `num_q2s` elements respectively, the
+/// `results` pointer must be valid for writing `num_pids * num_q2s` elements and the
+/// `alphas` pointer must be valid for writing `num_q2s` elements.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_pdf_xfxq2_fixed_x(
+    pdf: *mut NeoPDFWrapper,
+    pids: *const i32,
+    num_pids: usize,
+    x: c_double,
+    q2s: *const c_double,
+    num_q2s: usize,
+    results: *mut c_double,
+    alphas: *mut c_double,
+) -> NeopdfResult {
+    assert!(!pdf.is_null());
+    if pids.is_null() || q2s.is_null() || results.is_null() || alphas.is_null() {
+        return NeopdfResult::ErrorNullPointer;
+    }
+    let Some(num_results) = num_pids.checked_mul(num_q2s) else {
+        return NeopdfResult::ErrorInvalidLength;
+    };
+
+    let pdf_obj = unsafe { &(*pdf).0 };
+    let pids = unsafe { slice::from_raw_parts(pids, num_pids) };
+    let q2s = unsafe { slice::from_raw_parts(q2s, num_q2s) };
+    let results = unsafe { slice::from_raw_parts_mut(results, num_results) };
+    let alphas = unsafe { slice::from_raw_parts_mut(alphas, num_q2s) };
+
+    match pdf_obj.xfxq2_fixed_x(pids, x, q2s, results, alphas) {
+        Ok(()) => NeopdfResult::Success,
+        Err(_) => NeopdfResult::ErrorInvalidData,
+    }
+}
+
+/// Interpolates the PDF values (xf) for several flavors at several momentum fractions and a
+/// fixed energy scale, together with `alpha_s` at this scale.
+///
+/// The results are written into `results` in row-major order with shape
+/// `[num_pids, num_xs]`, i.e. `results[i * num_xs + j]` holds the value of `pids[i]` at
+/// `(xs[j], q2)`. The value of `alpha_s` at `q2` is written into `alphas` if it is not
+/// null.
+///
+/// # Panics
+///
+/// This function will panic if the `pdf` pointer is null.
+///
+/// # Safety
+///
+/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object. The `pids` and `xs`
+/// pointers must be valid for reading `num_pids` and `num_xs` elements respectively, the
+/// `results` pointer must be valid for writing `num_pids * num_xs` elements and the
+/// `alphas` pointer must either be null or valid for writing one element.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_pdf_xfxq2_fixed_q2(
+    pdf: *mut NeoPDFWrapper,
+    pids: *const i32,
+    num_pids: usize,
+    xs: *const c_double,
+    num_xs: usize,
+    q2: c_double,
+    results: *mut c_double,
+    alphas: *mut c_double,
+) -> NeopdfResult {
+    assert!(!pdf.is_null());
+    if pids.is_null() || xs.is_null() || results.is_null() {
+        return NeopdfResult::ErrorNullPointer;
+    }
+    let Some(num_results) = num_pids.checked_mul(num_xs) else {
+        return NeopdfResult::ErrorInvalidLength;
+    };
+
+    let pdf_obj = unsafe { &(*pdf).0 };
+    let pids = unsafe { slice::from_raw_parts(pids, num_pids) };
+    let xs = unsafe { slice::from_raw_parts(xs, num_xs) };
+    let results = unsafe { slice::from_raw_parts_mut(results, num_results) };
+
+    match pdf_obj.xfxq2_fixed_q2(pids, xs, q2, results) {
+        Ok(value) => {
+            if !alphas.is_null() {
+                unsafe { *alphas = value };
+            }
+            NeopdfResult::Success
+        }
+        Err(_) => NeopdfResult::ErrorInvalidData,
+    }
+}
+
+/// Opaque pointer to a stack of PDF members evaluated at once.
+pub struct NeoPDFMemberStack(MemberStack);
+
+/// Stacks the knot values of several members of a PDF set to evaluate them at once.
+///
+/// Returns a pointer to a `NeoPDFMemberStack`, or `NULL` if the members do not share their
+/// knots or if their interpolation method is not supported. The caller is responsible for
+/// freeing the memory using `neopdf_member_stack_free`.
+///
+/// # Safety
+///
+/// The `pdfs` pointer must be valid for reading `num_pdfs` valid pointers to `NeoPDF`
+/// objects, e.g. the `pdfs` field of a `NeoPDFMembers`.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_member_stack_new(
+    pdfs: *const *mut NeoPDFWrapper,
+    num_pdfs: usize,
+) -> *mut NeoPDFMemberStack {
+    if pdfs.is_null() || num_pdfs == 0 {
+        return std::ptr::null_mut();
+    }
+    let pdfs = unsafe { slice::from_raw_parts(pdfs, num_pdfs) };
+    if pdfs.iter().any(|pdf| pdf.is_null()) {
+        return std::ptr::null_mut();
+    }
+
+    match MemberStack::new(pdfs.iter().map(|&pdf| unsafe { &*(*pdf).0 })) {
+        Ok(stack) => Box::into_raw(Box::new(NeoPDFMemberStack(stack))),
+        Err(_) => std::ptr::null_mut(),
+    }
+}
+
+/// Frees a stack of PDF members.
+///
+/// # Safety
+///
+/// The `stack` pointer must be a valid pointer to a `NeoPDFMemberStack` object
+/// previously allocated by `neopdf_member_stack_new`.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_member_stack_free(stack: *mut NeoPDFMemberStack) {
+    if !stack.is_null() {
+        unsafe { drop(Box::from_raw(stack)) };
+    }
+}
+
+/// Returns the number of members of a stack.
+///
+/// # Panics
+///
+/// This function will panic if the `stack` pointer is null.
+///
+/// # Safety
+///
+/// The `stack` pointer must be a valid pointer to a `NeoPDFMemberStack` object.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_member_stack_size(stack: *const NeoPDFMemberStack) -> usize {
+    assert!(!stack.is_null());
+    unsafe { (*stack).0.len() }
+}
+
+/// Interpolates the PDF values (xf) of a flavor on a batch of `(x, Q2)` points for all the
+/// members of a stack.
+///
+/// The results are written into `results` in row-major order with shape
+/// `[num_points, num_members]`, i.e. `results[j * num_members + m]` holds the value of the
+/// member `m` at `(xs[j], q2s[j])`, where `num_members` is given by
+/// `neopdf_member_stack_size`.
+///
+/// # Panics
+///
+/// This function will panic if the `stack` pointer is null.
+///
+/// # Safety
+///
+/// The `stack` pointer must be a valid pointer to a `NeoPDFMemberStack` object. The `xs`
+/// and `q2s` pointers must be valid for reading `num_points` elements, and the `results`
+/// pointer must be valid for writing `num_points * num_members` elements.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_member_stack_xfxq2_batch(
+    stack: *const NeoPDFMemberStack,
+    pid: i32,
+    xs: *const c_double,
+    q2s: *const c_double,
+    num_points: usize,
+    results: *mut c_double,
+) -> NeopdfResult {
+    assert!(!stack.is_null());
+    if xs.is_null() || q2s.is_null() || results.is_null() {
+        return NeopdfResult::ErrorNullPointer;
+    }
+    let stack = unsafe { &(*stack).0 };
+    let Some(num_results) = num_points.checked_mul(stack.len()) else {
+        return NeopdfResult::ErrorInvalidLength;
+    };
+
+    let xs = unsafe { slice::from_raw_parts(xs, num_points) };
+    let q2s = unsafe { slice::from_raw_parts(q2s, num_points) };
+    let results = unsafe { slice::from_raw_parts_mut(results, num_results) };
+
+    match stack.xfxq2_batch(pid, xs, q2s, results) {
+        Ok(()) => NeopdfResult::Success,
+        Err(_) => NeopdfResult::ErrorInvalidData,
+    }
+}
+
+/// Computes the central values and the uncertainties of a flavor on a batch of `(x, Q2)`
+/// points from the members of a stack, according to the `ErrorType` of the set.
+///
+/// The points are processed in parallel, and the members are combined as they are
+/// interpolated without storing their values.
+///
+/// # Panics
+///
+/// This function will panic if the `stack` pointer is null.
+///
+/// # Safety
+///
+/// The `stack` pointer must be a valid pointer to a `NeoPDFMemberStack` object. The `xs`,
+/// `q2s` and `results` pointers must be valid for reading, respectively writing,
+/// `num_points` elements.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_member_stack_uncertainty_batch(
+    stack: *const NeoPDFMemberStack,
+    pid: i32,
+    xs: *const c_double,
+    q2s: *const c_double,
+    num_points: usize,
+    results: *mut PDFUncertainty,
+) -> NeopdfResult {
+    assert!(!stack.is_null());
+    if xs.is_null() || q2s.is_null() || results.is_null() {
+        return NeopdfResult::ErrorNullPointer;
+    }
+
+    let stack = unsafe { &(*stack).0 };
+    let xs = unsafe { slice::from_raw_parts(xs, num_points) };
+    let q2s = unsafe { slice::from_raw_parts(q2s, num_points) };
+    let results = unsafe { slice::from_raw_parts_mut(results, num_points) };
+
+    match stack.uncertainty_batch(pid, xs, q2s, results) {
+        Ok(()) => NeopdfResult::Success,
+        Err(_) => NeopdfResult::ErrorInvalidData,
+    }
+}
+
+/// Computes the central values and the uncertainties of a flavor on the grid of points
+/// spanned by `xs` and `q2s` from the members of a stack.
+///
+/// The results are written into `results` in row-major order with shape `[num_xs, num_q2s]`,
+/// i.e. `results[i * num_q2s + j]` holds the result at `(xs[i], q2s[j])`.
+///
+/// # Panics
+///
+/// This function will panic if the `stack` pointer is null.
+///
+/// # Safety
+///
+/// The `stack` pointer must be a valid pointer to a `NeoPDFMemberStack` object. The `xs`
+/// and `q2s` pointers must be valid for reading `num_xs` and `num_q2s` elements, and the
+/// `results` pointer must be valid for writing `num_xs * num_q2s` elements.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_member_stack_uncertainty_grid(
+    stack: *const NeoPDFMemberStack,
+    pid: i32,
+    xs: *const c_double,
+    num_xs: usize,
+    q2s: *const c_double,
+    num_q2s: usize,
+    results: *mut PDFUncertainty,
+) -> NeopdfResult {
+    assert!(!stack.is_null());
+    if xs.is_null() || q2s.is_null() || results.is_null() {
+        return NeopdfResult::ErrorNullPointer;
+    }
+    let Some(num_results) = num_xs.checked_mul(num_q2s) else {
+        return NeopdfResult::ErrorInvalidLength;
+    };
+
+    let stack = unsafe { &(*stack).0 };
+    let xs = unsafe { slice::from_raw_parts(xs, num_xs) };
+    let q2s = unsafe { slice::from_raw_parts(q2s, num_q2s) };
+    let results = unsafe { slice::from_raw_parts_mut(results, num_results) };
+
+    match stack.uncertainty_grid(pid, xs, q2s, results) {
+        Ok(()) => NeopdfResult::Success,
+        Err(_) => NeopdfResult::ErrorInvalidData,
+    }
+}
+
+/// Interpolates PDF values for multiple points in parallel using Chebyshev batch interpolation.
+///
+/// # Safety
+///
+/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object.
+/// The `points` pointer must be a valid pointer to an array of pointers to `c_double`.
+/// The `lengths` pointer must be a valid pointer to an array of `usize`.
+/// `num_points` must be the correct number of points.
+/// The `results` pointer must be valid for writing `num_points` elements.
+///
+/// # Panics
+///
+/// TODO
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_pdf_xfxq2_cheby_batch(
+    pdf: *mut NeoPDFWrapper,
+    pid: i32,
+    points: *const *const c_double,
+    lengths: *const usize,
+    num_points: usize,
+    results: *mut c_double,
+) {
+    assert!(!pdf.is_null());
+    let pdf_obj = unsafe { &(*pdf).0 };
+
+    let points_slices: &[*const c_double] = unsafe { slice::from_raw_parts(points, num_points) };
+    let lengths_slice: &[usize] = unsafe { slice::from_raw_parts(lengths, num_points) };
+
+    let rust_points: Vec<&[f64]> = points_slices
+        .iter()
+        .zip(lengths_slice)
+        .map(|(&p, &l)| unsafe { slice::from_raw_parts(p, l) })
+        .collect();
+
+    let res_vec = pdf_obj.xfxq2_cheby_batch(pid, &rust_points);
+
+    let results_slice = unsafe { slice::from_raw_parts_mut(results, res_vec.len()) };
+    results_slice.copy_from_slice(&res_vec);
+}
+
+/// Task of a batch evaluation, to be called by a `NeoPDFExecutor` for every task index.
+pub type NeopdfTask = unsafe extern "C" fn(task_context: *mut c_void, index: usize);
+
+/// Executor supplied by the caller to run the chunks of a batch evaluation on its own
+/// threads, e.g. with a TBB `parallel_for`, instead of on the internal thread pool.
+#[repr(C)]
+pub struct NeoPDFExecutor {
+    /// Opaque context forwarded to `run`.
+    pub context: *mut c_void,
+    /// Calls `task(task_context, i)` once for every `i` in `0..num_tasks` and returns once
+    /// all the calls have completed. The calls may run concurrently and in any order.
+    pub run: Option<
+        unsafe extern "C" fn(
+            context: *mut c_void,
+            num_tasks: usize,
+            task: NeopdfTask,
+            task_context: *mut c_void,
+        ),
+    >,
+}
+
+/// A `NeoPDFExecutor` provided by the caller, which is only used from the calling thread.
+struct ForeignExecutor {
+    context: *mut c_void,
+    run: unsafe extern "C" fn(*mut c_void, usize, NeopdfTask, *mut c_void),
+}
+
+// SAFETY: the executor is only invoked from the thread which received it, for the duration
+// of the batch function it was passed to; the tasks it runs only share `Sync` data.
+unsafe impl Sync for ForeignExecutor {}
+
+impl BatchExecutor for ForeignExecutor {
+    fn execute(&self, num_tasks: usize, task: &(dyn Fn(usize) + Sync)) {
+        unsafe extern "C" fn call_task(task_context: *mut c_void, index: usize) {
+            let task = unsafe { &*task_context.cast::<&(dyn Fn(usize) + Sync)>() };
+            task(index);
+        }
+
+        let task_context = std::ptr::addr_of!(task).cast_mut().cast::<c_void>();
+        unsafe { (self.run)(self.context, num_tasks, call_task, task_context) };
+    }
+}
+
+/// The thread pool set by `neopdf_set_num_threads`, or `None` for the global rayon pool.
+static BATCH_EXECUTOR: RwLock<Option<RayonExecutor>> = RwLock::new(None);
+
+/// Calls `f` with the executor requested by the caller of a batch function.
+///
+/// # Safety
+///
+/// The `executor` pointer must be null or a valid pointer to a `NeoPDFExecutor`.
+unsafe fn with_executor<R>(
+    executor: *const NeoPDFExecutor,
+    f: impl FnOnce(&dyn BatchExecutor) -> R,
+) -> R {
+    if let Some(NeoPDFExecutor {
+        context,
+        run: Some(run),
+    }) = unsafe { executor.as_ref() }
+    {
+        return f(&ForeignExecutor {
+            context: *context,
+            run: *run,
+        });
+    }
+
+    let pool = BATCH_EXECUTOR
+        .read()
+        .unwrap_or_else(PoisonError::into_inner)
+        .clone();
+    f(&pool.unwrap_or_default())
+}
+
+/// Sets the number of threads used by the batch functions which are not given an executor.
+///
+/// A value of zero restores the default, i.e. the global thread pool whose size is set by
+/// the `RAYON_NUM_THREADS` environment variable or the number of CPUs.
+///
+/// # Returns
+///
+/// `NeopdfResult::Success` on success, or `NeopdfResult::ErrorMemoryError` if the threads
+/// cannot be spawned.
+#[no_mangle]
+pub extern "C" fn neopdf_set_num_threads(num_threads: usize) -> NeopdfResult {
+    let executor = match num_threads {
+        0 => None,
+        n => match RayonExecutor::with_threads(n) {
+            Ok(executor) => Some(executor),
+            Err(_) => return NeopdfResult::ErrorMemoryError,
+        },
+    };
+    *BATCH_EXECUTOR
+        .write()
+        .unwrap_or_else(PoisonError::into_inner) = executor;
+
+    NeopdfResult::Success
+}
+
+/// Converts the C arrays describing a list of points into slices.
+///
+/// # Safety
+///
+/// The `points` and `lengths` pointers must be valid for reading `num_points` elements, and
+/// each `points[i]` must be valid for reading `lengths[i]` elements.
+unsafe fn points_from_raw<'a>(
+    points: *const *const c_double,
+    lengths: *const usize,
+    num_points: usize,
+) -> Option<Vec<&'a [f64]>> {
+    if num_points == 0 {
+        return Some(Vec::new());
+    }
+    if points.is_null() || lengths.is_null() {
+        return None;
+    }
+
+    let points = unsafe { slice::from_raw_parts(points, num_points) };
+    let lengths = unsafe { slice::from_raw_parts(lengths, num_points) };
+
+    points
+        .iter()
+        .zip(lengths)
+        .map(|(&p, &l)| (!p.is_null()).then(|| unsafe { slice::from_raw_parts(p, l) }))
+        .collect()
+}
+
+/// Interpolates the PDF values for several flavors and points, with a status per value.
+///
+/// The results are written into `results` in row-major order with shape
+/// `[num_pids, num_points]`, i.e. `results[i * num_points + j]` holds the value of `pids[i]`
+/// at `points[j]`. A value which cannot be computed is set to `NaN` and the reason is recorded
+/// in the corresponding entry of `status`, without interrupting the batch.
+///
+/// The values are computed in chunks by `executor`, or on the internal thread pool (see
+/// `neopdf_set_num_threads`) if `executor` is null.
+///
+/// # Returns
+///
+/// `NeopdfResult::Success` if all the values were computed, `NeopdfResult::ErrorPointFailure`
+/// if some of them failed as recorded in `status`, or an error if the arguments are invalid.
+///
+/// # Panics
+///
+/// This function will panic if the `pdf` pointer is null.
+///
+/// # Safety
+///
+/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object. The `pids` pointer must be
+/// valid for reading `num_pids` elements, the `points` and `lengths` pointers must be valid for
+/// reading `num_points` elements, with each `points[i]` valid for reading `lengths[i]`
+/// elements, and the `results` and `status` pointers must be valid for writing
+/// `num_pids * num_points` elements. The `executor` pointer must be null or a valid pointer
+/// to a `NeoPDFExecutor`, whose `run` function must not unwind.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_pdf_xfxq2s(
+    pdf: *mut NeoPDFWrapper,
+    pids: *const i32,
+    num_pids: usize,
+    points: *const *const c_double,
+    lengths: *const usize,
+    num_points: usize,
+    executor: *const NeoPDFExecutor,
+    results: *mut c_double,
+    status: *mut PointStatus,
+) -> NeopdfResult {
+    assert!(!pdf.is_null());
+    let Some(num_results) = num_pids.checked_mul(num_points) else {
+        return NeopdfResult::ErrorInvalidLength;
+    };
+    if num_results == 0 {
+        return NeopdfResult::Success;
+    }
+    if pids.is_null() || results.is_null() || status.is_null() {
+        return NeopdfResult::ErrorNullPointer;
+    }
+    let Some(points) = (unsafe { points_from_raw(points, lengths, num_points) }) else {
+        return NeopdfResult::ErrorNullPointer;
+    };
+
+    let pdf_obj = unsafe { &(*pdf).0 };
+    let pids = unsafe { slice::from_raw_parts(pids, num_pids) };
+    let results = unsafe { slice::from_raw_parts_mut(results, num_results) };
+    let status = unsafe { slice::from_raw_parts_mut(status, num_results) };
+
+    let outcome = unsafe {
+        with_executor(executor, |executor| {
+            pdf_obj.xfxq2s_into(pids, &points, results, status, executor)
+        })
+    };
+    match outcome {
+        Ok(()) if status.iter().all(|&s| s == PointStatus::Success) => NeopdfResult::Success,
+        Ok(()) => NeopdfResult::ErrorPointFailure,
+        Err(_) => NeopdfResult::ErrorInvalidData,
+    }
+}
+
+/// Interpolates PDF values for multiple points using Chebyshev batch interpolation, with a
+/// status per value.
+///
+/// A value which cannot be computed is set to `NaN` and the reason is recorded in the
+/// corresponding entry of `status`, without interrupting the batch. The values are computed
+/// in chunks by `executor`, or on the internal thread pool (see `neopdf_set_num_threads`) if
+/// `executor` is null.
+///
+/// # Returns
+///
+/// `NeopdfResult::Success` if all the values were computed, `NeopdfResult::ErrorPointFailure`
+/// if some of them failed as recorded in `status`, `NeopdfResult::ErrorInvalidData` if the
+/// set is not interpolated with `LogChebyshev` or the flavor is not part of the grid, or an
+/// error if the arguments are invalid.
+///
+/// # Panics
+///
+/// This function will panic if the `pdf` pointer is null.
+///
+/// # Safety
+///
+/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object. The `points` and `lengths`
+/// pointers must be valid for reading `num_points` elements, with each `points[i]` valid for
+/// reading `lengths[i]` elements, and the `results` and `status` pointers must be valid for
+/// writing `num_points` elements. The `executor` pointer must be null or a valid pointer to a
+/// `NeoPDFExecutor`, whose `run` function must not unwind.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_pdf_xfxq2_cheby_batch_into(
+    pdf: *mut NeoPDFWrapper,
+    pid: i32,
+    points: *const *const c_double,
+    lengths: *const usize,
+    num_points: usize,
+    executor: *const NeoPDFExecutor,
+    results: *mut c_double,
+    status: *mut PointStatus,
+) -> NeopdfResult {
+    assert!(!pdf.is_null());
+    if num_points == 0 {
+        return NeopdfResult::Success;
+    }
+    if results.is_null() || status.is_null() {
+        return NeopdfResult::ErrorNullPointer;
+    }
+    let Some(points) = (unsafe { points_from_raw(points, lengths, num_points) }) else {
+        return NeopdfResult::ErrorNullPointer;
+    };
+
+    let pdf_obj = unsafe { &(*pdf).0 };
+    let results = unsafe { slice::from_raw_parts_mut(results, num_points) };
+    let status = unsafe { slice::from_raw_parts_mut(status, num_points) };
+
+    let outcome = unsafe {
+        with_executor(executor, |executor| {
+            pdf_obj.xfxq2_cheby_batch_into(pid, &points, results, status, executor)
+        })
+    };
+    match outcome {
+        Ok(()) if status.iter().all(|&s| s == PointStatus::Success) => NeopdfResult::Success,
+        Ok(()) => NeopdfResult::ErrorPointFailure,
+        Err(_) => NeopdfResult::ErrorInvalidData,
+    }
+}
+
+/// Clip the interpolated values if they turned out negatives.
+///
+/// # Panics
+///
+/// This function will panic if the `pdf` pointer is null.
+///
+/// # Safety
+///
+/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_pdf_set_force_positive(
+    pdf: *mut NeoPDFWrapper,
+    option: ForcePositive,
+) {
+    assert!(!pdf.is_null());
+    let pdf_obj = unsafe { Arc::make_mut(&mut (*pdf).0) };
+
+    pdf_obj.set_force_positive(option);
+}
+
+/// Clip the interpolated values if they turned out negatives for all members.
+///
+/// # Panics
+///
+/// This function will panic if the `pdfs` pointer is null.
+///
+/// # Safety
+///
+/// The `pdfs` pointer must be a valid pointer to a `NeoPDFMembers` object.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_pdf_set_force_positive_members(
+    pdfs: *mut NeoPDFMembers,
+    option: ForcePositive,
+) {
+    assert!(!pdfs.is_null());
+    let members = unsafe { &mut *pdfs };
+    let pdf_slice = unsafe { slice::from_raw_parts_mut(members.pdfs, members.size) };
+
+    for pdf_ptr in pdf_slice {
+        let pdf_obj = unsafe { Arc::make_mut(&mut (**pdf_ptr).0) };
+        pdf_obj.set_force_positive(option.clone());
+    }
+}
+
+/// Returns the value of `ForcePositive` defining the PDF grid.
+///
+/// # Panics
+///
+/// This function will panic if the `pdf` pointer is null.
+///
+/// # Safety
+///
+/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_pdf_is_force_positive(pdf: *mut NeoPDFWrapper) -> ForcePositive {
+    assert!(!pdf.is_null());
+    let pdf_obj = unsafe { &(*pdf).0 };
+
+    pdf_obj.is_force_positive().clone()
+}
+
+/// Enables or disables the recording of the evaluations of a PDF member in its counters.
+///
+/// The counters are shared by all the handles to the same member.
+///
+/// # Panics
+///
+/// This function will panic if the `pdf` pointer is null.
+///
+/// # Safety
+///
+/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_pdf_enable_stats(pdf: *mut NeoPDFWrapper, enabled: bool) {
+    assert!(!pdf.is_null());
+    let pdf_obj = unsafe { &(*pdf).0 };
+
+    pdf_obj.enable_stats(enabled);
+}
+
+/// Returns the counters of the load and of the recorded evaluations of a PDF member,
+/// aggregated over all the threads.
+///
+/// # Panics
+///
+/// This function will panic if the `pdf` pointer is null.
+///
+/// # Safety
+///
+/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_pdf_statistics(pdf: *mut NeoPDFWrapper) -> EvalStatistics {
+    assert!(!pdf.is_null());
+    let pdf_obj = unsafe { &(*pdf).0 };
+
+    pdf_obj.stats()
+}
+
+/// Resets the counters of a PDF member to zero.
+///
+/// # Panics
+///
+/// This function will panic if the `pdf` pointer is null.
+///
+/// # Safety
+///
+/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_pdf_reset_stats(pdf: *mut NeoPDFWrapper) {
+    assert!(!pdf.is_null());
+    let pdf_obj = unsafe { &(*pdf).0 };
+
+    pdf_obj.reset_stats();
+}
+
+/// Builds the interpolators of the given flavors of a PDF member ahead of the evaluations,
+/// which are otherwise built on their first use.
+///
+/// # Panics
+///
+/// This function will panic if the `pdf` pointer is null.
+///
+/// # Safety
+///
+/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object, and the `pids` pointer
+/// must be valid for reading `num_pids` elements.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_pdf_warmup(
+    pdf: *mut NeoPDFWrapper,
+    pids: *const i32,
+    num_pids: usize,
+) -> NeopdfResult {
+    assert!(!pdf.is_null());
+    if pids.is_null() && num_pids > 0 {
+        return NeopdfResult::ErrorNullPointer;
+    }
 
-    let res_vec = pdf_obj.xfxq2_cheby_batch(pid, &rust_points);
+    let pdf_obj = unsafe { &(*pdf).0 };
+    let pids = if num_pids == 0 {
+        &[]
+    } else {
+        unsafe { slice::from_raw_parts(pids, num_pids) }
+    };
 
-    let results_slice = unsafe { slice::from_raw_parts_mut(results, res_vec.len()) };
-    results_slice.copy_from_slice(&res_vec);
+    match pdf_obj.warmup(pids) {
+        Ok(()) => NeopdfResult::Success,
+        Err(_) => NeopdfResult::ErrorInvalidData,
+    }
 }
 
-/// Clip the interpolated values if they turned out negatives.
+/// Computes the `alpha_s` value at a given Q2.
 ///
 /// # Panics
 ///
@@ -367,41 +1569,47 @@ pub unsafe extern "C" fn neopdf_pdf_xfxq2_cheby_batch(
 ///
 /// The `pdf` pointer must be a valid pointer to a `NeoPDF` object.
 #[no_mangle]
-pub unsafe extern "C" fn neopdf_pdf_set_force_positive(
-    pdf: *mut NeoPDFWrapper,
-    option: ForcePositive,
-) {
+pub unsafe extern "C" fn neopdf_pdf_alphas_q2(pdf: *mut NeoPDFWrapper, q2: f64) -> f64 {
     assert!(!pdf.is_null());
-    let pdf_obj = unsafe { &mut (*pdf).0 };
-
-    pdf_obj.set_force_positive(option);
+    let pdf_obj = unsafe { &(*pdf).0 };
+    pdf_obj.alphas_q2(q2)
 }
 
-/// Clip the interpolated values if they turned out negatives for all members.
+/// Computes the `alpha_s` values at several values of Q2, such that `results[i]` holds the
+/// value at `q2s[i]`.
 ///
 /// # Panics
 ///
-/// This function will panic if the `pdfs` pointer is null.
+/// This function will panic if the `pdf` pointer is null.
 ///
 /// # Safety
 ///
-/// The `pdfs` pointer must be a valid pointer to a `NeoPDFMembers` object.
+/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object. The `q2s` pointer must
+/// be valid for reading `num_points` elements and the `results` pointer must be valid for
+/// writing `num_points` elements.
 #[no_mangle]
-pub unsafe extern "C" fn neopdf_pdf_set_force_positive_members(
-    pdfs: *mut NeoPDFMembers,
-    option: ForcePositive,
-) {
-    assert!(!pdfs.is_null());
-    let members = unsafe { &mut *pdfs };
-    let pdf_slice = unsafe { slice::from_raw_parts_mut(members.pdfs, members.size) };
+pub unsafe extern "C" fn neopdf_pdf_alphas_q2_batch(
+    pdf: *mut NeoPDFWrapper,
+    q2s: *const c_double,
+    num_points: usize,
+    results: *mut c_double,
+) -> NeopdfResult {
+    assert!(!pdf.is_null());
+    if q2s.is_null() || results.is_null() {
+        return NeopdfResult::ErrorNullPointer;
+    }
 
-    for pdf_ptr in pdf_slice {
-        let pdf_obj = unsafe { &mut (**pdf_ptr).0 };
-        pdf_obj.set_force_positive(option.clone());
+    let pdf_obj = unsafe { &(*pdf).0 };
+    let q2s = unsafe { slice::from_raw_parts(q2s, num_points) };
+    let results = unsafe { slice::from_raw_parts_mut(results, num_points) };
+
+    match pdf_obj.alphas_q2_batch(q2s, results) {
+        Ok(()) => NeopdfResult::Success,
+        Err(_) => NeopdfResult::ErrorInvalidData,
     }
 }
 
-/// Returns the value of `ForcePositive` defining the PDF grid.
+/// Returns the number of PIDs.
 ///
 /// # Panics
 ///
@@ -411,14 +1619,13 @@ pub unsafe extern "C" fn neopdf_pdf_set_force_positive_members(
 ///
 /// The `pdf` pointer must be a valid pointer to a `NeoPDF` object.
 #[no_mangle]
-pub unsafe extern "C" fn neopdf_pdf_is_force_positive(pdf: *mut NeoPDFWrapper) -> ForcePositive {
+pub unsafe extern "C" fn neopdf_pdf_num_pids(pdf: *mut NeoPDFWrapper) -> usize {
     assert!(!pdf.is_null());
-    let pdf_obj = unsafe { &mut (*pdf).0 };
-
-    pdf_obj.is_force_positive().clone()
+    let pdf_obj = unsafe { &(*pdf).0 };
+    pdf_obj.pids().len()
 }
 
-/// Computes the `alpha_s` value at a given Q2.
+/// Returns the PID representation of the PDF Grid.
 ///
 /// # Panics
 ///
@@ -426,15 +1633,23 @@ pub unsafe extern "C" fn neopdf_pdf_is_force_positive(pdf: *mut NeoPDFWrapper) -
 ///
 /// # Safety
 ///
-/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object.
+/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object, and the `pids` pointer
+/// must be valid for writing `num_pids` elements.
 #[no_mangle]
-pub unsafe extern "C" fn neopdf_pdf_alphas_q2(pdf: *mut NeoPDFWrapper, q2: f64) -> f64 {
+pub unsafe extern "C" fn neopdf_pdf_pids(pdf: *mut NeoPDFWrapper, pids: *mut i32, num_pids: usize) {
     assert!(!pdf.is_null());
     let pdf_obj = unsafe { &(*pdf).0 };
-    pdf_obj.alphas_q2(q2)
+
+    let pids = unsafe { slice::from_raw_parts_mut(pids, num_pids) };
+    let pid_values = pdf_obj.pids();
+
+    pids.copy_from_slice(pid_values.as_slice().unwrap());
 }
 
-/// Returns the number of PIDs.
+/// Finds the index of the subgrid that contains a point.
+///
+/// If no subgrid contains the point, the index of the closest subgrid is returned, which
+/// is the subgrid used for the extrapolation.
 ///
 /// # Panics
 ///
@@ -442,15 +1657,33 @@ pub unsafe extern "C" fn neopdf_pdf_alphas_q2(pdf: *mut NeoPDFWrapper, q2: f64)
 ///
 /// # Safety
 ///
-/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object.
+/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object, the `params` pointer
+/// must be valid for reading `num_params` elements, and the `subgrid_index` pointer must
+/// be valid for writing one element.
 #[no_mangle]
-pub unsafe extern "C" fn neopdf_pdf_num_pids(pdf: *mut NeoPDFWrapper) -> usize {
+pub unsafe extern "C" fn neopdf_pdf_find_subgrid(
+    pdf: *mut NeoPDFWrapper,
+    params: *const c_double,
+    num_params: usize,
+    subgrid_index: *mut usize,
+) -> NeopdfResult {
     assert!(!pdf.is_null());
+    if params.is_null() || subgrid_index.is_null() {
+        return NeopdfResult::ErrorNullPointer;
+    }
+
     let pdf_obj = unsafe { &(*pdf).0 };
-    pdf_obj.pids().len()
+    let params = unsafe { slice::from_raw_parts(params, num_params) };
+
+    pdf_obj
+        .find_subgrid(params)
+        .map_or(NeopdfResult::ErrorInvalidData, |index| {
+            unsafe { *subgrid_index = index };
+            NeopdfResult::Success
+        })
 }
 
-/// Returns the PID representation of the PDF Grid.
+/// Finds the indices of the subgrids that contain a batch of `(x, Q2)` points.
 ///
 /// # Panics
 ///
@@ -458,17 +1691,35 @@ pub unsafe extern "C" fn neopdf_pdf_num_pids(pdf: *mut NeoPDFWrapper) -> usize {
 ///
 /// # Safety
 ///
-/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object, and the `pids` pointer
-/// must be valid for writing `num_pids` elements.
+/// The `pdf` pointer must be a valid pointer to a `NeoPDF` object, the `xs`, `q2s` pointers
+/// must be valid for reading `num_points` elements, and the `subgrid_indices` pointer must
+/// be valid for writing `num_points` elements.
 #[no_mangle]
-pub unsafe extern "C" fn neopdf_pdf_pids(pdf: *mut NeoPDFWrapper, pids: *mut i32, num_pids: usize) {
+pub unsafe extern "C" fn neopdf_pdf_find_subgrids(
+    pdf: *mut NeoPDFWrapper,
+    xs: *const c_double,
+    q2s: *const c_double,
+    num_points: usize,
+    subgrid_indices: *mut usize,
+) -> NeopdfResult {
     assert!(!pdf.is_null());
+    if xs.is_null() || q2s.is_null() || subgrid_indices.is_null() {
+        return NeopdfResult::ErrorNullPointer;
+    }
+
     let pdf_obj = unsafe { &(*pdf).0 };
+    let xs = unsafe { slice::from_raw_parts(xs, num_points) };
+    let q2s = unsafe { slice::from_raw_parts(q2s, num_points) };
+    let indices = unsafe { slice::from_raw_parts_mut(subgrid_indices, num_points) };
 
-    let pids = unsafe { slice::from_raw_parts_mut(pids, num_pids) };
-    let pid_values = pdf_obj.pids();
+    for ((index, &x), &q2) in indices.iter_mut().zip(xs).zip(q2s) {
+        let Some(subgrid) = pdf_obj.find_subgrid(&[x, q2]) else {
+            return NeopdfResult::ErrorInvalidData;
+        };
+        *index = subgrid;
+    }
 
-    pids.copy_from_slice(pid_values.as_slice().unwrap());
+    NeopdfResult::Success
 }
 
 /// Parameters for subgrids in the PDF grid.
@@ -673,6 +1924,21 @@ impl NeoPDFGrid {
         NeopdfResult::Success
     }
 
+    /// Returns views of the subgrids, borrowing their data.
+    fn subgrid_views(&self) -> Vec<SubGridView<'_>> {
+        self.subgrids
+            .iter()
+            .map(|subgrid| SubGridView {
+                nucleons: &subgrid.nucleons,
+                alphas: &subgrid.alphas,
+                kts: &subgrid.kts,
+                xs: &subgrid.xs,
+                q2s: &subgrid.q2s,
+                values: &subgrid.grid_data,
+            })
+            .collect()
+    }
+
     /// Sets the flavor IDs for the grid
     unsafe fn set_flavors(&mut self, flavors: *const c_int, num_flavors: usize) -> NeopdfResult {
         if flavors.is_null() {
@@ -1070,8 +2336,8 @@ pub unsafe extern "C" fn neopdf_gridarray_collection_free(
 
 /// Compresses a collection of `NeoPDFGrid` objects and writes them to a file.
 ///
-/// This function iterates through the grids in the collection, converts them to `GridArray`s,
-/// and then uses the `neopdf::writer::GridArrayCollection::compress` function to write them.
+/// The grids are written one at a time with a `neopdf::writer::GridArrayWriter`, straight
+/// from the data of the collection.
 ///
 /// # Safety
 /// - `collection` must be a valid, non-null pointer to a `NeoPDFGridArrayCollection`.
@@ -1098,38 +2364,356 @@ pub unsafe extern "C" fn neopdf_grid_compress(
         return NeopdfResult::ErrorInvalidData;
     };
 
-    let mut grid_arrays = Vec::with_capacity(collection.len());
+    let Some(grids) = (0..collection.len())
+        .map(|i| collection.get(i))
+        .collect::<Option<Vec<_>>>()
+    else {
+        return NeopdfResult::ErrorInvalidData;
+    };
+
+    let write = || -> Result<(), Box<dyn std::error::Error>> {
+        let mut writer = GridArrayWriter::create_compressed(out_path, &meta)?;
+        for grid in grids {
+            writer.push_subgrids(&grid.flavors, &grid.subgrid_views())?;
+        }
+        writer.finish()
+    };
 
-    for i in 0..collection.len() {
-        let Some(grid) = collection.get(i) else {
-            return NeopdfResult::ErrorInvalidData;
+    writer_result(write())
+}
+
+/// Converts the result of a `GridArrayWriter` into a `NeopdfResult`: the failures to write
+/// the file are reported as `ErrorMemoryError`, and the inconsistent grids as
+/// `ErrorInvalidData`.
+fn writer_result(result: Result<(), Box<dyn std::error::Error>>) -> NeopdfResult {
+    match result {
+        Ok(()) => NeopdfResult::Success,
+        Err(err) if err.is::<std::io::Error>() => NeopdfResult::ErrorMemoryError,
+        Err(_) => NeopdfResult::ErrorInvalidData,
+    }
+}
+
+/// Opaque pointer to a writer which writes the members of a set one at a time.
+pub struct NeoPDFGridWriter(GridArrayWriter);
+
+/// Borrowed knots and values of a subgrid, passed to `neopdf_grid_writer_push_subgrids`.
+///
+/// The values are laid out as the `grid_data` of `neopdf_grid_add_subgrid`.
+#[repr(C)]
+pub struct NeoPDFSubgridView {
+    /// The nucleon numbers `A`.
+    pub nucleons: *const c_double,
+    /// The number of nucleon numbers.
+    pub num_nucleons: usize,
+    /// The values of `alpha_s`.
+    pub alphas: *const c_double,
+    /// The number of values of `alpha_s`.
+    pub num_alphas: usize,
+    /// The values of `kT`.
+    pub kts: *const c_double,
+    /// The number of values of `kT`.
+    pub num_kts: usize,
+    /// The values of `x`.
+    pub xs: *const c_double,
+    /// The number of values of `x`.
+    pub num_xs: usize,
+    /// The values of `Q2`.
+    pub q2s: *const c_double,
+    /// The number of values of `Q2`.
+    pub num_q2s: usize,
+    /// The knot values.
+    pub grid_data: *const c_double,
+    /// The number of knot values.
+    pub grid_data_len: usize,
+}
+
+impl NeoPDFSubgridView {
+    /// Borrows the data of the subgrid, or returns `None` if any of the pointers is null.
+    unsafe fn as_view(&self) -> Option<SubGridView<'_>> {
+        let borrow = |ptr: *const c_double, len: usize| {
+            (!ptr.is_null()).then(|| unsafe { slice::from_raw_parts(ptr, len) })
         };
-        let grid_array = GridArray::new(grid.subgrids.clone(), grid.flavors.clone());
-        grid_arrays.push(grid_array);
+
+        Some(SubGridView {
+            nucleons: borrow(self.nucleons, self.num_nucleons)?,
+            alphas: borrow(self.alphas, self.num_alphas)?,
+            kts: borrow(self.kts, self.num_kts)?,
+            xs: borrow(self.xs, self.num_xs)?,
+            q2s: borrow(self.q2s, self.num_q2s)?,
+            values: borrow(self.grid_data, self.grid_data_len)?,
+        })
+    }
+}
+
+/// Creates a file and returns a writer of its members, in the layout selected by the
+/// extension of `output_path` as in `neopdf::writer::GridArrayCollection::write`.
+///
+/// Each member pushed to the writer is encoded and written to the file straight away. The
+/// file is only complete once `neopdf_grid_writer_finish` is called.
+///
+/// Returns a null pointer if the metadata is invalid or if the file cannot be created.
+///
+/// # Safety
+/// - `metadata` must be a valid, non-null pointer to a `NeoPDFMetaData` struct.
+/// - `output_path` must be a valid, null-terminated C string representing the output file path.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_grid_writer_new(
+    metadata: *const NeoPDFMetaData,
+    output_path: *const c_char,
+) -> *mut NeoPDFGridWriter {
+    if output_path.is_null() {
+        return std::ptr::null_mut();
     }
+    let Some(meta) = process_metadata(metadata) else {
+        return std::ptr::null_mut();
+    };
+    let Ok(out_path) = (unsafe { CStr::from_ptr(output_path).to_str() }) else {
+        return std::ptr::null_mut();
+    };
 
-    let grid_refs: Vec<&GridArray> = grid_arrays.iter().collect();
+    GridArrayWriter::create(out_path, &meta).map_or(std::ptr::null_mut(), |writer| {
+        Box::into_raw(Box::new(NeoPDFGridWriter(writer)))
+    })
+}
 
-    match GridArrayCollection::compress(&grid_refs, &meta, out_path) {
-        Ok(()) => NeopdfResult::Success,
-        Err(_) => NeopdfResult::ErrorMemoryError,
+/// Writes a member made of the given subgrids, without copying their data.
+///
+/// # Safety
+/// - `writer` must be a valid pointer to a `NeoPDFGridWriter`.
+/// - `flavors` must be a valid pointer to an array of integers of size `num_flavors`.
+/// - `subgrids` must be a valid pointer to an array of `num_subgrids` subgrids, whose data
+///   pointers are valid for the specified lengths.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_grid_writer_push_subgrids(
+    writer: *mut NeoPDFGridWriter,
+    flavors: *const c_int,
+    num_flavors: usize,
+    subgrids: *const NeoPDFSubgridView,
+    num_subgrids: usize,
+) -> NeopdfResult {
+    if writer.is_null() || flavors.is_null() || subgrids.is_null() {
+        return NeopdfResult::ErrorNullPointer;
+    }
+
+    let writer = unsafe { &mut (*writer).0 };
+    let flavors = unsafe { slice::from_raw_parts(flavors, num_flavors) };
+    let Some(views) = unsafe { slice::from_raw_parts(subgrids, num_subgrids) }
+        .iter()
+        .map(|subgrid| unsafe { subgrid.as_view() })
+        .collect::<Option<Vec<_>>>()
+    else {
+        return NeopdfResult::ErrorNullPointer;
+    };
+
+    writer_result(writer.push_subgrids(flavors, &views))
+}
+
+/// Writes a member from a `NeoPDFGrid`, which remains owned by the caller.
+///
+/// # Safety
+/// - `writer` must be a valid pointer to a `NeoPDFGridWriter`.
+/// - `grid` must be a valid pointer to a `NeoPDFGrid` whose flavors were set.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_grid_writer_push_grid(
+    writer: *mut NeoPDFGridWriter,
+    grid: *const NeoPDFGrid,
+) -> NeopdfResult {
+    if writer.is_null() || grid.is_null() {
+        return NeopdfResult::ErrorNullPointer;
+    }
+
+    let (writer, grid) = unsafe { (&mut (*writer).0, &*grid) };
+    writer_result(writer.push_subgrids(&grid.flavors, &grid.subgrid_views()))
+}
+
+/// Returns the number of members written so far.
+///
+/// # Panics
+///
+/// This function will panic if the `writer` pointer is null.
+///
+/// # Safety
+/// `writer` must be a valid pointer to a `NeoPDFGridWriter`.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_grid_writer_num_members(writer: *const NeoPDFGridWriter) -> usize {
+    assert!(!writer.is_null());
+    unsafe { (*writer).0.len() }
+}
+
+/// Completes the file by writing the index of the members, and frees the writer.
+///
+/// # Safety
+/// `writer` must be a valid pointer to a `NeoPDFGridWriter` created by
+/// `neopdf_grid_writer_new`. The pointer is invalid after this call.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_grid_writer_finish(writer: *mut NeoPDFGridWriter) -> NeopdfResult {
+    if writer.is_null() {
+        return NeopdfResult::ErrorNullPointer;
+    }
+
+    let writer = unsafe { Box::from_raw(writer) };
+    writer_result(writer.0.finish())
+}
+
+/// Frees a writer without completing its file, which is then left unreadable.
+///
+/// # Safety
+/// `writer` must be a valid pointer to a `NeoPDFGridWriter` created by
+/// `neopdf_grid_writer_new`, or null.
+#[no_mangle]
+pub unsafe extern "C" fn neopdf_grid_writer_free(writer: *mut NeoPDFGridWriter) {
+    if !writer.is_null() {
+        unsafe { drop(Box::from_raw(writer)) };
     }
 }
 
 // LHAPDF C-API drop-in compatibility layer.
 ///
-/// This global state stores the loaded PDF set and the currently selected
-/// member index. It is not thread-safe and mirrors the behavior of legacy
-/// LHAPDF interfaces.
+/// The PDF set loaded by `initpdfsetbyname` is shared by all the threads. The member
+/// selected by `initpdf` is process-wide, as in LHAPDF, such that the threads spawned after
+/// the selection, e.g. by an OpenMP region, evaluate it. A thread calling `initpdf` also
+/// keeps its selection as an override of the process-wide member, such that different
+/// threads can evaluate different members concurrently. The overrides are dropped when
+/// another set is loaded.
 struct LhapdfState {
-    pdf_set: Option<Vec<PDF>>,
-    member: usize,
+    pdfs: Vec<PDF>,
+    /// The flavors of `DEFAULT_PIDS` available in each member.
+    flavors: Vec<LhapdfFlavors>,
+}
+
+/// The flavors of `DEFAULT_PIDS` available in a member, with their slots in the output
+/// array of `evolvepdf`.
+struct LhapdfFlavors {
+    pids: [i32; DEFAULT_PIDS.len()],
+    slots: [usize; DEFAULT_PIDS.len()],
+    len: usize,
+}
+
+impl LhapdfFlavors {
+    fn new(pdf: &PDF) -> Self {
+        let mut flavors = Self {
+            pids: [0; DEFAULT_PIDS.len()],
+            slots: [0; DEFAULT_PIDS.len()],
+            len: 0,
+        };
+
+        for (slot, &pid) in DEFAULT_PIDS.iter().enumerate() {
+            if pdf.pids().iter().any(|&available| available == pid) {
+                flavors.pids[flavors.len] = pid;
+                flavors.slots[flavors.len] = slot;
+                flavors.len += 1;
+            }
+        }
+
+        flavors
+    }
+
+    /// Evaluates all the flavors at once into their slots of `out`, the missing flavors
+    /// being set to zero.
+    fn evolve(&self, pdf: &PDF, x: f64, q2: f64, out: &mut [f64]) {
+        let mut values = [0.0; DEFAULT_PIDS.len()];
+        let values = &mut values[..self.len];
+        out.fill(0.0);
+        // The flavors are part of the member, hence the batch cannot fail. The values are
+        // nevertheless left to zero rather than unwinding across the FFI boundary.
+        if pdf
+            .xfxq2_batch(&self.pids[..self.len], &[x], &[q2], values)
+            .is_err()
+        {
+            return;
+        }
+
+        for (&slot, &value) in self.slots[..self.len].iter().zip(values.iter()) {
+            out[slot] = value;
+        }
+    }
+}
+
+/// The PDF set loaded by `initpdfsetbyname`.
+static LHAPDF_STATE: RwLock<Option<Arc<LhapdfState>>> = RwLock::new(None);
+
+/// Counter incremented every time a PDF set is loaded, used by the threads to detect
+/// that their reference to the loaded set is outdated.
+static LHAPDF_GENERATION: AtomicU64 = AtomicU64::new(0);
+
+/// The member selected by the last call to `initpdf` of any thread.
+static LHAPDF_MEMBER: AtomicUsize = AtomicUsize::new(0);
+
+/// The state of the LHAPDF compatibility layer specific to a thread.
+struct LhapdfThreadState {
+    /// The reference of the thread to the loaded set, as of `generation`.
+    state: Option<Arc<LhapdfState>>,
+    generation: u64,
+    /// The member selected by the thread for the set of `generation`, which overrides
+    /// `LHAPDF_MEMBER`.
+    member: Option<usize>,
 }
 
-static mut LHAPDF_STATE: LhapdfState = LhapdfState {
-    pdf_set: None,
-    member: 0,
-};
+impl LhapdfThreadState {
+    /// Refreshes the reference of the thread to the loaded set if another set was loaded
+    /// in the meantime, in which case the member selected by the thread is dropped.
+    fn refresh(&mut self) {
+        let generation = LHAPDF_GENERATION.load(Ordering::Acquire);
+        if self.generation != generation {
+            self.state = LHAPDF_STATE.read().unwrap().clone();
+            self.generation = generation;
+            self.member = None;
+        }
+    }
+}
+
+thread_local! {
+    static LHAPDF_THREAD_STATE: RefCell<LhapdfThreadState> = const {
+        RefCell::new(LhapdfThreadState {
+            state: None,
+            generation: 0,
+            member: None,
+        })
+    };
+}
+
+/// Loads all the members of a PDF set for the LHAPDF compatibility layer, and resets the
+/// selected member to 0.
+fn lhapdf_load(pdf_name: &str) {
+    let pdfs = PDF::load_pdfs(pdf_name);
+    let flavors = pdfs.iter().map(LhapdfFlavors::new).collect();
+
+    let mut state = LHAPDF_STATE.write().unwrap();
+    *state = Some(Arc::new(LhapdfState { pdfs, flavors }));
+    LHAPDF_MEMBER.store(0, Ordering::Relaxed);
+    LHAPDF_GENERATION.fetch_add(1, Ordering::Release);
+}
+
+/// Selects the member of the process, and of the calling thread.
+fn lhapdf_select(member: usize) {
+    LHAPDF_MEMBER.store(member, Ordering::Relaxed);
+    LHAPDF_THREAD_STATE.with_borrow_mut(|thread| {
+        thread.refresh();
+        thread.member = Some(member);
+    });
+}
+
+/// Calls `f` with the member selected by the calling thread, or by the process if the
+/// thread did not select any.
+///
+/// The reference of the thread to the loaded set is only refreshed when another set was
+/// loaded in the meantime, such that the evaluations do not take any lock.
+///
+/// # Returns
+///
+/// The result of `f`, or `None` if no set is loaded or the member is out of range.
+fn with_lhapdf_member<T>(f: impl FnOnce(&PDF, &LhapdfFlavors) -> T) -> Option<T> {
+    LHAPDF_THREAD_STATE.with_borrow_mut(|thread| {
+        thread.refresh();
+
+        let member = thread
+            .member
+            .unwrap_or_else(|| LHAPDF_MEMBER.load(Ordering::Relaxed));
+        let state = thread.state.as_ref()?;
+        let pdf = state.pdfs.get(member)?;
+        Some(f(pdf, &state.flavors[member]))
+    })
+}
 
 /// Sets LHAPDF runtime parameters from a string (no-op).
 ///
@@ -1155,8 +2739,8 @@ pub const unsafe extern "C" fn setlhaparm_(_line: *const c_char, _len: isize) {}
 
 /// Initializes a PDF set by its name/path and loads all members.
 ///
-/// The loaded set is stored in a global state used by the other LHAPDF-compatible
-/// functions, with the current member index reset to 0.
+/// The loaded set is stored in a global state shared by the other LHAPDF-compatible
+/// functions of all the threads, and the selected member is reset to 0 for all of them.
 ///
 /// # Panics
 ///
@@ -1167,20 +2751,16 @@ pub const unsafe extern "C" fn setlhaparm_(_line: *const c_char, _len: isize) {}
 /// `name` must be a valid, null-terminated C string pointing to a UTF-8 path or set name.
 #[no_mangle]
 pub unsafe extern "C" fn initpdfsetbyname(name: *const c_char) {
-    unsafe {
-        let c_str = CStr::from_ptr(name);
-        let pdf_name = c_str.to_str().expect("Invalid UTF-8 string");
-        let pdfs = PDF::load_pdfs(pdf_name);
-        LHAPDF_STATE.pdf_set = Some(pdfs);
-        LHAPDF_STATE.member = 0;
-    }
+    let c_str = unsafe { CStr::from_ptr(name) };
+    let pdf_name = c_str.to_str().expect("Invalid UTF-8 string");
+    lhapdf_load(pdf_name);
 }
 
 /// Fortran name-mangled variant of `initpdfsetbyname`.
 ///
 /// Reads a fixed-length Fortran character buffer, trims trailing spaces, and loads
-/// the corresponding PDF set into the global state. The current member index is
-/// reset to 0.
+/// the corresponding PDF set into the global state. The selected member is reset to 0
+/// for all the threads.
 ///
 /// # Panics
 ///
@@ -1193,17 +2773,17 @@ pub unsafe extern "C" fn initpdfsetbyname(name: *const c_char) {
 #[no_mangle]
 #[allow(clippy::cast_sign_loss)]
 pub unsafe extern "C" fn initpdfsetbyname_(name: *const c_char, len: c_int) {
-    unsafe {
-        let name_slice = slice::from_raw_parts(name.cast::<u8>(), len as usize);
-        let pdf_name = std::str::from_utf8(name_slice).unwrap().trim_end();
-        let pdfs = PDF::load_pdfs(pdf_name);
-        LHAPDF_STATE.pdf_set = Some(pdfs);
-        LHAPDF_STATE.member = 0;
-    }
+    let name_slice = unsafe { slice::from_raw_parts(name.cast::<u8>(), len as usize) };
+    let pdf_name = std::str::from_utf8(name_slice).unwrap().trim_end();
+    lhapdf_load(pdf_name);
 }
 
 /// Selects the active member of the currently loaded PDF set.
 ///
+/// The member is evaluated by all the threads which did not select another one, including
+/// the threads spawned afterwards, and by the calling thread until it selects another one
+/// or another set is loaded.
+///
 /// # Safety
 ///
 /// This function does not perform bounds checking here; subsequent calls that
@@ -1211,7 +2791,7 @@ pub unsafe extern "C" fn initpdfsetbyname_(name: *const c_char, len: c_int) {
 #[no_mangle]
 #[allow(clippy::cast_sign_loss)]
 pub unsafe extern "C" fn initpdf(member: c_int) {
-    unsafe { LHAPDF_STATE.member = member as usize };
+    lhapdf_select(member as usize);
 }
 
 /// Fortran name-mangled variant of `initpdf`.
@@ -1222,43 +2802,25 @@ pub unsafe extern "C" fn initpdf(member: c_int) {
 #[no_mangle]
 #[allow(clippy::cast_sign_loss)]
 pub unsafe extern "C" fn initpdf_(member: *const c_int) {
-    unsafe { LHAPDF_STATE.member = *member as usize };
+    lhapdf_select(unsafe { *member } as usize);
 }
 
 /// Evaluates parton distribution functions at given `(x, q)` for the active member.
 ///
+/// All the flavors are evaluated at once and without allocating.
+///
 /// # Safety
 ///
-/// - `f` must point to writable memory for at least 13 `c_double` values.
+/// - `f` must point to writable memory for at least 14 `c_double` values.
 /// - Requires that a PDF set has been initialized via `initpdfsetbyname` or its
 ///   Fortran variant. If no set is loaded or the member index is out of range,
 ///   the function returns without writing.
 #[no_mangle]
 pub unsafe extern "C" fn evolvepdf(x: c_double, q: c_double, f: *mut c_double) {
-    unsafe {
-        let state_ptr = &raw const LHAPDF_STATE;
-        let pdf_set_ptr = &raw const (*state_ptr).pdf_set;
-
-        if let Some(pdfs) = &*pdf_set_ptr {
-            let member = (*state_ptr).member;
-            if member >= pdfs.len() {
-                return;
-            }
-            let pdf = &pdfs[member];
-            let q2 = q * q;
-
-            let (available_pids, _) = pdf.pids().clone().into_raw_vec_and_offset();
-            let out_slice = slice::from_raw_parts_mut(f, 14);
-
-            for (out, &pid) in out_slice.iter_mut().zip(DEFAULT_PIDS.iter()) {
-                *out = if available_pids.contains(&pid) {
-                    pdf.xfxq2(pid, &[x, q2])
-                } else {
-                    0.0
-                };
-            }
-        }
-    }
+    with_lhapdf_member(|pdf, flavors| {
+        let out_slice = unsafe { slice::from_raw_parts_mut(f, DEFAULT_PIDS.len()) };
+        flavors.evolve(pdf, x, q * q, out_slice);
+    });
 }
 
 /// Fortran name-mangled variant of `evolvepdf`.
@@ -1266,34 +2828,12 @@ pub unsafe extern "C" fn evolvepdf(x: c_double, q: c_double, f: *mut c_double) {
 /// # Safety
 ///
 /// - `x`, `q` must be valid pointers to `c_double` values.
-/// - `f` must point to writable memory for at least 13 `c_double` values.
+/// - `f` must point to writable memory for at least 14 `c_double` values.
 /// - A PDF set must have been initialized and the member index must be valid or
 ///   the function will return without writing.
 #[no_mangle]
 pub unsafe extern "C" fn evolvepdf_(x: *const c_double, q: *const c_double, f: *mut c_double) {
-    unsafe {
-        let pdf_set_ptr = &raw const LHAPDF_STATE.pdf_set;
-
-        if let Some(pdfs) = &*pdf_set_ptr {
-            let member = (&raw const LHAPDF_STATE.member).read();
-            if member >= pdfs.len() {
-                return;
-            }
-            let pdf = &pdfs[member];
-            let q2 = (*q) * (*q);
-
-            let (available_pids, _) = pdf.pids().clone().into_raw_vec_and_offset();
-            let out_slice = slice::from_raw_parts_mut(f, 14);
-
-            for (out, &pid) in out_slice.iter_mut().zip(DEFAULT_PIDS.iter()) {
-                *out = if available_pids.contains(&pid) {
-                    pdf.xfxq2(pid, &[*x, q2])
-                } else {
-                    0.0
-                };
-            }
-        }
-    }
+    unsafe { evolvepdf(*x, *q, f) };
 }
 
 /// Evaluates the strong coupling `alpha_s` at scale `q` for the active member.
@@ -1305,22 +2845,7 @@ pub unsafe extern "C" fn evolvepdf_(x: *const c_double, q: *const c_double, f: *
 ///   the function returns 0.0.
 #[no_mangle]
 pub unsafe extern "C" fn alphaspdf(q: c_double) -> c_double {
-    unsafe {
-        let state_ptr = &raw const LHAPDF_STATE;
-        let pdf_set_ptr = &raw const (*state_ptr).pdf_set;
-
-        if let Some(pdfs) = &*pdf_set_ptr {
-            let member = (*state_ptr).member;
-            if member >= pdfs.len() {
-                return 0.0;
-            }
-            let pdf = &pdfs[member];
-            let q2 = q * q;
-            pdf.alphas_q2(q2)
-        } else {
-            0.0
-        }
-    }
+    with_lhapdf_member(|pdf, _| pdf.alphas_q2(q * q)).unwrap_or(0.0)
 }
 
 /// Fortran name-mangled variant of `alphaspdf`.
@@ -1332,20 +2857,5 @@ pub unsafe extern "C" fn alphaspdf(q: c_double) -> c_double {
 ///   the function will return 0.0.
 #[no_mangle]
 pub unsafe extern "C" fn alphaspdf_(q: *const c_double) -> c_double {
-    unsafe {
-        let state_ptr = &raw const LHAPDF_STATE;
-        let pdf_set_ptr = &raw const (*state_ptr).pdf_set;
-
-        if let Some(pdfs) = &*pdf_set_ptr {
-            let member = (*state_ptr).member;
-            if member >= pdfs.len() {
-                return 0.0;
-            }
-            let pdf = &pdfs[member];
-            let q2 = (*q) * (*q);
-            pdf.alphas_q2(q2)
-        } else {
-            0.0
-        }
-    }
+    unsafe { alphaspdf(*q) }
 }
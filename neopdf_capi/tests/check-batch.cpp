@@ -0,0 +1,254 @@
+#include <NeoPDF.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace neopdf;
+
+const double TOLERANCE = 1e-12;
+
+// The knot values stored in single precision are rounded to about 7 digits.
+const double F32_TOLERANCE = 1e-6;
+
+template<typename T>
+std::vector<T> geomspace(T start, T stop, int num, bool endpoint = false) {
+    std::vector<T> result(num);
+
+    if (num == 1) {
+        result[0] = start;
+        return result;
+    }
+
+    T log_start = std::log(start);
+    T log_stop = std::log(stop);
+    T step = (log_stop - log_start) / (endpoint ? (num - 1) : num);
+
+    for (int i = 0; i < num; ++i) {
+        result[i] = std::exp(log_start + i * step);
+    }
+
+    return result;
+}
+
+bool is_close(double result, double expected, double tolerance) {
+    return std::abs(result - expected) <= tolerance * std::max(std::abs(expected), 1.0);
+}
+
+void test_xfxq2_batch() {
+    std::cout << "=== Test xfxQ2_batch for all flavors at once ===\n";
+
+    std::string pdfname = "NNPDF40_nnlo_as_01180";
+    NeoPDF neo_pdf(pdfname, 0);
+
+    std::vector<int32_t> pids = {-5, -4, -3, -2, -1, 21, 1, 2, 3, 4, 5};
+    std::vector<double> xs;
+    std::vector<double> q2s;
+    for (double x : geomspace(neo_pdf.x_min(), neo_pdf.x_max(), 20)) {
+        for (double q2 : geomspace(neo_pdf.q2_min(), neo_pdf.q2_max(), 20)) {
+            xs.push_back(x);
+            q2s.push_back(q2);
+        }
+    }
+
+    // The values are laid out as `[pids, points]`.
+    std::vector<double> out(pids.size() * xs.size());
+    neo_pdf.xfxQ2_batch(pids, xs, q2s, out);
+    for (size_t i = 0; i < pids.size(); ++i) {
+        for (size_t j = 0; j < xs.size(); ++j) {
+            double expected = neo_pdf.xfxQ2(pids[i], xs[j], q2s[j]);
+            assert(is_close(out[i * xs.size() + j], expected, TOLERANCE));
+        }
+    }
+    std::cout << "Computed " << pids.size() << " flavors at " << xs.size() << " points\n";
+
+    // The single-precision outputs are the rounded double-precision values.
+    std::vector<float> out_f32(out.size());
+    neo_pdf.xfxQ2_batch(pids, xs, q2s, out_f32);
+    for (size_t i = 0; i < out.size(); ++i) {
+        assert(out_f32[i] == static_cast<float>(out[i]));
+    }
+
+    // An empty batch leaves the outputs untouched.
+    double untouched = -1.0;
+    neo_pdf.xfxQ2_batch(pids.data(), pids.size(), nullptr, nullptr, 0, &untouched);
+    assert(untouched == -1.0);
+
+    // Inconsistent sizes are rejected before reaching the C API.
+    bool rejected = false;
+    try {
+        std::vector<double> short_out(out.size() - 1);
+        neo_pdf.xfxQ2_batch(pids, xs, q2s, short_out);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    assert(rejected);
+
+    std::cout << "xfxQ2_batch test passed.\n";
+}
+
+void test_find_subgrid() {
+    std::cout << "=== Test find_subgrid ===\n";
+
+    std::string pdfname = "NNPDF40_nnlo_as_01180";
+    NeoPDF neo_pdf(pdfname, 0);
+
+    std::vector<double> xs;
+    std::vector<double> q2s;
+    for (double x : geomspace(neo_pdf.x_min(), neo_pdf.x_max(), 15)) {
+        for (double q2 : geomspace(neo_pdf.q2_min(), neo_pdf.q2_max(), 15)) {
+            xs.push_back(x);
+            q2s.push_back(q2);
+        }
+    }
+
+    // The subgrid returned for a point inside the grid contains the point.
+    std::vector<size_t> indices = neo_pdf.find_subgrids(xs, q2s);
+    for (size_t j = 0; j < xs.size(); ++j) {
+        size_t index = neo_pdf.find_subgrid({xs[j], q2s[j]});
+        assert(index == indices[j]);
+        assert(index < neo_pdf.num_subgrids());
+
+        std::vector<double> x_knots = neo_pdf.subgrid_for_param(NEOPDF_SUBGRID_PARAMS_MOMENTUM, index);
+        std::vector<double> q2_knots = neo_pdf.subgrid_for_param(NEOPDF_SUBGRID_PARAMS_SCALE, index);
+        assert(x_knots.front() <= xs[j] && xs[j] <= x_knots.back());
+        assert(q2_knots.front() <= q2s[j] && q2s[j] <= q2_knots.back());
+    }
+    std::cout << "Located " << xs.size() << " points\n";
+
+    // A point outside of the grid is assigned to the closest subgrid.
+    size_t above = neo_pdf.find_subgrid({0.1, 10.0 * neo_pdf.q2_max()});
+    std::vector<double> q2_knots = neo_pdf.subgrid_for_param(NEOPDF_SUBGRID_PARAMS_SCALE, above);
+    assert(q2_knots.back() == neo_pdf.param_range(NEOPDF_SUBGRID_PARAMS_SCALE)[1]);
+
+    std::cout << "find_subgrid test passed.\n";
+}
+
+void test_load_options() {
+    std::cout << "=== Test NeoPDF with load options ===\n";
+
+    std::string pdfname = "NNPDF40_nnlo_as_01180";
+    NeoPDF neo_pdf(pdfname, 0);
+
+    neopdf_load_options coeffs = neopdf_load_options();
+    coeffs.precompute_coeffs = true;
+    NeoPDF coeffs_pdf(pdfname, 0, coeffs);
+
+    neopdf_load_options single = neopdf_load_options();
+    single.single_precision = true;
+    NeoPDF single_pdf(pdfname, 0, single);
+
+    std::vector<int32_t> pids = {-3, -1, 21, 1, 2, 4};
+    std::vector<double> xs = geomspace(neo_pdf.x_min(), neo_pdf.x_max(), 30);
+    std::vector<double> q2s = geomspace(neo_pdf.q2_min(), neo_pdf.q2_max(), 30);
+    for (int32_t pid : pids) {
+        for (double x : xs) {
+            for (double q2 : q2s) {
+                double expected = neo_pdf.xfxQ2(pid, x, q2);
+                assert(is_close(coeffs_pdf.xfxQ2(pid, x, q2), expected, TOLERANCE));
+                assert(is_close(single_pdf.xfxQ2(pid, x, q2), expected, F32_TOLERANCE));
+            }
+        }
+    }
+    std::cout << "Compared the precomputed coefficients and the single precision\n";
+
+    std::cout << "Load options test passed.\n";
+}
+
+void test_xfxq2_grid() {
+    std::cout << "=== Test xfxQ2_grid on the product of x and Q2 values ===\n";
+
+    std::string pdfname = "NNPDF40_nnlo_as_01180";
+    NeoPDF neo_pdf(pdfname, 0);
+
+    std::vector<int32_t> pids = {-2, 21, 2};
+    std::vector<double> xs = geomspace(neo_pdf.x_min(), neo_pdf.x_max(), 25);
+    std::vector<double> q2s = geomspace(neo_pdf.q2_min(), neo_pdf.q2_max(), 35);
+
+    // The values are laid out as `[pids, xs, q2s]`.
+    std::vector<double> out(pids.size() * xs.size() * q2s.size());
+    neo_pdf.xfxQ2_grid(pids, xs, q2s, out);
+    for (size_t i = 0; i < pids.size(); ++i) {
+        for (size_t j = 0; j < xs.size(); ++j) {
+            for (size_t k = 0; k < q2s.size(); ++k) {
+                double expected = neo_pdf.xfxQ2(pids[i], xs[j], q2s[k]);
+                assert(is_close(out[(i * xs.size() + j) * q2s.size() + k], expected, TOLERANCE));
+            }
+        }
+    }
+    std::cout << "Computed " << pids.size() << " flavors on a " << xs.size() << "x"
+        << q2s.size() << " grid\n";
+
+    std::cout << "xfxQ2_grid test passed.\n";
+}
+
+void test_xfxq2_fixed() {
+    std::cout << "=== Test xfxQ2 at fixed x and at fixed Q2 ===\n";
+
+    std::string pdfname = "NNPDF40_nnlo_as_01180";
+    NeoPDF neo_pdf(pdfname, 0);
+
+    std::vector<int32_t> pids = {-1, 21, 1, 2};
+    std::vector<double> xs = geomspace(neo_pdf.x_min(), neo_pdf.x_max(), 40);
+    std::vector<double> q2s = geomspace(neo_pdf.q2_min(), neo_pdf.q2_max(), 40);
+
+    // The scale variations at fixed x, laid out as `[pids, q2s]`.
+    double x = 1e-3;
+    std::vector<double> out(pids.size() * q2s.size());
+    std::vector<double> alphas(q2s.size());
+    neo_pdf.xfxQ2_fixed_x(pids, x, q2s, out, alphas);
+    for (size_t k = 0; k < q2s.size(); ++k) {
+        assert(is_close(alphas[k], neo_pdf.alphasQ2(q2s[k]), TOLERANCE));
+        for (size_t i = 0; i < pids.size(); ++i) {
+            double expected = neo_pdf.xfxQ2(pids[i], x, q2s[k]);
+            assert(is_close(out[i * q2s.size() + k], expected, TOLERANCE));
+        }
+    }
+    std::cout << "Computed " << q2s.size() << " scales at fixed x\n";
+
+    // The x values at fixed Q2, laid out as `[pids, xs]`.
+    double q2 = 1e4;
+    out.resize(pids.size() * xs.size());
+    double alphas_q2 = neo_pdf.xfxQ2_fixed_Q2(pids, xs, q2, out);
+    assert(is_close(alphas_q2, neo_pdf.alphasQ2(q2), TOLERANCE));
+    for (size_t j = 0; j < xs.size(); ++j) {
+        for (size_t i = 0; i < pids.size(); ++i) {
+            double expected = neo_pdf.xfxQ2(pids[i], xs[j], q2);
+            assert(is_close(out[i * xs.size() + j], expected, TOLERANCE));
+        }
+    }
+    std::cout << "Computed " << xs.size() << " momentum fractions at fixed Q2\n";
+
+    std::cout << "xfxQ2 at fixed x and Q2 test passed.\n";
+}
+
+void test_alphas_q2_batch() {
+    std::cout << "=== Test alphasQ2_batch ===\n";
+
+    std::string pdfname = "NNPDF40_nnlo_as_01180";
+    NeoPDF neo_pdf(pdfname, 0);
+
+    // The scales extend beyond the knots of `alphas` on both sides.
+    std::vector<double> q2s = geomspace(0.5 * neo_pdf.q2_min(), 2.0 * neo_pdf.q2_max(), 500);
+    std::vector<double> out(q2s.size());
+    neo_pdf.alphasQ2_batch(q2s, out);
+    for (size_t k = 0; k < q2s.size(); ++k) {
+        assert(is_close(out[k], neo_pdf.alphasQ2(q2s[k]), TOLERANCE));
+    }
+    std::cout << "Computed " << q2s.size() << " values of alphas\n";
+
+    std::cout << "alphasQ2_batch test passed.\n";
+}
+
+int main() {
+    test_xfxq2_batch();
+    test_find_subgrid();
+    test_load_options();
+    test_xfxq2_grid();
+    test_xfxq2_fixed();
+    test_alphas_q2_batch();
+
+    return 0;
+}
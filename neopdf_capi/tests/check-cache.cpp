@@ -0,0 +1,163 @@
+#include <NeoPDF.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace neopdf;
+
+const double TOLERANCE = 1e-12;
+
+bool is_close(double result, double expected, double tolerance) {
+    return std::abs(result - expected) <= tolerance * std::max(std::abs(expected), 1.0);
+}
+
+void test_member_cache() {
+    std::cout << "=== Test NeoPDFCache under a memory budget ===\n";
+
+    std::string pdfname = "NNPDF40_nnlo_as_01180";
+
+    std::vector<int32_t> pids = {-1, 21, 1};
+    std::vector<double> xs = {1e-5, 1e-3, 0.1, 0.5};
+    std::vector<double> q2s = {2.0, 1e2, 1e4, 1e6};
+
+    // The budget holds two members, and the first one is evaluated as below to measure its
+    // size, which includes the interpolators built by the evaluations once it is requested
+    // again.
+    NeoPDFCache probe(pdfname, 0);
+    std::vector<double> probe_out(pids.size() * xs.size());
+    probe.xfxQ2_batch(0, pids, xs, q2s, probe_out);
+    probe.alphasQ2(0, 1e2);
+    size_t member_bytes = probe.stats().resident_bytes;
+    assert(member_bytes > 0);
+
+    NeoPDFCache cache(pdfname, 2 * member_bytes);
+    std::cout << "The cache gives access to " << cache.size() << " members\n";
+
+    for (size_t member = 1; member <= 3; ++member) {
+        NeoPDF neo_pdf(pdfname, member);
+        std::vector<double> out(pids.size() * xs.size());
+        cache.xfxQ2_batch(member, pids, xs, q2s, out);
+        for (size_t i = 0; i < pids.size(); ++i) {
+            for (size_t j = 0; j < xs.size(); ++j) {
+                double expected = neo_pdf.xfxQ2(pids[i], xs[j], q2s[j]);
+                assert(is_close(out[i * xs.size() + j], expected, TOLERANCE));
+            }
+        }
+        assert(cache.alphasQ2(member, 1e2) == neo_pdf.alphasQ2(1e2));
+    }
+
+    // Member 1 is the least recently used one, hence it was evicted to make room for 3.
+    neopdf_cache_stats stats = cache.stats();
+    std::cout << "Hits: " << stats.hits << ", misses: " << stats.misses
+        << ", evictions: " << stats.evictions << "\n";
+    assert(stats.hits == 3 && stats.misses == 3 && stats.evictions == 1);
+    assert(stats.num_resident == 2);
+    assert(stats.resident_bytes <= 2 * member_bytes);
+
+    // The cache is shared by several threads.
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, t]() {
+            for (size_t member = t; member < 20; member += 4) {
+                assert(cache.xfxQ2(member % 5, 21, 0.1, 1e2) > 0.0);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    stats = cache.stats();
+    assert(stats.resident_bytes <= 2 * member_bytes);
+
+    cache.clear();
+    assert(cache.stats().num_resident == 0);
+
+    std::cout << "NeoPDFCache test passed.\n";
+}
+
+void test_registry() {
+    std::cout << "=== Test the registry of the loaded members ===\n";
+
+    std::string pdfname = "NNPDF40_nnlo_as_01180";
+    size_t bytes_before = registry_resident_bytes();
+
+    // The second handle to the same member does not load it again.
+    NeoPDF first(pdfname, 7);
+    size_t bytes_first = registry_resident_bytes();
+    assert(bytes_first > bytes_before);
+    {
+        NeoPDF second(pdfname, 7);
+        assert(registry_resident_bytes() == bytes_first);
+        assert(second.xfxQ2(21, 1e-3, 1e2) == first.xfxQ2(21, 1e-3, 1e2));
+
+        std::string report = registry_report();
+        assert(report.find(pdfname) != std::string::npos);
+        assert(report.find("Handles") != std::string::npos);
+    }
+    std::cout << "Shared member 7 between two handles\n";
+
+    // Other load options give another member.
+    neopdf_load_options options = neopdf_load_options();
+    options.precompute_coeffs = true;
+    {
+        NeoPDF coeffs(pdfname, 7, options);
+        assert(registry_resident_bytes() > bytes_first);
+        assert(registry_report().find("precompute_coeffs") != std::string::npos);
+    }
+
+    // A modified handle is detached from the shared member.
+    first.set_force_positive(NEOPDF_FORCE_POSITIVE_CLIP_NEGATIVE);
+    NeoPDF third(pdfname, 7);
+    assert(third.is_force_positive() == NEOPDF_FORCE_POSITIVE_NO_CLIPPING);
+
+    std::cout << "Registry test passed.\n";
+}
+
+void test_eval_statistics() {
+    std::cout << "=== Test the evaluation statistics ===\n";
+
+    std::string pdfname = "NNPDF40_nnlo_as_01180";
+    NeoPDF neo_pdf(pdfname, 3);
+    neopdf_eval_stats stats = neo_pdf.stats();
+    assert(stats.member_loads == 1);
+    assert(stats.load_nanos > 0);
+
+    // The evaluations are only recorded once enabled.
+    neo_pdf.xfxQ2(21, 1e-12, 100.0);
+    assert(neo_pdf.stats().points == 0);
+
+    neo_pdf.enable_stats();
+    neo_pdf.xfxQ2(21, 0.01, 100.0);
+    neo_pdf.xfxQ2(21, 1e-12, 100.0);
+    neo_pdf.xfxQ2(21, 0.01, 1e12);
+    stats = neo_pdf.stats();
+    std::cout << "Points: " << stats.points << ", fallbacks: " << stats.subgrid_fallbacks
+        << ", x below: " << stats.x_below << ", Q2 above: " << stats.q2_above << "\n";
+    assert(stats.points == 3);
+    assert(stats.subgrid_fallbacks == 2);
+    assert(stats.x_below == 1 && stats.x_above == 0);
+    assert(stats.q2_below == 0 && stats.q2_above == 1);
+    assert(stats.force_positive_clips == 0);
+
+    neo_pdf.reset_stats();
+    stats = neo_pdf.stats();
+    assert(stats.points == 0 && stats.subgrid_fallbacks == 0 && stats.member_loads == 0);
+
+    neo_pdf.enable_stats(false);
+    neo_pdf.xfxQ2(21, 0.01, 100.0);
+    assert(neo_pdf.stats().points == 0);
+
+    std::cout << "Evaluation statistics test passed.\n";
+}
+
+int main() {
+    test_member_cache();
+    test_registry();
+    test_eval_statistics();
+
+    return 0;
+}
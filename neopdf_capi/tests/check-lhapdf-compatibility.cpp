@@ -4,6 +4,7 @@
 #include <cmath>
 #include <iostream>
 #include <string>
+#include <thread>
 
 using namespace NEOLHAPDF;
 
@@ -91,9 +92,49 @@ void test_lhapdf_compatibility_c() {
     printf("LHAPDF C Compatibility test passed.\n");
 }
 
+void test_lhapdf_compatibility_threads() {
+    printf("=== Test LHAPDF C Compatibility Layer with Threads ===\n");
+
+    const char* pdfname = "NNPDF40_nnlo_as_01180";
+    const int member = 3;
+    double x = 0.1;
+    double q = 10.0;
+
+    // The member selected by the main thread is evaluated by the threads spawned after.
+    initpdfsetbyname(pdfname);
+    initpdf(member);
+    double xfxs_worker[14];
+    std::thread worker([&]() { evolvepdf(x, q, xfxs_worker); });
+    worker.join();
+
+    NeoPDFWrapper* neo_pdf = neopdf_pdf_load(pdfname, member);
+    double expected_g = neopdf_pdf_xfxq2(neo_pdf, 21, x, q*q);
+    neopdf_pdf_free(neo_pdf);
+
+    printf("Member %d evaluated by a worker thread\n", member);
+    assert(fabs(xfxs_worker[0] - expected_g) <= TOLERANCE * fabs(expected_g));
+
+    // A thread keeps its own selection, until another set is loaded.
+    double xfxs_own[14];
+    double xfxs_reloaded[14];
+    std::thread selecting([&]() {
+        initpdf(0);
+        initpdfsetbyname(pdfname);
+        evolvepdf(x, q, xfxs_own);
+    });
+    selecting.join();
+    evolvepdf(x, q, xfxs_reloaded);
+
+    printf("Member 0 evaluated after reloading the set\n");
+    assert(xfxs_own[0] == xfxs_reloaded[0]);
+
+    printf("LHAPDF C Compatibility test with threads passed.\n");
+}
+
 int main() {
     test_lhapdf_compatibility_oop();
     test_lhapdf_compatibility_c();
+    test_lhapdf_compatibility_threads();
 
     return 0;
 }
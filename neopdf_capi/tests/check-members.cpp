@@ -0,0 +1,301 @@
+#include <neopdf_capi.h>
+#include <NeoPDF.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace neopdf;
+
+const double TOLERANCE = 1e-12;
+
+// The uncertainties are accumulated in a single pass over the members.
+const double UNCERTAINTY_TOLERANCE = 1e-8;
+
+template<typename T>
+std::vector<T> geomspace(T start, T stop, int num, bool endpoint = false) {
+    std::vector<T> result(num);
+
+    if (num == 1) {
+        result[0] = start;
+        return result;
+    }
+
+    T log_start = std::log(start);
+    T log_stop = std::log(stop);
+    T step = (log_stop - log_start) / (endpoint ? (num - 1) : num);
+
+    for (int i = 0; i < num; ++i) {
+        result[i] = std::exp(log_start + i * step);
+    }
+
+    return result;
+}
+
+bool is_close(double result, double expected, double tolerance) {
+    return std::abs(result - expected) <= tolerance * std::max(std::abs(expected), 1.0);
+}
+
+/** @brief Counts the batches and tasks run by `run_in_reverse`. */
+struct TaskCounter {
+    size_t num_runs;
+    size_t num_tasks;
+};
+
+/** @brief C executor running the tasks in reverse order on the calling thread. */
+void run_in_reverse(void* context, size_t num_tasks, neopdf_task task, void* task_context) {
+    TaskCounter* counter = static_cast<TaskCounter*>(context);
+    counter->num_runs += 1;
+    for (size_t i = num_tasks; i > 0; --i) {
+        task(task_context, i - 1);
+        counter->num_tasks += 1;
+    }
+}
+
+void test_xfxq2_all_members() {
+    std::cout << "=== Test xfxQ2_all_members ===\n";
+
+    std::string pdfname = "NNPDF40_nnlo_as_01180";
+    NeoPDFs neo_pdfs(pdfname);
+    std::cout << "Loaded " << neo_pdfs.size() << " PDF members\n";
+
+    std::vector<double> xs;
+    std::vector<double> q2s;
+    for (double x : geomspace(neo_pdfs[0].x_min(), neo_pdfs[0].x_max(), 10)) {
+        for (double q2 : geomspace(neo_pdfs[0].q2_min(), neo_pdfs[0].q2_max(), 10)) {
+            xs.push_back(x);
+            q2s.push_back(q2);
+        }
+    }
+
+    // The values are laid out as `[points, members]`.
+    for (int32_t pid : {-2, 21, 2}) {
+        std::vector<double> out(xs.size() * neo_pdfs.size());
+        neo_pdfs.xfxQ2_all_members(pid, xs, q2s, out);
+        for (size_t j = 0; j < xs.size(); ++j) {
+            for (size_t m = 0; m < neo_pdfs.size(); ++m) {
+                double expected = neo_pdfs[m].xfxQ2(pid, xs[j], q2s[j]);
+                assert(is_close(out[j * neo_pdfs.size() + m], expected, TOLERANCE));
+            }
+        }
+    }
+    std::cout << "Computed all the members at " << xs.size() << " points\n";
+
+    // The clipping set through the members also applies to their stack.
+    neo_pdfs.set_force_positive_members(NEOPDF_FORCE_POSITIVE_CLIP_SMALL);
+    std::vector<double> clipped = neo_pdfs.xfxQ2_all_members(3, 0.9, 1e4);
+    for (size_t m = 0; m < neo_pdfs.size(); ++m) {
+        assert(clipped[m] >= 1e-10);
+        assert(is_close(clipped[m], neo_pdfs[m].xfxQ2(3, 0.9, 1e4), TOLERANCE));
+    }
+
+    std::cout << "xfxQ2_all_members test passed.\n";
+}
+
+void test_uncertainty() {
+    std::cout << "=== Test uncertainty of the replicas ===\n";
+
+    std::string pdfname = "NNPDF40_nnlo_as_01180";
+    NeoPDFs neo_pdfs(pdfname);
+
+    std::vector<double> xs = geomspace(1e-5, 0.9, 8);
+    std::vector<double> q2s = geomspace(2.0, 1e5, 6);
+    std::vector<neopdf_uncertainty> grid = neo_pdfs.uncertainty_grid(21, xs, q2s);
+
+    for (size_t i = 0; i < xs.size(); ++i) {
+        for (size_t j = 0; j < q2s.size(); ++j) {
+            // The central value is the mean of the replicas, and the uncertainty their
+            // standard deviation.
+            std::vector<double> values = neo_pdfs.xfxQ2_all_members(21, xs[i], q2s[j]);
+            size_t n = values.size() - 1;
+            double mean = 0.0;
+            for (size_t m = 1; m <= n; ++m) {
+                mean += values[m] / n;
+            }
+            double variance = 0.0;
+            for (size_t m = 1; m <= n; ++m) {
+                variance += (values[m] - mean) * (values[m] - mean) / (n - 1);
+            }
+            double sd = std::sqrt(variance);
+
+            neopdf_uncertainty result = neo_pdfs.uncertainty(21, xs[i], q2s[j]);
+            assert(is_close(result.central, mean, UNCERTAINTY_TOLERANCE));
+            assert(is_close(result.errsymm, sd, UNCERTAINTY_TOLERANCE));
+            assert(result.errplus == result.errsymm && result.errminus == result.errsymm);
+            assert(result.errparam == 0.0);
+
+            const neopdf_uncertainty& entry = grid[i * q2s.size() + j];
+            assert(is_close(entry.central, result.central, TOLERANCE));
+            assert(is_close(entry.errsymm, result.errsymm, TOLERANCE));
+        }
+    }
+    std::cout << "Combined " << neo_pdfs.size() - 1 << " replicas at "
+        << xs.size() * q2s.size() << " points\n";
+
+    std::cout << "Uncertainty test passed.\n";
+}
+
+void test_executor() {
+    std::cout << "=== Test xfxQ2s with executors ===\n";
+
+    std::string pdfname = "NNPDF40_nnlo_as_01180";
+    NeoPDF neo_pdf(pdfname, 0);
+
+    std::vector<int32_t> pids = {-1, 21, 1};
+    std::vector<std::vector<double>> points;
+    for (double x : geomspace(neo_pdf.x_min(), neo_pdf.x_max(), 30)) {
+        for (double q2 : geomspace(neo_pdf.q2_min(), neo_pdf.q2_max(), 30)) {
+            points.push_back({x, q2});
+        }
+    }
+
+    // The tasks are distributed over threads of the caller.
+    std::atomic<size_t> num_tasks(0);
+    Executor executor = [&num_tasks](size_t ntasks, const std::function<void(size_t)>& task) {
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < 4; ++t) {
+            threads.emplace_back([&task, &num_tasks, ntasks, t]() {
+                for (size_t i = t; i < ntasks; i += 4) {
+                    task(i);
+                    num_tasks += 1;
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    };
+
+    std::vector<neopdf_point_status> status;
+    std::vector<double> results = neo_pdf.xfxQ2s(pids, points, status, &executor);
+    assert(num_tasks > 0);
+    for (size_t i = 0; i < pids.size(); ++i) {
+        for (size_t j = 0; j < points.size(); ++j) {
+            size_t index = i * points.size() + j;
+            assert(status[index] == NEOPDF_POINT_STATUS_SUCCESS);
+            assert(results[index] == neo_pdf.xfxQ2(pids[i], points[j][0], points[j][1]));
+        }
+    }
+    std::cout << "Computed " << results.size() << " values on the threads of the caller\n";
+
+    // The internal thread pool gives the same values.
+    NeoPDF::set_num_threads(2);
+    std::vector<neopdf_point_status> pool_status;
+    std::vector<double> pool_results = neo_pdf.xfxQ2s(pids, points, pool_status);
+    assert(pool_results == results);
+    NeoPDF::set_num_threads(0);
+
+    // A point with too many coordinates is reported in its status.
+    std::vector<std::vector<double>> invalid = {{1e-3, 1e2}, {208.0, 1e-3, 1e2}};
+    std::vector<double> partial(invalid.size());
+    std::vector<neopdf_point_status> partial_status(invalid.size());
+    std::vector<const double*> c_points = {invalid[0].data(), invalid[1].data()};
+    std::vector<size_t> lengths = {invalid[0].size(), invalid[1].size()};
+    int32_t gluon = 21;
+    bool complete = neo_pdf.xfxQ2s(&gluon, 1, c_points.data(), lengths.data(), invalid.size(),
+                                   partial.data(), partial_status.data(), &executor);
+    assert(!complete);
+    assert(partial_status[0] == NEOPDF_POINT_STATUS_SUCCESS);
+    assert(partial_status[1] == NEOPDF_POINT_STATUS_INTERPOLATION_ERROR);
+    assert(std::isnan(partial[1]));
+
+    std::cout << "xfxQ2s with executors test passed.\n";
+}
+
+void test_c_executor() {
+    std::cout << "=== Test neopdf_pdf_xfxq2s with a C executor ===\n";
+
+    const char* pdfname = "NNPDF40_nnlo_as_01180";
+    NeoPDFWrapper* pdf = neopdf_pdf_load(pdfname, 0);
+
+    std::vector<int32_t> pids = {2, 21};
+    std::vector<double> xs = geomspace(1e-6, 0.9, 500);
+    std::vector<const double*> points(xs.size());
+    std::vector<size_t> lengths(xs.size(), 2);
+    std::vector<std::vector<double>> storage(xs.size());
+    for (size_t j = 0; j < xs.size(); ++j) {
+        storage[j] = {xs[j], 1e3};
+        points[j] = storage[j].data();
+    }
+
+    TaskCounter counter = {0, 0};
+    NeoPDFExecutor executor;
+    executor.context = &counter;
+    executor.run = run_in_reverse;
+
+    std::vector<double> results(pids.size() * xs.size());
+    std::vector<neopdf_point_status> status(results.size());
+    NeopdfResult result = neopdf_pdf_xfxq2s(
+        pdf, pids.data(), pids.size(), points.data(), lengths.data(), points.size(),
+        &executor, results.data(), status.data()
+    );
+    assert(result == NEOPDF_RESULT_SUCCESS);
+    assert(counter.num_runs == 1 && counter.num_tasks > 0);
+
+    for (size_t i = 0; i < pids.size(); ++i) {
+        for (size_t j = 0; j < xs.size(); ++j) {
+            size_t index = i * xs.size() + j;
+            assert(status[index] == NEOPDF_POINT_STATUS_SUCCESS);
+            assert(results[index] == neopdf_pdf_xfxq2(pdf, pids[i], xs[j], 1e3));
+        }
+    }
+    std::cout << "Computed " << results.size() << " values in reverse order\n";
+
+    neopdf_pdf_free(pdf);
+
+    std::cout << "C executor test passed.\n";
+}
+
+void test_numa_placement() {
+    std::cout << "=== Test NeoPDFs with NUMA placement ===\n";
+
+    std::string pdfname = "NNPDF40_nnlo_as_01180";
+    NeoPDFs neo_pdfs(pdfname);
+
+    // The placement of the knot values does not change the values.
+    neopdf_numa_policy policies[] = {
+        NEOPDF_NUMA_POLICY_FIRST_TOUCH,
+        NEOPDF_NUMA_POLICY_INTERLEAVE,
+        NEOPDF_NUMA_POLICY_REPLICATE,
+    };
+    std::vector<double> xs = geomspace(1e-6, 0.9, 12);
+    std::vector<double> q2s(xs.size(), 1e2);
+    for (neopdf_numa_policy policy : policies) {
+        NeoPDFs placed(pdfname, policy);
+        assert(placed.size() == neo_pdfs.size());
+
+        std::vector<double> expected(xs.size() * neo_pdfs.size());
+        std::vector<double> out(xs.size() * placed.size());
+        neo_pdfs.xfxQ2_all_members(21, xs, q2s, expected);
+        placed.xfxQ2_all_members(21, xs, q2s, out);
+        assert(out == expected);
+
+        for (size_t m = 0; m < placed.size(); m += 10) {
+            assert(placed[m].xfxQ2(2, 0.1, 1e2) == neo_pdfs[m].xfxQ2(2, 0.1, 1e2));
+        }
+    }
+    std::cout << "Compared the first touch, interleaved and replicated placements\n";
+
+    // A single member can be placed as well.
+    neopdf_load_options options = neopdf_load_options();
+    options.huge_pages = true;
+    options.numa = NEOPDF_NUMA_POLICY_INTERLEAVE;
+    NeoPDF placed_pdf(pdfname, 0, options);
+    assert(placed_pdf.xfxQ2(21, 1e-3, 1e2) == neo_pdfs[0].xfxQ2(21, 1e-3, 1e2));
+
+    std::cout << "NUMA placement test passed.\n";
+}
+
+int main() {
+    test_xfxq2_all_members();
+    test_uncertainty();
+    test_executor();
+    test_c_executor();
+    test_numa_placement();
+
+    return 0;
+}
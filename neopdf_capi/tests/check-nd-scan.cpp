@@ -0,0 +1,64 @@
+#include <NeoPDF.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace neopdf;
+
+const double TOLERANCE = 1e-12;
+
+bool is_close(double result, double expected, double tolerance) {
+    return std::abs(result - expected) <= tolerance * std::max(std::abs(expected), 1.0);
+}
+
+void test_xfxq2_nd_scan() {
+    std::cout << "=== Test xfxQ2_ND scan over the nucleon numbers ===\n";
+
+    std::string pdfname = "nNNPDF30_nlo_as_0118.neopdf.lz4";
+    NeoPDF neo_pdf(pdfname, 0);
+
+    std::vector<double> a_range = neo_pdf.param_range(NEOPDF_SUBGRID_PARAMS_NUCLEONS);
+    std::cout << "Nucleon numbers from " << a_range[0] << " to " << a_range[1] << "\n";
+
+    // The scan shares the interpolation in (x, Q2) across the nucleon numbers, including at
+    // and beyond the boundaries.
+    std::vector<double> nucleons = {1.0, 2.0, 4.0, 12.0, 40.0, 56.0, 56.0, 100.0, 208.0, 300.0};
+    double points[][2] = {{1e-3, 1e2}, {0.1, 1e4}, {0.5, 10.0}};
+    for (int32_t pid : {-2, 21, 1, 2}) {
+        for (const auto& point : points) {
+            std::vector<double> params = {0.0, point[0], point[1]};
+            std::vector<double> results = neo_pdf.xfxQ2_ND(pid, params, nucleons);
+            assert(results.size() == nucleons.size());
+            for (size_t i = 0; i < nucleons.size(); ++i) {
+                double expected = neo_pdf.xfxQ2_ND(pid, {nucleons[i], point[0], point[1]});
+                assert(is_close(results[i], expected, TOLERANCE));
+            }
+        }
+    }
+    std::cout << "Scanned " << nucleons.size() << " nucleon numbers at 3 points\n";
+
+    // An empty scan is a no-op.
+    std::vector<double> empty = neo_pdf.xfxQ2_ND(21, {0.0, 1e-3, 1e2}, std::vector<double>());
+    assert(empty.empty());
+
+    // A point without leading parameter is rejected.
+    bool rejected = false;
+    try {
+        neo_pdf.xfxQ2_ND(21, {1e-3, 1e2}, nucleons);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+
+    std::cout << "xfxQ2_ND scan test passed.\n";
+}
+
+int main() {
+    test_xfxq2_nd_scan();
+
+    return 0;
+}
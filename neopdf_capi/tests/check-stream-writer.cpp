@@ -0,0 +1,155 @@
+#include <NeoPDF.hpp>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace neopdf;
+
+const double TOLERANCE = 1e-16;
+
+const size_t NUM_MEMBERS = 3;
+
+/** @brief Builds the metadata of the members written from `ref_pdf`. */
+MetaData make_metadata(const NeoPDF& ref_pdf) {
+    std::vector<double> x_range = ref_pdf.param_range(NEOPDF_SUBGRID_PARAMS_MOMENTUM);
+    std::vector<double> q2_range = ref_pdf.param_range(NEOPDF_SUBGRID_PARAMS_SCALE);
+
+    PhysicsParameters phys_params;
+    phys_params.flavor_scheme = "variable";
+    phys_params.order_qcd = 2;
+    phys_params.alphas_order_qcd = 2;
+    phys_params.m_w = 80.352;
+    phys_params.m_z = 91.1876;
+    phys_params.m_up = 0.0;
+    phys_params.m_down = 0.0;
+    phys_params.m_strange = 0.0;
+    phys_params.m_charm = 1.51;
+    phys_params.m_bottom = 4.92;
+    phys_params.m_top = 172.5;
+    phys_params.alphas_type = "ipol";
+    phys_params.number_flavors = 4;
+
+    MetaData meta;
+    meta.set_desc = "NNPDF40_nnlo_as_01180 streamed members";
+    meta.set_index = 0;
+    meta.num_members = NUM_MEMBERS;
+    meta.x_min = x_range[0];
+    meta.x_max = x_range[1];
+    meta.q_min = std::sqrt(q2_range[0]);
+    meta.q_max = std::sqrt(q2_range[1]);
+    meta.flavors = ref_pdf.pids();
+    meta.format = "neopdf";
+    meta.alphas_q_values = {2.0};
+    meta.alphas_vals = {0.118};
+    meta.polarised = false;
+    meta.set_type = NEOPDF_SET_TYPE_SPACE_LIKE;
+    meta.interpolator_type = NEOPDF_INTERPOLATOR_TYPE_LOG_BICUBIC;
+    meta.error_type = "replicas";
+    meta.hadron_pid = 2212;
+    meta.phys_params = phys_params;
+    return meta;
+}
+
+/** @brief Returns the path of `filename` in `NEOPDF_DATA_PATH` if defined. */
+std::string output_path(const std::string& filename) {
+    const char* neopdf_path = std::getenv("NEOPDF_DATA_PATH");
+    if (!neopdf_path) {
+        return filename;
+    }
+    std::string path(neopdf_path);
+    return path + (path.back() == '/' ? "" : "/") + filename;
+}
+
+void test_stream_writer(const std::string& filename) {
+    std::cout << "=== Test GridStreamWriter into " << filename << " ===\n";
+
+    std::string pdfname = "NNPDF40_nnlo_as_01180";
+    NeoPDF ref_pdf(pdfname, 0);
+    std::vector<int32_t> pids = ref_pdf.pids();
+    size_t num_subgrids = ref_pdf.num_subgrids();
+
+    GridStreamWriter writer(make_metadata(ref_pdf), output_path(filename));
+    for (size_t m = 0; m < NUM_MEMBERS; ++m) {
+        NeoPDF pdf(pdfname, m);
+
+        // The knots and values of the subgrids are borrowed until the member is pushed.
+        std::vector<std::vector<double>> knots;
+        std::vector<std::vector<double>> values;
+        knots.reserve(5 * num_subgrids);
+        values.reserve(num_subgrids);
+        for (size_t subgrid_idx = 0; subgrid_idx != num_subgrids; ++subgrid_idx) {
+            knots.push_back(pdf.subgrid_for_param(NEOPDF_SUBGRID_PARAMS_NUCLEONS, subgrid_idx));
+            knots.push_back(pdf.subgrid_for_param(NEOPDF_SUBGRID_PARAMS_ALPHAS, subgrid_idx));
+            knots.push_back(pdf.subgrid_for_param(NEOPDF_SUBGRID_PARAMS_KT, subgrid_idx));
+            knots.push_back(pdf.subgrid_for_param(NEOPDF_SUBGRID_PARAMS_MOMENTUM, subgrid_idx));
+            knots.push_back(pdf.subgrid_for_param(NEOPDF_SUBGRID_PARAMS_SCALE, subgrid_idx));
+            const std::vector<double>& xs = knots[knots.size() - 2];
+            const std::vector<double>& q2s = knots[knots.size() - 1];
+
+            // NOTE: This assumes that there is no 'A' and `alphas` dependence.
+            std::vector<double> grid_data;
+            for (double x : xs) {
+                for (double q2 : q2s) {
+                    for (int32_t pid : pids) {
+                        grid_data.push_back(pdf.xfxQ2(pid, x, q2));
+                    }
+                }
+            }
+            values.push_back(grid_data);
+
+            size_t first = knots.size() - 5;
+            writer.add_subgrid(
+                knots[first], knots[first + 1], knots[first + 2], knots[first + 3],
+                knots[first + 4], values.back()
+            );
+        }
+
+        writer.push_grid(pids);
+        std::cout << "Wrote member " << m << "\n";
+    }
+    assert(writer.size() == NUM_MEMBERS);
+    writer.finish();
+
+    // A finished writer does not accept members anymore.
+    bool rejected = false;
+    try {
+        writer.push_grid(pids);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+
+    // If `NEOPDF_DATA_PATH` is defined, reload the members and check their values.
+    if (std::getenv("NEOPDF_DATA_PATH")) {
+        for (size_t m = 0; m < NUM_MEMBERS; ++m) {
+            NeoPDF pdf(pdfname, m);
+            NeoPDF written(filename, m);
+            for (double x : {1e-5, 1e-3, 0.1, 0.6}) {
+                for (double q2 : {2.0, 1e2, 1e4}) {
+                    double expected = pdf.xfxQ2(21, x, q2);
+                    assert(std::abs(written.xfxQ2(21, x, q2) - expected) < TOLERANCE);
+                }
+            }
+        }
+
+        NeoPDFLazy lazy(filename);
+        size_t num_read = 0;
+        while (lazy.next()) {
+            num_read += 1;
+        }
+        assert(num_read == NUM_MEMBERS);
+    }
+
+    std::cout << "GridStreamWriter test passed.\n";
+}
+
+int main() {
+    test_stream_writer("check-stream-writer.neopdf.lz4");
+    test_stream_writer("check-stream-writer.neopdf");
+
+    return 0;
+}
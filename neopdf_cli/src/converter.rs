@@ -248,7 +248,7 @@ pub fn run_cli(cli: Cli) -> Result<(), Box<dyn std::error::Error>> {
                 _ => return Err(format!("Unknown metadata key: {key}").into()),
             }
             let grids_data: Vec<_> = grids_with_metadata.iter().map(|g| &g.grid).collect();
-            neopdf::writer::GridArrayCollection::compress(&grids_data, &metadata, path)?;
+            neopdf::writer::GridArrayCollection::write(&grids_data, &metadata, path)?;
         }
     }
     Ok(())
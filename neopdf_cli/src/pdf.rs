@@ -3,6 +3,7 @@
 //! This module provides subcommands for evaluating PDF values and `alpha_s` at specified kinematic points.
 
 use clap::{Args, Parser, Subcommand};
+use neopdf::gridpdf::LoadOptions;
 use std::process;
 
 /// Command-line interface for PDF and `alpha_s` evaluation.
@@ -23,6 +24,9 @@ pub enum PdfCommands {
     /// Evaluate `alphasQ2` for a given set, member, and Q2 value.
     #[command(name = "alphas_q2")]
     AlphasQ2(AlphasQ2Args),
+    /// Report the deviation of a member stored in single precision from double precision
+    #[command(name = "precision")]
+    Precision(PrecisionArgs),
     /// Evaluate TMD PDF for a given set, member, and input values.
     #[cfg(feature = "tmdlib")]
     #[command(name = "xfx_q2_kt")]
@@ -60,6 +64,17 @@ pub struct AlphasQ2Args {
     pub q2: f64,
 }
 
+/// Arguments for the `precision` subcommand.
+#[derive(Args, Clone)]
+pub struct PrecisionArgs {
+    /// Name of the PDF set (LHAPDF or `NeoPDF` file)
+    #[arg(short, long)]
+    pub pdf_name: String,
+    /// Member index (0-based)
+    #[arg(short, long)]
+    pub member: usize,
+}
+
 /// Arguments for the `xfxQ2_kt` subcommand.
 #[cfg(feature = "tmdlib")]
 #[derive(Args, Clone)]
@@ -98,6 +113,15 @@ pub fn main(cli: PdfCli) {
             let val = pdf.alphas_q2(args.q2);
             println!("{val}");
         }
+        PdfCommands::Precision(args) => {
+            let double = neopdf::pdf::PDF::load(&args.pdf_name, args.member);
+            let options = LoadOptions {
+                single_precision: true,
+                ..LoadOptions::default()
+            };
+            let single = neopdf::pdf::PDF::load_with_options(&args.pdf_name, args.member, options);
+            println!("{}", single.precision_report(&double));
+        }
         #[cfg(feature = "tmdlib")]
         PdfCommands::XfxQ2Kt(args) => {
             use neopdf_tmdlib::Tmd;
@@ -140,7 +140,8 @@ pub fn main(cli: ReadCli) {
             }
             println!();
 
-            let grid_slice = subgrid.grid.slice(s![
+            let grid = subgrid.grid();
+            let grid_slice = grid.slice(s![
                 args.nucleon_index,
                 args.alphas_index,
                 pid_idx,
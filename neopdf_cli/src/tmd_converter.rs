@@ -1,6 +1,7 @@
 //! CLI logic for `NeoPDF` TMD conversion utilities.
 
 use ndarray::Array1;
+use rayon::prelude::*;
 use serde::Deserialize;
 use std::f64::consts::PI;
 use std::fs;
@@ -9,7 +10,7 @@ use neopdf::gridpdf::GridArray;
 use neopdf::metadata::{InterpolatorType, MetaData, MetaDataV1, SetType};
 use neopdf::subgrid::SubGrid;
 use neopdf::writer::GridArrayCollection;
-use neopdf_tmdlib::Tmd;
+use neopdf_tmdlib::{Tmd, NUM_FLAVORS};
 
 #[derive(Deserialize)]
 struct TmdConfig {
@@ -115,6 +116,8 @@ fn construct_subgrids(
         .collect()
 }
 
+/// Evaluates the TMDs of the member held by `tmd` on the knots of a subgrid, in the layout
+/// expected by `SubGrid::new`.
 fn create_grid_data(
     tmd: &mut Tmd,
     config: &TmdConfig,
@@ -125,61 +128,120 @@ fn create_grid_data(
     // NOTE: Hard-coded definition of how `TMDlib` flavours are constructed.
     const TMDLIB_PIDS: &[i32] = &[-6, -5, -4, -3, -2, -1, 21, 1, 2, 3, 4, 5, 6];
 
-    config
-        .nucleons
+    let n_knots = kts.len() * xs.len() * q2s.len();
+    let mut knot_kts = Vec::with_capacity(n_knots);
+    let mut knot_xs = Vec::with_capacity(n_knots);
+    let mut knot_qs = Vec::with_capacity(n_knots);
+    for &kt in kts {
+        for &x in xs {
+            for &q2 in q2s {
+                knot_kts.push(kt);
+                knot_xs.push(x);
+                knot_qs.push(q2.sqrt());
+            }
+        }
+    }
+
+    let mut tmd_pds = vec![0.0; n_knots * NUM_FLAVORS];
+    tmd.xfxq2kt_batch(&knot_xs, &knot_kts, &knot_qs, &mut tmd_pds);
+
+    let positions: Vec<Option<usize>> = config
+        .pids
         .iter()
-        .flat_map(|_nuc| config.alphas.iter())
-        .flat_map(|_alpha| kts.iter())
-        .flat_map(|&kt| xs.iter().map(move |&x| (kt, x)))
-        .flat_map(|(kt, x)| q2s.iter().map(move |&q2| (kt, x, q2)))
-        .flat_map(|(kt, x, q2)| {
-            let tmd_pds = tmd.xfxq2kt(x, kt, q2.sqrt());
-            config.pids.iter().map(move |&pid| {
-                TMDLIB_PIDS
-                    .iter()
-                    .position(|&p| p == pid)
-                    .map_or(0.0, |pos| tmd_pds[pos])
-            })
+        .map(|&pid| TMDLIB_PIDS.iter().position(|&p| p == pid))
+        .collect();
+    let block: Vec<f64> = tmd_pds
+        .chunks_exact(NUM_FLAVORS)
+        .flat_map(|values| {
+            positions
+                .iter()
+                .map(move |pos| pos.map_or(0.0, |pos| values[pos]))
         })
-        .collect()
+        .collect();
+
+    // The TMDs depend neither on the nucleon numbers nor on the values of alpha_s, such that
+    // the same block is repeated for each of their combinations.
+    block.repeat(config.nucleons.len() * config.alphas.len())
 }
 
-#[allow(clippy::cast_possible_truncation)]
-#[allow(clippy::cast_possible_wrap)]
-fn create_member_grid(
-    tmd: &mut Tmd,
+/// A `TMDlib` instance owned by a worker thread, together with the member it holds.
+struct TmdWorker {
+    tmd: Tmd,
+    member: Option<usize>,
+}
+
+impl TmdWorker {
+    fn new() -> Self {
+        let mut tmd = Tmd::new();
+        tmd.set_verbosity(0);
+        Self { tmd, member: None }
+    }
+
+    /// Returns the instance holding `member`, which is only initialised if the instance was
+    /// holding a different member.
+    #[allow(clippy::cast_possible_truncation)]
+    #[allow(clippy::cast_possible_wrap)]
+    fn select(&mut self, set_name: &str, member: usize) -> &mut Tmd {
+        if self.member != Some(member) {
+            self.tmd.init(set_name, member as i32);
+            self.member = Some(member);
+        }
+        &mut self.tmd
+    }
+}
+
+/// Builds the grids of all the members, evaluating the subgrids of all the members in
+/// parallel.
+///
+/// Each worker thread owns its own `TMDlib` instance. The subgrids are visited member by
+/// member, such that a worker only re-initialises its instance when it moves on to a
+/// different member.
+fn create_member_grids(
     config: &TmdConfig,
-    member: usize,
+    n_members: usize,
     kt_subgrids: &[&[f64]],
     x_subgrids: &[&[f64]],
     q2_subgrids: &[&[f64]],
-) -> GridArray {
-    tmd.init(&config.set_name, member as i32);
-
-    let mut subgrids = Vec::new();
-    for kts in kt_subgrids {
-        for xs in x_subgrids {
-            for q2s in q2_subgrids {
-                let grid_data = create_grid_data(tmd, config, kts, xs, q2s);
-
-                let subgrid = SubGrid::new(
-                    config.nucleons.clone(),
-                    config.alphas.clone(),
-                    kts.to_vec(),
-                    xs.to_vec(),
-                    q2s.to_vec(),
-                    config.pids.len(),
-                    grid_data,
-                );
-                subgrids.push(subgrid);
+) -> Vec<GridArray> {
+    let mut tasks = Vec::new();
+    for member in 0..n_members {
+        for &kts in kt_subgrids {
+            for &xs in x_subgrids {
+                for &q2s in q2_subgrids {
+                    tasks.push((member, kts, xs, q2s));
+                }
             }
         }
     }
 
-    GridArray {
-        pids: config.pids.clone().into(),
-        subgrids,
+    let subgrids: Vec<(usize, SubGrid)> = tasks
+        .into_par_iter()
+        .map_init(TmdWorker::new, |worker, (member, kts, xs, q2s)| {
+            let tmd = worker.select(&config.set_name, member);
+            let grid_data = create_grid_data(tmd, config, kts, xs, q2s);
+
+            let subgrid = SubGrid::new(
+                config.nucleons.clone(),
+                config.alphas.clone(),
+                kts.to_vec(),
+                xs.to_vec(),
+                q2s.to_vec(),
+                config.pids.len(),
+                grid_data,
+            );
+            (member, subgrid)
+        })
+        .collect();
+
+    let mut member_subgrids: Vec<Vec<SubGrid>> = (0..n_members).map(|_| Vec::new()).collect();
+    for (member, subgrid) in subgrids {
+        member_subgrids[member].push(subgrid);
     }
+
+    member_subgrids
+        .into_iter()
+        .map(|subgrids| GridArray::from_subgrids(subgrids, config.pids.clone().into()))
+        .collect()
 }
 
 /// TODO
@@ -237,12 +299,7 @@ pub fn convert_tmd(input_path: &str, output_path: &str) -> Result<(), Box<dyn st
     let xs: Vec<&[f64]> = x_subgrids.iter().map(Vec::as_slice).collect();
     let q2s: Vec<&[f64]> = q2_subgrids.iter().map(Vec::as_slice).collect();
 
-    let member_grids: Vec<_> = (0..n_members)
-        .map(|m| {
-            tmd.init(&config.set_name, m as i32);
-            create_member_grid(&mut tmd, &config, m, &kts, &xs, &q2s)
-        })
-        .collect();
+    let member_grids = create_member_grids(&config, n_members, &kts, &xs, &q2s);
 
     let member_grid_refs: Vec<&GridArray> = member_grids.iter().collect();
 
@@ -280,7 +337,7 @@ pub fn convert_tmd(input_path: &str, output_path: &str) -> Result<(), Box<dyn st
         number_flavors: config.number_flavors,
     });
 
-    GridArrayCollection::compress(&member_grid_refs, &meta, output_path)?;
+    GridArrayCollection::write(&member_grid_refs, &meta, output_path)?;
     println!("Compression succeeded!");
 
     Ok(())
@@ -10,6 +10,7 @@ Usage: neopdf compute <COMMAND>
 Commands:
   xfx_q2     Evaluate xf(x, Q2, pid, ...) for a given set, member, and input values
   alphas_q2  Evaluate `alphasQ2` for a given set, member, and Q2 value
+  precision  Report the deviation of a member stored in single precision from double precision
   help       Print this message or the help of the given subcommand(s)
 
 Options:
@@ -151,6 +152,24 @@ fn alphasq2_neopdf() {
         .stdout("0.2485925816007479\n");
 }
 
+#[test]
+fn precision_lhapdf() {
+    Command::cargo_bin("neopdf")
+        .unwrap()
+        .args([
+            "compute",
+            "precision",
+            "--pdf-name",
+            "NNPDF40_nnlo_as_01180",
+            "--member",
+            "0",
+        ])
+        .assert()
+        .success()
+        .stdout(str::contains("max. rel. dev."))
+        .stdout(str::contains("    21  "));
+}
+
 #[test]
 #[cfg(feature = "tmdlib")]
 fn xfxq2_kt_tmdlib() {
@@ -3,7 +3,7 @@ use numpy::{PyArrayMethods, PyReadonlyArray6};
 use pyo3::prelude::*;
 
 use neopdf::gridpdf::GridArray;
-use neopdf::subgrid::{ParamRange, SubGrid};
+use neopdf::subgrid::SubGrid;
 
 /// Python wrapper for the `SubGrid` struct.
 #[pyclass(name = "SubGrid")]
@@ -45,25 +45,7 @@ impl PySubGrid {
         alphas: Vec<f64>,
         grid: PyReadonlyArray6<f64>,
     ) -> PyResult<Self> {
-        let alphas_range = ParamRange::new(*alphas.first().unwrap(), *alphas.last().unwrap());
-        let x_range = ParamRange::new(*xs.first().unwrap(), *xs.last().unwrap());
-        let q2_range = ParamRange::new(*q2s.first().unwrap(), *q2s.last().unwrap());
-        let kt_range = ParamRange::new(*kts.first().unwrap(), *kts.last().unwrap());
-        let nucleons_range = ParamRange::new(*nucleons.first().unwrap(), *nucleons.last().unwrap());
-
-        let subgrid = SubGrid {
-            xs: Array1::from(xs),
-            q2s: Array1::from(q2s),
-            kts: Array1::from(kts),
-            grid: grid.to_owned_array(),
-            nucleons: Array1::from(nucleons),
-            alphas: Array1::from(alphas),
-            nucleons_range,
-            alphas_range,
-            kt_range,
-            x_range,
-            q2_range,
-        };
+        let subgrid = SubGrid::from_grid(nucleons, alphas, kts, xs, q2s, grid.to_owned_array());
 
         Ok(Self { subgrid })
     }
@@ -104,7 +86,7 @@ impl PySubGrid {
     /// Returns the shape of the subgrid
     #[must_use]
     pub fn grid_shape(&self) -> (usize, usize, usize, usize, usize, usize) {
-        self.subgrid.grid.dim()
+        self.subgrid.grid_dim()
     }
 }
 
@@ -135,10 +117,7 @@ impl PyGridArray {
             .map(|py_ref| py_ref.subgrid.clone())
             .collect();
 
-        let gridarray = GridArray {
-            pids: Array1::from(pids),
-            subgrids,
-        };
+        let gridarray = GridArray::from_subgrids(subgrids, Array1::from(pids));
         Self { gridarray }
     }
 
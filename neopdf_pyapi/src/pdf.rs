@@ -1,8 +1,10 @@
-use numpy::{IntoPyArray, PyArray2};
+use ndarray::Array3;
+use numpy::{IntoPyArray, PyArray2, PyArray3};
+use pyo3::exceptions::PyRuntimeError;
 use pyo3::prelude::*;
 use std::sync::Mutex;
 
-use neopdf::gridpdf::ForcePositive;
+use neopdf::gridpdf::{ForcePositive, LoadOptions};
 use neopdf::pdf::PDF;
 
 use super::gridpdf::PySubGrid;
@@ -132,6 +134,13 @@ impl PyPDF {
     ///     The name of the PDF set.
     /// member : int
     ///     The ID of the PDF member to load. Defaults to 0.
+    /// precompute_coeffs : bool
+    ///     Precompute the per-cell coefficients of the `LogBicubic` interpolation for
+    ///     faster evaluations at the cost of memory. Defaults to False.
+    /// single_precision : bool
+    ///     Store the knot values of the 2D subgrids in single precision, halving their
+    ///     memory footprint, while still interpolating in double precision. Defaults to
+    ///     False.
     ///
     /// Returns
     /// -------
@@ -139,10 +148,20 @@ impl PyPDF {
     ///     A new `PDF` instance.
     #[new]
     #[must_use]
-    #[pyo3(signature = (pdf_name, member = 0))]
-    pub fn new(pdf_name: &str, member: usize) -> Self {
+    #[pyo3(signature = (pdf_name, member = 0, precompute_coeffs = false, single_precision = false))]
+    pub fn new(
+        pdf_name: &str,
+        member: usize,
+        precompute_coeffs: bool,
+        single_precision: bool,
+    ) -> Self {
+        let options = LoadOptions {
+            precompute_coeffs,
+            single_precision,
+            ..LoadOptions::default()
+        };
         Self {
-            pdf: PDF::load(pdf_name, member),
+            pdf: PDF::load_with_options(pdf_name, member, options),
         }
     }
 
@@ -157,6 +176,13 @@ impl PyPDF {
     ///     The name of the PDF set.
     /// member : int
     ///     The ID of the PDF member. Defaults to 0.
+    /// precompute_coeffs : bool
+    ///     Precompute the per-cell coefficients of the `LogBicubic` interpolation for
+    ///     faster evaluations at the cost of memory. Defaults to False.
+    /// single_precision : bool
+    ///     Store the knot values of the 2D subgrids in single precision, halving their
+    ///     memory footprint, while still interpolating in double precision. Defaults to
+    ///     False.
     ///
     /// Returns
     /// -------
@@ -165,9 +191,14 @@ impl PyPDF {
     #[must_use]
     #[staticmethod]
     #[pyo3(name = "mkPDF")]
-    #[pyo3(signature = (pdf_name, member = 0))]
-    pub fn mkpdf(pdf_name: &str, member: usize) -> Self {
-        Self::new(pdf_name, member)
+    #[pyo3(signature = (pdf_name, member = 0, precompute_coeffs = false, single_precision = false))]
+    pub fn mkpdf(
+        pdf_name: &str,
+        member: usize,
+        precompute_coeffs: bool,
+        single_precision: bool,
+    ) -> Self {
+        Self::new(pdf_name, member, precompute_coeffs, single_precision)
     }
 
     /// Loads all members of the PDF set.
@@ -202,13 +233,17 @@ impl PyPDF {
 
     /// Creates an iterator that loads PDF members lazily.
     ///
-    /// This function is suitable for `.neopdf.lz4` files, which support lazy loading.
+    /// This function is suitable for `.neopdf.lz4` and `.neopdf` files, which support lazy
+    /// loading.
     /// It returns an iterator that yields `PDF` instances on demand, which is useful
     /// for reducing memory consumption when working with large PDF sets.
     ///
     /// # Arguments
     ///
-    /// * `pdf_name` - The name of the PDF set (must end with `.neopdf.lz4`).
+    /// * `pdf_name` - The name of the PDF set (must end with `.neopdf.lz4` or `.neopdf`).
+    /// * `prefetch_depth` - If given, the following members are decoded and built on a
+    ///   background thread while the current one is processed, with at most
+    ///   `prefetch_depth` of them queued ahead.
     ///
     /// # Returns
     ///
@@ -216,9 +251,19 @@ impl PyPDF {
     #[must_use]
     #[staticmethod]
     #[pyo3(name = "mkPDFs_lazy")]
-    pub fn mkpdfs_lazy(pdf_name: &str) -> PyLazyPDFs {
+    #[pyo3(signature = (pdf_name, prefetch_depth = None))]
+    pub fn mkpdfs_lazy(pdf_name: &str, prefetch_depth: Option<usize>) -> PyLazyPDFs {
+        let iter: Box<dyn Iterator<Item = LazyType> + Send> = match prefetch_depth {
+            Some(depth) => Box::new(PDF::load_pdfs_lazy_prefetched(
+                pdf_name,
+                depth,
+                LoadOptions::default(),
+            )),
+            None => Box::new(PDF::load_pdfs_lazy(pdf_name)),
+        };
+
         PyLazyPDFs {
-            iter: Mutex::new(Box::new(PDF::load_pdfs_lazy(pdf_name))),
+            iter: Mutex::new(iter),
         }
     }
 
@@ -477,6 +522,47 @@ impl PyPDF {
         self.pdf.xfxq2s(pids, slice_points).into_pyarray(py)
     }
 
+    /// Interpolates the PDF values (xf) for several flavors on the tensor product of a list
+    /// of x-values and a list of Q2-values.
+    ///
+    /// The knot intervals and interpolation weights are computed once per x-value and once
+    /// per Q2-value instead of once per point.
+    ///
+    /// Parameters
+    /// ----------
+    /// pids : list[int]
+    ///     A list of flavor IDs.
+    /// xs : list[float]
+    ///     A list of momentum fractions.
+    /// q2s : list[float]
+    ///     A list of energy scales squared.
+    ///
+    /// Returns
+    /// -------
+    /// numpy.ndarray
+    ///     A 3D NumPy array of shape `(len(pids), len(xs), len(q2s))`.
+    ///
+    /// Raises
+    /// ------
+    /// RuntimeError
+    ///     If a flavor is not part of the set or the interpolation fails.
+    #[pyo3(name = "xfxQ2_grid")]
+    #[allow(clippy::needless_pass_by_value)]
+    pub fn xfxq2_grid<'py>(
+        &self,
+        pids: Vec<i32>,
+        xs: Vec<f64>,
+        q2s: Vec<f64>,
+        py: Python<'py>,
+    ) -> PyResult<Bound<'py, PyArray3<f64>>> {
+        let mut out = Array3::zeros((pids.len(), xs.len(), q2s.len()));
+        self.pdf
+            .xfxq2_grid(&pids, &xs, &q2s, out.as_slice_mut().unwrap())
+            .map_err(|e| PyRuntimeError::new_err(e.to_string()))?;
+
+        Ok(out.into_pyarray(py))
+    }
+
     /// Computes the alpha_s value at a given Q2.
     ///
     /// Parameters
@@ -3,6 +3,7 @@ import numpy as np
 
 from itertools import product
 from neopdf.pdf import ForcePositive
+from neopdf.pdf import PDF as NeoPDF
 
 
 @pytest.mark.parametrize("pdfname", ["NNPDF40_nnlo_as_01180", "MSHT20qed_an3lo"])
@@ -68,6 +69,21 @@ class TestPDFInterpolations:
         ref = [lhapdf.xfxQ2(pid, x, q2) for x, q2 in product(xs, q2s)]
         np.testing.assert_equal(res, [ref])
 
+    def test_xfxq2_grid(self, neo_pdf, xq2_points, pdfname):
+        neopdf = neo_pdf(pdfname)
+        xs, q2s = xq2_points(
+            xmin=neopdf.x_min(),
+            xmax=neopdf.x_max(),
+            q2min=neopdf.q2_min(),
+            q2max=neopdf.q2_max(),
+        )
+        pids = [-2, 21, 1]
+
+        res = neopdf.xfxQ2_grid(pids, xs, q2s)
+        ref = neopdf.xfxQ2s(pids, xs, q2s)
+        assert res.shape == (len(pids), len(xs), len(q2s))
+        np.testing.assert_allclose(res.reshape(len(pids), -1), ref, rtol=1e-12, atol=1e-12)
+
 
 class TestAlphaSInterpolations:
     @pytest.mark.parametrize("pdfname", ["NNPDF40_nnlo_as_01180", "MSHT20qed_an3lo"])
@@ -109,6 +125,18 @@ class TestLazyLoader:
             res = pdf.xfxQ2(21, 1e-5, 1e2)
             assert isinstance(res, float)
 
+    @pytest.mark.parametrize("pdfname", ["NNPDF40_nnlo_as_01180.neopdf.lz4"])
+    @pytest.mark.parametrize("prefetch_depth", [0, 4])
+    def test_lazy_loader_prefetched(self, pdfname, prefetch_depth):
+        reference = NeoPDF.mkPDFs_lazy(pdfname)
+        neopdfs = NeoPDF.mkPDFs_lazy(pdfname, prefetch_depth=prefetch_depth)
+
+        num_members = 0
+        for pdf, ref in zip(neopdfs, reference):
+            assert pdf.xfxQ2(21, 1e-5, 1e2) == ref.xfxQ2(21, 1e-5, 1e2)
+            num_members += 1
+        assert num_members == 101
+
 
 class TestForcePositive:
     def test_force_positive(self, neo_pdf):
@@ -29,10 +29,14 @@ pub mod ffi {
         fn tmd_get_ktmin(tmd: Pin<&mut TMD>) -> f64;
         fn tmd_get_ktmax(tmd: Pin<&mut TMD>) -> f64;
         fn tmd_pdf(tmd: Pin<&mut TMD>, x: f64, kt: f64, q: f64) -> Vec<f64>;
+        fn tmd_pdf_batch(tmd: Pin<&mut TMD>, xs: &[f64], kts: &[f64], qs: &[f64], pdfs: &mut [f64]);
         fn tmd_set_verbosity(tmd: Pin<&mut TMD>, verbosity: i32);
     }
 }
 
+/// The number of flavours returned by `TMDlib` for each knot, i.e. `[-6, ..., -1, 21, 1, ..., 6]`.
+pub const NUM_FLAVORS: usize = 13;
+
 pub struct Tmd {
     ptr: UniquePtr<ffi::TMD>,
 }
@@ -84,6 +88,20 @@ impl Tmd {
         ffi::tmd_pdf(self.ptr.pin_mut(), x, kt, q)
     }
 
+    /// Evaluates the TMDs at many `(x, kt, q)` knots at once, writing the `NUM_FLAVORS`
+    /// values of the i-th knot into `pdfs[i * NUM_FLAVORS..(i + 1) * NUM_FLAVORS]`.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `xs`, `kts` and `qs` do not have the same length, or if `pdfs` does not hold
+    /// `NUM_FLAVORS` values for each knot.
+    pub fn xfxq2kt_batch(&mut self, xs: &[f64], kts: &[f64], qs: &[f64], pdfs: &mut [f64]) {
+        assert_eq!(xs.len(), kts.len());
+        assert_eq!(xs.len(), qs.len());
+        assert_eq!(pdfs.len(), xs.len() * NUM_FLAVORS);
+        ffi::tmd_pdf_batch(self.ptr.pin_mut(), xs, kts, qs, pdfs);
+    }
+
     pub fn set_verbosity(&mut self, verbosity: i32) {
         ffi::tmd_set_verbosity(self.ptr.pin_mut(), verbosity);
     }
@@ -1,5 +1,6 @@
 #include "neopdf_tmdlib/src/tmdlib.hpp"
 #include "tmdlib/TMDlib.h"
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <iterator>
@@ -59,6 +60,22 @@ rust::Vec<double> tmd_pdf(TMDlib::TMD& tmd, double x, double kt, double q) {
     return std_vector_to_rust_vec(pdfs);
 }
 
+void tmd_pdf_batch(TMDlib::TMD& tmd, rust::Slice<const double> xs, rust::Slice<const double> kts,
+                   rust::Slice<const double> qs, rust::Slice<double> pdfs) {
+    if (xs.empty()) {
+        return;
+    }
+
+    const size_t stride = pdfs.size() / xs.size();
+    for (size_t i = 0; i < xs.size(); ++i) {
+        const std::vector<double> values = tmd.TMDpdf(xs[i], 0.0, kts[i], qs[i]);
+        const size_t n = std::min(stride, values.size());
+        double* out = pdfs.data() + i * stride;
+        std::copy(values.begin(), values.begin() + n, out);
+        std::fill(out + n, out + stride, 0.0);
+    }
+}
+
 void tmd_set_verbosity(TMDlib::TMD& tmd, int verbosity) {
     tmd.setVerbosity(verbosity);
 }
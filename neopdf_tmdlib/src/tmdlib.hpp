@@ -22,6 +22,8 @@ double tmd_get_q2max(TMDlib::TMD& tmd);
 double tmd_get_ktmin(TMDlib::TMD& tmd);
 double tmd_get_ktmax(TMDlib::TMD& tmd);
 rust::Vec<double> tmd_pdf(TMDlib::TMD& tmd, double x, double kt, double q);
+void tmd_pdf_batch(TMDlib::TMD& tmd, rust::Slice<const double> xs, rust::Slice<const double> kts,
+                   rust::Slice<const double> qs, rust::Slice<double> pdfs);
 void tmd_set_verbosity(TMDlib::TMD& tmd, int verbosity);
 
 #endif